@@ -0,0 +1,552 @@
+//======================================= alarm.c === BEGIN ===
+/**
+ * \file  'alarm.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Threshold alarms on the analog inputs A1 and A2.
+ *
+ * Every K8055 has got two comparators, one for A1 and one
+ * for A2. Each of them can watch a high limit and a low
+ * limit. A limit counts as crossed, if the input stays
+ * beyond it for a minimum duration. It counts as cleared,
+ * if the input returns by more than the hysteresis for the
+ * same duration.
+ *
+ * The comparators are evaluated on every EP81 report
+ * ('AlarmEvaluate()' is called by 'BoardReportIn()').
+ * With the Acquisition Thread running, the alarm latency is
+ * one report period (10 ms) plus the minimum duration, no
+ * matter how slowly an application polls.
+ *
+ * Crossings are queued as events. An application picks them
+ * up with 'K8055_GetAlarmEvent()', which can wait for the
+ * next event.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 'AlarmDetach()' waits for the threads in
+ * 'K8055_GetAlarmEvent()' before it closes the semaphores
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "alarm.h"
+
+
+/**
+* \brief Alarm data of one K8055
+*/
+typedef struct _ALARMBOARD
+{
+  HMTX         hmtx;      // Guards everything below
+  HEV          hev;       // Posted for every new event
+  ALARMCHANNEL aChannel[ ALARM_CHANNELS ];
+  ALARMEVENT   aEvent[ ALARM_EVENTS_MAX ];
+  ULONG        ulHead;    // Next event to be read
+  ULONG        ulCount;   // Number of queued events
+  BOOL         blLost;    // Queue overflowed
+  BOOL         blClosing; // 'AlarmDetach()' is running
+  ULONG        ulWaiters; // Threads waiting for 'hev'
+} ALARMBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Alarm data, indexed by Board Slot ---------------------//
+//
+ALARMBOARD aAlarm[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Resets one comparator to 'switched off'.
+*/
+static VOID AlarmChannelReset( ALARMCHANNEL *pChannel )
+{
+  pChannel->ulHigh = ALARM_LIMIT_OFF;
+  pChannel->ulLow = ALARM_LIMIT_OFF;
+  pChannel->ulHysteresis = 0;
+  pChannel->tmMinDuration = 0;
+  pChannel->ulState = ALARM_STATE_NORMAL;
+  pChannel->ulPending = ALARM_STATE_NORMAL;
+  pChannel->tmPendingSince = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'.
+*/
+VOID AlarmAttach( ULONG ulSlot )
+{
+  ULONG ulIndex;
+  ALARMBOARD *pAlarm;
+
+  pAlarm = &aAlarm[ ulSlot ];
+
+  for ( ulIndex = 0; ulIndex < ALARM_CHANNELS; ulIndex++ )
+  {
+    AlarmChannelReset( &pAlarm->aChannel[ ulIndex ] );
+  }
+  pAlarm->ulHead = 0;
+  pAlarm->ulCount = 0;
+  pAlarm->blLost = FALSE;
+  pAlarm->blClosing = FALSE;
+  pAlarm->ulWaiters = 0;
+
+  DosCreateMutexSem( NULL, &pAlarm->hmtx, 0, FALSE );
+  DosCreateEventSem( NULL, &pAlarm->hev, 0, FALSE );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardDetach()'. Threads waiting in
+*           'K8055_GetAlarmEvent()' are woken up. The
+*           semaphores are closed when the last of them has
+*           left, a thread still blocked on the mutex keeps
+*           it busy for a moment.
+*/
+VOID AlarmDetach( ULONG ulSlot )
+{
+  ULONG ulWaiters;
+  ALARMBOARD *pAlarm;
+
+  pAlarm = &aAlarm[ ulSlot ];
+
+  DosRequestMutexSem( pAlarm->hmtx, SEM_INDEFINITE_WAIT );
+  pAlarm->blClosing = TRUE;
+  DosPostEventSem( pAlarm->hev );
+  ulWaiters = pAlarm->ulWaiters;
+  DosReleaseMutexSem( pAlarm->hmtx );
+
+  while ( ulWaiters != 0 )
+  {
+    DosSleep( 1 );
+    DosRequestMutexSem( pAlarm->hmtx, SEM_INDEFINITE_WAIT );
+    ulWaiters = pAlarm->ulWaiters;
+    DosReleaseMutexSem( pAlarm->hmtx );
+  }
+
+  DosCloseEventSem( pAlarm->hev );
+  while ( DosCloseMutexSem( pAlarm->hmtx ) == ERROR_SEM_BUSY )
+  {
+    DosSleep( 1 );
+  }
+  pAlarm->hev = 0;
+  pAlarm->hmtx = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Puts one event into the queue of a board.
+*           Must be called with 'pAlarm->hmtx' owned.
+*           If the queue is full, the oldest event is
+*           dropped and ALARM_EV_LOST will be reported.
+*/
+static VOID AlarmQueue( ALARMBOARD *pAlarm,
+                        ULONG ulChannel,
+                        ULONG ulEvent,
+                        ULONG ulValue,
+                        K8055TIME tmReport )
+{
+  ULONG ulTail;
+  ALARMEVENT *pEvent;
+
+  if ( pAlarm->ulCount == ALARM_EVENTS_MAX )
+  {
+    pAlarm->ulHead = ( pAlarm->ulHead + 1 ) % ALARM_EVENTS_MAX;
+    --pAlarm->ulCount;
+    pAlarm->blLost = TRUE;
+  }
+
+  ulTail = ( pAlarm->ulHead + pAlarm->ulCount ) % ALARM_EVENTS_MAX;
+  pEvent = &pAlarm->aEvent[ ulTail ];
+  pEvent->ulChannel = ulChannel;
+  pEvent->ulEvent = ulEvent;
+  pEvent->ulValue = ulValue;
+  pEvent->ulTimeMs = (ULONG)( tmReport / 1000 );
+  ++pAlarm->ulCount;
+
+  DosPostEventSem( pAlarm->hev );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Evaluates both comparators of a board against
+*           a new EP81 report.
+*
+*           State diagram of one comparator:
+*
+*             NORMAL --( value >= High )--> HIGH
+*             HIGH ----( value <  High - Hysteresis )--> NORMAL
+*             NORMAL --( value <= Low )---> LOW
+*             LOW -----( value >  Low + Hysteresis )---> NORMAL
+*
+*           A transition only happens, if its condition holds
+*           for the minimum duration without interruption.
+*
+* \param    'pbyData'
+*           - The 8 data bytes { Ix xx A1 A2 ... }.
+*/
+VOID AlarmEvaluate( ULONG ulSlot,
+                    BYTE *pbyData,
+                    K8055TIME tmReport )
+{
+  ULONG ulIndex;
+  ULONG ulValue;
+  ULONG ulTarget;
+  ALARMBOARD *pAlarm;
+  ALARMCHANNEL *pChannel;
+
+  pAlarm = &aAlarm[ ulSlot ];
+  if ( pAlarm->hmtx == 0 )
+  {
+    return;
+  }
+
+  DosRequestMutexSem( pAlarm->hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < ALARM_CHANNELS; ulIndex++ )
+  {
+    pChannel = &pAlarm->aChannel[ ulIndex ];
+    ulValue = pbyData[ 2 + ulIndex ];   // A1, A2
+
+    // -- Which state does the value ask for? --
+    ulTarget = pChannel->ulState;
+    switch ( pChannel->ulState )
+    {
+      case ALARM_STATE_HIGH:
+        if ( ( pChannel->ulHigh == ALARM_LIMIT_OFF ) ||
+             ( ulValue + pChannel->ulHysteresis <
+               pChannel->ulHigh ) )
+        {
+          ulTarget = ALARM_STATE_NORMAL;
+        }
+        break;
+
+      case ALARM_STATE_LOW:
+        if ( ( pChannel->ulLow == ALARM_LIMIT_OFF ) ||
+             ( ulValue > pChannel->ulLow +
+                         pChannel->ulHysteresis ) )
+        {
+          ulTarget = ALARM_STATE_NORMAL;
+        }
+        break;
+
+      default:
+        if ( ( pChannel->ulHigh != ALARM_LIMIT_OFF ) &&
+             ( ulValue >= pChannel->ulHigh ) )
+        {
+          ulTarget = ALARM_STATE_HIGH;
+        }
+        else if ( ( pChannel->ulLow != ALARM_LIMIT_OFF ) &&
+                  ( ulValue <= pChannel->ulLow ) )
+        {
+          ulTarget = ALARM_STATE_LOW;
+        }
+        break;
+    }
+
+    // -- Minimum duration --
+    if ( ulTarget == pChannel->ulState )
+    {
+      pChannel->ulPending = ulTarget;
+      continue;
+    }
+    if ( ulTarget != pChannel->ulPending )
+    {
+      pChannel->ulPending = ulTarget;
+      pChannel->tmPendingSince = tmReport;
+    }
+    if ( tmReport - pChannel->tmPendingSince <
+         pChannel->tmMinDuration )
+    {
+      continue;
+    }
+
+    // -- Transition, raise the event(s) --
+    if ( pChannel->ulState == ALARM_STATE_HIGH )
+    {
+      AlarmQueue( pAlarm, ulIndex + 1, ALARM_EV_HIGH_CLEAR,
+                  ulValue, tmReport );
+    }
+    if ( pChannel->ulState == ALARM_STATE_LOW )
+    {
+      AlarmQueue( pAlarm, ulIndex + 1, ALARM_EV_LOW_CLEAR,
+                  ulValue, tmReport );
+    }
+    if ( ulTarget == ALARM_STATE_HIGH )
+    {
+      AlarmQueue( pAlarm, ulIndex + 1, ALARM_EV_HIGH_SET,
+                  ulValue, tmReport );
+    }
+    if ( ulTarget == ALARM_STATE_LOW )
+    {
+      AlarmQueue( pAlarm, ulIndex + 1, ALARM_EV_LOW_SET,
+                  ulValue, tmReport );
+    }
+    pChannel->ulState = ulTarget;
+  }
+
+  DosReleaseMutexSem( pAlarm->hmtx );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------19-
+//
+// Export Index 19
+/**
+* \brief 'K8055_SetAlarm()' configures the comparator of one
+* analog input. See 'func.h' for details.
+*/
+ULONG K8055_SetAlarm( ULONG *pulFileDesc,
+                      ULONG *pulChannel,
+                      ULONG *pulHighLimit,
+                      ULONG *pulLowLimit,
+                      ULONG *pulHysteresis,
+                      ULONG *pulMinDurationMs )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulChannel;
+  ALARMBOARD *pAlarm;
+  ALARMCHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulHighLimit ) ||
+       ( NULL == pulLowLimit ) ||
+       ( NULL == pulHysteresis ) ||
+       ( NULL == pulMinDurationMs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  // -- Channel 1..2, limits 0..255 or ALARM_LIMIT_OFF --
+  ulChannel = *pulChannel;
+  if ( ( ulChannel < 1 ) || ( ulChannel > ALARM_CHANNELS ) ||
+       ( ( *pulHighLimit > 255 ) &&
+         ( *pulHighLimit != ALARM_LIMIT_OFF ) ) ||
+       ( ( *pulLowLimit > 255 ) &&
+         ( *pulLowLimit != ALARM_LIMIT_OFF ) ) ||
+       ( *pulHysteresis > 255 ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  // -- Both limits on: Low must be below High --
+  if ( ( *pulHighLimit != ALARM_LIMIT_OFF ) &&
+       ( *pulLowLimit != ALARM_LIMIT_OFF ) &&
+       ( *pulLowLimit >= *pulHighLimit ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pAlarm = &aAlarm[ ulSlot ];
+  pChannel = &pAlarm->aChannel[ ulChannel - 1 ];
+
+  DosRequestMutexSem( pAlarm->hmtx, SEM_INDEFINITE_WAIT );
+  AlarmChannelReset( pChannel );
+  pChannel->ulHigh = *pulHighLimit;
+  pChannel->ulLow = *pulLowLimit;
+  pChannel->ulHysteresis = *pulHysteresis;
+  pChannel->tmMinDuration = (K8055TIME)*pulMinDurationMs * 1000;
+  DosReleaseMutexSem( pAlarm->hmtx );
+
+  return ulRc;
+}
+//---------19-
+
+
+//----------------------------------------------------------20-
+//
+// Export Index 20
+/**
+* \brief 'K8055_GetAlarmEvent()' takes the oldest alarm event
+* out of the queue. If the queue is empty, it waits up to
+* '*pulTimeoutMs' for a new one. See 'func.h' for details.
+*/
+ULONG K8055_GetAlarmEvent( ULONG *pulFileDesc,
+                           ULONG *pulTimeoutMs,
+                           ULONG *pulChannel,
+                           ULONG *pulEvent,
+                           ULONG *pulValue,
+                           ULONG *pulTimeMs     )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulPostCount;
+  ALARMBOARD *pAlarm;
+  ALARMEVENT *pEvent;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulTimeoutMs ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulEvent ) ||
+       ( NULL == pulValue ) ||
+       ( NULL == pulTimeMs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+  pAlarm = &aAlarm[ ulSlot ];
+
+  *pulChannel = 0;
+  *pulEvent = ALARM_EV_NONE;
+  *pulValue = 0;
+  *pulTimeMs = 0;
+
+  if ( DosRequestMutexSem( pAlarm->hmtx, SEM_INDEFINITE_WAIT )
+       != NO_DOS_ERROR )
+  {
+    // -- K8055_Close() has closed the semaphores --
+    return ulRc;
+  }
+  if ( pAlarm->blClosing == TRUE )
+  {
+    DosReleaseMutexSem( pAlarm->hmtx );
+    return ulRc;
+  }
+
+  if ( ( pAlarm->ulCount == 0 ) &&
+       ( pAlarm->blLost == FALSE ) &&
+       ( *pulTimeoutMs != 0 ) )
+  {
+    // -- Reset under the lock, so no post gets lost --
+    DosResetEventSem( pAlarm->hev, &ulPostCount );
+    ++pAlarm->ulWaiters;
+    DosReleaseMutexSem( pAlarm->hmtx );
+
+    DosWaitEventSem( pAlarm->hev, *pulTimeoutMs );
+
+    DosRequestMutexSem( pAlarm->hmtx, SEM_INDEFINITE_WAIT );
+    --pAlarm->ulWaiters;
+    if ( pAlarm->blClosing == TRUE )
+    {
+      // -- K8055_Close() while waiting --
+      DosReleaseMutexSem( pAlarm->hmtx );
+      return ulRc;
+    }
+  }
+
+  if ( pAlarm->blLost == TRUE )
+  {
+    pAlarm->blLost = FALSE;
+    *pulEvent = ALARM_EV_LOST;
+  }
+  else if ( pAlarm->ulCount > 0 )
+  {
+    pEvent = &pAlarm->aEvent[ pAlarm->ulHead ];
+    *pulChannel = pEvent->ulChannel;
+    *pulEvent = pEvent->ulEvent;
+    *pulValue = pEvent->ulValue;
+    *pulTimeMs = pEvent->ulTimeMs;
+    pAlarm->ulHead = ( pAlarm->ulHead + 1 ) % ALARM_EVENTS_MAX;
+    --pAlarm->ulCount;
+  }
+
+  DosReleaseMutexSem( pAlarm->hmtx );
+
+  return ulRc;
+}
+//---------20-
+
+
+//----------------------------------------------------------21-
+//
+// Export Index 21
+/**
+* \brief 'K8055_GetAlarmState()' tells the current state of
+* one comparator. See 'func.h' for details.
+*/
+ULONG K8055_GetAlarmState( ULONG *pulFileDesc,
+                           ULONG *pulChannel,
+                           ULONG *pulState    )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulState ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulChannel = *pulChannel;
+  if ( ( ulChannel < 1 ) || ( ulChannel > ALARM_CHANNELS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  *pulState = aAlarm[ ulSlot ].aChannel[ ulChannel - 1 ].ulState;
+
+  return ulRc;
+}
+//---------21-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== alarm.c === END ===
@@ -0,0 +1,95 @@
+/**
+ * \file 'alarm.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'alarm.h' is the headerfile belonging to 'alarm.c'.
+ * It provides constants and types of the threshold alarms
+ * on the analog inputs A1 and A2.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_ALARM_
+#define __K8055DD_H_ALARM_
+
+
+//-- Values belonging to the alarms ------------- BEGIN --!
+//
+/**
+* \brief Number of alarm channels per K8055.
+* Channel 1 watches A1, channel 2 watches A2.
+*/
+#define ALARM_CHANNELS 2
+
+/**
+* \brief A limit set to this value switches the
+* corresponding comparator off.
+*/
+#define ALARM_LIMIT_OFF 0xFFFFFFFF
+
+/**
+* \brief Number of alarm events that can be queued per K8055
+* before the oldest ones get lost.
+*/
+#define ALARM_EVENTS_MAX 32
+
+/**
+* \brief Alarm states as returned by 'K8055_GetAlarmState()'
+*/
+#define ALARM_STATE_NORMAL  0
+#define ALARM_STATE_HIGH    1
+#define ALARM_STATE_LOW     2
+
+/**
+* \brief Alarm events as returned by 'K8055_GetAlarmEvent()'
+*/
+#define ALARM_EV_NONE       0
+#define ALARM_EV_HIGH_SET   1
+#define ALARM_EV_HIGH_CLEAR 2
+#define ALARM_EV_LOW_SET    3
+#define ALARM_EV_LOW_CLEAR  4
+#define ALARM_EV_LOST       5
+//
+//-- Values belonging to the alarms --------------- END --!
+
+
+/**
+* \brief Comparator of one analog input
+*/
+typedef struct _ALARMCHANNEL
+{
+  ULONG     ulHigh;          // High limit or ALARM_LIMIT_OFF
+  ULONG     ulLow;           // Low limit or ALARM_LIMIT_OFF
+  ULONG     ulHysteresis;    // Counts to fall back
+  K8055TIME tmMinDuration;   // Microseconds beyond a limit
+  ULONG     ulState;         // ALARM_STATE_...
+  ULONG     ulPending;       // State waiting for duration
+  K8055TIME tmPendingSince;
+} ALARMCHANNEL;
+
+
+/**
+* \brief One queued alarm event
+*/
+typedef struct _ALARMEVENT
+{
+  ULONG ulChannel;
+  ULONG ulEvent;
+  ULONG ulValue;
+  ULONG ulTimeMs;
+} ALARMEVENT;
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID AlarmAttach( ULONG ulSlot );
+VOID AlarmDetach( ULONG ulSlot );
+VOID AlarmEvaluate( ULONG ulSlot,
+                    BYTE *pbyData,
+                    K8055TIME tmReport );
+
+#endif
+
+
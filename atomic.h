@@ -0,0 +1,92 @@
+/**
+ * \file 'atomic.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'atomic.h' provides the few interlocked operations
+ * the library needs where a mutex semaphore would be too
+ * slow or could block a time critical thread.
+ *
+ * With 'OpenWatcom C' they are inline instructions with
+ * the 'lock' prefix ( see: '#pragma aux' ). With gcc the
+ * '__sync' builtins are used.
+ *
+ * All three operations are full memory barriers.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_ATOMIC_
+#define __K8055DD_H_ATOMIC_
+
+
+#if defined( __WATCOMC__ )
+
+//-------------------------------------------------------------
+// Stores 'lValue' into '*plTarget', returns the old value.
+//
+LONG AtomicExchange( volatile LONG *plTarget, LONG lValue );
+#pragma aux AtomicExchange = \
+        "lock xchg [edx], eax" \
+        parm [edx] [eax] \
+        value [eax] \
+        modify exact [eax];
+
+//-------------------------------------------------------------
+// Stores 'lNew' into '*plTarget' if it holds 'lComparand'.
+// Returns the value found in '*plTarget'.
+//
+LONG AtomicCompareExchange( volatile LONG *plTarget,
+                            LONG lNew,
+                            LONG lComparand );
+#pragma aux AtomicCompareExchange = \
+        "lock cmpxchg [edx], ecx" \
+        parm [edx] [ecx] [eax] \
+        value [eax] \
+        modify exact [eax];
+
+//-------------------------------------------------------------
+// Adds 'lValue' to '*plTarget', returns the old value.
+//
+LONG AtomicExchangeAdd( volatile LONG *plTarget, LONG lValue );
+#pragma aux AtomicExchangeAdd = \
+        "lock xadd [edx], eax" \
+        parm [edx] [eax] \
+        value [eax] \
+        modify exact [eax];
+
+#else
+
+static __inline__ LONG AtomicCompareExchange
+                     ( volatile LONG *plTarget,
+                       LONG lNew,
+                       LONG lComparand )
+{
+  return __sync_val_compare_and_swap( plTarget, lComparand, lNew );
+}
+
+static __inline__ LONG AtomicExchange( volatile LONG *plTarget,
+                                       LONG lValue )
+{
+  LONG lOld;
+
+  do
+  {
+    lOld = *plTarget;
+  } while ( AtomicCompareExchange( plTarget, lValue, lOld )
+            != lOld );
+  return lOld;
+}
+
+static __inline__ LONG AtomicExchangeAdd( volatile LONG *plTarget,
+                                          LONG lValue )
+{
+  return __sync_fetch_and_add( plTarget, lValue );
+}
+
+#endif
+
+#endif
+
+
@@ -0,0 +1,626 @@
+//-------------------------------------------------------------
+//  Micro-benchmark 'k8055bch.exe' for the
+//
+//  ' USB-Interface Board VELLEMAN K8055 '  aka  'VM110'
+//
+//  It calls the exports of 'K8055DD.dll' that talk to a
+//  K8055 or decode its data ( 'K8055_Open()' .. 'K8055_
+//  GetInfoByte()', Export Index 1..16 ) over and over and
+//  measures the latency of every call. For each export it
+//  writes one line with the calls per second, the mean, the
+//  minimum, the percentiles 50, 90 and 99 and the maximum,
+//  in ns. The lines are comma separated values, to be kept
+//  and compared with a later run by 'k8055cmp.exe'.
+//
+//  Since 'K8055BCH 2' each line also holds the standard
+//  deviation of the samples and the 95 % confidence interval
+//  of each percentile, taken from the order statistics: the
+//  samples at the ranks n*q -/+ 1.96*sqrt( n*q*(1-q) ). New
+//  columns are added at the end, a reader finds them by the
+//  names in the header line.
+//
+//  By default it runs against the emulated K8055 'EMUL0' of
+//  the library, whose latency is set by '-l', '-j' and '-r'
+//  ( see 'K8055_SetEmulation()' ). With '-d K8055_$' it runs
+//  against a real K8055.
+//
+//  Exports that take less than the resolution of the timer
+//  ( about 0.8 us ) are measured in batches of BENCH_BATCH
+//  calls, a sample is then the mean of one batch.
+//
+//  Usage:
+//    k8055bch [-d <device>] [-n <calls>] [-i <inits>]
+//             [-l <us>] [-j <us>] [-r <us>] [-o <file>]
+//
+//    -d ........ Device name, default 'EMUL0'.
+//    -n ........ Calls ( samples ) per export, default 1000.
+//    -i ........ Calls of 'K8055_Init()', default 3. Each one
+//                takes more than a second.
+//    -l ........ Emulation: latency per transfer in us.
+//    -j ........ Emulation: random jitter on top in us.
+//    -r ........ Emulation: report interval of EP81 in us,
+//                0 hands out reports without waiting.
+//    -o ........ Results to a file instead of stdout.
+//
+//  Preconditions:
+//  - C Compiler:
+//    'OpenWatcom C 1.6' or higher
+//
+//  - Device Specific Library:
+//    'K8055DD.dll' by B.Hennig and U.Hinz
+//    'k8055lib.h' ( '..\example' )
+//
+//  How to compile and link: see 'Makefile.wmk'.
+//
+//-------------------------------------------------------------
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define INCL_DOS
+#include <os2.h>
+
+#include "k8055lib.h"  // Exports of 'K8055DD.dll'
+
+
+//-- Values of the benchmark -------------------- BEGIN -----!
+//
+#define BENCH_SAMPLES_MAX 100000   // Samples per export
+#define BENCH_BATCH       100      // Calls per sample, short ones
+#define BENCH_VERSION     2        // First line 'K8055BCH 2'
+//
+//-- Values of the benchmark -------------------- END -------!
+
+
+// -- One export and the call measured ------------------------
+//
+typedef ULONG ( *PFNBENCH )( VOID );
+
+typedef struct _BENCHCALL
+{
+  CHAR     *pszName;
+  PFNBENCH pfnCall;
+  ULONG    ulBatch;
+} BENCHCALL;
+
+
+// -- Function Prototypes ------------------------ BEGIN -----!
+
+unsigned long long NowNs( VOID );
+
+VOID BenchStart( VOID );
+
+VOID BenchSample( unsigned long long ullNs, ULONG ulBatch,
+                  ULONG ulRc );
+
+ULONG BenchRank( ULONG ulPercent, LONG lSide );
+
+VOID BenchReport( FILE *pOut, CHAR *pszName, ULONG ulBatch );
+
+VOID BenchRun( FILE *pOut, BENCHCALL *pCall, ULONG ulCalls );
+
+ULONG CallRead( VOID );
+ULONG CallWrite( VOID );
+ULONG CallReadAllInputs( VOID );
+ULONG CallSetAllOutputs( VOID );
+ULONG CallDecodeDigitalInputs( VOID );
+ULONG CallCheckDigitalInput( VOID );
+ULONG CallPrepairDigitalOut( VOID );
+ULONG CallPrepairDACxOut( VOID );
+ULONG CallCheckIxCounter( VOID );
+ULONG CallGetInfoStr( VOID );
+ULONG CallGetInfoByte( VOID );
+
+// -- Function Prototypes ------------------------ END -------!
+
+
+// -- Global Data -------------------------------- BEGIN -----!
+
+ULONG ulDevice;                    // Handle of the K8055
+ULONG ulCall;                      // Counts the calls
+
+ULONG aulSample[ BENCH_SAMPLES_MAX ];   // ns per call
+ULONG ulSamples;
+ULONG ulErrors;
+unsigned long long ullTotalNs;
+
+ULONG ulTimerFreq;
+
+BENCHCALL aBenchCall[] =
+{
+  { "K8055_Read",                CallRead,                1 },
+  { "K8055_Write",               CallWrite,               1 },
+  { "K8055_ReadAllInputs",       CallReadAllInputs,       1 },
+  { "K8055_SetAllOutputs",       CallSetAllOutputs,       1 },
+  { "K8055_DecodeDigitalInputs", CallDecodeDigitalInputs,
+                                                BENCH_BATCH },
+  { "K8055_CheckDigitalInput",   CallCheckDigitalInput,
+                                                BENCH_BATCH },
+  { "K8055_PrepairDigitalOut",   CallPrepairDigitalOut,
+                                                BENCH_BATCH },
+  { "K8055_PrepairDACxOut",      CallPrepairDACxOut,
+                                                BENCH_BATCH },
+  { "K8055_CheckIxCounter",      CallCheckIxCounter,
+                                                BENCH_BATCH },
+  { "K8055_GetInfoStr",          CallGetInfoStr,
+                                                BENCH_BATCH },
+  { "K8055_GetInfoByte",         CallGetInfoByte,
+                                                BENCH_BATCH },
+  { NULL,                        NULL,                    0 }
+};
+
+// -- Global Data -------------------------------- END -------!
+
+
+// == Main ============================== BEGIN ===============
+
+int main( INT argc, CHAR* *argv )
+{
+  FILE  *pOut;
+  CHAR  *pszDevice;
+  CHAR  *pszOut;
+  ULONG ulCalls;
+  ULONG ulInits;
+  ULONG ulLatencyUs;
+  ULONG ulJitterUs;
+  ULONG ulReportUs;
+  ULONG ulIndex;
+  ULONG ulRc;
+  INT   iArg;
+  unsigned long long ullStart;
+  BENCHCALL *pCall;
+
+  pszDevice = "EMUL0";
+  pszOut = NULL;
+  ulCalls = 1000;
+  ulInits = 3;
+  ulLatencyUs = 0;
+  ulJitterUs = 0;
+  ulReportUs = 0;
+
+  for ( iArg = 1; iArg + 1 < argc; iArg = iArg + 2 )
+  {
+    if ( strcmp( argv[ iArg ], "-d" ) == 0 )
+    {
+      pszDevice = argv[ iArg + 1 ];
+    }
+    else if ( strcmp( argv[ iArg ], "-n" ) == 0 )
+    {
+      ulCalls = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-i" ) == 0 )
+    {
+      ulInits = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-l" ) == 0 )
+    {
+      ulLatencyUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-j" ) == 0 )
+    {
+      ulJitterUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-r" ) == 0 )
+    {
+      ulReportUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-o" ) == 0 )
+    {
+      pszOut = argv[ iArg + 1 ];
+    }
+    else
+    {
+      break;
+    }
+  }
+  if ( ( iArg < argc ) || ( ulCalls == 0 ) ||
+       ( ulCalls > BENCH_SAMPLES_MAX ) )
+  {
+    printf( "Usage: k8055bch [-d <device>] [-n <calls>] "
+            "[-i <inits>]\n"
+            "                [-l <us>] [-j <us>] [-r <us>] "
+            "[-o <file>]\n" );
+    return 1;
+  }
+
+  pOut = stdout;
+  if ( pszOut != NULL )
+  {
+    pOut = fopen( pszOut, "w" );
+    if ( pOut == NULL )
+    {
+      printf( "Cannot open '%s'\n", pszOut );
+      return 1;
+    }
+  }
+
+  fprintf( pOut, "K8055BCH %u\n", BENCH_VERSION );
+  fprintf( pOut, "# device=%s calls=%lu inits=%lu latency_us=%lu "
+                 "jitter_us=%lu report_us=%lu\n",
+           pszDevice, ulCalls, ulInits,
+           ulLatencyUs, ulJitterUs, ulReportUs );
+  fprintf( pOut, "name,batch,samples,errors,calls_per_s,"
+                 "mean_ns,min_ns,p50_ns,p90_ns,p99_ns,max_ns,"
+                 "stddev_ns,p50_lo_ns,p50_hi_ns,p90_lo_ns,p90_hi_ns,"
+                 "p99_lo_ns,p99_hi_ns\n" );
+
+  // -- 'K8055_Open()', the board closed again untimed --
+  BenchStart();
+  for ( ulIndex = 0; ulIndex < ulCalls; ulIndex++ )
+  {
+    ullStart = NowNs();
+    ulRc = K8055_Open( pszDevice, &ulDevice );
+    BenchSample( NowNs() - ullStart, 1, ulRc );
+    if ( ulRc == RET_OKAY )
+    {
+      K8055_Close( &ulDevice );
+    }
+  }
+  BenchReport( pOut, "K8055_Open", 1 );
+
+  // -- 'K8055_Close()', the board opened before untimed --
+  BenchStart();
+  for ( ulIndex = 0; ulIndex < ulCalls; ulIndex++ )
+  {
+    ulRc = K8055_Open( pszDevice, &ulDevice );
+    if ( ulRc == RET_OKAY )
+    {
+      ullStart = NowNs();
+      ulRc = K8055_Close( &ulDevice );
+      BenchSample( NowNs() - ullStart, 1, ulRc );
+    }
+  }
+  BenchReport( pOut, "K8055_Close", 1 );
+
+  // -- All other exports on one open board --
+  ulRc = K8055_Open( pszDevice, &ulDevice );
+  if ( ulRc != RET_OKAY )
+  {
+    printf( "K8055_Open( '%s' ) returned 0x%04lX\n", pszDevice, ulRc );
+    return 1;
+  }
+  if ( K8055_SetEmulation( &ulDevice, &ulLatencyUs,
+                           &ulJitterUs, &ulReportUs ) != RET_OKAY )
+  {
+    printf( "'%s' is not emulated, '-l', '-j', '-r' ignored\n",
+            pszDevice );
+  }
+
+  if ( ulInits != 0 )
+  {
+    BenchStart();
+    for ( ulIndex = 0; ulIndex < ulInits; ulIndex++ )
+    {
+      ullStart = NowNs();
+      ulRc = K8055_Init( &ulDevice );
+      BenchSample( NowNs() - ullStart, 1, ulRc );
+    }
+    BenchReport( pOut, "K8055_Init", 1 );
+  }
+
+  for ( pCall = &aBenchCall[0]; pCall->pszName != NULL; pCall++ )
+  {
+    BenchRun( pOut, pCall, ulCalls );
+  }
+
+  K8055_Close( &ulDevice );
+
+  if ( pOut != stdout )
+  {
+    fclose( pOut );
+  }
+  return 0;
+}
+
+// == Main ============================== END =================
+
+
+//-------------------------------------------------------------
+//
+// Time in ns, from the high resolution timer of OS/2.
+//
+unsigned long long NowNs( VOID )
+{
+  QWORD qwTicks;
+  unsigned long long ullTicks;
+
+  if ( ulTimerFreq == 0 )
+  {
+    DosTmrQueryFreq( &ulTimerFreq );
+  }
+  DosTmrQueryTime( &qwTicks );
+  ullTicks = ( (unsigned long long)qwTicks.ulHi << 32 ) |
+             qwTicks.ulLo;
+
+  return ( ullTicks / ulTimerFreq ) * 1000000000 +
+         ( ( ullTicks % ulTimerFreq ) * 1000000000 ) / ulTimerFreq;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// No samples yet.
+//
+VOID BenchStart( VOID )
+{
+  ulSamples = 0;
+  ulErrors = 0;
+  ullTotalNs = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// One sample: the time of 'ulBatch' calls and the Return
+// Codes of them, OR-ed.
+//
+VOID BenchSample( unsigned long long ullNs, ULONG ulBatch,
+                  ULONG ulRc )
+{
+  if ( ulRc != RET_OKAY )
+  {
+    ++ulErrors;
+  }
+  ullTotalNs = ullTotalNs + ullNs;
+  if ( ulSamples < BENCH_SAMPLES_MAX )
+  {
+    aulSample[ ulSamples ] = (ULONG)( ullNs / ulBatch );
+    ++ulSamples;
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// For 'qsort()'
+//
+static int CompareSample( const void *pv1, const void *pv2 )
+{
+  ULONG ul1;
+  ULONG ul2;
+
+  ul1 = *(const ULONG *)pv1;
+  ul2 = *(const ULONG *)pv2;
+  if ( ul1 < ul2 )
+  {
+    return -1;
+  }
+  return ( ul1 > ul2 ) ? 1 : 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Rank of the sorted samples bounding the 95 % confidence
+// interval of the percentile 'ulPercent': 'lSide' -1 the
+// lower, +1 the upper bound, 0 the percentile itself.
+//
+ULONG BenchRank( ULONG ulPercent, LONG lSide )
+{
+  double dRank;
+  double dQ;
+
+  dQ = ulPercent / 100.0;
+  dRank = ( ulSamples - 1 ) * dQ +
+          lSide * 1.96 * sqrt( ulSamples * dQ * ( 1.0 - dQ ) );
+  if ( dRank < 0.0 )
+  {
+    return 0;
+  }
+  if ( dRank > ulSamples - 1 )
+  {
+    return ulSamples - 1;
+  }
+  return ( lSide > 0 ) ? (ULONG)ceil( dRank ) : (ULONG)dRank;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Writes the line of one export.
+//
+VOID BenchReport( FILE *pOut, CHAR *pszName, ULONG ulBatch )
+{
+  ULONG ulCallsPerS;
+  ULONG ulMean;
+  ULONG ulIndex;
+  double dSquares;
+  double dDiff;
+
+  if ( ulSamples == 0 )
+  {
+    fprintf( pOut, "%s,%lu,0,%lu,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n",
+             pszName, ulBatch, ulErrors );
+    return;
+  }
+
+  qsort( &aulSample[0], ulSamples, sizeof( ULONG ), CompareSample );
+
+  ulCallsPerS = 0;
+  if ( ullTotalNs != 0 )
+  {
+    ulCallsPerS = (ULONG)( (unsigned long long)ulSamples * ulBatch *
+                           1000000000 / ullTotalNs );
+  }
+  ulMean = (ULONG)( ullTotalNs / ( (unsigned long long)ulSamples *
+                                   ulBatch ) );
+
+  // -- Spread of the samples, for the test of the mean --
+  dSquares = 0.0;
+  for ( ulIndex = 0; ulIndex < ulSamples; ulIndex++ )
+  {
+    dDiff = (double)aulSample[ ulIndex ] - ulMean;
+    dSquares = dSquares + dDiff * dDiff;
+  }
+  if ( ulSamples > 1 )
+  {
+    dSquares = dSquares / ( ulSamples - 1 );
+  }
+
+  fprintf( pOut, "%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,"
+                 "%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+           pszName, ulBatch, ulSamples, ulErrors, ulCallsPerS, ulMean,
+           aulSample[ 0 ],
+           aulSample[ BenchRank( 50, 0 ) ],
+           aulSample[ BenchRank( 90, 0 ) ],
+           aulSample[ BenchRank( 99, 0 ) ],
+           aulSample[ ulSamples - 1 ],
+           (ULONG)sqrt( dSquares ),
+           aulSample[ BenchRank( 50, -1 ) ],
+           aulSample[ BenchRank( 50, 1 ) ],
+           aulSample[ BenchRank( 90, -1 ) ],
+           aulSample[ BenchRank( 90, 1 ) ],
+           aulSample[ BenchRank( 99, -1 ) ],
+           aulSample[ BenchRank( 99, 1 ) ] );
+  fflush( pOut );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Measures one export, 'ulCalls' samples of 'ulBatch' calls.
+//
+VOID BenchRun( FILE *pOut, BENCHCALL *pCall, ULONG ulCalls )
+{
+  ULONG ulIndex;
+  ULONG ulBatch;
+  ULONG ulRc;
+  unsigned long long ullStart;
+
+  BenchStart();
+  for ( ulIndex = 0; ulIndex < ulCalls; ulIndex++ )
+  {
+    ulRc = RET_OKAY;
+    ullStart = NowNs();
+    for ( ulBatch = 0; ulBatch < pCall->ulBatch; ulBatch++ )
+    {
+      ulRc = ulRc | pCall->pfnCall();
+    }
+    BenchSample( NowNs() - ullStart, pCall->ulBatch, ulRc );
+  }
+  BenchReport( pOut, pCall->pszName, pCall->ulBatch );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// The exports measured, with changing values where they
+// take any.
+//
+ULONG CallRead( VOID )
+{
+  BYTE abyData[ 8 ];
+
+  return K8055_Read( &ulDevice, 8, &abyData[0] );
+}
+
+ULONG CallWrite( VOID )
+{
+  BYTE abyData[ 8 ];
+
+  ++ulCall;
+  memset( &abyData[0], 0, sizeof( abyData ) );
+  abyData[0] = 0x05;
+  abyData[1] = (BYTE)ulCall;
+  return K8055_Write( &ulDevice, 8, &abyData[0] );
+}
+
+ULONG CallReadAllInputs( VOID )
+{
+  ULONG ulIx;
+  ULONG ulA1;
+  ULONG ulA2;
+
+  return K8055_ReadAllInputs( &ulDevice, &ulIx, &ulA1, &ulA2 );
+}
+
+ULONG CallSetAllOutputs( VOID )
+{
+  return K8055_SetAllOutputs( &ulDevice );
+}
+
+ULONG CallDecodeDigitalInputs( VOID )
+{
+  ULONG ulIx;
+  ULONG ulResult;
+
+  ++ulCall;
+  ulIx = ulCall & 0xF1;
+  return K8055_DecodeDigitalInputs( &ulIx, &ulResult );
+}
+
+ULONG CallCheckDigitalInput( VOID )
+{
+  ULONG ulIx;
+  ULONG ulResult;
+  ULONG ulInput;
+
+  ++ulCall;
+  ulIx = ulCall & 0xF1;
+  ulInput = ulCall % 5 + 1;
+  return K8055_CheckDigitalInput( &ulIx, &ulResult, &ulInput );
+}
+
+ULONG CallPrepairDigitalOut( VOID )
+{
+  ULONG ulValue;
+
+  ++ulCall;
+  ulValue = ulCall & 0xFF;
+  return K8055_PrepairDigitalOut( &ulValue );
+}
+
+ULONG CallPrepairDACxOut( VOID )
+{
+  ULONG ulValue;
+  ULONG ulOutput;
+
+  ++ulCall;
+  ulValue = ulCall & 0xFF;
+  ulOutput = ulCall % 2 + 1;
+  return K8055_PrepairDACxOut( &ulValue, &ulOutput );
+}
+
+ULONG CallCheckIxCounter( VOID )
+{
+  ULONG ulValue;
+  ULONG ulCounter;
+
+  ++ulCall;
+  ulCounter = ulCall % 2 + 1;
+  return K8055_CheckIxCounter( &ulValue, &ulCounter );
+}
+
+ULONG CallGetInfoStr( VOID )
+{
+  CHAR  szInfo[ 64 ];
+  ULONG ulString;
+
+  ++ulCall;
+  ulString = ulCall % 6 + 1;
+  return K8055_GetInfoStr( &szInfo[0], &ulString );
+}
+
+ULONG CallGetInfoByte( VOID )
+{
+  BYTE  byInfo;
+  ULONG ulSection;
+  ULONG ulByte;
+
+  ++ulCall;
+  ulSection = ulCall % 6 + 1;
+  ulByte = ulCall % 33 + 1;
+  return K8055_GetInfoByte( &byInfo, &ulSection, &ulByte );
+}
+// -----
@@ -0,0 +1,508 @@
+//-------------------------------------------------------------
+//  Comparison 'k8055cmp.exe' of two results of the
+//  benchmark 'k8055bch.exe' for the
+//
+//  ' USB-Interface Board VELLEMAN K8055 '  aka  'VM110'
+//
+//  It reads a base and a new result and compares every
+//  export found in both: the mean ( and with it the calls per
+//  second ) and the percentiles 50, 90 and 99. A change is
+//  flagged only if it is statistically significant and at
+//  least '-m' percent:
+//
+//  - The mean by Welch's t-test on mean, standard deviation
+//    and number of samples, |t| > 1.96 ( 95 % ).
+//  - A percentile if the 95 % confidence intervals of both
+//    runs do not overlap.
+//
+//  A change of less than one tick of the timer ( CMP_TICK_NS,
+//  divided by the calls of a batch ) is never flagged.
+//
+//  Results of 'K8055BCH 1' hold no spread. Their changes are
+//  judged by '-m' alone, marked with a comment line.
+//
+//  The columns are found by the names of the header line, so
+//  results of any version 'K8055BCH n' can be compared.
+//
+//  Usage:
+//    k8055cmp [-m <percent>] <base> <new>
+//
+//    -m ........ Least change flagged, in percent, default 5.
+//
+//  One line per export and value: base, new, change in
+//  percent and 'same', 'faster' or 'slower'. The exit code
+//  is 2 if anything got slower, 1 on errors, else 0, for
+//  the use in scripts.
+//
+//  Preconditions:
+//  - C Compiler:
+//    'OpenWatcom C 1.6' or higher
+//
+//  How to compile and link: see 'Makefile.wmk'.
+//
+//-------------------------------------------------------------
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define INCL_DOS
+#include <os2.h>
+
+
+//-- Values of the comparison ------------------- BEGIN -----!
+//
+#define CMP_ROWS        32         // Exports in one result
+#define CMP_NAME        48         // Length of an export name
+#define CMP_LINE        512        // Length of a line
+#define CMP_TICK_NS     838        // Timer of OS/2, 1193182 Hz
+#define CMP_VERSION     1          // First line 'K8055CMP 1'
+//
+//-- Values of the comparison ------------------- END -------!
+
+
+//-- Columns used, by their names in the header -- BEGIN ---!
+//
+#define COL_BATCH       0
+#define COL_SAMPLES     1
+#define COL_CALLS       2
+#define COL_MEAN        3
+#define COL_STDDEV      4
+#define COL_P50         5
+#define COL_P50_LO      6
+#define COL_P50_HI      7
+#define COL_P90         8
+#define COL_P90_LO      9
+#define COL_P90_HI      10
+#define COL_P99         11
+#define COL_P99_LO      12
+#define COL_P99_HI      13
+#define COL_COUNT       14
+
+CHAR *apszColumn[ COL_COUNT ] =
+{
+  "batch", "samples", "calls_per_s", "mean_ns", "stddev_ns",
+  "p50_ns", "p50_lo_ns", "p50_hi_ns",
+  "p90_ns", "p90_lo_ns", "p90_hi_ns",
+  "p99_ns", "p99_lo_ns", "p99_hi_ns"
+};
+//
+//-- Columns used, by their names in the header -- END -----!
+
+
+// -- One result file -----------------------------------------
+//
+typedef struct _CMPROW
+{
+  CHAR   szName[ CMP_NAME ];
+  double adValue[ COL_COUNT ];
+} CMPROW;
+
+typedef struct _CMPRESULT
+{
+  CHAR   *pszFile;
+  ULONG  ulVersion;
+  BOOL   ablColumn[ COL_COUNT ];   // Column found
+  ULONG  ulRows;
+  CMPROW aRow[ CMP_ROWS ];
+} CMPRESULT;
+
+
+// -- Function Prototypes ------------------------ BEGIN -----!
+
+ULONG CmpLoad( CMPRESULT *pResult, CHAR *pszFile );
+
+CMPROW *CmpFind( CMPRESULT *pResult, CHAR *pszName );
+
+BOOL CmpTick( CMPROW *pRow, double dBase, double dNew );
+
+CHAR *CmpJudge( double dBase, double dNew, BOOL blSignificant,
+                BOOL blLowerIsBetter );
+
+VOID CmpLine( CHAR *pszName, CHAR *pszValue, double dBase,
+              double dNew, CHAR *pszResult );
+
+VOID CmpMean( CMPROW *pBase, CMPROW *pNew, BOOL blSpread );
+
+VOID CmpPercentile( CMPROW *pBase, CMPROW *pNew, BOOL blSpread,
+                    CHAR *pszValue, ULONG ulColumn );
+
+// -- Function Prototypes ------------------------ END -------!
+
+
+// -- Global Data -------------------------------- BEGIN -----!
+
+CMPRESULT Base;
+CMPRESULT New;
+
+double dMinChange;                 // '-m' as a fraction
+ULONG  ulSlower;                   // Values got slower
+
+// -- Global Data -------------------------------- END -------!
+
+
+// == Main ============================== BEGIN ===============
+
+int main( INT argc, CHAR* *argv )
+{
+  INT    iArg;
+  ULONG  ulRow;
+  ULONG  ulColumn;
+  BOOL   blSpread;
+  CMPROW *pBase;
+  CMPROW *pNew;
+
+  dMinChange = 0.05;
+  iArg = 1;
+  if ( ( argc > 2 ) && ( strcmp( argv[ 1 ], "-m" ) == 0 ) )
+  {
+    dMinChange = atof( argv[ 2 ] ) / 100.0;
+    iArg = 3;
+  }
+  if ( argc - iArg != 2 )
+  {
+    printf( "Usage: k8055cmp [-m <percent>] <base> <new>\n" );
+    return 1;
+  }
+
+  if ( ( CmpLoad( &Base, argv[ iArg ] ) != 0 ) ||
+       ( CmpLoad( &New, argv[ iArg + 1 ] ) != 0 ) )
+  {
+    return 1;
+  }
+
+  // -- The spread is needed in both results --
+  blSpread = TRUE;
+  for ( ulColumn = 0; ulColumn < COL_COUNT; ulColumn++ )
+  {
+    if ( ( Base.ablColumn[ ulColumn ] == FALSE ) ||
+         ( New.ablColumn[ ulColumn ] == FALSE ) )
+    {
+      blSpread = FALSE;
+    }
+  }
+
+  printf( "K8055CMP %u\n", CMP_VERSION );
+  printf( "# base=%s new=%s min_change_pct=%.1f\n",
+          Base.pszFile, New.pszFile, dMinChange * 100.0 );
+  if ( blSpread == FALSE )
+  {
+    printf( "# no spread in 'K8055BCH %lu' vs. 'K8055BCH %lu', "
+            "changes judged by -m only\n",
+            Base.ulVersion, New.ulVersion );
+  }
+  printf( "name,value,base,new,change_pct,result\n" );
+
+  for ( ulRow = 0; ulRow < Base.ulRows; ulRow++ )
+  {
+    pBase = &Base.aRow[ ulRow ];
+    pNew = CmpFind( &New, pBase->szName );
+    if ( pNew == NULL )
+    {
+      printf( "%s,,,,,missing\n", pBase->szName );
+      continue;
+    }
+    if ( ( pBase->adValue[ COL_SAMPLES ] == 0 ) ||
+         ( pNew->adValue[ COL_SAMPLES ] == 0 ) )
+    {
+      printf( "%s,,,,,no samples\n", pBase->szName );
+      continue;
+    }
+
+    CmpMean( pBase, pNew, blSpread );
+    CmpPercentile( pBase, pNew, blSpread, "p50_ns", COL_P50 );
+    CmpPercentile( pBase, pNew, blSpread, "p90_ns", COL_P90 );
+    CmpPercentile( pBase, pNew, blSpread, "p99_ns", COL_P99 );
+  }
+
+  for ( ulRow = 0; ulRow < New.ulRows; ulRow++ )
+  {
+    if ( CmpFind( &Base, New.aRow[ ulRow ].szName ) == NULL )
+    {
+      printf( "%s,,,,,new\n", New.aRow[ ulRow ].szName );
+    }
+  }
+
+  printf( "# verdict=%s slower=%lu\n",
+          ( ulSlower == 0 ) ? "PASS" : "FAIL", ulSlower );
+
+  return ( ulSlower == 0 ) ? 0 : 2;
+}
+
+// == Main ============================== END =================
+
+
+//-------------------------------------------------------------
+//
+// Reads one result of 'k8055bch.exe'. The columns are taken
+// by the names of the header line. Returns 0 or 1 on errors.
+//
+ULONG CmpLoad( CMPRESULT *pResult, CHAR *pszFile )
+{
+  FILE  *pIn;
+  CHAR  szLine[ CMP_LINE ];
+  CHAR  *pszField;
+  CHAR  *pszEnd;
+  LONG  alColumn[ CMP_LINE / 2 ];  // Header position -> COL_
+  ULONG ulField;
+  ULONG ulFields;
+  ULONG ulColumn;
+  CMPROW *pRow;
+
+  memset( pResult, 0, sizeof( CMPRESULT ) );
+  pResult->pszFile = pszFile;
+
+  pIn = fopen( pszFile, "r" );
+  if ( pIn == NULL )
+  {
+    printf( "Cannot open '%s'\n", pszFile );
+    return 1;
+  }
+
+  if ( ( fgets( szLine, sizeof( szLine ), pIn ) == NULL ) ||
+       ( strncmp( szLine, "K8055BCH ", 9 ) != 0 ) )
+  {
+    printf( "'%s' is no result of 'k8055bch.exe'\n", pszFile );
+    fclose( pIn );
+    return 1;
+  }
+  pResult->ulVersion = strtoul( &szLine[ 9 ], NULL, 10 );
+
+  ulFields = 0;
+  while ( fgets( szLine, sizeof( szLine ), pIn ) != NULL )
+  {
+    szLine[ strcspn( szLine, "\r\n" ) ] = '\0';
+    if ( ( szLine[0] == '#' ) || ( szLine[0] == '\0' ) )
+    {
+      continue;
+    }
+
+    // -- The header line, positions of the columns --
+    if ( strncmp( szLine, "name,", 5 ) == 0 )
+    {
+      ulFields = 0;
+      pszField = strtok( szLine, "," );
+      while ( ( pszField != NULL ) &&
+              ( ulFields < CMP_LINE / 2 ) )
+      {
+        alColumn[ ulFields ] = -1;
+        for ( ulColumn = 0; ulColumn < COL_COUNT; ulColumn++ )
+        {
+          if ( strcmp( pszField, apszColumn[ ulColumn ] ) == 0 )
+          {
+            alColumn[ ulFields ] = ulColumn;
+            pResult->ablColumn[ ulColumn ] = TRUE;
+          }
+        }
+        ++ulFields;
+        pszField = strtok( NULL, "," );
+      }
+      continue;
+    }
+
+    if ( ( ulFields == 0 ) || ( pResult->ulRows >= CMP_ROWS ) )
+    {
+      continue;
+    }
+
+    // -- One export --
+    pRow = &pResult->aRow[ pResult->ulRows ];
+    pszEnd = strchr( szLine, ',' );
+    if ( pszEnd == NULL )
+    {
+      continue;
+    }
+    *pszEnd = '\0';
+    strncpy( pRow->szName, szLine, CMP_NAME - 1 );
+
+    ulField = 1;
+    pszField = strtok( pszEnd + 1, "," );
+    while ( ( pszField != NULL ) && ( ulField < ulFields ) )
+    {
+      if ( alColumn[ ulField ] >= 0 )
+      {
+        pRow->adValue[ alColumn[ ulField ] ] = atof( pszField );
+      }
+      ++ulField;
+      pszField = strtok( NULL, "," );
+    }
+    ++pResult->ulRows;
+  }
+
+  fclose( pIn );
+
+  if ( ( pResult->ablColumn[ COL_MEAN ] == FALSE ) ||
+       ( pResult->ablColumn[ COL_SAMPLES ] == FALSE ) )
+  {
+    printf( "'%s' has no header line\n", pszFile );
+    return 1;
+  }
+  return 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// The line of an export, or NULL.
+//
+CMPROW *CmpFind( CMPRESULT *pResult, CHAR *pszName )
+{
+  ULONG ulRow;
+
+  for ( ulRow = 0; ulRow < pResult->ulRows; ulRow++ )
+  {
+    if ( strcmp( pResult->aRow[ ulRow ].szName, pszName ) == 0 )
+    {
+      return &pResult->aRow[ ulRow ];
+    }
+  }
+  return NULL;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// TRUE if the change is at least one tick of the timer per
+// call.
+//
+BOOL CmpTick( CMPROW *pRow, double dBase, double dNew )
+{
+  double dBatch;
+
+  dBatch = pRow->adValue[ COL_BATCH ];
+  if ( dBatch < 1.0 )
+  {
+    dBatch = 1.0;
+  }
+  return ( fabs( dNew - dBase ) >= CMP_TICK_NS / dBatch ) ? TRUE : FALSE;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// 'same', 'faster' or 'slower'. A significant change smaller
+// than '-m' is the same. Counts what got slower.
+//
+CHAR *CmpJudge( double dBase, double dNew, BOOL blSignificant,
+                BOOL blLowerIsBetter )
+{
+  double dChange;
+
+  if ( ( blSignificant == FALSE ) || ( dBase == 0.0 ) )
+  {
+    return "same";
+  }
+  dChange = ( dNew - dBase ) / dBase;
+  if ( fabs( dChange ) < dMinChange )
+  {
+    return "same";
+  }
+  if ( ( dChange > 0.0 ) == ( blLowerIsBetter == TRUE ) )
+  {
+    ++ulSlower;
+    return "slower";
+  }
+  return "faster";
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Writes the line of one value.
+//
+VOID CmpLine( CHAR *pszName, CHAR *pszValue, double dBase,
+              double dNew, CHAR *pszResult )
+{
+  double dChange;
+
+  dChange = 0.0;
+  if ( dBase != 0.0 )
+  {
+    dChange = ( dNew - dBase ) * 100.0 / dBase;
+  }
+  printf( "%s,%s,%.0f,%.0f,%+.1f,%s\n",
+          pszName, pszValue, dBase, dNew, dChange, pszResult );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// The mean and the calls per second, by Welch's t-test. The
+// calls per second follow the mean, they share its test.
+//
+VOID CmpMean( CMPROW *pBase, CMPROW *pNew, BOOL blSpread )
+{
+  BOOL   blSignificant;
+  double dError;
+
+  blSignificant = TRUE;
+  if ( blSpread == TRUE )
+  {
+    dError = sqrt( pBase->adValue[ COL_STDDEV ] *
+                   pBase->adValue[ COL_STDDEV ] /
+                   pBase->adValue[ COL_SAMPLES ] +
+                   pNew->adValue[ COL_STDDEV ] *
+                   pNew->adValue[ COL_STDDEV ] /
+                   pNew->adValue[ COL_SAMPLES ] );
+    blSignificant = ( fabs( pNew->adValue[ COL_MEAN ] -
+                            pBase->adValue[ COL_MEAN ] ) >
+                      1.96 * dError ) ? TRUE : FALSE;
+  }
+  if ( CmpTick( pBase, pBase->adValue[ COL_MEAN ],
+                pNew->adValue[ COL_MEAN ] ) == FALSE )
+  {
+    blSignificant = FALSE;
+  }
+
+  CmpLine( pBase->szName, "mean_ns",
+           pBase->adValue[ COL_MEAN ], pNew->adValue[ COL_MEAN ],
+           CmpJudge( pBase->adValue[ COL_MEAN ],
+                     pNew->adValue[ COL_MEAN ], blSignificant, TRUE ) );
+  CmpLine( pBase->szName, "calls_per_s",
+           pBase->adValue[ COL_CALLS ], pNew->adValue[ COL_CALLS ],
+           CmpJudge( pBase->adValue[ COL_CALLS ],
+                     pNew->adValue[ COL_CALLS ], blSignificant, FALSE ) );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// One percentile. Significant if the confidence intervals
+// of both runs ( columns 'ulColumn' + 1 and + 2 ) do not
+// overlap.
+//
+VOID CmpPercentile( CMPROW *pBase, CMPROW *pNew, BOOL blSpread,
+                    CHAR *pszValue, ULONG ulColumn )
+{
+  BOOL blSignificant;
+
+  blSignificant = TRUE;
+  if ( blSpread == TRUE )
+  {
+    blSignificant =
+      ( ( pNew->adValue[ ulColumn + 1 ] >
+          pBase->adValue[ ulColumn + 2 ] ) ||
+        ( pNew->adValue[ ulColumn + 2 ] <
+          pBase->adValue[ ulColumn + 1 ] ) ) ? TRUE : FALSE;
+  }
+  if ( CmpTick( pBase, pBase->adValue[ ulColumn ],
+                pNew->adValue[ ulColumn ] ) == FALSE )
+  {
+    blSignificant = FALSE;
+  }
+
+  CmpLine( pBase->szName, pszValue,
+           pBase->adValue[ ulColumn ], pNew->adValue[ ulColumn ],
+           CmpJudge( pBase->adValue[ ulColumn ],
+                     pNew->adValue[ ulColumn ], blSignificant, TRUE ) );
+}
+// -----
@@ -0,0 +1,551 @@
+//-------------------------------------------------------------
+//  Fault recovery 'k8055flt.exe' for the
+//
+//  ' USB-Interface Board VELLEMAN K8055 '  aka  'VM110'
+//
+//  It injects faults into an emulated K8055 of the library
+//  ( see 'K8055_SetEmulationFault()' ): a stuck Toggle Bit,
+//  a short byte count, failed and delayed transfers and a
+//  board pulled out. Meanwhile it reads with
+//  'K8055_ReadAllInputs()' like an acquisition, one read per
+//  report, and takes the time of every read.
+//
+//  A read is good if it worked and came 0.5 .. 1.5 report
+//  intervals after the one before. The first read that is
+//  not good starts an episode, FLT_STEADY_READS good reads
+//  in a row ( see '-k' ) end it: the cadence is steady
+//  again. For every episode it writes
+//
+//  - the time from the start of the fault window to the
+//    first bad read: how long the fault took to show,
+//  - the time from the first bad read to the steady cadence:
+//    the outage the application saw,
+//  - the time from the end of the fault window to the steady
+//    cadence: how long the library took to recover,
+//  - the failed reads of the episode.
+//
+//  A failed read is followed by a pause up to the next report
+//  interval, the loop does not spin on a pulled out board.
+//  The board comes back via the Recovery Thread of the
+//  library ( see 'K8055_SetRecovery()' ), its pause between
+//  two attempts grows up to '-b'.
+//
+//  Usage:
+//    k8055flt [-d <device>] [-f <fault>] [-m <per mille>]
+//             [-s <ms>] [-w <ms>] [-p <ms>] [-t <seconds>]
+//             [-k <reads>] [-b <ms>] [-r <us>] [-o <file>]
+//
+//    -d ........ Emulated K8055, default 'EMUL0'.
+//    -f ........ Fault: 0 toggle, 1 bytes, 2 xfer, 3 delay,
+//                4 unplug, 5 all of them one after the
+//                other. Default 5.
+//    -m ........ Probability per transfer in per mille
+//                within the window, default 1000.
+//    -s ........ Start of the first window in ms after the
+//                start of the run, default 1000.
+//    -w ........ Length of the window in ms, default 200.
+//    -p ........ Repeat of the window in ms, 0 once.
+//                Default 0.
+//    -t ........ Duration of the run of one fault in
+//                seconds, default 5.
+//    -k ........ Good reads in a row for a steady cadence,
+//                default 10.
+//    -b ........ Longest pause of the Recovery Thread in ms,
+//                default 5000.
+//    -r ........ Report interval of EP81 in us, default
+//                10000.
+//    -o ........ Results to a file instead of stdout.
+//
+//  Preconditions:
+//  - C Compiler:
+//    'OpenWatcom C 1.6' or higher
+//
+//  - Device Specific Library:
+//    'K8055DD.dll' by B.Hennig and U.Hinz
+//    'k8055lib.h' ( '..\example' )
+//
+//  How to compile and link: see 'Makefile.wmk'.
+//
+//-------------------------------------------------------------
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INCL_DOS
+#include <os2.h>
+
+#include "k8055lib.h"  // Exports of 'K8055DD.dll'
+
+
+//-- Values of the fault recovery --------------- BEGIN -----!
+//
+#define FLT_ALL           EMUL_FAULTS   // '-f' for every fault
+#define FLT_STEADY_READS  10            // Default of '-k'
+#define FLT_VERSION       1             // First line 'K8055FLT 1'
+//
+//-- Values of the fault recovery --------------- END -------!
+
+
+/**
+* \brief One run: the fault window and the episode going on
+*/
+typedef struct _FLTRUN
+{
+  ULONG ulFault;
+  ULONG ulPerMille;
+  ULONG ulStartMs;
+  ULONG ulLengthMs;
+  ULONG ulPeriodMs;
+  ULONG ulReportUs;
+  ULONG ulSteadyReads;
+
+  unsigned long long ullFaultStart;  // First window
+  unsigned long long ullLast;        // End of the read before
+
+  BOOL  blSteady;
+  BOOL  blWarmUp;                    // No episode yet
+  ULONG ulEpisodes;
+  ULONG ulGood;                      // Good reads in a row
+  ULONG ulFailed;                    // Failed reads of it
+  ULONG ulFailedTotal;
+  ULONG ulReads;
+  unsigned long long ullFirstBad;    // Start of the episode
+  unsigned long long ullGoodStart;   // Start of the good row
+} FLTRUN;
+
+
+// -- Function Prototypes ------------------------ BEGIN -----!
+
+unsigned long long NowUs( VOID );
+
+VOID FltWaitUntilUs( unsigned long long ullDeadline );
+
+VOID FltRead( FILE *pOut, FLTRUN *pRun, ULONG ulRc,
+              unsigned long long ullNow );
+
+VOID FltEpisode( FILE *pOut, FLTRUN *pRun, BOOL blSteady );
+
+ULONG FltRun( FILE *pOut, CHAR *pszDevice, FLTRUN *pRun,
+              ULONG ulSeconds, ULONG ulBackoffMs );
+
+// -- Function Prototypes ------------------------ END -------!
+
+
+// -- Global Data -------------------------------- BEGIN -----!
+
+ULONG ulTimerFreq;
+
+CHAR *apszFault[ EMUL_FAULTS ] =
+{
+  "toggle", "bytes", "xfer", "delay", "unplug"
+};
+
+// -- Global Data -------------------------------- END -------!
+
+
+// == Main ============================== BEGIN ===============
+
+int main( INT argc, CHAR* *argv )
+{
+  FILE   *pOut;
+  CHAR   *pszDevice;
+  CHAR   *pszOut;
+  FLTRUN Run;
+  ULONG  ulFault;
+  ULONG  ulFirst;
+  ULONG  ulLast;
+  ULONG  ulSeconds;
+  ULONG  ulBackoffMs;
+  INT    iArg;
+
+  pszDevice = "EMUL0";
+  pszOut = NULL;
+  ulFault = FLT_ALL;
+  ulSeconds = 5;
+  ulBackoffMs = 5000;
+  memset( &Run, 0, sizeof( Run ) );
+  Run.ulPerMille = EMUL_PER_MILLE;
+  Run.ulStartMs = 1000;
+  Run.ulLengthMs = 200;
+  Run.ulPeriodMs = 0;
+  Run.ulReportUs = 10000;
+  Run.ulSteadyReads = FLT_STEADY_READS;
+
+  for ( iArg = 1; iArg + 1 < argc; iArg = iArg + 2 )
+  {
+    if ( strcmp( argv[ iArg ], "-d" ) == 0 )
+    {
+      pszDevice = argv[ iArg + 1 ];
+    }
+    else if ( strcmp( argv[ iArg ], "-f" ) == 0 )
+    {
+      ulFault = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-m" ) == 0 )
+    {
+      Run.ulPerMille = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-s" ) == 0 )
+    {
+      Run.ulStartMs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-w" ) == 0 )
+    {
+      Run.ulLengthMs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-p" ) == 0 )
+    {
+      Run.ulPeriodMs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-t" ) == 0 )
+    {
+      ulSeconds = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-k" ) == 0 )
+    {
+      Run.ulSteadyReads = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-b" ) == 0 )
+    {
+      ulBackoffMs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-r" ) == 0 )
+    {
+      Run.ulReportUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-o" ) == 0 )
+    {
+      pszOut = argv[ iArg + 1 ];
+    }
+    else
+    {
+      break;
+    }
+  }
+  if ( ( iArg < argc ) || ( ulFault > FLT_ALL ) ||
+       ( ulSeconds == 0 ) || ( Run.ulSteadyReads == 0 ) ||
+       ( Run.ulReportUs == 0 ) )
+  {
+    printf( "Usage: k8055flt [-d <device>] [-f <fault>] "
+            "[-m <per mille>]\n"
+            "                [-s <ms>] [-w <ms>] [-p <ms>] "
+            "[-t <seconds>]\n"
+            "                [-k <reads>] [-b <ms>] [-r <us>] "
+            "[-o <file>]\n" );
+    return 1;
+  }
+
+  pOut = stdout;
+  if ( pszOut != NULL )
+  {
+    pOut = fopen( pszOut, "w" );
+    if ( pOut == NULL )
+    {
+      printf( "Cannot open '%s'\n", pszOut );
+      return 1;
+    }
+  }
+
+  fprintf( pOut, "K8055FLT %u\n", FLT_VERSION );
+  fprintf( pOut, "# device=%s per_mille=%lu start_ms=%lu "
+                 "window_ms=%lu period_ms=%lu seconds=%lu "
+                 "steady_reads=%lu backoff_ms=%lu report_us=%lu\n",
+           pszDevice, Run.ulPerMille, Run.ulStartMs,
+           Run.ulLengthMs, Run.ulPeriodMs, ulSeconds,
+           Run.ulSteadyReads, ulBackoffMs, Run.ulReportUs );
+  fprintf( pOut, "fault,episode,window_us,detect_us,outage_us,"
+                 "recover_us,failed,steady\n" );
+  fflush( pOut );
+
+  ulFirst = ( ulFault == FLT_ALL ) ? 0 : ulFault;
+  ulLast = ( ulFault == FLT_ALL ) ? FLT_ALL - 1 : ulFault;
+  for ( ulFault = ulFirst; ulFault <= ulLast; ulFault++ )
+  {
+    Run.ulFault = ulFault;
+    if ( FltRun( pOut, pszDevice, &Run,
+                 ulSeconds, ulBackoffMs ) != RET_OKAY )
+    {
+      return 1;
+    }
+  }
+
+  if ( pOut != stdout )
+  {
+    fclose( pOut );
+  }
+  return 0;
+}
+
+// == Main ============================== END =================
+
+
+//-------------------------------------------------------------
+//
+// Time in us, from the high resolution timer of OS/2.
+//
+unsigned long long NowUs( VOID )
+{
+  QWORD qwTicks;
+  unsigned long long ullTicks;
+
+  if ( ulTimerFreq == 0 )
+  {
+    DosTmrQueryFreq( &ulTimerFreq );
+  }
+  DosTmrQueryTime( &qwTicks );
+  ullTicks = ( (unsigned long long)qwTicks.ulHi << 32 ) |
+             qwTicks.ulLo;
+
+  return ( ullTicks / ulTimerFreq ) * 1000000 +
+         ( ( ullTicks % ulTimerFreq ) * 1000000 ) / ulTimerFreq;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Waits until 'ullDeadline'. 'DosSleep()' for the timer ticks
+// of 32 ms that fit, then 'DosSleep( 0 )'.
+//
+VOID FltWaitUntilUs( unsigned long long ullDeadline )
+{
+  unsigned long long ullNow;
+
+  ullNow = NowUs();
+  while ( ullNow < ullDeadline )
+  {
+    if ( ( ullDeadline - ullNow ) > 3 * 32000 )
+    {
+      DosSleep( (ULONG)( ( ullDeadline - ullNow - 2 * 32000 ) /
+                         1000 ) );
+    }
+    else
+    {
+      DosSleep( 0 );
+    }
+    ullNow = NowUs();
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Writes one episode. The window is the one the episode
+// started in, or the last one before; an episode before the
+// first window gets none ( -1 ).
+//
+VOID FltEpisode( FILE *pOut, FLTRUN *pRun, BOOL blSteady )
+{
+  unsigned long long ullWindow;
+  unsigned long long ullPeriod;
+  LONG lWindowUs;
+  LONG lDetectUs;
+  LONG lOutageUs;
+  LONG lRecoverUs;
+
+  ++pRun->ulEpisodes;
+
+  lWindowUs = -1;
+  lDetectUs = -1;
+  lOutageUs = -1;
+  lRecoverUs = -1;
+
+  if ( pRun->ullFirstBad >= pRun->ullFaultStart )
+  {
+    ullWindow = pRun->ullFaultStart;
+    ullPeriod = (unsigned long long)pRun->ulPeriodMs * 1000;
+    if ( ullPeriod != 0 )
+    {
+      ullWindow = ullWindow +
+                  ( pRun->ullFirstBad - ullWindow ) / ullPeriod *
+                  ullPeriod;
+    }
+    lWindowUs = (LONG)( ullWindow - pRun->ullFaultStart );
+    lDetectUs = (LONG)( pRun->ullFirstBad - ullWindow );
+
+    // -- Recovery after the end of the window, before it if
+    //    the faults stopped within ( negative ) --
+    if ( ( blSteady == TRUE ) && ( pRun->ulLengthMs != 0 ) )
+    {
+      lRecoverUs = (LONG)( (long long)pRun->ullGoodStart -
+                           (long long)( ullWindow +
+                                        pRun->ulLengthMs * 1000 ) );
+    }
+  }
+  if ( blSteady == TRUE )
+  {
+    lOutageUs = (LONG)( pRun->ullGoodStart - pRun->ullFirstBad );
+  }
+
+  fprintf( pOut, "%s,%lu,%ld,%ld,%ld,%ld,%lu,%u\n",
+           apszFault[ pRun->ulFault ], pRun->ulEpisodes,
+           lWindowUs, lDetectUs, lOutageUs, lRecoverUs,
+           pRun->ulFailed, ( blSteady == TRUE ) ? 1 : 0 );
+  fflush( pOut );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// One read at 'ullNow' with its Return Code: starts or ends
+// an episode.
+//
+VOID FltRead( FILE *pOut, FLTRUN *pRun, ULONG ulRc,
+              unsigned long long ullNow )
+{
+  unsigned long long ullInterval;
+  BOOL blGood;
+
+  ++pRun->ulReads;
+  if ( ulRc != RET_OKAY )
+  {
+    ++pRun->ulFailedTotal;
+  }
+
+  ullInterval = ullNow - pRun->ullLast;
+  blGood = ( ( ulRc == RET_OKAY ) &&
+             ( ullInterval * 2 >= pRun->ulReportUs ) &&
+             ( ullInterval * 2 <= pRun->ulReportUs * 3 ) ) ?
+           TRUE : FALSE;
+
+  if ( pRun->blSteady == TRUE )
+  {
+    if ( blGood == FALSE )
+    {
+      pRun->blSteady = FALSE;
+      pRun->ullFirstBad = ullNow;
+      pRun->ulFailed = ( ulRc != RET_OKAY ) ? 1 : 0;
+      pRun->ulGood = 0;
+    }
+  }
+  else if ( blGood == FALSE )
+  {
+    if ( ulRc != RET_OKAY )
+    {
+      ++pRun->ulFailed;
+    }
+    pRun->ulGood = 0;
+  }
+  else
+  {
+    // -- The steady cadence starts with the read before the
+    //    first good interval --
+    if ( pRun->ulGood == 0 )
+    {
+      pRun->ullGoodStart = pRun->ullLast;
+    }
+    ++pRun->ulGood;
+    if ( pRun->ulGood >= pRun->ulSteadyReads )
+    {
+      pRun->blSteady = TRUE;
+      if ( pRun->blWarmUp == FALSE )
+      {
+        FltEpisode( pOut, pRun, TRUE );
+      }
+      pRun->blWarmUp = FALSE;
+    }
+  }
+
+  pRun->ullLast = ullNow;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// The run of one fault on a freshly opened board.
+//
+ULONG FltRun( FILE *pOut, CHAR *pszDevice, FLTRUN *pRun,
+              ULONG ulSeconds, ULONG ulBackoffMs )
+{
+  ULONG ulDevice;
+  ULONG ulRc;
+  ULONG ulZero;
+  ULONG ulFailLimit;
+  ULONG ulIx;
+  ULONG ulA1;
+  ULONG ulA2;
+  ULONG ulState;
+  ULONG ulOutages;
+  ULONG ulOutageMs;
+  ULONG ulOutageTotalMs;
+  ULONG ulLost;
+  unsigned long long ullEnd;
+  unsigned long long ullNow;
+
+  ulRc = K8055_Open( pszDevice, &ulDevice );
+  if ( ulRc != RET_OKAY )
+  {
+    printf( "K8055_Open( '%s' ) returned 0x%04lX\n", pszDevice, ulRc );
+    return ulRc;
+  }
+
+  ulZero = 0;
+  ulFailLimit = PLUG_FAILS_DEFAULT;
+  ulRc = K8055_SetEmulation( &ulDevice, &ulZero, &ulZero,
+                             &pRun->ulReportUs );
+  ulRc = ulRc | K8055_SetRecovery( &ulDevice, &ulFailLimit,
+                                   &ulBackoffMs );
+  ulRc = ulRc | K8055_SetEmulationFault( &ulDevice,
+                                         &pRun->ulFault,
+                                         &pRun->ulPerMille,
+                                         &pRun->ulStartMs,
+                                         &pRun->ulLengthMs,
+                                         &pRun->ulPeriodMs );
+  if ( ulRc != RET_OKAY )
+  {
+    printf( "'%s' is no emulated K8055, or an option is out of "
+            "range ( 0x%04lX )\n", pszDevice, ulRc );
+    K8055_Close( &ulDevice );
+    return ulRc;
+  }
+
+  pRun->ullFaultStart = NowUs() + (unsigned long long)pRun->ulStartMs * 1000;
+  pRun->ullLast = NowUs();
+
+  // -- The first reads have to find the cadence --
+  pRun->blSteady = FALSE;
+  pRun->blWarmUp = TRUE;
+  pRun->ulGood = 0;
+  pRun->ulEpisodes = 0;
+  pRun->ulFailedTotal = 0;
+  pRun->ulReads = 0;
+
+  ullEnd = NowUs() + (unsigned long long)ulSeconds * 1000000;
+  do
+  {
+    ulRc = K8055_ReadAllInputs( &ulDevice, &ulIx, &ulA1, &ulA2 );
+    ullNow = NowUs();
+    FltRead( pOut, pRun, ulRc, ullNow );
+
+    // -- No spinning on a board that fails at once --
+    if ( ulRc != RET_OKAY )
+    {
+      FltWaitUntilUs( ullNow + pRun->ulReportUs );
+    }
+  } while ( ullNow < ullEnd );
+
+  if ( ( pRun->blSteady == FALSE ) && ( pRun->blWarmUp == FALSE ) )
+  {
+    FltEpisode( pOut, pRun, FALSE );
+  }
+
+  K8055_GetPlugStats( &ulDevice, &ulState, &ulOutages, &ulOutageMs,
+                      &ulOutageTotalMs, &ulLost );
+  fprintf( pOut, "# fault=%s reads=%lu failed=%lu episodes=%lu "
+                 "plug_outages=%lu plug_outage_ms=%lu "
+                 "plug_lost=%lu\n",
+           apszFault[ pRun->ulFault ], pRun->ulReads,
+           pRun->ulFailedTotal, pRun->ulEpisodes,
+           ulOutages, ulOutageTotalMs, ulLost );
+  fflush( pOut );
+
+  K8055_Close( &ulDevice );
+  return RET_OKAY;
+}
+// -----
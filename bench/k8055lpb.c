@@ -0,0 +1,310 @@
+//-------------------------------------------------------------
+//  Loopback latency 'k8055lpb.exe' for the
+//
+//  ' USB-Interface Board VELLEMAN K8055 '  aka  'VM110'
+//
+//  On a test rig a digital output is wired to a digital
+//  input, or DAC1 to A1. 'k8055lpb.exe' lets
+//  'K8055_MeasureLoopback()' change the output over and over
+//  and take the time until the change shows in a report of
+//  EP81. It writes the distribution of that round trip: the
+//  mean, the minimum, the percentiles 50, 90, 99 and 99.9,
+//  the maximum and a histogram of LPB_BUCKET_US wide buckets.
+//
+//  By default it runs against the emulated K8055 'EMUL0' of
+//  the library, wired like the rig ( see
+//  'K8055_SetEmulationWiring()' ). With '-d K8055_$' it runs
+//  against a real K8055.
+//
+//  Usage:
+//    k8055lpb [-d <device>] [-n <changes>] [-p <output>]
+//             [-i <input>] [-l <us>] [-j <us>] [-r <us>]
+//             [-o <file>]
+//
+//    -d ........ Device name, default 'EMUL0'.
+//    -n ........ Changes of the output, default 1000.
+//    -p ........ Output: 1..8 DO1..DO8, 9 DAC1, default 1.
+//    -i ........ Input: 1..5 I1..I5, 6 A1, default 1, or 6
+//                for DAC1.
+//    -l ........ Emulation: latency per transfer in us.
+//    -j ........ Emulation: random jitter on top in us.
+//    -r ........ Emulation: report interval of EP81 in us,
+//                default 10000.
+//    -o ........ Results to a file instead of stdout.
+//
+//  Preconditions:
+//  - C Compiler:
+//    'OpenWatcom C 1.6' or higher
+//
+//  - Device Specific Library:
+//    'K8055DD.dll' by B.Hennig and U.Hinz
+//    'k8055lib.h' ( '..\example' )
+//
+//  How to compile and link: see 'Makefile.wmk'.
+//
+//-------------------------------------------------------------
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INCL_DOS
+#include <os2.h>
+
+#include "k8055lib.h"  // Exports of 'K8055DD.dll'
+
+
+//-- Values of the loopback latency ------------- BEGIN -----!
+//
+#define LPB_SAMPLES_MAX   100000   // Changes of one run
+#define LPB_BUCKET_US     500      // Width of a bucket
+#define LPB_VERSION       1        // First line 'K8055LPB 1'
+//
+//-- Values of the loopback latency ------------- END -------!
+
+
+// -- Function Prototypes ------------------------ BEGIN -----!
+
+VOID LpbReport( FILE *pOut, ULONG ulSamples );
+
+// -- Function Prototypes ------------------------ END -------!
+
+
+// -- Global Data -------------------------------- BEGIN -----!
+
+ULONG aulLatency[ LPB_SAMPLES_MAX ];   // us per change
+
+// -- Global Data -------------------------------- END -------!
+
+
+// == Main ============================== BEGIN ===============
+
+int main( INT argc, CHAR* *argv )
+{
+  FILE  *pOut;
+  CHAR  *pszDevice;
+  CHAR  *pszOut;
+  ULONG ulDevice;
+  ULONG ulChanges;
+  ULONG ulOutput;
+  ULONG ulInput;
+  ULONG ulLatencyUs;
+  ULONG ulJitterUs;
+  ULONG ulReportUs;
+  ULONG ulWiring;
+  ULONG ulRc;
+  INT   iArg;
+
+  pszDevice = "EMUL0";
+  pszOut = NULL;
+  ulChanges = 1000;
+  ulOutput = 1;
+  ulInput = 0;                     // Not given
+  ulLatencyUs = 0;
+  ulJitterUs = 0;
+  ulReportUs = 10000;
+
+  for ( iArg = 1; iArg + 1 < argc; iArg = iArg + 2 )
+  {
+    if ( strcmp( argv[ iArg ], "-d" ) == 0 )
+    {
+      pszDevice = argv[ iArg + 1 ];
+    }
+    else if ( strcmp( argv[ iArg ], "-n" ) == 0 )
+    {
+      ulChanges = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-p" ) == 0 )
+    {
+      ulOutput = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-i" ) == 0 )
+    {
+      ulInput = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-l" ) == 0 )
+    {
+      ulLatencyUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-j" ) == 0 )
+    {
+      ulJitterUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-r" ) == 0 )
+    {
+      ulReportUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-o" ) == 0 )
+    {
+      pszOut = argv[ iArg + 1 ];
+    }
+    else
+    {
+      break;
+    }
+  }
+  if ( ulInput == 0 )
+  {
+    ulInput = ( ulOutput == LOOP_DAC1 ) ? LOOP_A1 : 1;
+  }
+  if ( ( iArg < argc ) || ( ulChanges == 0 ) ||
+       ( ulChanges > LPB_SAMPLES_MAX ) )
+  {
+    printf( "Usage: k8055lpb [-d <device>] [-n <changes>] "
+            "[-p <output>]\n"
+            "                [-i <input>] [-l <us>] [-j <us>] "
+            "[-r <us>]\n"
+            "                [-o <file>]\n" );
+    return 1;
+  }
+
+  pOut = stdout;
+  if ( pszOut != NULL )
+  {
+    pOut = fopen( pszOut, "w" );
+    if ( pOut == NULL )
+    {
+      printf( "Cannot open '%s'\n", pszOut );
+      return 1;
+    }
+  }
+
+  ulRc = K8055_Open( pszDevice, &ulDevice );
+  if ( ulRc != RET_OKAY )
+  {
+    printf( "K8055_Open( '%s' ) returned 0x%04lX\n", pszDevice, ulRc );
+    return 1;
+  }
+
+  // -- An emulated K8055 gets the wiring of the rig --
+  ulWiring = EMUL_WIRE_DO | EMUL_WIRE_DAC;
+  if ( K8055_SetEmulation( &ulDevice, &ulLatencyUs,
+                           &ulJitterUs, &ulReportUs ) == RET_OKAY )
+  {
+    K8055_SetEmulationWiring( &ulDevice, &ulWiring );
+  }
+  else
+  {
+    K8055_Init( &ulDevice );
+  }
+
+  fprintf( pOut, "K8055LPB %u\n", LPB_VERSION );
+  fprintf( pOut, "# device=%s changes=%lu output=%lu input=%lu "
+                 "latency_us=%lu jitter_us=%lu report_us=%lu\n",
+           pszDevice, ulChanges, ulOutput, ulInput,
+           ulLatencyUs, ulJitterUs, ulReportUs );
+  fflush( pOut );
+
+  // -- Left as lost if the start level does not show --
+  memset( &aulLatency[0], 0xFF, ulChanges * sizeof( ULONG ) );
+  ulRc = K8055_MeasureLoopback( &ulDevice, &ulOutput, &ulInput,
+                                &ulChanges, &aulLatency[0] );
+  K8055_Close( &ulDevice );
+
+  if ( ( ulRc & ( ERROR_POINTER | ERROR_RANGE ) ) != 0 )
+  {
+    printf( "K8055_MeasureLoopback() returned 0x%04lX, "
+            "output %lu and input %lu do not match\n",
+            ulRc, ulOutput, ulInput );
+    return 1;
+  }
+  fprintf( pOut, "# rc=0x%04lX\n", ulRc );
+  LpbReport( pOut, ulChanges );
+
+  if ( pOut != stdout )
+  {
+    fclose( pOut );
+  }
+  return 0;
+}
+
+// == Main ============================== END =================
+
+
+//-------------------------------------------------------------
+//
+// For 'qsort()'
+//
+static int CompareLatency( const void *pv1, const void *pv2 )
+{
+  ULONG ul1;
+  ULONG ul2;
+
+  ul1 = *(const ULONG *)pv1;
+  ul2 = *(const ULONG *)pv2;
+  if ( ul1 < ul2 )
+  {
+    return -1;
+  }
+  return ( ul1 > ul2 ) ? 1 : 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Writes the distribution, the lost changes sorted to the
+// end and left out.
+//
+VOID LpbReport( FILE *pOut, ULONG ulSamples )
+{
+  ULONG ulIndex;
+  ULONG ulLost;
+  ULONG ulCount;
+  ULONG ulBucket;
+  unsigned long long ullSum;
+
+  qsort( &aulLatency[0], ulSamples, sizeof( ULONG ), CompareLatency );
+
+  ulLost = 0;
+  while ( ( ulSamples > 0 ) &&
+          ( aulLatency[ ulSamples - 1 ] == LOOP_LOST ) )
+  {
+    --ulSamples;
+    ++ulLost;
+  }
+
+  fprintf( pOut, "samples,lost,mean_us,min_us,p50_us,p90_us,"
+                 "p99_us,p999_us,max_us\n" );
+  if ( ulSamples == 0 )
+  {
+    fprintf( pOut, "0,%lu,0,0,0,0,0,0,0\n", ulLost );
+    fprintf( pOut, "# no change seen, output not wired to the "
+                   "input?\n" );
+    return;
+  }
+
+  ullSum = 0;
+  for ( ulIndex = 0; ulIndex < ulSamples; ulIndex++ )
+  {
+    ullSum = ullSum + aulLatency[ ulIndex ];
+  }
+
+  fprintf( pOut, "%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+           ulSamples, ulLost, (ULONG)( ullSum / ulSamples ),
+           aulLatency[ 0 ],
+           aulLatency[ ( ulSamples - 1 ) * 50 / 100 ],
+           aulLatency[ ( ulSamples - 1 ) * 90 / 100 ],
+           aulLatency[ ( ulSamples - 1 ) * 99 / 100 ],
+           aulLatency[ ( ulSamples - 1 ) * 999 / 1000 ],
+           aulLatency[ ulSamples - 1 ] );
+
+  // -- Histogram, one line per bucket holding samples --
+  ulIndex = 0;
+  while ( ulIndex < ulSamples )
+  {
+    ulBucket = aulLatency[ ulIndex ] / LPB_BUCKET_US;
+    ulCount = 0;
+    while ( ( ulIndex < ulSamples ) &&
+            ( aulLatency[ ulIndex ] / LPB_BUCKET_US == ulBucket ) )
+    {
+      ++ulCount;
+      ++ulIndex;
+    }
+    fprintf( pOut, "# hist from_us=%lu count=%lu\n",
+             ulBucket * LPB_BUCKET_US, ulCount );
+  }
+}
+// -----
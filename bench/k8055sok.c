@@ -0,0 +1,738 @@
+//-------------------------------------------------------------
+//  Soak test 'k8055sok.exe' for the
+//
+//  ' USB-Interface Board VELLEMAN K8055 '  aka  'VM110'
+//
+//  It runs the loop of an acquisition for a long time: on
+//  every board 'K8055_ReadAllInputs()', followed by new
+//  digital outputs and 'K8055_SetAllOutputs()', as fast as
+//  the reports come in. For every board it records
+//
+//  - the interval between two valid reads, as a histogram
+//    of SOAK_BUCKET_US wide buckets, giving the percentiles
+//    50, 99 and 99.9 and the maximum,
+//  - missed reports: an interval longer than 1.5 report
+//    intervals ( '-p' ) counts the reports that fit in, and
+//    a gap in counter 1 counts the pulses between ( see
+//    '-c' ),
+//  - stale reads ( the Toggle Bit did not change ) and
+//    other errors,
+//
+//  and the load of the system: CPU busy in percent and the
+//  free memory. OS/2 has no resident set size per process;
+//  the private memory still free to the process takes its
+//  place, it shrinks when the process grows.
+//
+//  Every '-s' seconds one line per board is written for that
+//  period, comma separated values. At the end one line per
+//  board for the whole run, the histograms and the verdict
+//  'PASS' ( no report missed ) or 'FAIL'. The verdict takes
+//  the missed reports of counter 1 if checked, else those of
+//  the intervals.
+//
+//  By default it runs against the emulated K8055 'EMUL0' of
+//  the library, whose counter 1 counts the reports. A real
+//  K8055 needs a pulse generator at the report rate on I1
+//  for the check of counter 1.
+//
+//  Usage:
+//    k8055sok [-d <devices>] [-t <seconds>] [-s <seconds>]
+//             [-p <ms>] [-w <ms>] [-c <0|1>]
+//             [-l <us>] [-j <us>] [-r <us>] [-o <file>]
+//
+//    -d ........ Device names separated by ',', up to
+//                SOAK_BOARDS, default 'EMUL0'.
+//    -t ........ Duration in seconds, default 60.
+//    -s ........ Seconds between two result lines,
+//                default 10.
+//    -p ........ Report interval of the board in ms, for
+//                the missed reports, default 10.
+//    -w ........ Pause of the loop in ms after every round,
+//                loads the loop, default 0.
+//    -c ........ 1: check counter 1, the default of an
+//                emulated K8055. 0: no check.
+//    -l ........ Emulation: latency per transfer in us.
+//    -j ........ Emulation: random jitter on top in us.
+//    -r ........ Emulation: report interval of EP81 in us,
+//                default 10000.
+//    -o ........ Results to a file instead of stdout.
+//
+//  Preconditions:
+//  - C Compiler:
+//    'OpenWatcom C 1.6' or higher
+//
+//  - Device Specific Library:
+//    'K8055DD.dll' by B.Hennig and U.Hinz
+//    'k8055lib.h' ( '..\example' )
+//
+//  How to compile and link: see 'Makefile.wmk'.
+//
+//-------------------------------------------------------------
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INCL_DOS
+#include <os2.h>
+
+#include "k8055lib.h"  // Exports of 'K8055DD.dll'
+
+
+//-- Values of the soak test -------------------- BEGIN -----!
+//
+#define SOAK_BOARDS       4        // Boards in one run
+#define SOAK_BUCKET_US    100      // Width of a bucket
+#define SOAK_BUCKETS      2000     // Buckets up to 200 ms,
+                                   // one more for the rest
+#define SOAK_CPUS         16       // Processors summed up
+#define SOAK_VERSION      1        // First line 'K8055SOK 1'
+//
+//-- Values of the soak test -------------------- END -------!
+
+
+//-- 'DosPerfSysCall()', missing in older headers -- BEGIN --!
+//
+#ifndef CMD_KI_RDCNT
+#define CMD_KI_RDCNT 0x63
+
+typedef struct _CPUUTIL
+{
+  ULONG ulTimeLow;
+  ULONG ulTimeHigh;
+  ULONG ulIdleLow;
+  ULONG ulIdleHigh;
+  ULONG ulBusyLow;
+  ULONG ulBusyHigh;
+  ULONG ulIntrLow;
+  ULONG ulIntrHigh;
+} CPUUTIL;
+
+APIRET APIENTRY DosPerfSysCall( ULONG ulCommand, ULONG ulParm1,
+                                ULONG ulParm2, ULONG ulParm3 );
+#endif
+//
+//-- 'DosPerfSysCall()', missing in older headers -- END ----!
+
+
+// -- Interval histogram and counts of one period -------------
+//
+typedef struct _SOAKSTAT
+{
+  ULONG ulReads;
+  ULONG ulMissedGap;
+  ULONG ulMissedCounter;
+  ULONG ulStale;
+  ULONG ulErrors;
+  ULONG ulIntervals;
+  ULONG ulMaxUs;
+  ULONG aulBucket[ SOAK_BUCKETS + 1 ];
+} SOAKSTAT;
+
+// -- One board of the run ------------------------------------
+//
+typedef struct _SOAKBOARD
+{
+  CHAR     *pszDevice;
+  ULONG    ulDevice;
+  BOOL     blCounter;          // Check counter 1
+  BOOL     blValid;            // A valid read before
+  unsigned long long ullLastUs;  // Time of it
+  ULONG    ulLastCounter;      // Counter 1 of it
+  SOAKSTAT Period;             // Since the last line
+  SOAKSTAT Total;              // Whole run
+} SOAKBOARD;
+
+
+// -- Function Prototypes ------------------------ BEGIN -----!
+
+unsigned long long NowUs( VOID );
+
+VOID SoakWaitUntilUs( unsigned long long ullDeadline );
+
+VOID SoakClear( SOAKSTAT *pStat );
+
+VOID SoakInterval( SOAKBOARD *pBoard, ULONG ulIntervalUs,
+                   ULONG ulPeriodUs );
+
+VOID SoakRead( SOAKBOARD *pBoard, ULONG ulPeriodUs );
+
+ULONG SoakPercentile( SOAKSTAT *pStat, ULONG ulPerMille );
+
+VOID SoakLine( FILE *pOut, CHAR *pszElapsed, ULONG ulBoard,
+               SOAKSTAT *pStat, ULONG ulCpuBusy );
+
+VOID SoakHistogram( FILE *pOut, ULONG ulBoard, SOAKSTAT *pStat );
+
+ULONG CpuBusy( VOID );
+
+// -- Function Prototypes ------------------------ END -------!
+
+
+// -- Global Data -------------------------------- BEGIN -----!
+
+SOAKBOARD aSoakBoard[ SOAK_BOARDS ];
+ULONG ulBoards;
+
+ULONG ulTimerFreq;
+
+unsigned long long ullCpuTime;     // Last 'CpuBusy()'
+unsigned long long ullCpuBusy;
+
+// -- Global Data -------------------------------- END -------!
+
+
+// == Main ============================== BEGIN ===============
+
+int main( INT argc, CHAR* *argv )
+{
+  FILE  *pOut;
+  CHAR  *pszDevices;
+  CHAR  *pszOut;
+  CHAR  *pszNext;
+  CHAR  szElapsed[ 16 ];
+  ULONG ulSeconds;
+  ULONG ulLineSeconds;
+  ULONG ulPeriodMs;
+  ULONG ulPauseMs;
+  ULONG ulCounter;
+  ULONG ulLatencyUs;
+  ULONG ulJitterUs;
+  ULONG ulReportUs;
+  ULONG ulBoard;
+  ULONG ulRound;
+  ULONG ulValue;
+  ULONG ulCpuBusy;
+  ULONG ulMissed;
+  INT   iArg;
+  unsigned long long ullStart;
+  unsigned long long ullEnd;
+  unsigned long long ullLine;
+  SOAKBOARD *pBoard;
+
+  pszDevices = "EMUL0";
+  pszOut = NULL;
+  ulSeconds = 60;
+  ulLineSeconds = 10;
+  ulPeriodMs = 10;
+  ulPauseMs = 0;
+  ulCounter = 2;                   // Not given
+  ulLatencyUs = 0;
+  ulJitterUs = 0;
+  ulReportUs = 10000;
+
+  for ( iArg = 1; iArg + 1 < argc; iArg = iArg + 2 )
+  {
+    if ( strcmp( argv[ iArg ], "-d" ) == 0 )
+    {
+      pszDevices = argv[ iArg + 1 ];
+    }
+    else if ( strcmp( argv[ iArg ], "-t" ) == 0 )
+    {
+      ulSeconds = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-s" ) == 0 )
+    {
+      ulLineSeconds = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-p" ) == 0 )
+    {
+      ulPeriodMs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-w" ) == 0 )
+    {
+      ulPauseMs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-c" ) == 0 )
+    {
+      ulCounter = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-l" ) == 0 )
+    {
+      ulLatencyUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-j" ) == 0 )
+    {
+      ulJitterUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-r" ) == 0 )
+    {
+      ulReportUs = strtoul( argv[ iArg + 1 ], NULL, 10 );
+    }
+    else if ( strcmp( argv[ iArg ], "-o" ) == 0 )
+    {
+      pszOut = argv[ iArg + 1 ];
+    }
+    else
+    {
+      break;
+    }
+  }
+  if ( ( iArg < argc ) || ( ulSeconds == 0 ) ||
+       ( ulLineSeconds == 0 ) || ( ulPeriodMs == 0 ) ||
+       ( ulCounter > 2 ) )
+  {
+    printf( "Usage: k8055sok [-d <devices>] [-t <seconds>] "
+            "[-s <seconds>]\n"
+            "                [-p <ms>] [-w <ms>] [-c <0|1>]\n"
+            "                [-l <us>] [-j <us>] [-r <us>] "
+            "[-o <file>]\n" );
+    return 1;
+  }
+
+  pOut = stdout;
+  if ( pszOut != NULL )
+  {
+    pOut = fopen( pszOut, "w" );
+    if ( pOut == NULL )
+    {
+      printf( "Cannot open '%s'\n", pszOut );
+      return 1;
+    }
+  }
+
+  fprintf( pOut, "K8055SOK %u\n", SOAK_VERSION );
+  fprintf( pOut, "# devices=%s seconds=%lu line_s=%lu period_ms=%lu "
+                 "pause_ms=%lu latency_us=%lu jitter_us=%lu "
+                 "report_us=%lu\n",
+           pszDevices, ulSeconds, ulLineSeconds, ulPeriodMs,
+           ulPauseMs, ulLatencyUs, ulJitterUs, ulReportUs );
+
+  // -- Opens and initialises the boards --
+  //    'pszDevices' is split in place.
+  ulBoards = 0;
+  while ( ( pszDevices != NULL ) && ( ulBoards < SOAK_BOARDS ) )
+  {
+    pszNext = strchr( pszDevices, ',' );
+    if ( pszNext != NULL )
+    {
+      *pszNext = '\0';
+      ++pszNext;
+    }
+
+    pBoard = &aSoakBoard[ ulBoards ];
+    memset( pBoard, 0, sizeof( SOAKBOARD ) );
+    pBoard->pszDevice = pszDevices;
+    if ( K8055_Open( pszDevices, &pBoard->ulDevice ) != RET_OKAY )
+    {
+      printf( "Cannot open '%s'\n", pszDevices );
+      return 1;
+    }
+    pBoard->blCounter = ( ulCounter == 1 ) ? TRUE : FALSE;
+    if ( K8055_SetEmulation( &pBoard->ulDevice, &ulLatencyUs,
+                             &ulJitterUs, &ulReportUs ) == RET_OKAY )
+    {
+      pBoard->blCounter = ( ulCounter == 0 ) ? FALSE : TRUE;
+    }
+    K8055_Init( &pBoard->ulDevice );
+
+    ++ulBoards;
+    pszDevices = pszNext;
+  }
+
+  fprintf( pOut, "elapsed_s,board,reads,missed_gap,missed_counter,"
+                 "stale,errors,int_p50_us,int_p99_us,int_p999_us,"
+                 "int_max_us,cpu_busy_pct,mem_avail_kb,"
+                 "mem_private_kb\n" );
+  fflush( pOut );
+
+  // -- The loop of the acquisition --
+  CpuBusy();
+  ullStart = NowUs();
+  ullEnd = ullStart + (unsigned long long)ulSeconds * 1000000;
+  ullLine = ullStart + (unsigned long long)ulLineSeconds * 1000000;
+  ulRound = 0;
+
+  while ( NowUs() < ullEnd )
+  {
+    for ( ulBoard = 0; ulBoard < ulBoards; ulBoard++ )
+    {
+      pBoard = &aSoakBoard[ ulBoard ];
+      SoakRead( pBoard, ulPeriodMs * 1000 );
+
+      // -- A running light, new outputs every round --
+      ulValue = 1 << ( ulRound % 8 );
+      K8055_PrepairDigitalOut( &ulValue );
+      if ( K8055_SetAllOutputs( &pBoard->ulDevice ) != RET_OKAY )
+      {
+        ++pBoard->Period.ulErrors;
+        ++pBoard->Total.ulErrors;
+      }
+    }
+    ++ulRound;
+
+    if ( ulPauseMs != 0 )
+    {
+      SoakWaitUntilUs( NowUs() + ulPauseMs * 1000 );
+    }
+
+    // -- One line per board for the period --
+    if ( NowUs() >= ullLine )
+    {
+      ulCpuBusy = CpuBusy();
+      sprintf( szElapsed, "%lu",
+               (ULONG)( ( NowUs() - ullStart ) / 1000000 ) );
+      for ( ulBoard = 0; ulBoard < ulBoards; ulBoard++ )
+      {
+        SoakLine( pOut, szElapsed, ulBoard,
+                  &aSoakBoard[ ulBoard ].Period, ulCpuBusy );
+        SoakClear( &aSoakBoard[ ulBoard ].Period );
+      }
+      fflush( pOut );
+      ullLine = ullLine + (unsigned long long)ulLineSeconds * 1000000;
+    }
+  }
+
+  // -- The whole run, the histograms and the verdict --
+  ulCpuBusy = CpuBusy();
+  ulMissed = 0;
+  for ( ulBoard = 0; ulBoard < ulBoards; ulBoard++ )
+  {
+    pBoard = &aSoakBoard[ ulBoard ];
+    SoakLine( pOut, "total", ulBoard, &pBoard->Total, ulCpuBusy );
+    // -- Counter 1 is exact, the gaps are the estimate --
+    if ( pBoard->blCounter == TRUE )
+    {
+      ulMissed = ulMissed + pBoard->Total.ulMissedCounter;
+    }
+    else
+    {
+      ulMissed = ulMissed + pBoard->Total.ulMissedGap;
+    }
+  }
+  for ( ulBoard = 0; ulBoard < ulBoards; ulBoard++ )
+  {
+    SoakHistogram( pOut, ulBoard, &aSoakBoard[ ulBoard ].Total );
+  }
+  fprintf( pOut, "# verdict=%s missed=%lu\n",
+           ( ulMissed == 0 ) ? "PASS" : "FAIL", ulMissed );
+
+  for ( ulBoard = 0; ulBoard < ulBoards; ulBoard++ )
+  {
+    K8055_Close( &aSoakBoard[ ulBoard ].ulDevice );
+  }
+
+  if ( pOut != stdout )
+  {
+    fclose( pOut );
+  }
+  return ( ulMissed == 0 ) ? 0 : 2;
+}
+
+// == Main ============================== END =================
+
+
+//-------------------------------------------------------------
+//
+// Time in us, from the high resolution timer of OS/2.
+//
+unsigned long long NowUs( VOID )
+{
+  QWORD qwTicks;
+  unsigned long long ullTicks;
+
+  if ( ulTimerFreq == 0 )
+  {
+    DosTmrQueryFreq( &ulTimerFreq );
+  }
+  DosTmrQueryTime( &qwTicks );
+  ullTicks = ( (unsigned long long)qwTicks.ulHi << 32 ) |
+             qwTicks.ulLo;
+
+  return ( ullTicks / ulTimerFreq ) * 1000000 +
+         ( ( ullTicks % ulTimerFreq ) * 1000000 ) / ulTimerFreq;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Waits until 'ullDeadline'. 'DosSleep()' for the timer ticks
+// of 32 ms that fit, then 'DosSleep( 0 )'.
+//
+VOID SoakWaitUntilUs( unsigned long long ullDeadline )
+{
+  unsigned long long ullNow;
+
+  ullNow = NowUs();
+  while ( ullNow < ullDeadline )
+  {
+    if ( ( ullDeadline - ullNow ) > 3 * 32000 )
+    {
+      DosSleep( (ULONG)( ( ullDeadline - ullNow - 2 * 32000 ) /
+                         1000 ) );
+    }
+    else
+    {
+      DosSleep( 0 );
+    }
+    ullNow = NowUs();
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// No reads in the period yet.
+//
+VOID SoakClear( SOAKSTAT *pStat )
+{
+  memset( pStat, 0, sizeof( SOAKSTAT ) );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// One interval between two valid reads, to the period and
+// to the whole run. An interval longer than 1.5 report
+// intervals holds reports never read.
+//
+VOID SoakInterval( SOAKBOARD *pBoard, ULONG ulIntervalUs,
+                   ULONG ulPeriodUs )
+{
+  ULONG ulBucket;
+  ULONG ulMissed;
+
+  ulBucket = ulIntervalUs / SOAK_BUCKET_US;
+  if ( ulBucket > SOAK_BUCKETS )
+  {
+    ulBucket = SOAK_BUCKETS;
+  }
+
+  ulMissed = 0;
+  if ( ulIntervalUs * 2 > ulPeriodUs * 3 )
+  {
+    ulMissed = ( ulIntervalUs + ulPeriodUs / 2 ) / ulPeriodUs - 1;
+  }
+
+  ++pBoard->Period.ulIntervals;
+  ++pBoard->Period.aulBucket[ ulBucket ];
+  pBoard->Period.ulMissedGap = pBoard->Period.ulMissedGap + ulMissed;
+  if ( ulIntervalUs > pBoard->Period.ulMaxUs )
+  {
+    pBoard->Period.ulMaxUs = ulIntervalUs;
+  }
+
+  ++pBoard->Total.ulIntervals;
+  ++pBoard->Total.aulBucket[ ulBucket ];
+  pBoard->Total.ulMissedGap = pBoard->Total.ulMissedGap + ulMissed;
+  if ( ulIntervalUs > pBoard->Total.ulMaxUs )
+  {
+    pBoard->Total.ulMaxUs = ulIntervalUs;
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Reads all inputs of one board. Counter 1 is taken from the
+// same report, before the next board overwrites it.
+//
+VOID SoakRead( SOAKBOARD *pBoard, ULONG ulPeriodUs )
+{
+  ULONG ulRc;
+  ULONG ulIx;
+  ULONG ulA1;
+  ULONG ulA2;
+  ULONG ulIndex;
+  ULONG ulCounter;
+  ULONG ulDelta;
+  unsigned long long ullNow;
+
+  ulRc = K8055_ReadAllInputs( &pBoard->ulDevice, &ulIx, &ulA1, &ulA2 );
+  ullNow = NowUs();
+
+  if ( ( ulRc & ERROR_TOGGLE_BIT ) != 0 )
+  {
+    ++pBoard->Period.ulStale;
+    ++pBoard->Total.ulStale;
+    return;
+  }
+  if ( ulRc != RET_OKAY )
+  {
+    ++pBoard->Period.ulErrors;
+    ++pBoard->Total.ulErrors;
+    return;
+  }
+
+  ++pBoard->Period.ulReads;
+  ++pBoard->Total.ulReads;
+
+  ulIndex = 1;
+  K8055_CheckIxCounter( &ulCounter, &ulIndex );
+
+  if ( pBoard->blValid == TRUE )
+  {
+    SoakInterval( pBoard, (ULONG)( ullNow - pBoard->ullLastUs ),
+                  ulPeriodUs );
+
+    if ( pBoard->blCounter == TRUE )
+    {
+      ulDelta = ( ulCounter - pBoard->ulLastCounter ) & 0xFFFF;
+      if ( ulDelta > 1 )
+      {
+        pBoard->Period.ulMissedCounter =
+                           pBoard->Period.ulMissedCounter + ulDelta - 1;
+        pBoard->Total.ulMissedCounter =
+                           pBoard->Total.ulMissedCounter + ulDelta - 1;
+      }
+      else if ( ulDelta == 0 )
+      {
+        // -- The Toggle Bit changed, the report did not --
+        ++pBoard->Period.ulStale;
+        ++pBoard->Total.ulStale;
+      }
+    }
+  }
+
+  pBoard->blValid = TRUE;
+  pBoard->ullLastUs = ullNow;
+  pBoard->ulLastCounter = ulCounter;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Upper edge of the bucket holding the interval at
+// 'ulPerMille' of the intervals, in us. The last bucket
+// answers with the maximum.
+//
+ULONG SoakPercentile( SOAKSTAT *pStat, ULONG ulPerMille )
+{
+  ULONG ulBucket;
+  ULONG ulRank;
+  ULONG ulSum;
+
+  if ( pStat->ulIntervals == 0 )
+  {
+    return 0;
+  }
+
+  ulRank = (ULONG)( ( (unsigned long long)pStat->ulIntervals *
+                      ulPerMille + 999 ) / 1000 );
+  ulSum = 0;
+  for ( ulBucket = 0; ulBucket < SOAK_BUCKETS; ulBucket++ )
+  {
+    ulSum = ulSum + pStat->aulBucket[ ulBucket ];
+    if ( ulSum >= ulRank )
+    {
+      return ( ulBucket + 1 ) * SOAK_BUCKET_US;
+    }
+  }
+  return pStat->ulMaxUs;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Writes the line of one board.
+//
+VOID SoakLine( FILE *pOut, CHAR *pszElapsed, ULONG ulBoard,
+               SOAKSTAT *pStat, ULONG ulCpuBusy )
+{
+  ULONG ulAvail;
+  ULONG ulPrivate;
+
+  ulAvail = 0;
+  ulPrivate = 0;
+  DosQuerySysInfo( QSV_TOTAVAILMEM, QSV_TOTAVAILMEM,
+                   &ulAvail, sizeof( ULONG ) );
+  DosQuerySysInfo( QSV_MAXPRMEM, QSV_MAXPRMEM,
+                   &ulPrivate, sizeof( ULONG ) );
+
+  fprintf( pOut, "%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,"
+                 "%lu,%lu,%lu\n",
+           pszElapsed, ulBoard, pStat->ulReads, pStat->ulMissedGap,
+           pStat->ulMissedCounter, pStat->ulStale, pStat->ulErrors,
+           SoakPercentile( pStat, 500 ),
+           SoakPercentile( pStat, 990 ),
+           SoakPercentile( pStat, 999 ),
+           pStat->ulMaxUs, ulCpuBusy,
+           ulAvail / 1024, ulPrivate / 1024 );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Writes the buckets of one board holding intervals, as
+// comment lines.
+//
+VOID SoakHistogram( FILE *pOut, ULONG ulBoard, SOAKSTAT *pStat )
+{
+  ULONG ulBucket;
+
+  for ( ulBucket = 0; ulBucket <= SOAK_BUCKETS; ulBucket++ )
+  {
+    if ( pStat->aulBucket[ ulBucket ] != 0 )
+    {
+      fprintf( pOut, "# hist board=%lu from_us=%lu count=%lu\n",
+               ulBoard, ulBucket * SOAK_BUCKET_US,
+               pStat->aulBucket[ ulBucket ] );
+    }
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// CPU busy in percent since the last call, all processors.
+// 0 if 'DosPerfSysCall()' does not work.
+//
+ULONG CpuBusy( VOID )
+{
+  CPUUTIL aCpu[ SOAK_CPUS ];
+  ULONG ulCpus;
+  ULONG ulCpu;
+  ULONG ulBusy;
+  unsigned long long ullTime;
+  unsigned long long ullBusyNow;
+
+  ulCpus = 1;
+  DosQuerySysInfo( QSV_NUMPROCESSORS, QSV_NUMPROCESSORS,
+                   &ulCpus, sizeof( ULONG ) );
+  if ( ( ulCpus == 0 ) || ( ulCpus > SOAK_CPUS ) )
+  {
+    ulCpus = SOAK_CPUS;
+  }
+
+  memset( &aCpu[0], 0, sizeof( aCpu ) );
+  if ( DosPerfSysCall( CMD_KI_RDCNT, (ULONG)&aCpu[0], 0, 0 ) != 0 )
+  {
+    return 0;
+  }
+
+  ullTime = 0;
+  ullBusyNow = 0;
+  for ( ulCpu = 0; ulCpu < ulCpus; ulCpu++ )
+  {
+    ullTime = ullTime +
+              ( ( (unsigned long long)aCpu[ ulCpu ].ulTimeHigh << 32 ) |
+                aCpu[ ulCpu ].ulTimeLow );
+    ullBusyNow = ullBusyNow +
+              ( ( (unsigned long long)aCpu[ ulCpu ].ulBusyHigh << 32 ) |
+                aCpu[ ulCpu ].ulBusyLow ) +
+              ( ( (unsigned long long)aCpu[ ulCpu ].ulIntrHigh << 32 ) |
+                aCpu[ ulCpu ].ulIntrLow );
+  }
+
+  ulBusy = 0;
+  if ( ullTime > ullCpuTime )
+  {
+    ulBusy = (ULONG)( ( ullBusyNow - ullCpuBusy ) * 100 /
+                      ( ullTime - ullCpuTime ) );
+  }
+  ullCpuTime = ullTime;
+  ullCpuBusy = ullBusyNow;
+
+  return ulBusy;
+}
+// -----
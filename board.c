@@ -0,0 +1,1238 @@
+//======================================= board.c === BEGIN ===
+/**
+ * \file  'board.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief This file keeps track of every K8055 opened by
+ * 'K8055_Open()'. It provides
+ *  - Board Slots: A device handle is mapped to a slot number
+ *    0..3. Other modules keep their per-board data in arrays
+ *    indexed by that number.
+ *  - Locks: The legacy byte arrays of 'func.c' are shared by
+ *    all boards. A transfer on one handle must never be
+ *    interleaved with another transfer on the same handle.
+ *  - The library clock in microseconds.
+ *  - The Acquisition Thread: Once started, it reads one EP81
+ *    report per period and hands it over to the subsystems
+ *    (see 'BoardReportIn()'). An application that polls
+ *    slowly does not slow down alarms any more.
+ *
+ * \version 1.0.23 -
+ * 2026-10-19 'SharedUnlockAll()', 'BoardUnlockXferAll()' and
+ * the relocks for the pause of a retry
+ * \version 1.0.22 -
+ * 2026-10-19 'BoardWriteFrame()' keeps the slew rate limits
+ * \version 1.0.21 -
+ * 2026-10-19 'TimeWaitUntilUs()' yields at regular priority
+ * when called by a time critical thread. The Acquisition
+ * Thread waits with 'TimeWaitSlotUs()'.
+ * \version 1.0.20 -
+ * 2026-10-19 'BoardTryLockXfer()' for the recovery
+ * \version 1.0.19 -
+ * 2026-10-19 'BoardReadReport()' releases the transfer lock
+ * during the pause before a retry
+ * \version 1.0.18 -
+ * 2026-10-19 legacy shadow: 'K8055_SetAllOutputs()' keeps
+ * the outputs changed by the library on this board only
+ * \version 1.0.17 -
+ * 2026-10-19 'TimeWaitSlotUs()': time critical threads
+ * block or yield at regular priority while they wait
+ * \version 1.0.16 -
+ * 2026-10-18 probe point for reports without a new
+ * Toggle Bit
+ * \version 1.0.15 -
+ * 2026-10-18 transfers recorded in the packet trace
+ * \version 1.0.14 -
+ * 2026-10-18 transfers counted by the call statistics
+ * \version 1.0.13 -
+ * 2026-10-18 transfer results and latencies passed to the
+ * health tracking
+ * \version 1.0.12 -
+ * 2026-10-18 EP81 reads retried by policy
+ * \version 1.0.11 -
+ * 2026-10-18 I/O Worker ended on detach
+ * \version 1.0.10 -
+ * 2026-10-18 transfer results passed to the recovery
+ * \version 1.0.9 -
+ * 2026-10-18 Group Worker ended on detach
+ * \version 1.0.8 -
+ * 2026-10-18 scheduled events cancelled on detach
+ * \version 1.0.7 -
+ * 2026-10-18 DO shadow kept in step with every frame,
+ * 'BoardWriteDigital()'
+ * \version 1.0.6 -
+ * 2026-10-18 DAC ramps attached to the slots
+ * \version 1.0.5 -
+ * 2026-10-18 waveform generator attached to the slots
+ * \version 1.0.4 -
+ * 2026-10-18 Output Thread and PWM attached to the slots
+ * \version 1.0.3 -
+ * 2026-10-18 PID controllers are fed with every report
+ * \version 1.0.2 -
+ * 2026-10-18 'BoardReadReport()' shared with the scan engine
+ * \version 1.0.1 -
+ * 2026-10-18 per-board output frame, report lock,
+ * reflex rules
+ * \version 1.0.0 -
+ * 2026-10-18 init, board slots, library clock,
+ * acquisition thread
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+#include <i86.h>
+#include <dos.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "alarm.h"
+#include "reflex.h"
+#include "scan.h"
+#include "pid.h"
+#include "output.h"
+#include "pwm.h"
+#include "wave.h"
+#include "ramp.h"
+#include "dout.h"
+#include "sched.h"
+#include "group.h"
+#include "plug.h"
+#include "timed.h"
+#include "retry.h"
+#include "health.h"
+#include "stats.h"
+#include "trace.h"
+#include "probe.h"
+
+
+//-----------------------------------------------------------//
+//--- Board slots -------------------------------------------//
+//
+K8055BOARD aBoard[ K8055_MAX_BOARDS ];
+
+//-----------------------------------------------------------//
+//--- Byte array for K8055 Digital Inputs Decoder, 'func.c' //
+//
+extern BYTE byaDigInput[ 6 ];
+
+//-----------------------------------------------------------//
+//--- Lock for the legacy byte arrays in 'func.c' -----------//
+//
+HMTX hmtxShared = 0;
+
+//-----------------------------------------------------------//
+//--- Frequency of the timer used by 'DosTmrQueryTime()' ----//
+//
+ULONG ulTmrFreq = 0;
+
+
+//--- Prototype of the thread function --------------------
+//
+static VOID AcqThread( VOID *pvSlot );
+
+
+
+//-------Library clock---------------------------------Begin----
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Library clock. Microseconds since the PC was
+*           started, based on the 1.19 MHz timer chip.
+*
+* \return   Current time in microseconds.
+*/
+K8055TIME TimeNowUs( VOID )
+{
+  QWORD     qwTicks;
+  K8055TIME tmTicks;
+
+  if ( ulTmrFreq == 0 )
+  {
+    DosTmrQueryFreq( &ulTmrFreq );
+  }
+
+  DosTmrQueryTime( &qwTicks );
+  tmTicks = ( (K8055TIME)qwTicks.ulHi << 32 ) | qwTicks.ulLo;
+
+  // -- Split up to keep the product below 2^64 --
+  return ( tmTicks / ulTmrFreq ) * 1000000 +
+         ( ( tmTicks % ulTmrFreq ) * 1000000 ) / ulTmrFreq;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Library clock in milliseconds. Wraps around after
+*           49 days, so only differences are meaningful.
+*/
+ULONG TimeNowMs( VOID )
+{
+  return (ULONG)( TimeNowUs() / 1000 );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Returns when the library clock has reached
+*           'tmDeadline'. The OS/2 scheduler works with
+*           ticks of about 32 ms. So 'DosSleep()' is only
+*           used while the deadline is more than two ticks
+*           ahead. The rest of the time is spent yielding.
+*           'DosSleep( 0 )' yields only to threads of the
+*           same class or above, so a thread running at
+*           PRTYC_TIMECRITICAL drops to PRTYC_REGULAR while
+*           it yields and is time critical again on return.
+*
+* \param    'tmDeadline'
+*           - Absolute time in microseconds.
+*/
+VOID TimeWaitUntilUs( K8055TIME tmDeadline )
+{
+  K8055TIME tmNow;
+  PTIB      ptib;
+  PPIB      ppib;
+  BOOL      blCritical;
+
+  tmNow = TimeNowUs();
+  if ( tmNow >= tmDeadline )
+  {
+    return;
+  }
+
+  // -- Class is the high byte of the priority --
+  DosGetInfoBlocks( &ptib, &ppib );
+  blCritical = ( ( ptib->tib_ptib2->tib2_ulpri >> 8 ) & 0xFF )
+               == PRTYC_TIMECRITICAL;
+  if ( blCritical == TRUE )
+  {
+    DosSetPriority( PRTYS_THREAD, PRTYC_REGULAR, 0, 0 );
+  }
+
+  while ( tmNow < tmDeadline )
+  {
+    if ( ( tmDeadline - tmNow ) > 3 * TIMER_TICK_US )
+    {
+      DosSleep( (ULONG)( ( tmDeadline - tmNow
+                           - 2 * TIMER_TICK_US ) / 1000 ) );
+    }
+    else
+    {
+      DosSleep( 0 );
+    }
+    tmNow = TimeNowUs();
+  }
+
+  if ( blCritical == TRUE )
+  {
+    DosSetPriority( PRTYS_THREAD, PRTYC_TIMECRITICAL, 0, 0 );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Waits for the next slot of a thread running at
+*           PRTYC_TIMECRITICAL. The ticks that fit are spent
+*           blocked on 'hevStop'. The rest is too short to
+*           sleep and is spent in 'TimeWaitUntilUs()' at
+*           regular priority.
+*
+* \param    'tmDeadline'
+*           - Absolute time in microseconds.
+*
+* \param    'hevStop'
+*           - Posted to stop the thread.
+*
+* \return   TRUE, if 'hevStop' was posted.
+*/
+BOOL TimeWaitSlotUs( K8055TIME tmDeadline, HEV hevStop )
+{
+  K8055TIME tmNow;
+
+  tmNow = TimeNowUs();
+  if ( tmDeadline > tmNow + 2 * TIMER_TICK_US )
+  {
+    if ( DosWaitEventSem( hevStop,
+                          (ULONG)( ( tmDeadline - tmNow
+                                     - TIMER_TICK_US ) / 1000 ) )
+         == NO_DOS_ERROR )
+    {
+      return TRUE;
+    }
+    tmNow = TimeNowUs();
+  }
+
+  TimeWaitUntilUs( tmDeadline );
+  return FALSE;
+}
+// -----
+
+//-------Library clock-----------------------------------End----
+
+
+
+//-------Board slots-----------------------------------Begin----
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Creates the lock for the legacy byte arrays
+*           once. Called inside 'DosEnterCritSec()'.
+*/
+static VOID CreateSharedLock( VOID )
+{
+  if ( hmtxShared == 0 )
+  {
+    DosCreateMutexSem( NULL, &hmtxShared, 0, FALSE );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'K8055_Open()'. A free slot is taken
+*           and prepared for the handle 'hDev'.
+*
+* \param    'hDev'
+*           - Handle returned by 'DosOpen()'.
+*
+* \return   Slot number 0..3 or BOARD_NONE, if all slots are
+*           taken.
+*/
+ULONG BoardAttach( ULONG hDev )
+{
+  ULONG ulSlot;
+  ULONG ulFree;
+  K8055BOARD *pBoard;
+
+  ulFree = BOARD_NONE;
+
+  DosEnterCritSec();
+  CreateSharedLock();
+  for ( ulSlot = 0; ulSlot < K8055_MAX_BOARDS; ulSlot++ )
+  {
+    if ( ( aBoard[ ulSlot ].blInUse == TRUE ) &&
+         ( aBoard[ ulSlot ].hDev == hDev ) )
+    {
+      // -- Opened twice, keep the slot --
+      DosExitCritSec();
+      return ulSlot;
+    }
+    if ( ( aBoard[ ulSlot ].blInUse == FALSE ) &&
+         ( ulFree == BOARD_NONE ) )
+    {
+      ulFree = ulSlot;
+    }
+  }
+  if ( ulFree != BOARD_NONE )
+  {
+    aBoard[ ulFree ].blInUse = TRUE;
+    aBoard[ ulFree ].hDev = hDev;
+  }
+  DosExitCritSec();
+
+  if ( ulFree == BOARD_NONE )
+  {
+    return BOARD_NONE;
+  }
+
+  pBoard = &aBoard[ ulFree ];
+
+  // -- Own Parameter Packet for EP81, see 'byaGetData[]' --
+  memset( &pBoard->byaReport[0], 0, SIZEGETBYTES );
+  pBoard->byaReport[0] = 0xEC;
+  pBoard->byaReport[1] = 0x10;
+  pBoard->byaReport[4] = 0x81;
+  pBoard->byaReport[5] = 3;
+  pBoard->byaReport[6] = 8;
+
+  // -- Own Parameter Packet for EP01, see 'byaPutData[]' --
+  memset( &pBoard->byaOutFrame[0], 0, SIZEPUTBYTES );
+  pBoard->byaOutFrame[0] = 0xEC;
+  pBoard->byaOutFrame[1] = 0x10;
+  pBoard->byaOutFrame[4] = 0x01;
+  pBoard->byaOutFrame[5] = 3;
+  pBoard->byaOutFrame[6] = 8;
+  pBoard->byaOutFrame[8] = 0x05;
+  memset( &pBoard->byaLegacyOut[0], 0, sizeof( pBoard->byaLegacyOut ) );
+
+  memset( &pBoard->byaLastData[0], 0, SIZEBUFFERMAX );
+  pBoard->tmLastReport = 0;
+  pBoard->ulReports = 0;
+  pBoard->tidAcq = 0;
+  pBoard->ulAcqPeriodMs = 0;
+  pBoard->ulAcqErrors = 0;
+  pBoard->blAcqRun = FALSE;
+
+  DosCreateMutexSem( NULL, &pBoard->hmtxXfer, 0, FALSE );
+  DosCreateMutexSem( NULL, &pBoard->hmtxReport, 0, FALSE );
+  DosCreateEventSem( NULL, &pBoard->hevAcqStop, 0, FALSE );
+
+  AlarmAttach( ulFree );
+  ReflexAttach( ulFree );
+  PidAttach( ulFree );
+  OutputAttach( ulFree );
+  PwmAttach( ulFree );
+  WaveAttach( ulFree );
+  RampAttach( ulFree );
+  DoutAttach( ulFree );
+  PlugAttach( ulFree );
+  RetryAttach( ulFree );
+  HealthAttach( ulFree );
+  StatsAttach( ulFree );
+
+  return ulFree;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'K8055_Close()'. A running Acquisition
+*           Thread is stopped and the slot is released.
+*
+* \param    'hDev'
+*           - Handle returned by 'DosOpen()'.
+*/
+VOID BoardDetach( ULONG hDev )
+{
+  ULONG ulSlot;
+  K8055BOARD *pBoard;
+
+  ulSlot = BoardSlot( hDev );
+  if ( ulSlot == BOARD_NONE )
+  {
+    return;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  PlugDetach( ulSlot );
+  OutputDetach( ulSlot );
+  SchedDetach( ulSlot );
+  GroupDetach( ulSlot );
+  TimedDetach( ulSlot );
+  ScanDetach( ulSlot );
+  K8055_StopAcquisition( &hDev );
+
+  AlarmDetach( ulSlot );
+
+  DosCloseEventSem( pBoard->hevAcqStop );
+  DosCloseMutexSem( pBoard->hmtxReport );
+  DosCloseMutexSem( pBoard->hmtxXfer );
+  pBoard->hevAcqStop = 0;
+  pBoard->hmtxReport = 0;
+  pBoard->hmtxXfer = 0;
+
+  DosEnterCritSec();
+  pBoard->blInUse = FALSE;
+  pBoard->hDev = 0;
+  DosExitCritSec();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Finds the slot of an opened K8055.
+*
+* \return   Slot number 0..3 or BOARD_NONE.
+*/
+ULONG BoardSlot( ULONG hDev )
+{
+  ULONG ulSlot;
+
+  for ( ulSlot = 0; ulSlot < K8055_MAX_BOARDS; ulSlot++ )
+  {
+    if ( ( aBoard[ ulSlot ].blInUse == TRUE ) &&
+         ( aBoard[ ulSlot ].hDev == hDev ) )
+    {
+      return ulSlot;
+    }
+  }
+  return BOARD_NONE;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Device handle of a slot, 0 if the slot is free.
+*/
+ULONG BoardHandle( ULONG ulSlot )
+{
+  if ( ( ulSlot >= K8055_MAX_BOARDS ) ||
+       ( aBoard[ ulSlot ].blInUse == FALSE ) )
+  {
+    return 0;
+  }
+  return aBoard[ ulSlot ].hDev;
+}
+// -----
+
+//-------Board slots-------------------------------------End----
+
+
+
+//-------Locks-----------------------------------------Begin----
+
+VOID SharedLock( VOID )
+{
+  if ( hmtxShared == 0 )
+  {
+    DosEnterCritSec();
+    CreateSharedLock();
+    DosExitCritSec();
+  }
+  DosRequestMutexSem( hmtxShared, SEM_INDEFINITE_WAIT );
+}
+// -----
+
+VOID SharedUnlock( VOID )
+{
+  DosReleaseMutexSem( hmtxShared );
+}
+// -----
+
+VOID BoardLockXfer( ULONG ulSlot )
+{
+  if ( ulSlot < K8055_MAX_BOARDS )
+  {
+    DosRequestMutexSem( aBoard[ ulSlot ].hmtxXfer,
+                        SEM_INDEFINITE_WAIT        );
+  }
+}
+// -----
+
+BOOL BoardTryLockXfer( ULONG ulSlot, ULONG ulTimeoutMs )
+{
+  if ( ( ulSlot < K8055_MAX_BOARDS ) &&
+       ( DosRequestMutexSem( aBoard[ ulSlot ].hmtxXfer,
+                             ulTimeoutMs                ) == NO_DOS_ERROR ) )
+  {
+    return TRUE;
+  }
+  return FALSE;
+}
+// -----
+
+VOID BoardUnlockXfer( ULONG ulSlot )
+{
+  if ( ulSlot < K8055_MAX_BOARDS )
+  {
+    DosReleaseMutexSem( aBoard[ ulSlot ].hmtxXfer );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Releases every hold the calling thread has on the
+*           shared lock, which it must own.
+*
+* \return   Number of holds released, for 'SharedRelock()'.
+*/
+ULONG SharedUnlockAll( VOID )
+{
+  PID   pid;
+  TID   tid;
+  ULONG ulHolds;
+  ULONG ulIndex;
+
+  ulHolds = 0;
+  DosQueryMutexSem( hmtxShared, &pid, &tid, &ulHolds );
+  for ( ulIndex = 0; ulIndex < ulHolds; ulIndex++ )
+  {
+    DosReleaseMutexSem( hmtxShared );
+  }
+  return ulHolds;
+}
+// -----
+
+VOID SharedRelock( ULONG ulHolds )
+{
+  ULONG ulIndex;
+
+  for ( ulIndex = 0; ulIndex < ulHolds; ulIndex++ )
+  {
+    SharedLock();
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Releases every hold the calling thread has on the
+*           transfer lock of a board, which it must own.
+*
+* \return   Number of holds released, for 'BoardRelockXfer()'.
+*/
+ULONG BoardUnlockXferAll( ULONG ulSlot )
+{
+  PID   pid;
+  TID   tid;
+  ULONG ulHolds;
+  ULONG ulIndex;
+
+  ulHolds = 0;
+  if ( ulSlot < K8055_MAX_BOARDS )
+  {
+    DosQueryMutexSem( aBoard[ ulSlot ].hmtxXfer, &pid, &tid,
+                      &ulHolds );
+  }
+  for ( ulIndex = 0; ulIndex < ulHolds; ulIndex++ )
+  {
+    DosReleaseMutexSem( aBoard[ ulSlot ].hmtxXfer );
+  }
+  return ulHolds;
+}
+// -----
+
+VOID BoardRelockXfer( ULONG ulSlot, ULONG ulHolds )
+{
+  ULONG ulIndex;
+
+  for ( ulIndex = 0; ulIndex < ulHolds; ulIndex++ )
+  {
+    BoardLockXfer( ulSlot );
+  }
+}
+// -----
+
+//-------Locks-------------------------------------------End----
+
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Every valid EP81 report, no matter who read it,
+*           ends up here. It is stored as 'latest report'
+*           and handed over to all subsystems.
+*           Reports of one board are processed one after the
+*           other, even if the Acquisition Thread and an
+*           application read at the same time.
+*           Reflex rules come first, they are the most time
+*           critical subsystem.
+*
+* \param    'ulSlot'
+*           - Board Slot the report belongs to.
+*
+* \param    'pbyData'
+*           - The 8 data bytes { Ix xx A1 A2 I1cL I1cH I2cL
+*           I2cH }.
+*
+* \param    'tmReport'
+*           - Time the report arrived (library clock).
+*/
+VOID BoardReportIn( ULONG ulSlot,
+                    BYTE *pbyData,
+                    K8055TIME tmReport )
+{
+  K8055BOARD *pBoard;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  DosRequestMutexSem( pBoard->hmtxReport, SEM_INDEFINITE_WAIT );
+
+  BoardLockXfer( ulSlot );
+  memcpy( &pBoard->byaLastData[0], pbyData, SIZEBUFFERMAX );
+  pBoard->tmLastReport = tmReport;
+  ++pBoard->ulReports;
+  BoardUnlockXfer( ulSlot );
+
+  ReflexEvaluate( ulSlot, pbyData, tmReport );
+  PidEvaluate( ulSlot, pbyData, tmReport );
+  AlarmEvaluate( ulSlot, pbyData, tmReport );
+
+  DosReleaseMutexSem( pBoard->hmtxReport );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Reads one EP81 report with the board's private
+*           Parameter Packet. Used by all threads of the
+*           library, so they share one Toggle Bit sequence
+*           and never disturb 'byaGetData[]'.
+*
+* \param    'pbyData'
+*           - Receives the 8 data bytes, if the report is
+*           valid.
+*
+* \return   'ulRc'
+*
+*   0x000  RET_OK            Valid report.
+*
+*   0x002  ERROR_POINTER     Slot not in use.
+*
+*   0x020  ERROR_BYTE_NUMBER Not 8 bytes received.
+*
+*   0x040  ERROR_TOGGLE_BIT  No new report, Toggle Bit
+*                            unchanged.
+*
+*   0x100  ERROR_FROM_CALL   'DosWrite()' failed.
+*/
+ULONG BoardReadReport( ULONG ulSlot, BYTE *pbyData )
+{
+  ULONG ulRc;
+  ULONG ulRcDOScall;
+  ULONG ulAttempts;
+  ULONG cbDone;
+  BYTE  bOldToggleBit;
+  BYTE  bNewToggleBit;
+  K8055TIME tmLatency;
+  K8055BOARD *pBoard;
+
+  ulRc = RET_OKAY;
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  BoardLockXfer( ulSlot );
+
+  // -- Failed transfers may be retried, see 'retry.c' --
+  tmLatency = TimeNowUs();
+  ulAttempts = 0;
+  do
+  {
+    ulRc = RET_OKAY;
+    ++ulAttempts;
+
+    bOldToggleBit = pBoard->byaReport[1] & 0x08;
+    ulRcDOScall = TraceDosWrite( pBoard->hDev,
+                                 &pBoard->byaReport[0],
+                                 SIZEGETBYTES,
+                                 &cbDone                 );
+    bNewToggleBit = pBoard->byaReport[1] & 0x08;
+
+    if ( ulRcDOScall != NO_DOS_ERROR )
+    {
+      ulRc = ulRc | ERROR_FROM_CALL;
+    }
+    else if ( bOldToggleBit == bNewToggleBit )
+    {
+      ulRc = ulRc | ERROR_TOGGLE_BIT;
+      PROBE( PROBE_TOGGLE_MISS, pBoard->hDev, ulAttempts, 0 );
+    }
+    else if ( pBoard->byaReport[6] != 0x08 )
+    {
+      ulRc = ulRc | ERROR_BYTE_NUMBER;
+    }
+    else
+    {
+      memcpy( pbyData, &pBoard->byaReport[8], SIZEBUFFERMAX );
+    }
+  } while ( RetryAgain( ulSlot, ulAttempts, ulRc, FALSE ) == TRUE );
+  tmLatency = TimeNowUs() - tmLatency;
+
+  BoardUnlockXfer( ulSlot );
+
+  PlugResult( ulSlot, ulRc, TRUE );
+  HealthResult( ulSlot, ulRc, tmLatency );
+  StatsAdd( ulSlot, STAT_XFER_READ, ulRc, tmLatency );
+
+  return ulRc;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Same conversion as 'K8055_DecodeDigitalInputs()',
+*           done with a table, fast enough for every report.
+*
+* \param    'byIx'
+*           - Raw digital inputs
+*           (I1: 0x10, I2: 0x20, I3: 0x01, I4: 0x40, I5: 0x80)
+*
+* \return   Decoded inputs
+*           (I1: 0x01, I2: 0x02, I3: 0x04, I4: 0x08, I5: 0x10)
+*/
+ULONG BoardDecodeIx( BYTE byIx )
+{
+  ULONG ulIndex;
+  ULONG ulResult;
+
+  ulResult = 0;
+  for ( ulIndex = 1; ulIndex <= 5; ulIndex++ )
+  {
+    if ( ( byIx & byaDigInput[ ulIndex ] ) != 0 )
+    {
+      ulResult = ulResult | ( 1 << ( ulIndex - 1 ) );
+    }
+  }
+  return ulResult;
+}
+// -----
+
+
+
+//-------Output frame----------------------------------Begin----
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Writes DO, DAC1 and DAC2 to one K8055 at once,
+*           using the board's own EP01 Parameter Packet.
+*           This is the output path of all subsystems that
+*           work in the background, so the slew rate limits
+*           of the DACs are kept here (see 'ramp.c'). A DAC
+*           value that would jump too far is reached by a
+*           ramp on the Output Thread.
+*
+* \param    'ulDigitalOut', 'ulDAC1', 'ulDAC2'
+*           - New output values, 0..255 each.
+*
+* \return   Return value of 'DosWrite()'
+*/
+ULONG BoardWriteFrame( ULONG ulSlot,
+                       ULONG ulDigitalOut,
+                       ULONG ulDAC1,
+                       ULONG ulDAC2        )
+{
+  ULONG ulRc;
+  ULONG ulRcDOScall;
+  ULONG cbDone;
+  ULONG aulSent[ RAMP_CHANNELS ];
+  ULONG aulDac[ RAMP_CHANNELS ];
+  BOOL  blRamp;
+  K8055TIME tmLatency;
+  K8055BOARD *pBoard;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return ERROR_POINTER;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  BoardLockXfer( ulSlot );
+  aulSent[0] = pBoard->byaOutFrame[ 10 ];
+  aulSent[1] = pBoard->byaOutFrame[ 11 ];
+  aulDac[0] = ulDAC1;
+  aulDac[1] = ulDAC2;
+  blRamp = RampLimitFrame( ulSlot, &aulSent[0], &aulDac[0] );
+
+  DoutSync( ulSlot, pBoard->byaOutFrame[ 9 ], ulDigitalOut );
+  pBoard->byaOutFrame[  9 ] = (BYTE)ulDigitalOut;
+  pBoard->byaOutFrame[ 10 ] = (BYTE)aulDac[0];
+  pBoard->byaOutFrame[ 11 ] = (BYTE)aulDac[1];
+  tmLatency = TimeNowUs();
+  ulRcDOScall = TraceDosWrite( pBoard->hDev,
+                               &pBoard->byaOutFrame[0],
+                               SIZEPUTBYTES,
+                               &cbDone                  );
+  tmLatency = TimeNowUs() - tmLatency;
+  BoardUnlockXfer( ulSlot );
+
+  // -- The caller may own the transfer lock or the Output
+  //    Thread's slot, the ramp is demanded without waiting --
+  if ( blRamp == TRUE )
+  {
+    OutputKickRamp( ulSlot );
+  }
+
+  ulRc = ( ulRcDOScall == NO_DOS_ERROR ) ? RET_OKAY : ERROR_FROM_CALL;
+  PlugResult( ulSlot, ulRc, FALSE );
+  HealthResult( ulSlot, ulRc, tmLatency );
+  StatsAdd( ulSlot, STAT_XFER_WRITE, ulRc, tmLatency );
+
+  return ulRcDOScall;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called after 'K8055_SetAllOutputs()' or
+*           'K8055_Write()' sent data bytes via the shared
+*           'byaPutData[]'. The board's own frame is brought
+*           up to date, so background subsystems start from
+*           what the K8055 really outputs.
+*
+* \param    'pbyData'
+*           - The 8 data bytes { 0x05 DO DAC1 DAC2 xx .. }
+*/
+VOID BoardOutputSent( ULONG ulSlot, BYTE *pbyData )
+{
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+
+  BoardLockXfer( ulSlot );
+  DoutSync( ulSlot, aBoard[ ulSlot ].byaOutFrame[ 9 ], pbyData[1] );
+  memcpy( &aBoard[ ulSlot ].byaOutFrame[8], pbyData,
+          SIZEBUFFERMAX );
+  BoardUnlockXfer( ulSlot );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Merges the outputs an application put into the
+*           shared 'byaPutData[]' with the frame of the board.
+*           DO bits and DAC values the application did not
+*           change since its last 'K8055_SetAllOutputs()' on
+*           this board keep what the library made of them
+*           (reflex rules, ramps, scheduled events, ...).
+*           Other boards are not touched. Called with the
+*           shared lock and the transfer lock owned.
+*
+* \param    'pbyData'
+*           - Copy of the 8 data bytes { 0x05 DO DAC1 DAC2 ..}
+*           of 'byaPutData[]', merged in place.
+*/
+VOID BoardLegacyMerge( ULONG ulSlot, BYTE *pbyData )
+{
+  BYTE byChanged;
+  ULONG ulIndex;
+  K8055BOARD *pBoard;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  byChanged = (BYTE)( pbyData[1] ^ pBoard->byaLegacyOut[0] );
+  pbyData[1] = (BYTE)( ( pBoard->byaOutFrame[9] & ~byChanged ) |
+                       ( pbyData[1] & byChanged ) );
+
+  for ( ulIndex = 1; ulIndex <= 2; ulIndex++ )
+  {
+    if ( pbyData[ 1 + ulIndex ] == pBoard->byaLegacyOut[ ulIndex ] )
+    {
+      pbyData[ 1 + ulIndex ] = pBoard->byaOutFrame[ 9 + ulIndex ];
+    }
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called after 'K8055_SetAllOutputs()' sent a frame
+*           to the board. The values of 'byaPutData[]' become
+*           the legacy shadow of the board. Called with the
+*           shared lock and the transfer lock owned.
+*
+* \param    'pbyData'
+*           - The 8 data bytes of 'byaPutData[]', not merged.
+*/
+VOID BoardLegacySent( ULONG ulSlot, BYTE *pbyData )
+{
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+  memcpy( &aBoard[ ulSlot ].byaLegacyOut[0], &pbyData[1], 3 );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Writes a new DO byte, DAC1 and DAC2 stay. Unlike
+*           'BoardWriteFrame()' the DO shadow is not touched,
+*           this is the output path of 'dout.c' itself.
+*
+* \return   Return value of 'DosWrite()'
+*/
+ULONG BoardWriteDigital( ULONG ulSlot, ULONG ulDigitalOut )
+{
+  ULONG ulRc;
+  ULONG ulRcDOScall;
+  ULONG cbDone;
+  K8055TIME tmLatency;
+  K8055BOARD *pBoard;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return ERROR_POINTER;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  BoardLockXfer( ulSlot );
+  pBoard->byaOutFrame[ 9 ] = (BYTE)ulDigitalOut;
+  tmLatency = TimeNowUs();
+  ulRcDOScall = TraceDosWrite( pBoard->hDev,
+                               &pBoard->byaOutFrame[0],
+                               SIZEPUTBYTES,
+                               &cbDone                  );
+  tmLatency = TimeNowUs() - tmLatency;
+  BoardUnlockXfer( ulSlot );
+
+  ulRc = ( ulRcDOScall == NO_DOS_ERROR ) ? RET_OKAY : ERROR_FROM_CALL;
+  PlugResult( ulSlot, ulRc, FALSE );
+  HealthResult( ulSlot, ulRc, tmLatency );
+  StatsAdd( ulSlot, STAT_XFER_WRITE, ulRc, tmLatency );
+
+  return ulRcDOScall;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Tells the outputs of the last frame written to
+*           one K8055.
+*/
+VOID BoardGetOutputs( ULONG ulSlot,
+                      ULONG *pulDigitalOut,
+                      ULONG *pulDAC1,
+                      ULONG *pulDAC2        )
+{
+  K8055BOARD *pBoard;
+
+  *pulDigitalOut = 0;
+  *pulDAC1 = 0;
+  *pulDAC2 = 0;
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  BoardLockXfer( ulSlot );
+  *pulDigitalOut = pBoard->byaOutFrame[  9 ];
+  *pulDAC1 = pBoard->byaOutFrame[ 10 ];
+  *pulDAC2 = pBoard->byaOutFrame[ 11 ];
+  BoardUnlockXfer( ulSlot );
+}
+// -----
+
+//-------Output frame------------------------------------End----
+
+
+
+//-------Acquisition Thread----------------------------Begin----
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of the Acquisition Thread. One EP81 report
+*           is read per period. K8055 itself answers every
+*           10 ms, so with the shortest period the loop is
+*           paced by the device and does not need to wait.
+*
+* \param    'pvSlot'
+*           - Board Slot, passed as a pointer value.
+*/
+static VOID AcqThread( VOID *pvSlot )
+{
+  ULONG ulSlot;
+  ULONG ulPeriodUs;
+  BYTE  byaData[ SIZEBUFFERMAX ];
+  K8055TIME tmNext;
+  K8055TIME tmNow;
+  K8055BOARD *pBoard;
+
+  ulSlot = (ULONG)pvSlot;
+  pBoard = &aBoard[ ulSlot ];
+
+  // -- Reports must not wait for other applications --
+  DosSetPriority( PRTYS_THREAD, PRTYC_TIMECRITICAL, 0, 0 );
+
+  tmNext = TimeNowUs();
+  while ( pBoard->blAcqRun == TRUE )
+  {
+    if ( BoardReadReport( ulSlot, &byaData[0] ) == RET_OKAY )
+    {
+      BoardReportIn( ulSlot, &byaData[0], TimeNowUs() );
+    }
+    else
+    {
+      // -- K8055 may be unplugged. Do not spin. --
+      ++pBoard->ulAcqErrors;
+      DosWaitEventSem( pBoard->hevAcqStop, 100 );
+    }
+
+    // -- Longer periods are paced by the library clock --
+    if ( pBoard->ulAcqPeriodMs > ACQ_PERIOD_MIN_MS )
+    {
+      ulPeriodUs = pBoard->ulAcqPeriodMs * 1000;
+      tmNext = tmNext + ulPeriodUs;
+      tmNow = TimeNowUs();
+      if ( tmNext < tmNow )
+      {
+        // -- Overrun, do not try to catch up --
+        tmNext = tmNow;
+      }
+      else
+      {
+        TimeWaitSlotUs( tmNext, pBoard->hevAcqStop );
+      }
+    }
+  }
+}
+// -----
+
+//-------Acquisition Thread------------------------------End----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------17-
+//
+// Export Index 17
+/**
+* \brief 'K8055_StartAcquisition()' starts the Acquisition
+* Thread of one K8055. See 'func.h' for details.
+*/
+ULONG K8055_StartAcquisition( ULONG *pulFileDesc,
+                              ULONG *pulPeriodMs  )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulPeriodMs;
+  ULONG ulPostCount;
+  INT   iTid;
+  K8055BOARD *pBoard;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulPeriodMs )    )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulPeriodMs = *pulPeriodMs;
+  if ( ( ulPeriodMs < ACQ_PERIOD_MIN_MS ) ||
+       ( ulPeriodMs > ACQ_PERIOD_MAX_MS )    )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  // -- Already running: only the period changes --
+  pBoard->ulAcqPeriodMs = ulPeriodMs;
+  if ( pBoard->blAcqRun == TRUE )
+  {
+    return ulRc;
+  }
+
+  DosResetEventSem( pBoard->hevAcqStop, &ulPostCount );
+  pBoard->blAcqRun = TRUE;
+
+  iTid = _beginthread( AcqThread, NULL, THREAD_STACK_SIZE,
+                       (VOID *)ulSlot );
+  if ( iTid == -1 )
+  {
+    pBoard->blAcqRun = FALSE;
+    ulRc = ulRc | ERROR_FROM_CALL;
+    return ulRc;
+  }
+  pBoard->tidAcq = (TID)iTid;
+
+  return ulRc;
+}
+//---------17-
+
+
+//----------------------------------------------------------18-
+//
+// Export Index 18
+/**
+* \brief 'K8055_StopAcquisition()' stops the Acquisition
+* Thread of one K8055 and waits for its end.
+* See 'func.h' for details.
+*/
+ULONG K8055_StopAcquisition( ULONG *pulFileDesc )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  TID   tidAcq;
+  K8055BOARD *pBoard;
+  //
+  ulRc = RET_OKAY;
+
+  if ( NULL == pulFileDesc )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+  pBoard = &aBoard[ ulSlot ];
+
+  if ( pBoard->blAcqRun == FALSE )
+  {
+    return ulRc;
+  }
+
+  pBoard->blAcqRun = FALSE;
+  DosPostEventSem( pBoard->hevAcqStop );
+
+  tidAcq = pBoard->tidAcq;
+  if ( DosWaitThread( &tidAcq, DCWW_WAIT ) != NO_DOS_ERROR )
+  {
+    ulRc = ulRc | ERROR_FROM_CALL;
+  }
+  pBoard->tidAcq = 0;
+
+  return ulRc;
+}
+//---------18-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== board.c === END ===
@@ -0,0 +1,191 @@
+/**
+ * \file 'board.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'board.h' is the headerfile belonging to 'board.c'.
+ * It keeps the per-board bookkeeping of 'K8055DD.dll':
+ * Up to four K8055 can be connected to one PC (jumpers SK5
+ * and SK6). Every K8055 that was opened by 'K8055_Open()'
+ * gets a Board Slot. All subsystems that need to remember
+ * something about a particular K8055 (alarms, rules, ...)
+ * use the slot number as an index into their own tables.
+ *
+ * The file also provides the library clock (microseconds)
+ * and the Acquisition Thread, which reads a new EP81 report
+ * every 10 milliseconds and hands it over to all
+ * subsystems via 'BoardReportIn()'.
+ *
+ * \version 1.0.7 -
+ * 2026-10-19 'SharedUnlockAll()', 'BoardUnlockXferAll()'
+ * \version 1.0.6 -
+ * 2026-10-19 'BoardTryLockXfer()'
+ * \version 1.0.5 -
+ * 2026-10-19 per-board legacy shadow, 'BoardLegacyMerge()'
+ * and 'BoardLegacySent()'
+ * \version 1.0.4 -
+ * 2026-10-19 'TimeWaitSlotUs()' for time critical threads
+ * \version 1.0.3 -
+ * 2026-10-18 'BoardWriteDigital()' for the DO shadow
+ * \version 1.0.2 -
+ * 2026-10-18 'BoardReadReport()'
+ * \version 1.0.1 -
+ * 2026-10-18 per-board output frame, report lock,
+ * reflex rules
+ * \version 1.0.0 -
+ * 2026-10-18 init, board slots, library clock,
+ * acquisition thread
+ */
+#ifndef __K8055DD_H_BOARD_
+#define __K8055DD_H_BOARD_
+
+
+//---- Values concerning board slots ------------ BEGIN --;
+/**
+* \brief Maximum number of K8055 that can be handled at
+* the same time. A K8055 has got two address jumpers
+* (SK5, SK6), so four of them can share one PC.
+*/
+#define K8055_MAX_BOARDS 4
+
+/**
+* \brief Returned by 'BoardSlot()' if a device handle does
+* not belong to a K8055 opened by 'K8055_Open()'.
+*/
+#define BOARD_NONE 0xFFFFFFFF
+
+/**
+* \brief Shortest period of the Acquisition Thread.
+* K8055 delivers a new report via EP81 every 10 ms.
+*/
+#define ACQ_PERIOD_MIN_MS 10
+
+/**
+* \brief Longest period of the Acquisition Thread.
+*/
+#define ACQ_PERIOD_MAX_MS 60000
+
+/**
+* \brief Stack size for threads started by the library.
+*/
+#define THREAD_STACK_SIZE 32768
+
+/**
+* \brief Length of one OS/2 timer tick in microseconds.
+* 'DosSleep()' cannot be more precise than this.
+*/
+#define TIMER_TICK_US 32000
+//
+//---- Values concerning board slots -------------- END --;
+
+
+/**
+* \brief Library clock, microseconds since the PC was
+* started. Derived from the 1.19 MHz timer via
+* 'DosTmrQueryTime()'.
+*/
+typedef unsigned long long K8055TIME;
+
+
+/**
+* \brief Everything the library knows about one opened
+* K8055. The array of these records is private to
+* 'board.c'. Other modules refer to a board by its slot.
+*/
+typedef struct _K8055BOARD
+{
+  BOOL      blInUse;      // Slot is taken
+  ULONG     hDev;         // Handle returned by 'DosOpen()'
+  HMTX      hmtxXfer;     // Serialises transfers on 'hDev'
+
+  // -- EP81 Parameter Packet of the Acquisition Thread.
+  //    It is private to the board, so its Toggle Bit is
+  //    not disturbed by 'K8055_ReadAllInputs()'.
+  BYTE      byaReport[ SIZEGETBYTES ];
+
+  // -- Latest report, whoever read it
+  HMTX      hmtxReport;   // One report at a time
+  BYTE      byaLastData[ SIZEBUFFERMAX ];
+  K8055TIME tmLastReport;
+  ULONG     ulReports;
+
+  // -- EP01 Parameter Packet holding the frame this K8055
+  //    outputs right now. Unlike 'byaPutData[]' it is not
+  //    shared with other boards.
+  BYTE      byaOutFrame[ SIZEPUTBYTES ];
+
+  // -- DO, DAC1 and DAC2 of 'byaPutData[]' last sent to this
+  //    K8055 by 'K8055_SetAllOutputs()' ( legacy shadow )
+  BYTE      byaLegacyOut[ 3 ];
+
+  // -- Acquisition Thread
+  TID       tidAcq;
+  HEV       hevAcqStop;
+  ULONG     ulAcqPeriodMs;
+  ULONG     ulAcqErrors;
+  volatile BOOL blAcqRun;
+} K8055BOARD;
+
+
+
+//--- Library clock -------------------------------------------
+//
+K8055TIME TimeNowUs( VOID );
+ULONG     TimeNowMs( VOID );
+VOID      TimeWaitUntilUs( K8055TIME tmDeadline );
+BOOL      TimeWaitSlotUs( K8055TIME tmDeadline, HEV hevStop );
+
+//--- Board slots ---------------------------------------------
+//
+ULONG BoardAttach( ULONG hDev );
+VOID  BoardDetach( ULONG hDev );
+ULONG BoardSlot( ULONG hDev );
+ULONG BoardHandle( ULONG ulSlot );
+
+//--- Locks ---------------------------------------------------
+//    The legacy byte arrays 'byaGetData[]' and 'byaPutData[]'
+//    in 'func.c' are shared by all boards ('SharedLock()').
+//    Every board has got its own transfer lock on top.
+//    Order: SharedLock() first, BoardLockXfer() second.
+//
+VOID  SharedLock( VOID );
+VOID  SharedUnlock( VOID );
+VOID  BoardLockXfer( ULONG ulSlot );
+BOOL  BoardTryLockXfer( ULONG ulSlot, ULONG ulTimeoutMs );
+VOID  BoardUnlockXfer( ULONG ulSlot );
+
+//    Locks are recursive. These release every hold of the
+//    calling thread and take the same number again.
+//
+ULONG SharedUnlockAll( VOID );
+VOID  SharedRelock( ULONG ulHolds );
+ULONG BoardUnlockXferAll( ULONG ulSlot );
+VOID  BoardRelockXfer( ULONG ulSlot, ULONG ulHolds );
+
+//--- Report distribution -------------------------------------
+//
+ULONG BoardReadReport( ULONG ulSlot, BYTE *pbyData );
+VOID  BoardReportIn( ULONG ulSlot,
+                     BYTE *pbyData,
+                     K8055TIME tmReport );
+ULONG BoardDecodeIx( BYTE byIx );
+
+//--- Output frame --------------------------------------------
+//
+ULONG BoardWriteFrame( ULONG ulSlot,
+                       ULONG ulDigitalOut,
+                       ULONG ulDAC1,
+                       ULONG ulDAC2        );
+VOID  BoardOutputSent( ULONG ulSlot, BYTE *pbyData );
+VOID  BoardLegacyMerge( ULONG ulSlot, BYTE *pbyData );
+VOID  BoardLegacySent( ULONG ulSlot, BYTE *pbyData );
+ULONG BoardWriteDigital( ULONG ulSlot, ULONG ulDigitalOut );
+VOID  BoardGetOutputs( ULONG ulSlot,
+                       ULONG *pulDigitalOut,
+                       ULONG *pulDAC1,
+                       ULONG *pulDAC2        );
+
+#endif
+
+
@@ -0,0 +1,295 @@
+//======================================== dout.c === BEGIN ===
+/**
+ * \file  'dout.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Shadow of the digital outputs O1..O8.
+ *
+ * 'K8055_PrepairDigitalOut()' replaces the whole DO byte, so
+ * two threads that own different outputs had to lock each
+ * other out around read, modify and write.
+ *
+ * Every board keeps a shadow of its DO byte. Set, clear and
+ * toggle change the shadow by an interlocked compare and
+ * exchange, so no change is ever lost, and mark it dirty.
+ * Then the caller tries to become the one thread that
+ * writes the shadow to the K8055. If another thread is
+ * writing just now, the caller returns at once: the writer
+ * sees the dirty mark and writes once more before it stops.
+ * Changes of several threads are combined into one EP01
+ * frame this way.
+ *
+ * Frames written past the shadow ('K8055_SetAllOutputs()',
+ * reflex rules, PWM, ...) are taken over bit by bit (see
+ * 'DoutSync()'), bits they do not change keep pending
+ * values.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 no store into 'byaPutData[]'
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "atomic.h"
+#include "dout.h"
+
+
+/**
+* \brief Shadow of one K8055
+*/
+typedef struct _DOUTBOARD
+{
+  volatile LONG lShadow;      // DO byte wanted
+  volatile LONG lDirty;       // Shadow not written yet
+  volatile LONG lWriter;      // A thread is writing
+} DOUTBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Shadows, indexed by Board Slot ------------------------//
+//
+DOUTBOARD aDout[ K8055_MAX_BOARDS ];
+
+//-----------------------------------------------------------//
+//--- Operations on the shadow ------------------------------//
+//
+#define DOUT_SET    1
+#define DOUT_CLEAR  2
+#define DOUT_TOGGLE 3
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. The shadow starts with
+*           all outputs off, like the frame of the board.
+*/
+VOID DoutAttach( ULONG ulSlot )
+{
+  DOUTBOARD *pDout;
+
+  pDout = &aDout[ ulSlot ];
+
+  AtomicExchange( &pDout->lShadow, 0 );
+  AtomicExchange( &pDout->lDirty, 0 );
+  AtomicExchange( &pDout->lWriter, 0 );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    See 'dout.h'.
+*/
+VOID DoutSync( ULONG ulSlot, ULONG ulOldOut, ULONG ulNewOut )
+{
+  LONG lOld;
+  LONG lNew;
+  ULONG ulChanged;
+  DOUTBOARD *pDout;
+
+  pDout = &aDout[ ulSlot ];
+  ulChanged = ( ulOldOut ^ ulNewOut ) & 0xFF;
+  if ( ulChanged == 0 )
+  {
+    return;
+  }
+
+  do
+  {
+    lOld = pDout->lShadow;
+    lNew = (LONG)( ( (ULONG)lOld & ~ulChanged ) |
+                   ( ulNewOut & ulChanged ) );
+  } while ( AtomicCompareExchange( &pDout->lShadow, lNew, lOld )
+            != lOld );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Writes the shadow, unless another thread does it
+*           already.
+*
+* \return   RET_OKAY or ERROR_FROM_CALL
+*/
+static ULONG DoutFlush( ULONG ulSlot )
+{
+  ULONG ulRc;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  ULONG ulShadow;
+  DOUTBOARD *pDout;
+
+  ulRc = RET_OKAY;
+  pDout = &aDout[ ulSlot ];
+
+  while ( AtomicExchange( &pDout->lWriter, 1 ) == 0 )
+  {
+    AtomicExchange( &pDout->lDirty, 0 );
+
+    BoardLockXfer( ulSlot );
+    BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+    ulShadow = (ULONG)pDout->lShadow;
+    if ( ulShadow != ulDigitalOut )
+    {
+      // -- Not 'BoardWriteFrame()', the shadow must not be
+      //    synced with a value read before --
+      if ( BoardWriteDigital( ulSlot, ulShadow ) != NO_DOS_ERROR )
+      {
+        ulRc = ulRc | ERROR_FROM_CALL;
+      }
+    }
+    BoardUnlockXfer( ulSlot );
+
+    AtomicExchange( &pDout->lWriter, 0 );
+
+    // -- Changes made while writing, their threads did not
+    //    become the writer --
+    if ( pDout->lDirty == 0 )
+    {
+      break;
+    }
+  }
+
+  return ulRc;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Common part of set, clear and toggle.
+*/
+static ULONG DoutChange( ULONG *pulFileDesc,
+                         ULONG *pulMask,
+                         ULONG ulOperation )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  LONG  lOld;
+  LONG  lNew;
+  DOUTBOARD *pDout;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulMask ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( *pulMask > 0xFF )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pDout = &aDout[ ulSlot ];
+
+  do
+  {
+    lOld = pDout->lShadow;
+    switch ( ulOperation )
+    {
+      case DOUT_SET:
+        lNew = lOld | (LONG)*pulMask;
+        break;
+
+      case DOUT_CLEAR:
+        lNew = lOld & ~(LONG)*pulMask;
+        break;
+
+      default:
+        lNew = lOld ^ (LONG)*pulMask;
+        break;
+    }
+  } while ( AtomicCompareExchange( &pDout->lShadow, lNew, lOld )
+            != lOld );
+
+  AtomicExchange( &pDout->lDirty, 1 );
+
+  ulRc = ulRc | DoutFlush( ulSlot );
+
+  return ulRc;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------40-
+//
+// Export Index 40
+/**
+* \brief 'K8055_DigitalOutSet()' switches on the digital
+* outputs in a mask. See 'func.h' for details.
+*/
+ULONG K8055_DigitalOutSet( ULONG *pulFileDesc,
+                           ULONG *pulMask      )
+{
+  return DoutChange( pulFileDesc, pulMask, DOUT_SET );
+}
+//---------40-
+
+
+//----------------------------------------------------------41-
+//
+// Export Index 41
+/**
+* \brief 'K8055_DigitalOutClear()' switches off the digital
+* outputs in a mask. See 'func.h' for details.
+*/
+ULONG K8055_DigitalOutClear( ULONG *pulFileDesc,
+                             ULONG *pulMask      )
+{
+  return DoutChange( pulFileDesc, pulMask, DOUT_CLEAR );
+}
+//---------41-
+
+
+//----------------------------------------------------------42-
+//
+// Export Index 42
+/**
+* \brief 'K8055_DigitalOutToggle()' inverts the digital
+* outputs in a mask. See 'func.h' for details.
+*/
+ULONG K8055_DigitalOutToggle( ULONG *pulFileDesc,
+                              ULONG *pulMask      )
+{
+  return DoutChange( pulFileDesc, pulMask, DOUT_TOGGLE );
+}
+//---------42-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= dout.c === END ===
@@ -0,0 +1,32 @@
+/**
+ * \file 'dout.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'dout.h' is the headerfile belonging to 'dout.c',
+ * the shadow of the digital outputs O1..O8. Single bits can
+ * be set, cleared and toggled by several threads without a
+ * lock.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_DOUT_
+#define __K8055DD_H_DOUT_
+
+
+//--- Used by board.c ----------------------------------------
+//
+VOID DoutAttach( ULONG ulSlot );
+
+//    Called with 'BoardLockXfer()' owned, whenever a frame
+//    is written past the shadow. The bits that changed from
+//    'ulOldOut' to 'ulNewOut' are taken over, all other bits
+//    of the shadow stay as they are.
+//
+VOID DoutSync( ULONG ulSlot, ULONG ulOldOut, ULONG ulNewOut );
+
+#endif
+
+
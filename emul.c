@@ -0,0 +1,942 @@
+//======================================== emul.c === BEGIN ===
+/**
+ * \file  'emul.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Emulated K8055.
+ *
+ * Benchmarks and tests of the library need a K8055 that
+ * answers every time the same way, on a machine without
+ * 'usbecd.sys' or without a board plugged in.
+ *
+ * 'K8055_Open()' with a device name 'EMUL0' .. 'EMUL3'
+ * opens an emulated K8055. Its handle is EMUL_HANDLE_BASE +
+ * the number, and 'TraceDosWrite()' hands every transfer on
+ * such a handle to 'EmulDosWrite()' instead of 'DosWrite()'.
+ * All the rest of the library runs unchanged.
+ *
+ * The emulated K8055 answers the Setup Packets of
+ * 'K8055_Init()' with the descriptors of a K8055, takes the
+ * output frames via EP01 and hands out reports via EP81 with
+ * a new Toggle Bit each time. 'K8055_SetEmulation()' gives
+ * every transfer a latency with a random jitter, and paces
+ * the reports to one per report interval like the interrupt
+ * endpoint of a real K8055.
+ *
+ * Input I1 of an emulated K8055 gets one pulse per report:
+ * counter 1 counts the reports, also those never read. A gap
+ * in counter 1 shows missed reports, like a pulse generator
+ * on I1 of a test rig does.
+ *
+ * Outputs may be wired to inputs like on a test rig ( see
+ * EMUL_WIRE_... ). An output written via EP01 shows in the
+ * first report made after the write, a late read still gets
+ * the inputs of the report due last.
+ *
+ * Faults can be injected like they happen to a real K8055
+ * ( see EMUL_FAULT_... ): a stuck Toggle Bit, a short byte
+ * count, a failed or delayed transfer and a board pulled
+ * out. Each one hits a transfer with a probability, within
+ * a window that may repeat, so benchmarks can take the time
+ * the library needs to notice a fault and to recover from
+ * it. A pulled out board fails every transfer until the
+ * Recovery Thread opens it again after the window, via
+ * 'EmulReplug()'. It then starts like plugged in anew.
+ *
+ * The transfers of a handle are serialised by the transfer
+ * lock of its board, so the emulated K8055 takes no lock.
+ *
+ * A transfer to a real K8055 blocks in the driver, so the
+ * latency and the wait for a report block as well: the
+ * caller sleeps and never spins, even if it runs time
+ * critical. The CPU load of a benchmark is the load of the
+ * library. OS/2 wakes a sleeping thread on a timer tick of
+ * about 32 ms, so shorter waits take up to one tick.
+ *
+ * \version 1.0.4 -
+ * 2026-10-19 the latency and the wait for a report block
+ * instead of yielding
+ * \version 1.0.3 -
+ * 2026-10-19 fault injection, 'K8055_SetEmulationFault()'
+ * \version 1.0.2 -
+ * 2026-10-19 wiring of outputs to inputs,
+ * 'K8055_SetEmulationWiring()'
+ * \version 1.0.1 -
+ * 2026-10-19 counter 1 counts the reports. The Toggle Bit is
+ * flipped in the packet, boards sharing 'byaGetData[]' see
+ * a new one as well.
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "emul.h"
+
+
+/**
+* \brief One fault of an emulated K8055, set by
+* 'K8055_SetEmulationFault()'
+*/
+typedef struct _EMULFAULT
+{
+  ULONG     ulPerMille;          // Probability per transfer
+  K8055TIME tmStart;             // Start of the first window
+  K8055TIME tmLength;            // Length of a window, 0 endless
+  K8055TIME tmPeriod;            // Repeat of the window, 0 once
+} EMULFAULT;
+
+
+/**
+* \brief One emulated K8055
+*/
+typedef struct _EMULDEVICE
+{
+  BOOL      blOpen;
+
+  // -- Set by 'K8055_SetEmulation()'
+  ULONG     ulLatencyUs;
+  ULONG     ulJitterUs;
+  ULONG     ulReportUs;
+
+  // -- Set by 'K8055_SetEmulationWiring()'
+  ULONG     ulWiring;
+  K8055TIME tmOutput;            // Time of the last output
+  BYTE      abyInputOld[ 4 ];    // Ix, A1, A2 before it
+  BYTE      abyInputNew[ 4 ];    // Ix, A1, A2 after it
+
+  // -- Set by 'K8055_SetEmulationFault()'
+  ULONG     ulFaults;            // Bit per fault set
+  EMULFAULT aFault[ EMUL_FAULTS ];
+  BOOL      blUnplugged;         // Pulled out by a fault
+  K8055TIME tmReplug;            // End of its window
+
+  ULONG     ulRandom;            // State of the jitter
+  K8055TIME tmReport;            // Time of the last report
+  ULONG     ulReports;           // Reports made, counter 1
+  BYTE      abyReport[ 8 ];      // Data of EP81
+  BYTE      abyOutput[ 8 ];      // Data of EP01
+} EMULDEVICE;
+
+
+//-----------------------------------------------------------//
+//--- Descriptors of a K8055 --------------------------------//
+//
+static const BYTE abyEmulDevDscr[ 18 ] =
+{
+  18, 1, 0x10, 0x01, 0, 0, 0, 8,      // USB 1.1, EP0 8 bytes
+  0xCF, 0x10, 0x00, 0x55,             // Velleman, K8055
+  0x00, 0x00, 1, 2, 0, 1
+};
+
+static const BYTE abyEmulConfDscr[ 41 ] =
+{
+  9, 2, 41, 0, 1, 1, 0, 0x80, 10,     // Configuration
+  9, 4, 0, 0, 2, 3, 0, 0, 0,          // Interface, HID
+  9, 0x21, 0x00, 0x01, 0, 1, 0x22, 29, 0,
+  7, 5, 0x81, 3, 8, 0, 10,            // EP81, 10 ms
+  7, 5, 0x01, 3, 8, 0, 10             // EP01, 10 ms
+};
+
+static const BYTE abyEmulHidDscr[ 29 ] =
+{
+  0x06, 0x00, 0xFF, 0x09, 0x01, 0xA1, 0x01,
+  0x19, 0x01, 0x29, 0x08, 0x15, 0x00, 0x26, 0xFF, 0x00,
+  0x75, 0x08, 0x95, 0x08, 0x81, 0x02,
+  0x19, 0x01, 0x29, 0x08, 0x91, 0x02, 0xC0
+};
+
+static const BYTE abyEmulLangDscr[ 4 ] = { 4, 3, 0x09, 0x04 };
+
+static const BYTE abyEmulStr1Dscr[ 18 ] =
+{
+  18, 3, 'V',0, 'e',0, 'l',0, 'l',0, 'e',0, 'm',0, 'a',0, 'n',0
+};
+
+static const BYTE abyEmulStr2Dscr[ 20 ] =
+{
+  20, 3, 'U',0, 'S',0, 'B',0, ' ',0, 'K',0, '8',0, '0',0, '5',0,
+  '5',0
+};
+
+static const BYTE abyEmulStr4Dscr[ 4 ] = { 4, 3, '0', 0 };
+
+
+//-----------------------------------------------------------//
+//--- Raw bits of I1..I5 in a report, see 'func.c' ----------//
+//
+extern BYTE byaDigInput[ 6 ];
+
+
+//-----------------------------------------------------------//
+//--- Emulated K8055, indexed by device number --------------//
+//
+EMULDEVICE aEmul[ EMUL_DEVICES ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Number of the emulated K8055 of a device name.
+*
+* \return   0 .. EMUL_DEVICES - 1, EMUL_DEVICES if the name
+*           is none of them
+*/
+static ULONG EmulNumber( CHAR *pszName )
+{
+  ULONG ulLength;
+
+  ulLength = strlen( EMUL_PREFIX );
+  if ( ( strncmp( pszName, EMUL_PREFIX, ulLength ) != 0 ) ||
+       ( pszName[ ulLength ] < '0' ) ||
+       ( pszName[ ulLength ] >= '0' + EMUL_DEVICES ) ||
+       ( pszName[ ulLength + 1 ] != '\0' ) )
+  {
+    return EMUL_DEVICES;
+  }
+  return (ULONG)( pszName[ ulLength ] - '0' );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Emulated K8055 of a handle.
+*
+* \return   NULL if the handle is none of them or closed
+*/
+static EMULDEVICE *EmulDevice( ULONG hDev )
+{
+  if ( EmulHandle( hDev ) == FALSE )
+  {
+    return NULL;
+  }
+  if ( aEmul[ hDev - EMUL_HANDLE_BASE ].blOpen == FALSE )
+  {
+    return NULL;
+  }
+  return &aEmul[ hDev - EMUL_HANDLE_BASE ];
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    TRUE if the device name is an emulated K8055.
+*/
+BOOL EmulName( CHAR *pszName )
+{
+  return ( EmulNumber( pszName ) < EMUL_DEVICES ) ? TRUE : FALSE;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    TRUE if the handle is an emulated K8055.
+*/
+BOOL EmulHandle( ULONG hDev )
+{
+  if ( ( hDev >= EMUL_HANDLE_BASE ) &&
+       ( hDev < EMUL_HANDLE_BASE + EMUL_DEVICES ) )
+  {
+    return TRUE;
+  }
+  return FALSE;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Opens an emulated K8055, like 'DosOpen()'. It
+*           starts without latency, with the reports paced
+*           to one per 10 ms, inputs and counters at 0.
+*
+* \return   NO_DOS_ERROR, EMUL_NOT_FOUND or EMUL_DEVICE_IN_USE
+*/
+ULONG EmulOpen( CHAR *pszName, ULONG *phDev )
+{
+  ULONG ulNumber;
+  EMULDEVICE *pEmul;
+
+  ulNumber = EmulNumber( pszName );
+  if ( ulNumber >= EMUL_DEVICES )
+  {
+    return EMUL_NOT_FOUND;
+  }
+  pEmul = &aEmul[ ulNumber ];
+
+  DosEnterCritSec();
+  if ( pEmul->blOpen == TRUE )
+  {
+    DosExitCritSec();
+    return EMUL_DEVICE_IN_USE;
+  }
+  memset( pEmul, 0, sizeof( EMULDEVICE ) );
+  pEmul->blOpen = TRUE;
+  DosExitCritSec();
+
+  pEmul->ulReportUs = 10000;
+  pEmul->ulRandom = ulNumber + 1;
+  pEmul->tmReport = TimeNowUs();
+  pEmul->abyReport[1] = (BYTE)ulNumber;
+
+  *phDev = EMUL_HANDLE_BASE + ulNumber;
+  return NO_DOS_ERROR;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Closes an emulated K8055, like 'DosClose()'.
+*
+* \return   NO_DOS_ERROR or EMUL_INVALID_HANDLE
+*/
+ULONG EmulClose( ULONG hDev )
+{
+  EMULDEVICE *pEmul;
+
+  pEmul = EmulDevice( hDev );
+  if ( pEmul == NULL )
+  {
+    return EMUL_INVALID_HANDLE;
+  }
+  pEmul->blOpen = FALSE;
+  return NO_DOS_ERROR;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Blocks the caller until the library clock has
+*           reached 'tmDeadline', like a transfer blocked in
+*           the driver. The wait ends on a timer tick.
+*
+* \param    'tmDeadline'
+*           - Absolute time in microseconds.
+*/
+static VOID EmulWaitUntilUs( K8055TIME tmDeadline )
+{
+  K8055TIME tmNow;
+
+  tmNow = TimeNowUs();
+  while ( tmNow < tmDeadline )
+  {
+    DosSleep( (ULONG)( ( tmDeadline - tmNow + 999 ) / 1000 ) );
+    tmNow = TimeNowUs();
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Latency of a transfer, with its jitter.
+*/
+static VOID EmulLatency( EMULDEVICE *pEmul )
+{
+  ULONG ulWaitUs;
+
+  ulWaitUs = pEmul->ulLatencyUs;
+  if ( pEmul->ulJitterUs != 0 )
+  {
+    pEmul->ulRandom = pEmul->ulRandom * 1103515245 + 12345;
+    ulWaitUs = ulWaitUs +
+               ( pEmul->ulRandom >> 8 ) % ( pEmul->ulJitterUs + 1 );
+  }
+  if ( ulWaitUs != 0 )
+  {
+    EmulWaitUntilUs( TimeNowUs() + ulWaitUs );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    TRUE if a fault hits the transfer: it is within
+*           a window of the fault and the random number is
+*           below its probability.
+*
+* \param    'ptmEnd'
+*           - End of the window hit, or NULL.
+*/
+static BOOL EmulFault( EMULDEVICE *pEmul,
+                       ULONG ulFault,
+                       K8055TIME *ptmEnd   )
+{
+  EMULFAULT *pFault;
+  K8055TIME tmNow;
+  K8055TIME tmPhase;
+
+  if ( ( pEmul->ulFaults & ( 1 << ulFault ) ) == 0 )
+  {
+    return FALSE;
+  }
+  pFault = &pEmul->aFault[ ulFault ];
+
+  tmNow = TimeNowUs();
+  if ( tmNow < pFault->tmStart )
+  {
+    return FALSE;
+  }
+  tmPhase = tmNow - pFault->tmStart;
+  if ( pFault->tmPeriod != 0 )
+  {
+    tmPhase = tmPhase % pFault->tmPeriod;
+  }
+  if ( ( pFault->tmLength != 0 ) && ( tmPhase >= pFault->tmLength ) )
+  {
+    return FALSE;
+  }
+
+  pEmul->ulRandom = pEmul->ulRandom * 1103515245 + 12345;
+  if ( ( pEmul->ulRandom >> 8 ) % EMUL_PER_MILLE >= pFault->ulPerMille )
+  {
+    return FALSE;
+  }
+
+  if ( ptmEnd != NULL )
+  {
+    *ptmEnd = ( pFault->tmLength == 0 ) ? ~(K8055TIME)0 :
+              tmNow - tmPhase + pFault->tmLength;
+  }
+  return TRUE;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Answers a Setup Packet via EP0. Bytes 6 and 7
+*           get the number of bytes transferred.
+*/
+static VOID EmulSetup( EMULDEVICE *pEmul,
+                       BYTE *pbyPacket,
+                       ULONG cbPacket    )
+{
+  ULONG ulWanted;
+  ULONG ulLength;
+  const BYTE *pbyDscr;
+
+  pbyDscr = NULL;
+  ulLength = 0;
+
+  if ( ( ( pbyPacket[0] & 0x80 ) != 0 ) && ( pbyPacket[1] == 0x06 ) )
+  {
+    switch ( pbyPacket[3] )
+    {
+      case 0x01:
+        pbyDscr = &abyEmulDevDscr[0];
+        ulLength = sizeof( abyEmulDevDscr );
+        break;
+      case 0x02:
+        pbyDscr = &abyEmulConfDscr[0];
+        ulLength = sizeof( abyEmulConfDscr );
+        break;
+      case 0x03:
+        switch ( pbyPacket[2] )
+        {
+          case 0:
+            pbyDscr = &abyEmulLangDscr[0];
+            ulLength = sizeof( abyEmulLangDscr );
+            break;
+          case 1:
+            pbyDscr = &abyEmulStr1Dscr[0];
+            ulLength = sizeof( abyEmulStr1Dscr );
+            break;
+          case 2:
+            pbyDscr = &abyEmulStr2Dscr[0];
+            ulLength = sizeof( abyEmulStr2Dscr );
+            break;
+          case 4:
+            pbyDscr = &abyEmulStr4Dscr[0];
+            ulLength = sizeof( abyEmulStr4Dscr );
+            break;
+        }
+        break;
+      case 0x22:
+        pbyDscr = &abyEmulHidDscr[0];
+        ulLength = sizeof( abyEmulHidDscr );
+        break;
+    }
+  }
+
+  // -- Not more than asked for and than the packet holds --
+  ulWanted = pbyPacket[6] + ( pbyPacket[7] << 8 );
+  if ( ulLength > ulWanted )
+  {
+    ulLength = ulWanted;
+  }
+  if ( ulLength > cbPacket - SIZEUSBHEADER )
+  {
+    ulLength = cbPacket - SIZEUSBHEADER;
+  }
+  if ( pbyDscr != NULL )
+  {
+    memcpy( &pbyPacket[ SIZEUSBHEADER ], pbyDscr, ulLength );
+  }
+  pbyPacket[6] = (BYTE)ulLength;
+  pbyPacket[7] = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Hands out a report via EP81. A read before the
+*           next report is due waits for it, a late read
+*           gets the report due last.
+*/
+static VOID EmulReport( EMULDEVICE *pEmul,
+                        BYTE *pbyPacket,
+                        ULONG cbPacket    )
+{
+  ULONG ulLength;
+  K8055TIME tmNow;
+
+  if ( pEmul->ulReportUs != 0 )
+  {
+    tmNow = TimeNowUs();
+    if ( tmNow < pEmul->tmReport + pEmul->ulReportUs )
+    {
+      pEmul->tmReport = pEmul->tmReport + pEmul->ulReportUs;
+      ++pEmul->ulReports;
+      EmulWaitUntilUs( pEmul->tmReport );
+    }
+    else
+    {
+      // -- The reports in between were made, but not read --
+      pEmul->ulReports = pEmul->ulReports +
+                         (ULONG)( ( tmNow - pEmul->tmReport ) /
+                                  pEmul->ulReportUs );
+      pEmul->tmReport = tmNow - ( tmNow - pEmul->tmReport ) %
+                                pEmul->ulReportUs;
+    }
+  }
+  else
+  {
+    ++pEmul->ulReports;
+  }
+  pEmul->abyReport[4] = (BYTE)pEmul->ulReports;
+  pEmul->abyReport[5] = (BYTE)( pEmul->ulReports >> 8 );
+
+  // -- Wired inputs: the last output shows once a report
+  //    was made after it --
+  if ( pEmul->ulWiring != EMUL_WIRE_NONE )
+  {
+    if ( ( pEmul->ulReportUs == 0 ) ||
+         ( pEmul->tmReport >= pEmul->tmOutput ) )
+    {
+      memcpy( &pEmul->abyInputOld[0], &pEmul->abyInputNew[0], 4 );
+    }
+    pEmul->abyReport[0] = pEmul->abyInputOld[0];
+    pEmul->abyReport[2] = pEmul->abyInputOld[1];
+    pEmul->abyReport[3] = pEmul->abyInputOld[2];
+  }
+
+  // -- A new report, a new Toggle Bit, unless it got stuck --
+  if ( EmulFault( pEmul, EMUL_FAULT_TOGGLE, NULL ) == FALSE )
+  {
+    pbyPacket[1] = pbyPacket[1] ^ 0x08;
+  }
+
+  ulLength = 8;
+  if ( ulLength > cbPacket - SIZEUSBHEADER )
+  {
+    ulLength = cbPacket - SIZEUSBHEADER;
+  }
+  memcpy( &pbyPacket[ SIZEUSBHEADER ], &pEmul->abyReport[0], ulLength );
+  pbyPacket[6] = (BYTE)ulLength;
+  pbyPacket[7] = 0;
+
+  if ( EmulFault( pEmul, EMUL_FAULT_BYTES, NULL ) == TRUE )
+  {
+    pbyPacket[6] = EMUL_FAULT_SHORT;
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    The inputs driven by the outputs, as wired.
+*/
+static VOID EmulWire( EMULDEVICE *pEmul )
+{
+  ULONG ulIndex;
+
+  memset( &pEmul->abyInputNew[0], 0, 4 );
+  if ( ( pEmul->ulWiring & EMUL_WIRE_DO ) != 0 )
+  {
+    for ( ulIndex = 1; ulIndex <= 5; ulIndex++ )
+    {
+      if ( ( pEmul->abyOutput[1] & ( 1 << ( ulIndex - 1 ) ) ) != 0 )
+      {
+        pEmul->abyInputNew[0] = pEmul->abyInputNew[0] |
+                                byaDigInput[ ulIndex ];
+      }
+    }
+  }
+  if ( ( pEmul->ulWiring & EMUL_WIRE_DAC ) != 0 )
+  {
+    pEmul->abyInputNew[1] = pEmul->abyOutput[2];
+    pEmul->abyInputNew[2] = pEmul->abyOutput[3];
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Takes an output frame via EP01.
+*/
+static VOID EmulOutput( EMULDEVICE *pEmul,
+                        BYTE *pbyPacket,
+                        ULONG cbPacket    )
+{
+  ULONG ulLength;
+
+  ulLength = 8;
+  if ( ulLength > cbPacket - SIZEUSBHEADER )
+  {
+    ulLength = cbPacket - SIZEUSBHEADER;
+  }
+  memcpy( &pEmul->abyOutput[0], &pbyPacket[ SIZEUSBHEADER ], ulLength );
+  pbyPacket[6] = (BYTE)ulLength;
+  pbyPacket[7] = 0;
+
+  // -- Reports made before keep the inputs as they were --
+  if ( pEmul->tmReport >= pEmul->tmOutput )
+  {
+    memcpy( &pEmul->abyInputOld[0], &pEmul->abyInputNew[0], 4 );
+  }
+  EmulWire( pEmul );
+  pEmul->tmOutput = TimeNowUs();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Opens an emulated K8055 again, for the Recovery
+*           Thread. A board pulled out by EMUL_FAULT_UNPLUG
+*           is back once the window of the fault has ended,
+*           with inputs, outputs and counters at 0 like after
+*           power up. Latency, wiring and faults stay set.
+*
+* \return   NO_DOS_ERROR, EMUL_INVALID_HANDLE or
+*           EMUL_NOT_FOUND while still pulled out
+*/
+ULONG EmulReplug( ULONG hDev )
+{
+  EMULDEVICE *pEmul;
+
+  pEmul = EmulDevice( hDev );
+  if ( pEmul == NULL )
+  {
+    return EMUL_INVALID_HANDLE;
+  }
+  if ( pEmul->blUnplugged == FALSE )
+  {
+    return NO_DOS_ERROR;
+  }
+  if ( TimeNowUs() < pEmul->tmReplug )
+  {
+    return EMUL_NOT_FOUND;
+  }
+
+  pEmul->blUnplugged = FALSE;
+  pEmul->ulReports = 0;
+  pEmul->tmReport = TimeNowUs();
+  pEmul->tmOutput = 0;
+  memset( &pEmul->abyOutput[0], 0, sizeof( pEmul->abyOutput ) );
+  memset( &pEmul->abyReport[0], 0, sizeof( pEmul->abyReport ) );
+  pEmul->abyReport[1] = (BYTE)( hDev - EMUL_HANDLE_BASE );
+  EmulWire( pEmul );
+  memcpy( &pEmul->abyInputOld[0], &pEmul->abyInputNew[0], 4 );
+  pEmul->abyReport[0] = pEmul->abyInputOld[0];
+  pEmul->abyReport[2] = pEmul->abyInputOld[1];
+  pEmul->abyReport[3] = pEmul->abyInputOld[2];
+
+  return NO_DOS_ERROR;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    A transfer to an emulated K8055, like
+*           'DosWrite()' to 'usbecd.sys'.
+*
+* \return   NO_DOS_ERROR, EMUL_INVALID_HANDLE, or
+*           EMUL_NOT_READY and EMUL_GEN_FAILURE of faults
+*/
+ULONG EmulDosWrite( ULONG hDev,
+                    PVOID pvPacket,
+                    ULONG cbPacket,
+                    PULONG pcbDone   )
+{
+  BYTE *pbyPacket;
+  EMULDEVICE *pEmul;
+  K8055TIME tmEnd;
+
+  pEmul = EmulDevice( hDev );
+  if ( ( pEmul == NULL ) || ( cbPacket < SIZEUSBHEADER ) )
+  {
+    return EMUL_INVALID_HANDLE;
+  }
+  pbyPacket = (BYTE *)pvPacket;
+
+  // -- A pulled out board stays out until it is replugged --
+  if ( ( pEmul->blUnplugged == FALSE ) &&
+       ( EmulFault( pEmul, EMUL_FAULT_UNPLUG, &tmEnd ) == TRUE ) )
+  {
+    pEmul->blUnplugged = TRUE;
+    pEmul->tmReplug = tmEnd;
+  }
+  if ( pEmul->blUnplugged == TRUE )
+  {
+    *pcbDone = 0;
+    return EMUL_NOT_READY;
+  }
+
+  EmulLatency( pEmul );
+
+  if ( EmulFault( pEmul, EMUL_FAULT_DELAY, NULL ) == TRUE )
+  {
+    EmulWaitUntilUs( TimeNowUs() + EMUL_FAULT_DELAY_US );
+  }
+  if ( EmulFault( pEmul, EMUL_FAULT_XFER, NULL ) == TRUE )
+  {
+    *pcbDone = 0;
+    return EMUL_GEN_FAILURE;
+  }
+
+  // -- 0xEC is the signature of a Parameter Packet --
+  if ( pbyPacket[0] != 0xEC )
+  {
+    EmulSetup( pEmul, pbyPacket, cbPacket );
+  }
+  else if ( ( pbyPacket[4] & 0x80 ) != 0 )
+  {
+    EmulReport( pEmul, pbyPacket, cbPacket );
+  }
+  else
+  {
+    EmulOutput( pEmul, pbyPacket, cbPacket );
+  }
+
+  *pcbDone = cbPacket;
+  return NO_DOS_ERROR;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------69-
+//
+// Export Index 69
+/**
+* \brief 'K8055_SetEmulation()' sets the latency and the
+* report interval of an emulated K8055. See 'func.h' for
+* details.
+*/
+ULONG K8055_SetEmulation( ULONG *pulFileDesc,
+                          ULONG *pulLatencyUs,
+                          ULONG *pulJitterUs,
+                          ULONG *pulReportUs   )
+{
+  ULONG ulRc;
+  EMULDEVICE *pEmul;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulLatencyUs ) ||
+       ( NULL == pulJitterUs ) ||
+       ( NULL == pulReportUs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pEmul = EmulDevice( *pulFileDesc );
+  if ( pEmul == NULL )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulLatencyUs > EMUL_TIME_MAX_US ) ||
+       ( *pulJitterUs > EMUL_TIME_MAX_US ) ||
+       ( *pulReportUs > EMUL_TIME_MAX_US ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pEmul->ulLatencyUs = *pulLatencyUs;
+  pEmul->ulJitterUs = *pulJitterUs;
+  pEmul->ulReportUs = *pulReportUs;
+
+  return ulRc;
+}
+//---------69-
+
+
+//----------------------------------------------------------71-
+//
+// Export Index 71
+/**
+* \brief 'K8055_SetEmulationWiring()' wires outputs of an
+* emulated K8055 to its inputs. See 'func.h' for details.
+*/
+ULONG K8055_SetEmulationWiring( ULONG *pulFileDesc,
+                                ULONG *pulWiring    )
+{
+  ULONG ulRc;
+  EMULDEVICE *pEmul;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulWiring ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pEmul = EmulDevice( *pulFileDesc );
+  if ( pEmul == NULL )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulWiring & ~( EMUL_WIRE_DO | EMUL_WIRE_DAC ) ) != 0 )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  // -- The new wiring holds at once --
+  pEmul->ulWiring = *pulWiring;
+  EmulWire( pEmul );
+  memcpy( &pEmul->abyInputOld[0], &pEmul->abyInputNew[0], 4 );
+  pEmul->abyReport[0] = pEmul->abyInputOld[0];
+  pEmul->abyReport[2] = pEmul->abyInputOld[1];
+  pEmul->abyReport[3] = pEmul->abyInputOld[2];
+
+  return ulRc;
+}
+//---------71-
+
+
+//----------------------------------------------------------72-
+//
+// Export Index 72
+/**
+* \brief 'K8055_SetEmulationFault()' injects a fault into the
+* transfers of an emulated K8055. See 'func.h' for details.
+*/
+ULONG K8055_SetEmulationFault( ULONG *pulFileDesc,
+                               ULONG *pulFault,
+                               ULONG *pulPerMille,
+                               ULONG *pulStartMs,
+                               ULONG *pulLengthMs,
+                               ULONG *pulPeriodMs  )
+{
+  ULONG ulRc;
+  ULONG ulFault;
+  EMULDEVICE *pEmul;
+  EMULFAULT  *pFault;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulFault ) ||
+       ( NULL == pulPerMille ) ||
+       ( NULL == pulStartMs ) ||
+       ( NULL == pulLengthMs ) ||
+       ( NULL == pulPeriodMs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pEmul = EmulDevice( *pulFileDesc );
+  if ( pEmul == NULL )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  // -- A window repeats not before it has ended --
+  ulFault = *pulFault;
+  if ( ( ulFault >= EMUL_FAULTS ) ||
+       ( *pulPerMille > EMUL_PER_MILLE ) ||
+       ( ( *pulPeriodMs != 0 ) &&
+         ( ( *pulLengthMs == 0 ) || ( *pulLengthMs > *pulPeriodMs ) ) ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  // -- Switched off first, so no transfer sees half of it --
+  pEmul->ulFaults = pEmul->ulFaults & ~( 1 << ulFault );
+  pFault = &pEmul->aFault[ ulFault ];
+  pFault->ulPerMille = *pulPerMille;
+  pFault->tmStart = TimeNowUs() + (K8055TIME)*pulStartMs * 1000;
+  pFault->tmLength = (K8055TIME)*pulLengthMs * 1000;
+  pFault->tmPeriod = (K8055TIME)*pulPeriodMs * 1000;
+  if ( pFault->ulPerMille != 0 )
+  {
+    pEmul->ulFaults = pEmul->ulFaults | ( 1 << ulFault );
+  }
+
+  // -- Without the fault a pulled out board may come back --
+  if ( ( ulFault == EMUL_FAULT_UNPLUG ) && ( pFault->ulPerMille == 0 ) )
+  {
+    pEmul->tmReplug = 0;
+  }
+
+  return ulRc;
+}
+//---------72-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= emul.c === END ===
@@ -0,0 +1,119 @@
+/**
+ * \file 'emul.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'emul.h' is the headerfile belonging to 'emul.c',
+ * the emulated K8055 answering the transfers instead of
+ * 'usbecd.sys'.
+ *
+ * \version 1.0.2 -
+ * 2026-10-19 fault injection, 'EmulReplug()'
+ * \version 1.0.1 -
+ * 2026-10-19 wiring of outputs to inputs
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_EMUL_
+#define __K8055DD_H_EMUL_
+
+
+//-- Values belonging to the emulated K8055 ----- BEGIN --!
+//
+/**
+* \brief A device name 'EMUL0' .. 'EMUL3' opens an emulated
+* K8055 instead of 'usbecd.sys'.
+*/
+#define EMUL_PREFIX  "EMUL"
+#define EMUL_DEVICES 4
+
+/**
+* \brief Handles of the emulated K8055 are EMUL_HANDLE_BASE
+* + device number, far above the handles of OS/2.
+*/
+#define EMUL_HANDLE_BASE 0xE0550000
+
+/**
+* \brief Limit of the latency, the jitter and the report
+* interval of 'K8055_SetEmulation()', in us
+*/
+#define EMUL_TIME_MAX_US 1000000
+
+/**
+* \brief Wiring of 'K8055_SetEmulationWiring()', like on a
+* test rig:
+*
+*   EMUL_WIRE_DO   DO1..DO5 drive I1..I5
+*   EMUL_WIRE_DAC  DAC1 drives A1, DAC2 drives A2
+*/
+#define EMUL_WIRE_NONE 0x0000
+#define EMUL_WIRE_DO   0x0001
+#define EMUL_WIRE_DAC  0x0002
+
+/**
+* \brief Faults of 'K8055_SetEmulationFault()':
+*
+*   EMUL_FAULT_TOGGLE  Report without a new Toggle Bit
+*   EMUL_FAULT_BYTES   Report with EMUL_FAULT_SHORT bytes at
+*                      offset 6 instead of 8
+*   EMUL_FAULT_XFER    Transfer fails, EMUL_GEN_FAILURE
+*   EMUL_FAULT_DELAY   Transfer takes EMUL_FAULT_DELAY_US
+*                      longer
+*   EMUL_FAULT_UNPLUG  Board pulled out until the window
+*                      ends, replugged by the next reopen
+*/
+#define EMUL_FAULT_TOGGLE   0
+#define EMUL_FAULT_BYTES    1
+#define EMUL_FAULT_XFER     2
+#define EMUL_FAULT_DELAY    3
+#define EMUL_FAULT_UNPLUG   4
+#define EMUL_FAULTS         5
+
+#define EMUL_FAULT_SHORT    7
+#define EMUL_FAULT_DELAY_US 50000
+
+/**
+* \brief A fault hits a transfer with a probability of
+* 0 .. EMUL_PER_MILLE per mille
+*/
+#define EMUL_PER_MILLE      1000
+
+/**
+* \brief Return values like those of 'DosOpen()' and
+* 'DosWrite()'
+*/
+#define EMUL_NOT_FOUND       2     // ERROR_FILE_NOT_FOUND
+#define EMUL_INVALID_HANDLE  6     // ERROR_INVALID_HANDLE
+#define EMUL_NOT_READY      21     // ERROR_NOT_READY
+#define EMUL_GEN_FAILURE    31     // ERROR_GEN_FAILURE
+#define EMUL_DEVICE_IN_USE  99     // ERROR_DEVICE_IN_USE
+//
+//-- Values belonging to the emulated K8055 ------- END --!
+
+
+//--- Used by 'K8055_Open()' and 'K8055_Close()' --------------
+//
+BOOL EmulName( CHAR *pszName );
+
+BOOL EmulHandle( ULONG hDev );
+
+ULONG EmulOpen( CHAR *pszName, ULONG *phDev );
+
+ULONG EmulClose( ULONG hDev );
+
+//--- Used by the Recovery Thread instead of 'DosOpen()' ------
+//
+ULONG EmulReplug( ULONG hDev );
+
+//--- Used by 'TraceDosWrite()' instead of 'DosWrite()' -------
+//
+ULONG EmulDosWrite( ULONG hDev,
+                    PVOID pvPacket,
+                    ULONG cbPacket,
+                    PULONG pcbDone   );
+
+#endif
+
+
+
@@ -135,6 +135,30 @@
 *
 */
 #define ERROR_TESTERROR   0x200
+
+
+/**
+* \brief An output transaction was not committed, because
+* the outputs changed since it began (see 'K8055_TxCommit()').
+*
+*/
+#define ERROR_CONFLICT   0x400
+
+
+/**
+* \brief A call with a timeout did not finish in time
+* (see 'K8055_ReadInputsTimed()'). Its transfer was given up.
+*
+*/
+#define ERROR_DEADLINE   0x800
+
+
+/**
+* \brief The circuit breaker of the board is open, the call
+* was refused without a transfer (see 'K8055_SetBreaker()').
+*
+*/
+#define ERROR_BREAKER    0x1000
 //
 //-- Error values used in exported functions ------ END --#
 
@@ -797,4 +821,1059 @@ APIRET APIENTRY K8055_GetInfoByte
 
 
 
+//--- K8055_StartAcquisition ----------------------------------
+//                                            Import Index 17
+/**
+* Starts the Acquisition Thread of one K8055. It reads the
+* EP81 report once per period (10..60000 ms) and evaluates
+* the alarm comparators on every report.
+*/
+APIRET APIENTRY K8055_StartAcquisition
+                                ( ULONG *pulFileDesc,
+                                  ULONG *pulPeriodMs  );
+// ---------------------------------------------------------I17
+
+
+
+//--- K8055_StopAcquisition -----------------------------------
+//                                            Import Index 18
+/**
+* Stops the Acquisition Thread. 'K8055_Close' does it too.
+*/
+APIRET APIENTRY K8055_StopAcquisition( ULONG *pulFileDesc );
+// ---------------------------------------------------------I18
+
+
+
+//--- K8055_SetAlarm ------------------------------------------
+//                                            Import Index 19
+/**
+* Configures the comparator of A1 (channel 1) or A2
+* (channel 2): high and low limit (0..255 or ALARM_LIMIT_OFF),
+* hysteresis and minimum duration in ms.
+*/
+#define ALARM_LIMIT_OFF     0xFFFFFFFF
+
+APIRET APIENTRY K8055_SetAlarm( ULONG *pulFileDesc,
+                                ULONG *pulChannel,
+                                ULONG *pulHighLimit,
+                                ULONG *pulLowLimit,
+                                ULONG *pulHysteresis,
+                                ULONG *pulMinDurationMs );
+// ---------------------------------------------------------I19
+
+
+
+//--- K8055_GetAlarmEvent -------------------------------------
+//                                            Import Index 20
+/**
+* Takes the oldest alarm event out of the queue, waits up to
+* '*pulTimeoutMs' if there is none.
+*/
+#define ALARM_EV_NONE       0
+#define ALARM_EV_HIGH_SET   1
+#define ALARM_EV_HIGH_CLEAR 2
+#define ALARM_EV_LOW_SET    3
+#define ALARM_EV_LOW_CLEAR  4
+#define ALARM_EV_LOST       5
+
+APIRET APIENTRY K8055_GetAlarmEvent( ULONG *pulFileDesc,
+                                     ULONG *pulTimeoutMs,
+                                     ULONG *pulChannel,
+                                     ULONG *pulEvent,
+                                     ULONG *pulValue,
+                                     ULONG *pulTimeMs     );
+// ---------------------------------------------------------I20
+
+
+
+//--- K8055_GetAlarmState -------------------------------------
+//                                            Import Index 21
+/**
+* Current state of one comparator.
+*/
+#define ALARM_STATE_NORMAL  0
+#define ALARM_STATE_HIGH    1
+#define ALARM_STATE_LOW     2
+
+APIRET APIENTRY K8055_GetAlarmState( ULONG *pulFileDesc,
+                                     ULONG *pulChannel,
+                                     ULONG *pulState    );
+// ---------------------------------------------------------I21
+
+
+
+//--- K8055_SetReflexRules ------------------------------------
+//                                            Import Index 22
+/**
+* Replaces the Reflex Rules of a K8055 (0..8 rules). They are
+* checked after every EP81 report, the library changes the
+* outputs at once if a rule fires.
+* Digital inputs are given as decoded mask (I1: 0x01 ..
+* I5: 0x10).
+*/
+#define REFLEX_RULES_MAX        8
+
+#define REFLEX_COND_NONE        0
+#define REFLEX_COND_INPUT_HIGH  1
+#define REFLEX_COND_INPUT_LOW   2
+#define REFLEX_COND_INPUT_RISE  3
+#define REFLEX_COND_INPUT_FALL  4
+#define REFLEX_COND_A1_ABOVE    5
+#define REFLEX_COND_A1_BELOW    6
+#define REFLEX_COND_A2_ABOVE    7
+#define REFLEX_COND_A2_BELOW    8
+
+#define REFLEX_ANY              0
+#define REFLEX_ALL              1
+
+#define REFLEX_DAC_KEEP         0xFFFFFFFF
+
+typedef struct _REFLEXRULE
+{
+  ULONG ulCombine;
+  ULONG ulCondition1;
+  ULONG ulParam1;
+  ULONG ulCondition2;
+  ULONG ulParam2;
+  ULONG ulDoClear;
+  ULONG ulDoSet;
+  ULONG ulDac1;
+  ULONG ulDac2;
+} REFLEXRULE;
+
+APIRET APIENTRY K8055_SetReflexRules( ULONG *pulFileDesc,
+                                      ULONG *pulCount,
+                                      REFLEXRULE *paRules );
+// ---------------------------------------------------------I22
+
+
+
+//--- K8055_GetReflexCount ------------------------------------
+//                                            Import Index 23
+/**
+* On how many reports rule 1..8 has fired.
+*/
+APIRET APIENTRY K8055_GetReflexCount( ULONG *pulFileDesc,
+                                      ULONG *pulRule,
+                                      ULONG *pulFired     );
+// ---------------------------------------------------------I23
+
+
+
+//--- K8055_StartScan -----------------------------------------
+//                                            Import Index 24
+/**
+* Starts a Scan Engine for 1..4 boards with a fixed cycle
+* (10..60000 ms). Every cycle: read all inputs, call the
+* logic with the Process Images, write changed outputs.
+* The logic returns 0 to go on. '*pulScan' returns 1..4.
+*/
+typedef struct _SCANIMAGE
+{
+  ULONG ulFileDesc;
+  ULONG ulRcRead;
+  ULONG ulDigitalIn;
+  ULONG ulA1;
+  ULONG ulA2;
+  ULONG ulCounter1;
+  ULONG ulCounter2;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+} SCANIMAGE;
+
+typedef ULONG ( APIENTRY *PFNK8055SCAN )( ULONG ulBoards,
+                                         SCANIMAGE *paImage,
+                                         VOID *pvUser       );
+
+APIRET APIENTRY K8055_StartScan( ULONG *pulFileDescs,
+                                 ULONG *pulBoards,
+                                 ULONG *pulCycleMs,
+                                 PFNK8055SCAN pfnLogic,
+                                 VOID *pvUser,
+                                 ULONG *pulScan        );
+// ---------------------------------------------------------I24
+
+
+
+//--- K8055_StopScan ------------------------------------------
+//                                            Import Index 25
+/**
+* Stops and frees a Scan Engine.
+*/
+APIRET APIENTRY K8055_StopScan( ULONG *pulScan );
+// ---------------------------------------------------------I25
+
+
+
+//--- K8055_GetScanStats --------------------------------------
+//                                            Import Index 26
+/**
+* Cycles, overruns, failed reads, cycle start jitter (max,
+* mean) and longest cycle of a Scan Engine, times in us.
+*/
+APIRET APIENTRY K8055_GetScanStats( ULONG *pulScan,
+                                    ULONG *pulCycles,
+                                    ULONG *pulOverruns,
+                                    ULONG *pulReadErrors,
+                                    ULONG *pulJitterMaxUs,
+                                    ULONG *pulJitterAvgUs,
+                                    ULONG *pulScanMaxUs    );
+// ---------------------------------------------------------I26
+
+
+
+//--- K8055_SetPid --------------------------------------------
+//                                            Import Index 27
+/**
+* Sets all parameters of PID controller 1 (A1 -> DAC1) or
+* 2 (A2 -> DAC2) at once. Values in counts 0..255, 'dKi' per
+* second, 'dKd' in seconds, period 10..60000 ms. Needs the
+* Acquisition Thread.
+*/
+typedef struct _PIDPARAM
+{
+  ULONG  ulEnable;
+  ULONG  ulPeriodMs;
+  double dSetpoint;
+  double dKp;
+  double dKi;
+  double dKd;
+  ULONG  ulOutMin;
+  ULONG  ulOutMax;
+} PIDPARAM;
+
+APIRET APIENTRY K8055_SetPid( ULONG *pulFileDesc,
+                              ULONG *pulChannel,
+                              PIDPARAM *pParam    );
+// ---------------------------------------------------------I27
+
+
+
+//--- K8055_GetPidStats ---------------------------------------
+//                                            Import Index 28
+/**
+* Statistics of one PID controller since it was set.
+*/
+typedef struct _PIDSTATS
+{
+  ULONG  ulSamples;
+  ULONG  ulSaturated;
+  double dError;
+  double dErrorAbsMax;
+  double dErrorAbsAvg;
+  ULONG  ulOutput;
+  ULONG  ulIntervalMaxUs;
+  ULONG  ulLatencyMaxUs;
+  ULONG  ulLatencyAvgUs;
+} PIDSTATS;
+
+APIRET APIENTRY K8055_GetPidStats( ULONG *pulFileDesc,
+                                   ULONG *pulChannel,
+                                   PIDSTATS *pStats    );
+// ---------------------------------------------------------I28
+
+
+
+//--- K8055_SetPwm --------------------------------------------
+//                                            Import Index 29
+/**
+* Software PWM on digital output 1..8. Period 100..1000 ms in
+* steps of 10 ms, duty cycle 0..100 %.
+*/
+APIRET APIENTRY K8055_SetPwm( ULONG *pulFileDesc,
+                              ULONG *pulChannel,
+                              ULONG *pulPeriodMs,
+                              ULONG *pulDuty      );
+// ---------------------------------------------------------I29
+
+
+
+//--- K8055_StopPwm -------------------------------------------
+//                                            Import Index 30
+/**
+* Ends the PWM on one output and switches it off.
+*/
+APIRET APIENTRY K8055_StopPwm( ULONG *pulFileDesc,
+                               ULONG *pulChannel   );
+// ---------------------------------------------------------I30
+
+
+
+//--- K8055_GetOutputStats ------------------------------------
+//                                            Import Index 31
+/**
+* Output Slots (10 ms) handled, EP01 frames written and slots
+* skipped by the Output Thread.
+*/
+APIRET APIENTRY K8055_GetOutputStats( ULONG *pulFileDesc,
+                                      ULONG *pulSlots,
+                                      ULONG *pulWrites,
+                                      ULONG *pulLateSlots );
+// ---------------------------------------------------------I31
+
+
+
+//--- K8055_SetWave -------------------------------------------
+//                                            Import Index 32
+/**
+* DAC waveform generator: channel 1 drives DAC1, channel 2
+* drives DAC2. One point per 10 ms, 0.001..50 Hz, DAC range
+* 'pulLow'..'pulHigh', phase offset 0..359 degrees.
+*/
+#define WAVE_DAC1 0x01
+#define WAVE_DAC2 0x02
+
+#define WAVE_SINE     1
+#define WAVE_RAMP     2
+#define WAVE_TRIANGLE 3
+#define WAVE_USER     4
+
+#define WAVE_FREQ_MIN_MHZ 1
+#define WAVE_FREQ_MAX_MHZ 50000
+
+APIRET APIENTRY K8055_SetWave( ULONG *pulFileDesc,
+                               ULONG *pulChannel,
+                               ULONG *pulShape,
+                               ULONG *pulFreqMilliHz,
+                               ULONG *pulLow,
+                               ULONG *pulHigh,
+                               ULONG *pulPhaseDeg     );
+// ---------------------------------------------------------I32
+
+
+
+//--- K8055_SetWaveTable --------------------------------------
+//                                            Import Index 33
+/**
+* Points 2..256 of the user waveform WAVE_USER.
+*/
+APIRET APIENTRY K8055_SetWaveTable( ULONG *pulFileDesc,
+                                    ULONG *pulPoints,
+                                    BYTE *pbyPoints    );
+// ---------------------------------------------------------I33
+
+
+
+//--- K8055_StartWave -----------------------------------------
+//                                            Import Index 34
+/**
+* Starts WAVE_DAC1, WAVE_DAC2 or both in the same slot.
+*/
+APIRET APIENTRY K8055_StartWave( ULONG *pulFileDesc,
+                                 ULONG *pulChannels  );
+// ---------------------------------------------------------I34
+
+
+
+//--- K8055_StopWave ------------------------------------------
+//                                            Import Index 35
+/**
+* Stops channels, the DACs keep their last value.
+*/
+APIRET APIENTRY K8055_StopWave( ULONG *pulFileDesc,
+                                ULONG *pulChannels  );
+// ---------------------------------------------------------I35
+
+
+
+//--- K8055_GetWaveStats --------------------------------------
+//                                            Import Index 36
+/**
+* Requested and achieved frequency in milli Hertz, points
+* put out and points lost since the start of a channel.
+*/
+APIRET APIENTRY K8055_GetWaveStats( ULONG *pulFileDesc,
+                                    ULONG *pulChannel,
+                                    ULONG *pulRequestedMilliHz,
+                                    ULONG *pulAchievedMilliHz,
+                                    ULONG *pulSamples,
+                                    ULONG *pulMissed           );
+// ---------------------------------------------------------I36
+
+
+
+//--- K8055_SetDacSlew ----------------------------------------
+//                                            Import Index 37
+/**
+* Slew rate limit of DAC1 (1) or DAC2 (2) in counts per
+* second, also applied to 'K8055_SetAllOutputs()'.
+*/
+#define RAMP_SLEW_OFF 0
+#define RAMP_SLEW_MAX 25500
+
+#define RAMP_TIME_MAX_MS 600000
+
+APIRET APIENTRY K8055_SetDacSlew( ULONG *pulFileDesc,
+                                  ULONG *pulChannel,
+                                  ULONG *pulCountsPerSec );
+// ---------------------------------------------------------I37
+
+
+
+//--- K8055_RampDac -------------------------------------------
+//                                            Import Index 38
+/**
+* Ramps a DAC to 'pulTarget' within 'pulTimeMs', returns at
+* once.
+*/
+APIRET APIENTRY K8055_RampDac( ULONG *pulFileDesc,
+                               ULONG *pulChannel,
+                               ULONG *pulTarget,
+                               ULONG *pulTimeMs    );
+// ---------------------------------------------------------I38
+
+
+
+//--- K8055_GetDacRamp ----------------------------------------
+//                                            Import Index 39
+/**
+* Value last written, ramp target and TRUE while the ramp
+* runs.
+*/
+APIRET APIENTRY K8055_GetDacRamp( ULONG *pulFileDesc,
+                                  ULONG *pulChannel,
+                                  ULONG *pulValue,
+                                  ULONG *pulTarget,
+                                  ULONG *pulBusy      );
+// ---------------------------------------------------------I39
+
+
+
+//--- K8055_DigitalOutSet -------------------------------------
+//                                            Import Index 40
+/**
+* Switches on the outputs in 'pulMask' (O1 = 0x01), the
+* others stay. Safe for threads owning different outputs.
+*/
+APIRET APIENTRY K8055_DigitalOutSet( ULONG *pulFileDesc,
+                                     ULONG *pulMask      );
+// ---------------------------------------------------------I40
+
+
+
+//--- K8055_DigitalOutClear -----------------------------------
+//                                            Import Index 41
+/**
+* Switches off the outputs in 'pulMask'.
+*/
+APIRET APIENTRY K8055_DigitalOutClear( ULONG *pulFileDesc,
+                                       ULONG *pulMask      );
+// ---------------------------------------------------------I41
+
+
+
+//--- K8055_DigitalOutToggle ----------------------------------
+//                                            Import Index 42
+/**
+* Inverts the outputs in 'pulMask'.
+*/
+APIRET APIENTRY K8055_DigitalOutToggle( ULONG *pulFileDesc,
+                                        ULONG *pulMask      );
+// ---------------------------------------------------------I42
+
+
+
+//--- K8055_TxBegin -------------------------------------------
+//                                            Import Index 43
+/**
+* Output transaction: 'K8055_TxBegin()' reads the outputs,
+* the application changes 'ulDigitalOut', 'ulDac1', 'ulDac2',
+* 'K8055_TxCommit()' writes them with one frame.
+* TXN_COMPARE fails with ERROR_CONFLICT if the outputs
+* changed in between.
+*/
+#define TXN_MERGE   0x0000
+#define TXN_COMPARE 0x0001
+
+typedef struct _OUTPUTTX
+{
+  ULONG ulFlags;
+  ULONG ulOldOut;
+  ULONG ulOldDac1;
+  ULONG ulOldDac2;
+  ULONG ulDigitalOut;
+  ULONG ulDac1;
+  ULONG ulDac2;
+} OUTPUTTX;
+
+APIRET APIENTRY K8055_TxBegin( ULONG *pulFileDesc,
+                               OUTPUTTX *pTx      );
+// ---------------------------------------------------------I43
+
+
+
+//--- K8055_TxCommit ------------------------------------------
+//                                            Import Index 44
+/**
+* Writes the transaction with one EP01 frame.
+*/
+APIRET APIENTRY K8055_TxCommit( ULONG *pulFileDesc,
+                                OUTPUTTX *pTx      );
+// ---------------------------------------------------------I44
+
+
+
+//--- K8055_ScheduleOutput ------------------------------------
+//                                            Import Index 45
+/**
+* Output change in 'pulDelayMs' (0..10000000 ms), carried
+* out by the library in slots of 10 ms. Events of a board in
+* the same slot leave with one frame.
+*/
+#define SCHED_DAC1 0x01
+#define SCHED_DAC2 0x02
+
+#define SCHED_EVENTS_MAX   4096
+#define SCHED_DELAY_MAX_MS 10000000
+
+APIRET APIENTRY K8055_ScheduleOutput( ULONG *pulFileDesc,
+                                      ULONG *pulDelayMs,
+                                      ULONG *pulDoMask,
+                                      ULONG *pulDoBits,
+                                      ULONG *pulDacMask,
+                                      ULONG *pulDac1,
+                                      ULONG *pulDac2,
+                                      ULONG *pulEventId  );
+// ---------------------------------------------------------I45
+
+
+
+//--- K8055_SchedulePulse -------------------------------------
+//                                            Import Index 46
+/**
+* Outputs in 'pulDoMask' on in 'pulDelayMs', off again after
+* 'pulLengthMs'.
+*/
+APIRET APIENTRY K8055_SchedulePulse( ULONG *pulFileDesc,
+                                     ULONG *pulDelayMs,
+                                     ULONG *pulLengthMs,
+                                     ULONG *pulDoMask,
+                                     ULONG *pulOnId,
+                                     ULONG *pulOffId     );
+// ---------------------------------------------------------I46
+
+
+
+//--- K8055_CancelScheduled -----------------------------------
+//                                            Import Index 47
+/**
+* Cancels a pending event.
+*/
+APIRET APIENTRY K8055_CancelScheduled( ULONG *pulFileDesc,
+                                       ULONG *pulEventId   );
+// ---------------------------------------------------------I47
+
+
+
+//--- K8055_GetScheduleStats ----------------------------------
+//                                            Import Index 48
+/**
+* Pending and fired events, frames written, lateness in us.
+*/
+APIRET APIENTRY K8055_GetScheduleStats( ULONG *pulPending,
+                                        ULONG *pulFired,
+                                        ULONG *pulFrames,
+                                        ULONG *pulLateMaxUs,
+                                        ULONG *pulLateAvgUs  );
+// ---------------------------------------------------------I48
+
+
+
+//--- K8055_GroupCommit ---------------------------------------
+//                                            Import Index 49
+/**
+* Writes the outputs of 1..4 boards at the same moment,
+* returns the skew between the first and the last board.
+*/
+typedef struct _GROUPFRAME
+{
+  ULONG ulDigitalOut;
+  ULONG ulDac1;
+  ULONG ulDac2;
+} GROUPFRAME;
+
+APIRET APIENTRY K8055_GroupCommit( ULONG *pulCount,
+                                   ULONG *pulFileDescs,
+                                   GROUPFRAME *pFrames,
+                                   ULONG *pulSkewUs    );
+// ---------------------------------------------------------I49
+
+
+
+//--- K8055_GetGroupStats -------------------------------------
+//                                            Import Index 50
+/**
+* Group commits so far, skew and dispatch spread in us.
+*/
+APIRET APIENTRY K8055_GetGroupStats( ULONG *pulCommits,
+                                     ULONG *pulSkewMaxUs,
+                                     ULONG *pulSkewAvgUs,
+                                     ULONG *pulIssueMaxUs );
+// ---------------------------------------------------------I50
+
+
+
+//--- K8055_GroupSample ---------------------------------------
+//                                            Import Index 51
+/**
+* Reads the inputs of 1..4 boards at the same moment into one
+* record. Index n belongs to the n-th handle; A1/A2 and the
+* counters of board n are at 2n and 2n+1, I1..I5 at bits
+* 5n..5n+4 of 'ulDigitalIn'.
+*/
+typedef struct _GROUPSAMPLE
+{
+  ULONG ulBoards;
+  ULONG ulSequence;
+  ULONG ulTimeMs;
+  ULONG ulSkewUs;
+  ULONG ulDigitalIn;
+  ULONG aulAnalog[ 8 ];
+  ULONG aulCounter[ 8 ];
+  ULONG aulFileDesc[ 4 ];
+  ULONG aulRcRead[ 4 ];
+  ULONG aulOffsetUs[ 4 ];
+} GROUPSAMPLE;
+
+APIRET APIENTRY K8055_GroupSample( ULONG *pulCount,
+                                   ULONG *pulFileDescs,
+                                   GROUPSAMPLE *pSample );
+// ---------------------------------------------------------I51
+
+
+
+//--- K8055_SetRecovery ---------------------------------------
+//                                            Import Index 52
+/**
+* A board failing 'pulFailLimit' transfers in a row is opened
+* and initialised again in the background, the last output
+* frame is written again. 0 switches this off.
+*/
+#define PLUG_UP   0
+#define PLUG_LOST 1
+
+#define PLUG_FAILS_DEFAULT      3
+#define PLUG_FAILS_MAX          100
+#define PLUG_BACKOFF_MIN_MS     100
+#define PLUG_BACKOFF_DEFAULT_MS 5000
+#define PLUG_BACKOFF_MAX_MS     60000
+
+APIRET APIENTRY K8055_SetRecovery( ULONG *pulFileDesc,
+                                   ULONG *pulFailLimit,
+                                   ULONG *pulBackoffMaxMs );
+// ---------------------------------------------------------I52
+
+
+
+//--- K8055_GetPlugStats --------------------------------------
+//                                            Import Index 53
+/**
+* PLUG_UP or PLUG_LOST, outages, their duration in ms and
+* the reports lost.
+*/
+APIRET APIENTRY K8055_GetPlugStats( ULONG *pulFileDesc,
+                                    ULONG *pulState,
+                                    ULONG *pulOutages,
+                                    ULONG *pulOutageMs,
+                                    ULONG *pulOutageTotalMs,
+                                    ULONG *pulSamplesLost    );
+// ---------------------------------------------------------I53
+
+
+
+//--- K8055_ReadInputsTimed -----------------------------------
+//                                            Import Index 54
+/**
+* Like 'K8055_ReadAllInputs()', returns ERROR_DEADLINE after
+* 'pulTimeoutMs' (1..60000 ms). The transfer is given up then,
+* timed calls fail at once until it has returned.
+*/
+#define TIMED_TIMEOUT_MAX_MS 60000
+
+APIRET APIENTRY K8055_ReadInputsTimed( ULONG *pulFileDesc,
+                                       ULONG *pulTimeoutMs,
+                                       ULONG *pulDigitalInputsIx,
+                                       ULONG *pulAnalogInputA1,
+                                       ULONG *pulAnalogInputA2 );
+// ---------------------------------------------------------I54
+
+
+
+//--- K8055_WriteOutputsTimed ---------------------------------
+//                                            Import Index 55
+/**
+* DO, DAC1 and DAC2 with one frame, within a timeout.
+*/
+APIRET APIENTRY K8055_WriteOutputsTimed( ULONG *pulFileDesc,
+                                         ULONG *pulTimeoutMs,
+                                         ULONG *pulDigitalOut,
+                                         ULONG *pulDac1,
+                                         ULONG *pulDac2        );
+// ---------------------------------------------------------I55
+
+
+
+//--- K8055_ExchangeTimed -------------------------------------
+//                                            Import Index 56
+/**
+* Writes the outputs, reads the inputs, within one timeout.
+*/
+APIRET APIENTRY K8055_ExchangeTimed( ULONG *pulFileDesc,
+                                     ULONG *pulTimeoutMs,
+                                     ULONG *pulDigitalOut,
+                                     ULONG *pulDac1,
+                                     ULONG *pulDac2,
+                                     ULONG *pulDigitalInputsIx,
+                                     ULONG *pulAnalogInputA1,
+                                     ULONG *pulAnalogInputA2   );
+// ---------------------------------------------------------I56
+
+
+
+//--- K8055_InitTimed -----------------------------------------
+//                                            Import Index 57
+/**
+* Like 'K8055_Init()', within a timeout.
+*/
+APIRET APIENTRY K8055_InitTimed( ULONG *pulFileDesc,
+                                 ULONG *pulTimeoutMs );
+// ---------------------------------------------------------I57
+
+
+
+//--- K8055_SetRetryPolicy ------------------------------------
+//                                            Import Index 58
+/**
+* Failed EP81 reads are retried inside the library: up to
+* 'pulAttempts' transfers, pauses from 'pulBackoffUs' on,
+* doubled each time, only for the error bits in 'pulRetryOn'.
+*/
+#define RETRY_ATTEMPTS_MAX   8
+#define RETRY_BACKOFF_MAX_US 100000
+
+APIRET APIENTRY K8055_SetRetryPolicy( ULONG *pulFileDesc,
+                                      ULONG *pulAttempts,
+                                      ULONG *pulBackoffUs,
+                                      ULONG *pulRetryOn    );
+// ---------------------------------------------------------I58
+
+
+
+//--- K8055_GetRetryStats -------------------------------------
+//                                            Import Index 59
+/**
+* aulHistogram[n]: reads valid after n retries,
+* aulHistogram[RETRY_ATTEMPTS_MAX]: reads given up.
+*/
+typedef struct _RETRYSTATS
+{
+  ULONG aulHistogram[ RETRY_ATTEMPTS_MAX + 1 ];
+  ULONG ulRetriesToggle;
+  ULONG ulRetriesBytes;
+  ULONG ulRetriesCall;
+  ULONG ulWaitMaxUs;
+} RETRYSTATS;
+
+APIRET APIENTRY K8055_GetRetryStats( ULONG *pulFileDesc,
+                                     RETRYSTATS *pStats,
+                                     ULONG *pulReset     );
+// ---------------------------------------------------------I59
+
+
+
+//--- K8055_SetBreaker ----------------------------------------
+//                                            Import Index 60
+/**
+* Failed transfers in a row or a failure rate in percent of
+* the last 64 transfers open the circuit breaker, calls then
+* return ERROR_BREAKER. After the cooldown one probe read
+* decides. 'pulTripFails' 0 switches the breaker off.
+*/
+#define BREAKER_CLOSED 0
+#define BREAKER_OPEN   1
+#define BREAKER_PROBE  2
+
+#define BREAKER_FAILS_MAX       100
+#define BREAKER_COOLDOWN_MIN_MS 10
+#define BREAKER_COOLDOWN_MAX_MS 600000
+
+APIRET APIENTRY K8055_SetBreaker( ULONG *pulFileDesc,
+                                  ULONG *pulTripFails,
+                                  ULONG *pulTripPercent,
+                                  ULONG *pulCooldownMs   );
+// ---------------------------------------------------------I60
+
+
+
+//--- K8055_GetHealth -----------------------------------------
+//                                            Import Index 61
+/**
+* Health of a board, latency percentiles in us.
+*/
+typedef struct _HEALTHSTATS
+{
+  ULONG ulBreaker;
+  ULONG ulScore;
+  ULONG ulTransfers;
+  ULONG ulErrFromCall;
+  ULONG ulErrToggle;
+  ULONG ulErrBytes;
+  ULONG ulErrDeadline;
+  ULONG ulWindowErrPct;
+  ULONG ulFailRun;
+  ULONG ulToggleRun;
+  ULONG ulToggleRunMax;
+  ULONG ulLatP50Us;
+  ULONG ulLatP90Us;
+  ULONG ulLatP99Us;
+  ULONG ulLatMaxUs;
+  ULONG ulTrips;
+  ULONG ulFastFails;
+  ULONG ulProbes;
+} HEALTHSTATS;
+
+APIRET APIENTRY K8055_GetHealth( ULONG *pulFileDesc,
+                                 HEALTHSTATS *pHealthStats );
+// ---------------------------------------------------------I61
+
+
+
+//--- K8055_SetStats ------------------------------------------
+//                                            Import Index 62
+/**
+* Call statistics of all boards on (1) or off (0, default).
+*/
+APIRET APIENTRY K8055_SetStats( ULONG *pulEnable,
+                                ULONG *pulReset   );
+// ---------------------------------------------------------I62
+
+
+
+//--- K8055_GetStats ------------------------------------------
+//                                            Import Index 63
+/**
+* Statistics of one call of a board. Histogram buckets 0..7
+* hold 0..7 us, above each power of two has four buckets.
+*/
+#define STAT_OPEN       0
+#define STAT_INIT       1
+#define STAT_READ       2
+#define STAT_WRITE      3
+#define STAT_READ_ALL   4
+#define STAT_SET_ALL    5
+#define STAT_XFER_READ  6
+#define STAT_XFER_WRITE 7
+#define STAT_INIT_STEP  8     // + 0..8 for step 1..9
+#define STAT_CALLS      17
+
+#define STATS_ERROR_BITS  13
+#define STATS_LAT_BUCKETS 92
+
+typedef struct _CALLSTATS
+{
+  ULONG ulCalls;
+  ULONG ulErrors;
+  ULONG aulErrBit[ STATS_ERROR_BITS ];
+  ULONG ulLatMinUs;
+  ULONG ulLatMaxUs;
+  ULONG ulLatAvgUs;
+  ULONG ulLatP50Us;
+  ULONG ulLatP90Us;
+  ULONG ulLatP99Us;
+  ULONG aulHistogram[ STATS_LAT_BUCKETS ];
+} CALLSTATS;
+
+APIRET APIENTRY K8055_GetStats( ULONG *pulFileDesc,
+                                ULONG *pulCall,
+                                CALLSTATS *pCallStats );
+// ---------------------------------------------------------I63
+
+
+
+//--- K8055_GetTrace ------------------------------------------
+//                                            Import Index 64
+/**
+* Packet trace of the last TRACE_ENTRIES transfers of all
+* boards. Pass 0 in 'pulFromSeq' for the oldest entry, then
+* the number returned.
+*/
+#define TRACE_ENTRIES    256
+#define TRACE_PACKET_MAX 56
+
+#define TRACE_SETUP 0
+#define TRACE_DATA  1
+#define TRACE_OUT   0
+#define TRACE_IN    1
+
+typedef struct _TRACEENTRY
+{
+  ULONG ulSeq;
+  ULONG ulHandle;
+  ULONG ulRcDos;
+  ULONG ulKind;
+  ULONG ulDir;
+  ULONG ulLength;
+  ULONG ulStartUsHi;
+  ULONG ulStartUsLo;
+  ULONG ulDurationUs;
+  BYTE  byaPacket[ TRACE_PACKET_MAX ];
+} TRACEENTRY;
+
+APIRET APIENTRY K8055_GetTrace( ULONG *pulFromSeq,
+                                TRACEENTRY *pEntries,
+                                ULONG *pulCount       );
+// ---------------------------------------------------------I64
+
+
+
+//--- K8055_DumpTrace -----------------------------------------
+//                                            Import Index 65
+/**
+* Writes the packet trace to a file for 'tools\k8055trc.exe'.
+*/
+APIRET APIENTRY K8055_DumpTrace( CHAR *pszFileName );
+// ---------------------------------------------------------I65
+
+
+
+//--- K8055_SetProbes -----------------------------------------
+//                                            Import Index 66
+/**
+* Hook for the static probe points, NULL for none. It is
+* called by library threads and must return quickly.
+*
+*   Probe               ulArg1              ulArg2
+*   PROBE_XFER_SUBMIT   TRACE_SETUP/_DATA   TRACE_OUT/_IN
+*   PROBE_XFER_DONE     rc of 'DosWrite()'  duration in us
+*   PROBE_TOGGLE_MISS   attempt             0
+*   PROBE_RETRY         attempt             pause in us
+*   PROBE_INIT_STEP     step 1..9           0
+*   PROBE_INIT_STEP_END step 1..9           rc of the step
+*/
+#define PROBE_XFER_SUBMIT   0
+#define PROBE_XFER_DONE     1
+#define PROBE_TOGGLE_MISS   2
+#define PROBE_RETRY         3
+#define PROBE_INIT_STEP     4
+#define PROBE_INIT_STEP_END 5
+#define PROBE_MASK_ALL      0x3F
+
+typedef VOID ( APIENTRY *PFNK8055PROBE )( ULONG ulProbe,
+                                          ULONG ulHandle,
+                                          ULONG ulArg1,
+                                          ULONG ulArg2,
+                                          ULONG ulTimeUs,
+                                          VOID *pvUser    );
+
+APIRET APIENTRY K8055_SetProbes( PFNK8055PROBE pfnHook,
+                                 VOID *pvUser,
+                                 ULONG *pulMask         );
+// ---------------------------------------------------------I66
+
+
+
+//--- K8055_StartSpans ----------------------------------------
+//                                            Import Index 67
+/**
+* Starts the span recorder. The library writes a timeline of
+* its calls, init steps, transfers, retry pauses, Scheduler
+* ticks and Scan Engine logic to the file, in the trace
+* event format of Chrome ( 'chrome://tracing', Perfetto ).
+*/
+APIRET APIENTRY K8055_StartSpans( CHAR *pszFileName );
+// ---------------------------------------------------------I67
+
+
+
+//--- K8055_StopSpans -----------------------------------------
+//                                            Import Index 68
+/**
+* Stops the span recorder and closes its file. '*pulLost' is
+* the number of spans that did not fit into the buffer.
+*/
+APIRET APIENTRY K8055_StopSpans( ULONG *pulLost );
+// ---------------------------------------------------------I68
+
+
+
+//--- K8055_SetEmulation --------------------------------------
+//                                            Import Index 69
+/**
+* Timing of an emulated K8055, opened with the device name
+* 'EMUL0' .. 'EMUL3': latency per transfer, random jitter on
+* top and interval of the reports, all in us, 0..1000000.
+* Counter 1 counts the reports.
+*/
+APIRET APIENTRY K8055_SetEmulation( ULONG *pulFileDesc,
+                                    ULONG *pulLatencyUs,
+                                    ULONG *pulJitterUs,
+                                    ULONG *pulReportUs   );
+// ---------------------------------------------------------I69
+
+
+
+//--- K8055_MeasureLoopback -----------------------------------
+//                                            Import Index 70
+/**
+* Latency from an output to an input wired to it, in us, one
+* sample per change: DO1..DO8 with I1..I5, or LOOP_DAC1 with
+* LOOP_A1. 'paulLatencyUs' holds '*pulRepeats' ULONG, a lost
+* change is LOOP_LOST.
+*/
+#define LOOP_DAC1       9
+#define LOOP_A1         6
+#define LOOP_LOST       0xFFFFFFFF
+
+APIRET APIENTRY K8055_MeasureLoopback( ULONG *pulFileDesc,
+                                       ULONG *pulOutput,
+                                       ULONG *pulInput,
+                                       ULONG *pulRepeats,
+                                       ULONG *paulLatencyUs );
+// ---------------------------------------------------------I70
+
+
+
+//--- K8055_SetEmulationWiring --------------------------------
+//                                            Import Index 71
+/**
+* Wires outputs of an emulated K8055 to its inputs.
+*/
+#define EMUL_WIRE_NONE 0x0000
+#define EMUL_WIRE_DO   0x0001      // DO1..DO5 drive I1..I5
+#define EMUL_WIRE_DAC  0x0002      // DAC1, DAC2 drive A1, A2
+
+APIRET APIENTRY K8055_SetEmulationWiring( ULONG *pulFileDesc,
+                                          ULONG *pulWiring    );
+// ---------------------------------------------------------I71
+
+
+
+//--- K8055_SetEmulationFault ---------------------------------
+//                                            Import Index 72
+/**
+* Injects a fault into the transfers of an emulated K8055,
+* with a probability per mille within a window that may
+* repeat. An unplugged board comes back via the recovery.
+*/
+#define EMUL_FAULT_TOGGLE   0      // Toggle Bit stuck
+#define EMUL_FAULT_BYTES    1      // 7 bytes instead of 8
+#define EMUL_FAULT_XFER     2      // 'DosWrite()' fails
+#define EMUL_FAULT_DELAY    3      // Transfer 50 ms late
+#define EMUL_FAULT_UNPLUG   4      // Board pulled out
+#define EMUL_FAULTS         5
+
+#define EMUL_PER_MILLE      1000
+
+APIRET APIENTRY K8055_SetEmulationFault( ULONG *pulFileDesc,
+                                         ULONG *pulFault,
+                                         ULONG *pulPerMille,
+                                         ULONG *pulStartMs,
+                                         ULONG *pulLengthMs,
+                                         ULONG *pulPeriodMs  );
+// ---------------------------------------------------------I72
+
+
+
 #endif
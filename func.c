@@ -80,6 +80,81 @@
  *
  *
  *
+ * \version 1.0.41 -
+ * 2026-10-19 'K8055_Read()' passes on a report only with a
+ * new Toggle Bit
+ * \version 1.0.40 -
+ * 2026-10-19 'InitBoard()': the steps of 'K8055_Init()' with
+ * buffers of its own, for the Recovery Thread
+ * \version 1.0.39 -
+ * 2026-10-19 'K8055_ReadAllInputs()' releases its locks
+ * during the pause before a retry
+ * \version 1.0.38 -
+ * 2026-10-19 'K8055_SetAllOutputs()' merges 'byaPutData[]'
+ * with the frame of the board (see 'BoardLegacyMerge()')
+ * \version 1.0.37 -
+ * 2026-10-18 'K8055_Open()' and 'K8055_Close()' know the
+ * emulated K8055 (see 'emul.c')
+ * \version 1.0.36 -
+ * 2026-10-18 spans of the span recorder for 'K8055_Init()',
+ * each of its steps, the read and write calls (see 'span.c')
+ * \version 1.0.35 -
+ * 2026-10-18 probe points at the steps of 'K8055_Init()'
+ * and for reports without a new Toggle Bit (see 'probe.c')
+ * \version 1.0.34 -
+ * 2026-10-18 all transfers recorded in the packet trace
+ * (see 'trace.c'), the 'PrintArray56Byte()' test aids of
+ * 'K8055_Init()' removed
+ * \version 1.0.33 -
+ * 2026-10-18 transferring exports and the steps of
+ * 'K8055_Init()' counted by the call statistics
+ * (see 'stats.c')
+ * \version 1.0.32 -
+ * 2026-10-18 health tracking and circuit breaker in
+ * 'K8055_ReadAllInputs()' and 'K8055_SetAllOutputs()'
+ * (see 'health.c')
+ * \version 1.0.31 -
+ * 2026-10-18 'K8055_ReadAllInputs()' retried by policy
+ * (see 'retry.c')
+ * \version 1.0.30 -
+ * 2026-10-18 transfers with a timeout (see 'timed.c')
+ * \version 1.0.29 -
+ * 2026-10-18 transfer results passed to the recovery
+ * (see 'plug.c'), device name kept by 'K8055_Open()'
+ * \version 1.0.28 -
+ * 2026-10-18 group sampling over several boards
+ * (see 'group.c')
+ * \version 1.0.27 -
+ * 2026-10-18 group commit over several boards
+ * (see 'group.c')
+ * \version 1.0.26 -
+ * 2026-10-18 scheduled outputs on a timer wheel
+ * (see 'sched.c')
+ * \version 1.0.25 -
+ * 2026-10-18 output transactions (see 'txn.c')
+ * \version 1.0.24 -
+ * 2026-10-18 DO shadow with lock-free set/clear/toggle
+ * (see 'dout.c')
+ * \version 1.0.23 -
+ * 2026-10-18 DAC ramps and slew rate limits, also applied
+ * to 'K8055_SetAllOutputs()' (see 'ramp.c')
+ * \version 1.0.22 -
+ * 2026-10-18 DAC waveform generator (see 'wave.c')
+ * \version 1.0.21 -
+ * 2026-10-18 software PWM on O1..O8 by the Output Thread
+ * (see 'pwm.c', 'output.c')
+ * \version 1.0.20 -
+ * 2026-10-18 PID controllers on A1/DAC1 and A2/DAC2
+ * (see 'pid.c')
+ * \version 1.0.19 -
+ * 2026-10-18 scan engines: PLC scan cycle on absolute
+ * deadlines (see 'scan.c')
+ * \version 1.0.18 -
+ * 2026-10-18 reflex rules: outputs react to inputs within
+ * one report (see 'reflex.c')
+ * \version 1.0.17 -
+ * 2026-10-18 board slots, acquisition thread, threshold
+ * alarms on A1/A2 (see 'board.c', 'alarm.c')
  * \version 1.0.16 -
  * 2011-07-12 string output K8055_InfoStr improved
  * \version 1.0.15 -
@@ -136,6 +211,17 @@
 //     constants, error codes and function prototypes
 //
 #include "func.h"
+#include "board.h"
+#include "output.h"
+#include "ramp.h"
+#include "plug.h"
+#include "retry.h"
+#include "health.h"
+#include "stats.h"
+#include "trace.h"
+#include "probe.h"
+#include "span.h"
+#include "emul.h"
 
 
 //-----------------------------------------------------------//
@@ -222,8 +308,8 @@ ULONG cbTransfer;
 CHAR  szString1[INFO_STR_MAX_NUM][INFO_STR_CHARS_MAX] =
                     { "1 abcdefghijklmnopqrstuvwxyzABCD\0",
                       "2 Authors: B. Hennig , U. Hinz  \0",
-                      "3 Date: 2011-07-12              \0",
-                      "4 DLL-Version: 1.0.16           \0",
+                      "3 Date: 2026-10-18              \0",
+                      "4 DLL-Version: 1.0.41           \0",
                       "5 Licence: BSD                  \0",
                       "6 DLL-Name: K8055DD             \0"  };
 
@@ -264,6 +350,12 @@ CHAR  szString1[INFO_STR_MAX_NUM][INFO_STR_CHARS_MAX] =
 *
 *  0x002  ERROR_POINTER    Indicating parameter problems.
 *
+*  0x080  ERROR_RANGE      Four K8055 are open already.
+*                          The device was closed again.
+*
+*  0x100  ERROR_FROM_CALL  The API-Call 'DosOpen' returned
+*                          with error(s).
+*
 *
 */
 ULONG K8055_Open( CHAR *pcaDeviceName, ULONG *pulFileDesc )
@@ -271,6 +363,8 @@ ULONG K8055_Open( CHAR *pcaDeviceName, ULONG *pulFileDesc )
   ULONG ulrc;
   ULONG ulrcDosCall;
   ULONG ulAction;
+  ULONG ulSlot;
+  K8055TIME tmCall;
   //
   ulrc = RET_OKAY;
 
@@ -283,10 +377,18 @@ ULONG K8055_Open( CHAR *pcaDeviceName, ULONG *pulFileDesc )
     return ulrc;
   }
   //
-  ulrcDosCall = DosOpen( pcaDeviceName,
-                         pulFileDesc,
-                         &ulAction,
-                         0, 0, 1, 18, 0 );
+  tmCall = StatsStart();
+  if ( EmulName( pcaDeviceName ) == TRUE )
+  {
+    ulrcDosCall = EmulOpen( pcaDeviceName, pulFileDesc );
+  }
+  else
+  {
+    ulrcDosCall = DosOpen( pcaDeviceName,
+                           pulFileDesc,
+                           &ulAction,
+                           0, 0, 1, 18, 0 );
+  }
 
   /*
        0 NO_ERROR
@@ -311,8 +413,29 @@ ULONG K8055_Open( CHAR *pcaDeviceName, ULONG *pulFileDesc )
   if ( ulrcDosCall != 0 )
   {
     ulrc = ulrc | ERROR_FROM_CALL;
+    return ulrc;
+  }
+
+  // -- Every opened K8055 gets its Board Slot --
+  ulSlot = BoardAttach( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    if ( EmulHandle( *pulFileDesc ) == TRUE )
+    {
+      EmulClose( *pulFileDesc );
+    }
+    else
+    {
+      DosClose( *pulFileDesc );
+    }
+    ulrc = ulrc | ERROR_RANGE;
+    return ulrc;
   }
 
+  // -- The name is needed to open it again, see 'plug.c' --
+  PlugName( ulSlot, pcaDeviceName );
+  StatsEnd( ulSlot, STAT_OPEN, ulrc, tmCall );
+
   //
   // printf("\nDosOpen ulrc=%hu ulAction=%hu",ulrc,ulAction);
   return ulrc;
@@ -363,6 +486,11 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   ULONG ulrcSubFunc;
   ULONG ulInitStepIdx;
   ULONG ulArraySize;
+  ULONG ulSlot;
+  K8055TIME tmCall;
+  K8055TIME tmStep;
+  K8055TIME tmInit;
+  K8055TIME tmSpan;
   //
   ULONG index;
   BOOL blTestSwitch;
@@ -379,6 +507,15 @@ ULONG K8055_Init( ULONG *pulFileDesc )
     return ERROR_POINTER;
   }
 
+  // -- The Setup Packets are shared by all boards and the
+  //    handle may be in use by the Acquisition Thread.
+  //
+  ulSlot = BoardSlot( *pulFileDesc );
+  tmCall = StatsStart();
+  tmInit = SpanStart();
+  SharedLock();
+  BoardLockXfer( ulSlot );
+
   // -- 1st Step: Reading Device Descriptor ------------
   //             ( from K8055 to PC via EP0 )
   //
@@ -387,17 +524,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 1;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = GetDeviceDescriptor( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check --- 8+18 ----
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 18;
-              PrintArray56Byte( &byGetDevDscr[0],
-                                &ulArraySize      );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0018 ---
     if ( ! ( (byGetDevDscr[ 6 ] == 18) &&
@@ -408,6 +545,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(19);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
   //
   // -- 2nd Step: Reading Configuration Descriptor -----
@@ -418,17 +556,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 2;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = GetConfigurationDescriptor( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check --- 8+41 ----
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 41;
-              PrintArray56Byte( &byGetConfDscr[0],
-                                &ulArraySize       );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0041 ---
     if ( ! ( (byGetConfDscr[ 6 ] == 41) &&
@@ -439,6 +577,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(19);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
   //
   // -- 3rd Step: Reading Language Descriptor ----------
@@ -449,17 +588,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 3;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = GetLanguageDescriptor( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check --- 8+4 -----
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 4;
-              PrintArray56Byte( &byGetLangStrDscr[0],
-                                &ulArraySize          );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0004 ---
     if ( ! ( (byGetLangStrDscr[ 6 ] == 4) &&
@@ -470,6 +609,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(19);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
   //
   // -- 4th Step: Reading 4th String Descriptor --------
@@ -480,17 +620,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 4;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = Get4thStringDescriptor( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check --- 8+4 -----
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 4;
-              PrintArray56Byte( &byGet4thStrDscr[0],
-                                &ulArraySize         );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0004 ---
     if ( ! ( (byGet4thStrDscr[ 6 ] == 4) &&
@@ -501,6 +641,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(19);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
   //
   // -- 5th Step: Reading 2nd String Descriptor --------
@@ -511,17 +652,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 5;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = GetString2Descriptor( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check  --- 8+20 ---
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 20;
-              PrintArray56Byte( &byGetString2Dscr[0],
-                                &ulArraySize          );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0020 ---
     if ( ! ( (byGetString2Dscr[ 6 ] == 20) &&
@@ -532,6 +673,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(19);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
   //
   // -- 6th Step: Setting Configuration ----------------
@@ -544,18 +686,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 6;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = SetConfiguration( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check  --- 8+0 ----
-            //   SetConfiguration() has got no answer!
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 0;
-              PrintArray56Byte( &bySetConfigu[0],
-                                &ulArraySize      );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0000 ---
     if ( ! ( (bySetConfigu[ 6 ] == 0) &&
@@ -566,6 +707,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(30);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
   //
   // -- 7th Step: Writing an unknown Setup Packet ------
@@ -576,18 +718,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 7;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = DoUnknown21( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check  --- 8+0 ----
-            //   DoUnknown21() has got no answer!
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 1;
-              PrintArray56Byte( &by21unknown[0],
-                                &ulArraySize     );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0000 ---
     if ( ! ( (by21unknown[ 6 ] == 1) &&
@@ -598,6 +739,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(21);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
   //
   // -- 8th Step: Writing an unknown Setup Packet ------
@@ -608,17 +750,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 8;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = DoUnknown30Bytes( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check  --- 8+30 ---
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 30;
-              PrintArray56Byte( &by30unknown[0],
-                                &ulArraySize     );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // --- Number of read bytes to be checked: 0029 ---
     if ( ! ( (by30unknown[ 6 ] == 29) &&
@@ -630,6 +772,7 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     //--------
     delay(19);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
 
 
@@ -637,7 +780,9 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   //    internal initialisation processes.
   //    How long it takes in fact ? - No idea !
   //
+  tmSpan = SpanStart();
   delay(80);
+  SpanEnd( ulSlot, SPAN_INIT_WAIT, 80, tmSpan );
 
 
   // -- 9th Step: Reading data after initialisation ----
@@ -651,17 +796,17 @@ ULONG K8055_Init( ULONG *pulFileDesc )
   {
     ulInitStepIdx = 9;
 
+    PROBE( PROBE_INIT_STEP, *pulFileDesc, ulInitStepIdx, 0 );
+    tmSpan = SpanStart();
+    tmStep = StatsStart();
     ulrcSubFunc = Read_8_Bytes( *pulFileDesc );
     ulInitErrorStore[ ulInitStepIdx ] = ulrcSubFunc;
-
-            // -- Testaid ---- Answer check  --- 8+8 ---
-            blTestSwitch = FALSE;
-            if ( blTestSwitch == TRUE )
-            {
-              ulArraySize = 8 + 8;
-              PrintArray56Byte( &byaGetData[0],
-                                &ulArraySize    );
-            }
+    StatsEnd( ulSlot, STAT_INIT_STEP + ulInitStepIdx - 1,
+              ( ulrcSubFunc == NO_DOS_ERROR ) ? RET_OKAY
+                                              : ERROR_FROM_CALL,
+              tmStep );
+    PROBE( PROBE_INIT_STEP_END, *pulFileDesc, ulInitStepIdx,
+           ulrcSubFunc );
 
     // -- Number of read bytes to be checked: 0008 ---
     if ( ! ( (byaGetData[ 6 ] == 8) &&
@@ -672,8 +817,12 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
     // ------
     sleep(1);
+    SpanEnd( ulSlot, SPAN_INIT_STEP, ulInitStepIdx, tmSpan );
   }
 
+  BoardUnlockXfer( ulSlot );
+  SharedUnlock();
+
 
   // -- If one of the initalisation steps
   //    did not work, ERROR_INIT is set.
@@ -706,6 +855,8 @@ ULONG K8055_Init( ULONG *pulFileDesc )
 
   // ToDo : ERROR_FROM_CALL
 
+  StatsEnd( ulSlot, STAT_INIT, ulrc, tmCall );
+  SpanEnd( ulSlot, SPAN_INIT, ulrc, tmInit );
   return ulrc;
 }
 //----------------2-
@@ -782,6 +933,12 @@ ULONG K8055_Read( ULONG *pulFileDesc,
 {
   ULONG ulRc;
   ULONG ulRcInnerCall;
+  ULONG ulSlot;
+  BYTE  bOldToggleBit;
+  BYTE  bNewToggleBit;
+  BYTE  byNumberRead;
+  K8055TIME tmCall;
+  K8055TIME tmSpan;
   //
   ulRc = RET_OKAY;
   //
@@ -791,13 +948,38 @@ ULONG K8055_Read( ULONG *pulFileDesc,
     return ulRc;
   }
 
+  ulSlot = BoardSlot( *pulFileDesc );
+  tmCall = StatsStart();
+  tmSpan = SpanStart();
+  SharedLock();
+  BoardLockXfer( ulSlot );
+
+  bOldToggleBit = byaGetData[1] & 0x08;
   ulRcInnerCall = ReadNumberOfBytes( *pulFileDesc,
                                      byNumberOfBytes,
                                      pbyaData         );
+  bNewToggleBit = byaGetData[1] & 0x08;
+  byNumberRead = byaGetData[6];
+
+  BoardUnlockXfer( ulSlot );
+  SharedUnlock();
+
+  // -- A complete, new report is passed on to alarms etc.,
+  //    like by 'K8055_ReadAllInputs()' --
+  if ( ( ulRcInnerCall == NO_DOS_ERROR ) &&
+       ( byNumberOfBytes == SIZEBUFFERMAX ) &&
+       ( byNumberRead == SIZEBUFFERMAX ) &&
+       ( bOldToggleBit != bNewToggleBit ) &&
+       ( ulSlot != BOARD_NONE ) )
+  {
+    BoardReportIn( ulSlot, pbyaData, TimeNowUs() );
+  }
 
   if ( ulRcInnerCall == ERROR_BUFFER )
   {
     ulRc = ulRcInnerCall;
+    StatsEnd( ulSlot, STAT_READ, ulRc, tmCall );
+    SpanEnd( ulSlot, SPAN_READ, ulRc, tmSpan );
     return ulRc;
   }
 
@@ -807,6 +989,8 @@ ULONG K8055_Read( ULONG *pulFileDesc,
     ulRc = ulRc | ERROR_FROM_CALL;
   }
 
+  StatsEnd( ulSlot, STAT_READ, ulRc, tmCall );
+  SpanEnd( ulSlot, SPAN_READ, ulRc, tmSpan );
   return ulRc;
 }
 //----------3-
@@ -873,6 +1057,9 @@ ULONG K8055_Write( ULONG *pulFileDesc,
 {
   ULONG ulRc;
   ULONG ulRcInnerCall;
+  ULONG ulSlot;
+  K8055TIME tmCall;
+  K8055TIME tmSpan;
   //
   ulRc = RET_OKAY;
   //
@@ -882,13 +1069,33 @@ ULONG K8055_Write( ULONG *pulFileDesc,
     return ulRc;
   }
 
+  ulSlot = BoardSlot( *pulFileDesc );
+  tmCall = StatsStart();
+  tmSpan = SpanStart();
+  SharedLock();
+  BoardLockXfer( ulSlot );
+
   ulRcInnerCall = WriteNumberOfBytes( *pulFileDesc,
                                       byNumberOfBytes,
                                       pbyaPutData      );
 
+  // -- A full output frame (command 0x05) was sent --
+  if ( ( ulRcInnerCall == 0 ) &&
+       ( byNumberOfBytes == SIZEBUFFERMAX ) &&
+       ( pbyaPutData[0] == 0x05 ) &&
+       ( ulSlot != BOARD_NONE ) )
+  {
+    BoardOutputSent( ulSlot, pbyaPutData );
+  }
+
+  BoardUnlockXfer( ulSlot );
+  SharedUnlock();
+
   if ( ulRcInnerCall == ERROR_BUFFER )
   {
     ulRc = ulRcInnerCall;
+    StatsEnd( ulSlot, STAT_WRITE, ulRc, tmCall );
+    SpanEnd( ulSlot, SPAN_WRITE, ulRc, tmSpan );
     return ulRc;
   }
 
@@ -898,6 +1105,8 @@ ULONG K8055_Write( ULONG *pulFileDesc,
     ulRc = ulRc | ERROR_FROM_CALL;
   }
 
+  StatsEnd( ulSlot, STAT_WRITE, ulRc, tmCall );
+  SpanEnd( ulSlot, SPAN_WRITE, ulRc, tmSpan );
   return ulRc;
 }
 //----------4-
@@ -946,7 +1155,17 @@ ULONG K8055_Close( ULONG *pulFileDesc )
     return ulrc;
   }
 
-  ulrcDosCall = DosClose( *pulFileDesc );
+  // -- Threads working on that K8055 are stopped --
+  BoardDetach( *pulFileDesc );
+
+  if ( EmulHandle( *pulFileDesc ) == TRUE )
+  {
+    ulrcDosCall = EmulClose( *pulFileDesc );
+  }
+  else
+  {
+    ulrcDosCall = DosClose( *pulFileDesc );
+  }
 
   /* 'ulrcDosCall' can have the values listed here:
 
@@ -1119,10 +1338,18 @@ ULONG K8055_ReadAllInputs( ULONG *pulFileDesc,
 
   ULONG ulRc;
   ULONG ulRcDOScall;
+  ULONG ulSlot;
+  ULONG ulAttempts;
+  BOOL  blValid;
   BYTE  bOldToggleBit;
   BYTE  bNewToggleBit;
+  BYTE  byaReport[ SIZEBUFFERMAX ];
+  K8055TIME tmStart;
+  K8055TIME tmCall;
+  K8055TIME tmSpan;
   //
   ulRc = RET_OKAY;
+  blValid = FALSE;
   //
   if (
        ( NULL == pulFileDesc ) ||
@@ -1135,81 +1362,129 @@ ULONG K8055_ReadAllInputs( ULONG *pulFileDesc,
     return ulRc;
   }
 
-
-  bOldToggleBit = byaGetData[1] & 0x08;
-
-  ulRcDOScall = DosWrite( *pulFileDesc,
-                          &byaGetData[0],
-                          16,
-                          &cbTransfer     );
-
-       /*
-              0 NO_ERROR
-              5 ERROR_ACCESS_DENIED
-              6 ERROR_INVALID_HANDLE
-             19 ERROR_WRITE_PROTECT
-             26 ERROR_NOT_DOS_DISK
-             29 ERROR_WRITE_FAULT
-             33 ERROR_LOCK_VIOLATION
-            109 ERROR_BROKEN_PIPE
-
-            0d  0000 0000 0000 0000b  NO_ERROR
-            5d  0000 0000 0000 0101b  ERROR_ACCESS_DENIED
-            6d  0000 0000 0000 0101b  ERROR_INVALID_HANDLE
-           19d  0000 0000 0001 0011b  ERROR_WRITE_PROTECT
-           26d  0000 0000 0001 1010b  ERROR_NOT_DOS_DISK
-           29d  0000 0000 0001 1101b  ERROR_WRITE_FAULT
-           33d  0000 0000 0010 0001b  ERROR_LOCK_VIOLATION
-          109d  0000 0000 0110 1101b  ERROR_BROKEN_PIPE
-       */
-
-  bNewToggleBit = byaGetData[1] & 0x08;
-
-  // -- Error code if DosWrite() did not work properly --
-  //
-  //   ToDo : error code ulRcDOScall to be ored !
+  // -- 'byaGetData[]' is shared by all boards and the
+  //    handle may be in use by the Acquisition Thread.
   //
-  if ( ulRcDOScall != NO_DOS_ERROR )
+  ulSlot = BoardSlot( *pulFileDesc );
+  tmCall = StatsStart();
+  tmSpan = SpanStart();
+
+  // -- An open circuit breaker refuses the call --
+  ulRc = HealthGate( ulSlot );
+  if ( ulRc != RET_OKAY )
   {
-    // -- YesBranch: A problem with 'DosWrite()' --
-    //    Results are not valid !
-    // ToDo : Last Error Code to be stored !
+    StatsEnd( ulSlot, STAT_READ_ALL, ulRc, tmCall );
+    SpanEnd( ulSlot, SPAN_READ_ALL, ulRc, tmSpan );
+    return ulRc;
+  }
 
-    ulRc = ulRc | ERROR_FROM_CALL;
+  SharedLock();
+  BoardLockXfer( ulSlot );
+
+  // -- Failed transfers may be retried, see 'retry.c' --
+  tmStart = TimeNowUs();
+  ulAttempts = 0;
+  do
+  {
+    ulRc = RET_OKAY;
+    blValid = FALSE;
+    ++ulAttempts;
+
+    bOldToggleBit = byaGetData[1] & 0x08;
+
+    ulRcDOScall = TraceDosWrite( *pulFileDesc,
+                                 &byaGetData[0],
+                                 16,
+                                 &cbTransfer     );
+
+         /*
+                0 NO_ERROR
+                5 ERROR_ACCESS_DENIED
+                6 ERROR_INVALID_HANDLE
+               19 ERROR_WRITE_PROTECT
+               26 ERROR_NOT_DOS_DISK
+               29 ERROR_WRITE_FAULT
+               33 ERROR_LOCK_VIOLATION
+              109 ERROR_BROKEN_PIPE
+
+              0d  0000 0000 0000 0000b  NO_ERROR
+              5d  0000 0000 0000 0101b  ERROR_ACCESS_DENIED
+              6d  0000 0000 0000 0101b  ERROR_INVALID_HANDLE
+             19d  0000 0000 0001 0011b  ERROR_WRITE_PROTECT
+             26d  0000 0000 0001 1010b  ERROR_NOT_DOS_DISK
+             29d  0000 0000 0001 1101b  ERROR_WRITE_FAULT
+             33d  0000 0000 0010 0001b  ERROR_LOCK_VIOLATION
+            109d  0000 0000 0110 1101b  ERROR_BROKEN_PIPE
+         */
+
+    bNewToggleBit = byaGetData[1] & 0x08;
+
+    // -- Error code if DosWrite() did not work properly --
+    //
+    //   ToDo : error code ulRcDOScall to be ored !
+    //
+    if ( ulRcDOScall != NO_DOS_ERROR )
+    {
+      // -- YesBranch: A problem with 'DosWrite()' --
+      //    Results are not valid !
+      // ToDo : Last Error Code to be stored !
 
-    // ToDo : Error code from the DOS call has to be
-    //        merged with the error codes of the
-    //        project.
+      ulRc = ulRc | ERROR_FROM_CALL;
 
-  }
-  else
-  {
-    // -- NoBranch: No problem with 'DosWrite()' --
-    //    Results are valid, can be used !
+      // ToDo : Error code from the DOS call has to be
+      //        merged with the error codes of the
+      //        project.
 
-    if ( bOldToggleBit != bNewToggleBit )
-    {
-      // -- Toggle-Bit has changed. -------------
-      //    Results are valid, could be used !
-      *pulDigitalInputsIx = byaGetData[8];
-      *pulAnalogInputA1 = byaGetData[10];
-      *pulAnalogInputA2 = byaGetData[11];
     }
     else
     {
-      ulRc = ulRc | ERROR_TOGGLE_BIT;
+      // -- NoBranch: No problem with 'DosWrite()' --
+      //    Results are valid, can be used !
+
+      if ( bOldToggleBit != bNewToggleBit )
+      {
+        // -- Toggle-Bit has changed. -------------
+        //    Results are valid, could be used !
+        *pulDigitalInputsIx = byaGetData[8];
+        *pulAnalogInputA1 = byaGetData[10];
+        *pulAnalogInputA2 = byaGetData[11];
+
+        memcpy( &byaReport[0], &byaGetData[8], SIZEBUFFERMAX );
+        blValid = TRUE;
+      }
+      else
+      {
+        ulRc = ulRc | ERROR_TOGGLE_BIT;
+        PROBE( PROBE_TOGGLE_MISS, *pulFileDesc, ulAttempts, 0 );
+      }
     }
-  }
 
 
-  // -- 'DosWrite()' was OK, but the number
-  //    of read bytes may have been incorrect.
-  //    This is the test for such a situation.
-  if ( byaGetData[6] != 0x08 )
+    // -- 'DosWrite()' was OK, but the number
+    //    of read bytes may have been incorrect.
+    //    This is the test for such a situation.
+    if ( byaGetData[6] != 0x08 )
+    {
+      ulRc = ulRc | ERROR_BYTE_NUMBER;
+      blValid = FALSE;
+    }
+  } while ( RetryAgain( ulSlot, ulAttempts, ulRc, TRUE ) == TRUE );
+
+  BoardUnlockXfer( ulSlot );
+  SharedUnlock();
+
+  // -- Failures in a row start the recovery --
+  PlugResult( ulSlot, ulRc, TRUE );
+  HealthResult( ulSlot, ulRc, TimeNowUs() - tmStart );
+
+  // -- A valid report is passed on to alarms etc. --
+  if ( ( blValid == TRUE ) && ( ulSlot != BOARD_NONE ) )
   {
-    ulRc = ulRc | ERROR_BYTE_NUMBER;
+    BoardReportIn( ulSlot, &byaReport[0], TimeNowUs() );
   }
 
+  StatsEnd( ulSlot, STAT_READ_ALL, ulRc, tmCall );
+  SpanEnd( ulSlot, SPAN_READ_ALL, ulRc, tmSpan );
   return ulRc;
 }
 //------------8-
@@ -1515,7 +1790,13 @@ ULONG K8055_SetAllOutputs( ULONG *pulFileDesc )
 
   ULONG ulRc;
   ULONG ulRcDOScall;
+  ULONG ulSlot;
   BOOL blTestAid;
+  BOOL blRamp;
+  BYTE byaFrame[ SIZEPUTBYTES ];
+  K8055TIME tmLatency;
+  K8055TIME tmCall;
+  K8055TIME tmSpan;
   //
   ulRc = RET_OKAY;
 
@@ -1548,10 +1829,60 @@ ULONG K8055_SetAllOutputs( ULONG *pulFileDesc )
     //empty
   }
 
-  ulRcDOScall = DosWrite( *pulFileDesc,
-                          &byaPutData[0],
-                          16,
-                          &cbTransfer     );
+  ulSlot = BoardSlot( *pulFileDesc );
+  tmCall = StatsStart();
+  tmSpan = SpanStart();
+
+  // -- An open circuit breaker refuses the call --
+  ulRc = HealthGate( ulSlot );
+  if ( ulRc != RET_OKAY )
+  {
+    StatsEnd( ulSlot, STAT_SET_ALL, ulRc, tmCall );
+    SpanEnd( ulSlot, SPAN_SET_ALL, ulRc, tmSpan );
+    return ulRc;
+  }
+
+  SharedLock();
+  BoardLockXfer( ulSlot );
+
+  // -- Merging and DAC slew rate limits work on a copy,
+  //    'byaPutData[]' keeps the values the application
+  //    asked for --
+  memcpy( &byaFrame[0], &byaPutData[0], SIZEPUTBYTES );
+  blRamp = FALSE;
+  if ( ulSlot != BOARD_NONE )
+  {
+    BoardLegacyMerge( ulSlot, &byaFrame[8] );
+    blRamp = RampFilterFrame( ulSlot, &byaFrame[8] );
+  }
+
+  tmLatency = TimeNowUs();
+  ulRcDOScall = TraceDosWrite( *pulFileDesc,
+                               &byaFrame[0],
+                               16,
+                               &cbTransfer     );
+  tmLatency = TimeNowUs() - tmLatency;
+
+  if ( ( ulRcDOScall == 0 ) && ( ulSlot != BOARD_NONE ) )
+  {
+    BoardOutputSent( ulSlot, &byaFrame[8] );
+    BoardLegacySent( ulSlot, &byaPutData[8] );
+  }
+
+  BoardUnlockXfer( ulSlot );
+  SharedUnlock();
+
+  PlugResult( ulSlot,
+              ( ulRcDOScall == 0 ) ? RET_OKAY : ERROR_FROM_CALL,
+              FALSE );
+  HealthResult( ulSlot,
+                ( ulRcDOScall == 0 ) ? RET_OKAY : ERROR_FROM_CALL,
+                tmLatency );
+
+  if ( blRamp == TRUE )
+  {
+    ulRc = ulRc | RampDemand( ulSlot );
+  }
 
   // -- In case DosWrite() did not work properly -----
   //
@@ -1562,6 +1893,8 @@ ULONG K8055_SetAllOutputs( ULONG *pulFileDesc )
     ulRc = ulRc | ERROR_FROM_CALL;
   }
 
+  StatsEnd( ulSlot, STAT_SET_ALL, ulRc, tmCall );
+  SpanEnd( ulSlot, SPAN_SET_ALL, ulRc, tmSpan );
   return ulRc;
 }
 //---------11-
@@ -2245,10 +2578,10 @@ ULONG GetDeviceDescriptor( ULONG devpointer )
   //                                 |
   //             bDescriptorType ----+
   //
-  ulRcGetDevDrc = DosWrite( devpointer,
-                            &byGetDevDscr[0],
-                            ( SIZEUSBHEADER + 18 ),
-                            &cbTransfer             );
+  ulRcGetDevDrc = TraceDosWrite( devpointer,
+                                 &byGetDevDscr[0],
+                                 ( SIZEUSBHEADER + 18 ),
+                                 &cbTransfer             );
   //
   return  ulRcGetDevDrc;
 }
@@ -2295,10 +2628,10 @@ ULONG GetConfigurationDescriptor( ULONG devpointer )
   //                                  |
   //              bDescriptorType ----+
   //
-  ulRcGetConfDrc = DosWrite( devpointer,
-                             &byGetConfDscr[0],
-                             ( SIZEUSBHEADER + 48 ),
-                             &cbTransfer             );
+  ulRcGetConfDrc = TraceDosWrite( devpointer,
+                                  &byGetConfDscr[0],
+                                  ( SIZEUSBHEADER + 48 ),
+                                  &cbTransfer             );
 
   return  ulRcGetConfDrc;
 }
@@ -2346,10 +2679,10 @@ ULONG GetLanguageDescriptor( ULONG devpointer )
   //                                    |
   //                bDescriptorType ----+
   //
-  ulRcGetLangDrc = DosWrite( devpointer,
-                             &byGetLangStrDscr[0],
-                             ( SIZEUSBHEADER + 4 ),
-                             &cbTransfer            );
+  ulRcGetLangDrc = TraceDosWrite( devpointer,
+                                  &byGetLangStrDscr[0],
+                                  ( SIZEUSBHEADER + 4 ),
+                                  &cbTransfer            );
 
   return  ulRcGetLangDrc;
 }
@@ -2393,10 +2726,10 @@ ULONG Get4thStringDescriptor( ULONG devpointer )
   // --- Setup Paket for the Configuration Descriptor -------
   // byGet4thStrDscr[8+4] = { 0x80,6,4,3,0,0, 4,0 };
   //
-  ulRcGet4thStrDrc = DosWrite( devpointer,
-                               &byGet4thStrDscr[0],
-                               ( SIZEUSBHEADER + 4 ),
-                               &cbTransfer            );
+  ulRcGet4thStrDrc = TraceDosWrite( devpointer,
+                                    &byGet4thStrDscr[0],
+                                    ( SIZEUSBHEADER + 4 ),
+                                    &cbTransfer            );
 
   return  ulRcGet4thStrDrc;
 }
@@ -2435,10 +2768,10 @@ ULONG GetString2Descriptor( ULONG devpointer )
   // --- Setup Paket for the Configuration Descriptor -------
   // byGetString2Dscr[8+20] = { 0x80,6,2,3,9,4, 20,0 };
   //
-  ulRcGetStr2Drc = DosWrite( devpointer,
-                             &byGetString2Dscr[0],
-                             ( SIZEUSBHEADER + 20 ),
-                             &cbTransfer             );
+  ulRcGetStr2Drc = TraceDosWrite( devpointer,
+                                  &byGetString2Dscr[0],
+                                  ( SIZEUSBHEADER + 20 ),
+                                  &cbTransfer             );
 
   return  ulRcGetStr2Drc;
 }
@@ -2476,10 +2809,10 @@ ULONG SetConfiguration( ULONG devpointer )
   // --- Setup Paket for Setting Configuration Number 1 -----
   // bySetConfigu[8+0] = { 0x00,9,1,0,0,0, 0,0 };
   //
-  ulRcSetConf = DosWrite( devpointer,
-                          &bySetConfigu[0],
-                          ( SIZEUSBHEADER + 0 ),
-                          &cbTransfer            );
+  ulRcSetConf = TraceDosWrite( devpointer,
+                               &bySetConfigu[0],
+                               ( SIZEUSBHEADER + 0 ),
+                               &cbTransfer            );
 
   return  ulRcSetConf;
 }
@@ -2518,10 +2851,10 @@ ULONG DoUnknown21( ULONG devpointer )
   // --- Setup Paket for Setting Configuration Number 1 -----
   // by21unknown[8+1] = {0x21,0x0a,0,0,0,0, 1,0};
   //
-  ulRcDoUn21 = DosWrite( devpointer,
-                         &by21unknown[0],
-                         ( SIZEUSBHEADER + 1 ),
-                         &cbTransfer            );
+  ulRcDoUn21 = TraceDosWrite( devpointer,
+                              &by21unknown[0],
+                              ( SIZEUSBHEADER + 1 ),
+                              &cbTransfer            );
 
   return  ulRcDoUn21;
 }
@@ -2560,16 +2893,117 @@ ULONG DoUnknown30Bytes( ULONG devpointer )
   // --- Setup Paket for Setting Configuration Number 1 ----
   // by30unknown[8+30] = { 0x81,6,0,0x22,0,0, 30,0 };
   //
-  ulRcDoUn30 = DosWrite( devpointer,
-                         &by30unknown[0],
-                         ( SIZEUSBHEADER + 30 ),
-                         &cbTransfer             );
+  ulRcDoUn30 = TraceDosWrite( devpointer,
+                              &by30unknown[0],
+                              ( SIZEUSBHEADER + 30 ),
+                              &cbTransfer             );
 
   return  ulRcDoUn30;
 }
 //-------------------
 
 
+//-------------------------------------------------------------
+//
+//  Setup Pakets of 'InitBoard()', copied before every use
+//
+typedef struct _INITSTEP
+{
+  BYTE  byaHeader[ SIZEUSBHEADER ];   // Setup Packet
+  ULONG ulData;                       // Bytes behind it
+  BYTE  byAnswer;                     // Bytes to be read
+  ULONG ulDelayMs;                    // Pause after the step
+} INITSTEP;
+
+static INITSTEP aInitStep[] =
+{
+  { { 0x80,6,0,1,0,0, 18,0 }, 18, 18, 19 },   // 1st Step
+  { { 0x80,6,0,2,0,0, 48,0 }, 48, 41, 19 },   // 2nd Step
+  { { 0x80,6,0,3,0,0,  4,0 },  4,  4, 19 },   // 3rd Step
+  { { 0x80,6,4,3,0,0,  4,0 },  4,  4, 19 },   // 4th Step
+  { { 0x80,6,2,3,9,4, 20,0 }, 20, 20, 19 },   // 5th Step
+  { { 0x00,9,1,0,0,0,  0,0 },  0,  0, 30 },   // 6th Step
+  { { 0x81,6,0,0x22,0,0, 30,0 }, 30, 29, 19 } // 8th Step
+};
+
+
+//-------------------------------------------------------------
+//
+//  Init of a lost K8055, used by the Recovery Thread
+//
+/**
+*
+* \brief    Does the steps of 'K8055_Init()' again, with
+*           Setup Packets and a report buffer of its own. The
+*           caller owns 'BoardLockXfer()' of the board. The
+*           shared arrays above are not used, so the shared
+*           lock is not taken and the other boards are not
+*           held up by the pauses. Step 7 is left out, like in
+*           'K8055_Init()'.
+*
+* \param    'ulDevpointer'
+*           - Handle of the K8055.
+*
+* \return   RET_OKAY, ERROR_FROM_CALL if a transfer failed,
+*           ERROR_INIT if bytes were missing
+*/
+ULONG InitBoard( ULONG ulDevpointer )
+{
+  ULONG ulRc;
+  ULONG ulStep;
+  ULONG cbDone;
+  BYTE  byaSetup[ SIZEUSBHEADER + 48 ];
+  BYTE  byaReport[ SIZEGETBYTES ] =
+                                { 0xEC,0x10,0,0,0x81,3, 8,0 ,
+                                   0, 0, 0, 0, 0, 0, 0, 0    };
+
+  ulRc = RET_OKAY;
+
+  for ( ulStep = 0;
+        ulStep < sizeof( aInitStep ) / sizeof( aInitStep[0] );
+        ulStep++ )
+  {
+    memset( &byaSetup[0], 0, sizeof( byaSetup ) );
+    memcpy( &byaSetup[0], &aInitStep[ ulStep ].byaHeader[0],
+            SIZEUSBHEADER );
+    if ( TraceDosWrite( ulDevpointer,
+                        &byaSetup[0],
+                        SIZEUSBHEADER + aInitStep[ ulStep ].ulData,
+                        &cbDone ) != NO_DOS_ERROR )
+    {
+      return ERROR_FROM_CALL;
+    }
+    if ( ! ( ( byaSetup[ 6 ] == aInitStep[ ulStep ].byAnswer ) &&
+             ( byaSetup[ 7 ] == 0 ) ) )
+    {
+      ulRc = ulRc | ERROR_INIT;
+    }
+    delay( aInitStep[ ulStep ].ulDelayMs );
+  }
+
+  // -- Extra time for the K8055, like 'K8055_Init()' --
+  delay(80);
+
+  // -- 9th Step: Reading data after initialisation --
+  if ( TraceDosWrite( ulDevpointer,
+                      &byaReport[0],
+                      SIZEGETBYTES,
+                      &cbDone ) != NO_DOS_ERROR )
+  {
+    return ERROR_FROM_CALL;
+  }
+  if ( ! ( ( byaReport[ 6 ] == 8 ) &&
+           ( byaReport[ 7 ] == 0 ) ) )
+  {
+    ulRc = ulRc | ERROR_INIT;
+  }
+  sleep(1);
+
+  return ulRc;
+}
+//-------------------
+
+
 //-------Subfunctions of K8055_Init---------------------End----
 
 
@@ -2657,10 +3091,10 @@ ULONG Read_8_Bytes(ULONG devpointer)
   //
   // byaGetData[8+8] = { 0xEC,0x10,0,0,0x81,3, 8,0 };
   //
-  ulRcR8B = DosWrite( devpointer,
-                      &byaGetData[0],
-                      SIZEGETBYTES,
-                      &cbTransfer     );
+  ulRcR8B = TraceDosWrite( devpointer,
+                           &byaGetData[0],
+                           SIZEGETBYTES,
+                           &cbTransfer     );
 
   return  ulRcR8B;
 }
@@ -2696,10 +3130,10 @@ ULONG ReadNumberOfBytes
     return ERROR_BUFFER;
   }
   //
-  ulRet = DosWrite( ulDevpointer,
-                    &byaGetData[0],
-                    ( SIZEUSBHEADER + byNumbers),
-                    &cbTransfer                   );
+  ulRet = TraceDosWrite( ulDevpointer,
+                         &byaGetData[0],
+                         ( SIZEUSBHEADER + byNumbers),
+                         &cbTransfer                   );
        /*
              0 NO_ERROR
              5 ERROR_ACCESS_DENIED
@@ -2779,11 +3213,11 @@ ULONG WriteNumberOfBytes
   //
   // now write the data
   //
-  ulRetval = DosWrite( ulDevpointer,
-                       //&byaTheData[0],
-                       &byaPutData[0],
-                       ( SIZEUSBHEADER + byToWrite ),
-                       &cbTransfer                    );
+  ulRetval = TraceDosWrite( ulDevpointer,
+                            //&byaTheData[0],
+                            &byaPutData[0],
+                            ( SIZEUSBHEADER + byToWrite ),
+                            &cbTransfer                    );
        /*
              0 NO_ERROR
              5 ERROR_ACCESS_DENIED
@@ -2817,37 +3251,6 @@ ULONG WriteNumberOfBytes
 // -----
 
 
-//-------------------------------------------------------------
-//
-// Debugging Tool, used to probe (display) BYTE typed
-// variables.
-// Restricted for byte arrays not larger than 56 bytes.
-//
-VOID PrintArray56Byte( BYTE *pbyTheByteArray,
-                       ULONG *pulSizeOfByteArray )
-{
-  ULONG index;
-  ULONG indexMax;
-  BYTE byTheByte;
-
-  indexMax = *pulSizeOfByteArray;
-
-  if ( indexMax > 8 + 48  )
-  {
-    indexMax = 8 + 48;
-  }
-
-  printf( "\n" );
-  for ( index = 0; index < indexMax; index++ )
-  {
-    byTheByte = *( pbyTheByteArray + index );
-    printf( " %02X", byTheByte );
-  }
-
-}
-// -----
-
-
 //-------------------------------------------------------------
 //
 // Debugging Tool, used to probe (display) ULONG typed
@@ -10,19 +10,145 @@
  * (see: Error values),
  * USB buffer sizes (see: Values concerning buffers), constants
  * special for a certain functions (see: Values belonging to a
- * function) and function prototypes. Sixteen of them belong
+ * function) and function prototypes. Most of them belong
  * to exported functions (see: Functions that are exported).
  * They are arranged in the same order as listed in the modul
  * definition file 'k8055.def'. All remaining function
  * prototypes (see: Functions that are not exported) are
  * subfunctions or helping items.
  *
- * Three basic files are needed for the project:
+ * Export Index 1..16 are implemented in 'func.c'. Later
+ * exports live in the module they belong to, i.e. 'board.c',
+ * 'alarm.c', 'reflex.c', 'scan.c', 'pid.c', 'pwm.c',
+ * 'output.c', 'wave.c', 'ramp.c', 'dout.c', 'txn.c',
+ * 'sched.c', 'group.c', 'plug.c', 'timed.c', 'retry.c',
+ * 'health.c', 'stats.c', 'trace.c', 'probe.c', 'span.c',
+ * 'emul.c' or 'loop.c'.
+ * Each module has got a headerfile of its own
+ * for internal types and helpers.
+ *
+ * Basic files needed for the project:
  *   For the compiler 'func.c' and
- *                    'func.h' (this file).
+ *                    'func.h' (this file),
+ *                    'board.c', 'board.h',
+ *                    'alarm.c', 'alarm.h',
+ *                    'reflex.c', 'reflex.h', 'atomic.h',
+ *                    'scan.c', 'scan.h',
+ *                    'pid.c', 'pid.h',
+ *                    'output.c', 'output.h',
+ *                    'pwm.c', 'pwm.h',
+ *                    'wave.c', 'wave.h',
+ *                    'ramp.c', 'ramp.h',
+ *                    'dout.c', 'dout.h',
+ *                    'txn.c', 'txn.h',
+ *                    'sched.c', 'sched.h',
+ *                    'group.c', 'group.h',
+ *                    'plug.c', 'plug.h',
+ *                    'timed.c', 'timed.h',
+ *                    'retry.c', 'retry.h',
+ *                    'health.c', 'health.h',
+ *                    'stats.c', 'stats.h',
+ *                    'trace.c', 'trace.h',
+ *                    'probe.c', 'probe.h',
+ *                    'span.c', 'span.h',
+ *                    'emul.c', 'emul.h',
+ *                    'loop.c', 'loop.h'.
  *   For the linker   'k8055.def'
  *
  *
+ * \version 1.0.51 -
+ * 2026-10-19 'K8055_GetWaveStats()' tells the requested
+ * frequency of the channel
+ * \version 1.0.50 -
+ * 2026-10-19 'K8055_SetPid()' checks the gains
+ * \version 1.0.49 -
+ * 2026-10-19 the slew rate limit holds for all frames of the
+ * library
+ * \version 1.0.48 -
+ * 2026-10-19 the waits of an emulated K8055 block
+ * \version 1.0.47 -
+ * 2026-10-19 ERROR_TOGGLE_BIT does not make a K8055 count as
+ * lost
+ * \version 1.0.46 -
+ * 2026-10-19 'InitBoard()'
+ * \version 1.0.45 -
+ * 2026-10-19 'K8055_StopScan()' and 'K8055_Close()' may stop
+ * the same engine at the same time
+ * \version 1.0.44 -
+ * 2026-10-19 'K8055_SetProbes()' waits for running hook calls
+ * \version 1.0.43 -
+ * 2026-10-19 no locks held during the pause before a retry
+ * \version 1.0.42 -
+ * 2026-10-19 timed writes no longer write 'byaPutData[]'
+ * \version 1.0.41 -
+ * 2026-10-19 scheduled events no longer write 'byaPutData[]'
+ * \version 1.0.40 -
+ * 2026-10-19 'K8055_TxCommit()' no longer writes
+ * 'byaPutData[]'
+ * \version 1.0.39 -
+ * 2026-10-19 the DO shadow no longer writes 'byaPutData[]'
+ * \version 1.0.38 -
+ * 2026-10-19 'K8055_RampDac()' no longer writes
+ * 'byaPutData[]'
+ * \version 1.0.37 -
+ * 2026-10-19 'K8055_SetAllOutputs()' keeps outputs changed
+ * by the library, reflex rules no longer write
+ * 'byaPutData[]'
+ * \version 1.0.36 -
+ * 2026-10-19 export 72: faults injected into the emulated
+ * K8055
+ * \version 1.0.35 -
+ * 2026-10-19 exports 70..71: loopback latency, wiring of the
+ * emulated K8055
+ * \version 1.0.34 -
+ * 2026-10-18 export 69: emulated K8055
+ * \version 1.0.33 -
+ * 2026-10-18 exports 67..68: span recorder, Chrome trace
+ * \version 1.0.32 -
+ * 2026-10-18 export 66: static probe points
+ * \version 1.0.31 -
+ * 2026-10-18 exports 64..65: packet trace
+ * \version 1.0.30 -
+ * 2026-10-18 exports 62..63: call statistics and latency
+ * histograms
+ * \version 1.0.29 -
+ * 2026-10-18 exports 60..61: health tracking and circuit
+ * breaker, ERROR_BREAKER
+ * \version 1.0.28 -
+ * 2026-10-18 exports 58..59: retry policy for EP81 reads
+ * \version 1.0.27 -
+ * 2026-10-18 exports 54..57: transfers with a timeout,
+ * ERROR_DEADLINE
+ * \version 1.0.26 -
+ * 2026-10-18 exports 52..53: recovery of unplugged boards
+ * \version 1.0.25 -
+ * 2026-10-18 export 51: group sampling
+ * \version 1.0.24 -
+ * 2026-10-18 exports 49..50: group commit over several
+ * boards
+ * \version 1.0.23 -
+ * 2026-10-18 exports 45..48: timer wheel for scheduled
+ * outputs
+ * \version 1.0.22 -
+ * 2026-10-18 exports 43..44: output transactions,
+ * ERROR_CONFLICT
+ * \version 1.0.21 -
+ * 2026-10-18 exports 40..42: lock-free DO set/clear/toggle
+ * \version 1.0.20 -
+ * 2026-10-18 exports 37..39: DAC ramps and slew rate limits
+ * \version 1.0.19 -
+ * 2026-10-18 exports 32..36: DAC waveform generator
+ * \version 1.0.18 -
+ * 2026-10-18 exports 29..31: software PWM, Output Thread
+ * \version 1.0.17 -
+ * 2026-10-18 exports 27..28: PID controllers
+ * \version 1.0.16 -
+ * 2026-10-18 exports 24..26: scan engines
+ * \version 1.0.15 -
+ * 2026-10-18 exports 22..23: reflex rules
+ * \version 1.0.14 -
+ * 2026-10-18 exports 17..21: acquisition thread and
+ * threshold alarms
  * \version 1.0.13 -
  * 2010-10-09 constants renamed, commenting
  * \version 1.0.12 -
@@ -187,6 +313,30 @@
 *
 */
 #define ERROR_TESTERROR   0x200
+
+
+/**
+* \brief An output transaction was not committed, because
+* the outputs changed since it began (see 'K8055_TxCommit()').
+*
+*/
+#define ERROR_CONFLICT   0x400
+
+
+/**
+* \brief A call with a timeout did not finish in time
+* (see 'K8055_ReadInputsTimed()'). Its transfer was given up.
+*
+*/
+#define ERROR_DEADLINE   0x800
+
+
+/**
+* \brief The circuit breaker of the board is open, the call
+* was refused without a transfer (see 'K8055_SetBreaker()').
+*
+*/
+#define ERROR_BREAKER    0x1000
 //
 //-- Error values used in exported functions ------ END --#
 
@@ -254,6 +404,8 @@
 *          In the 'CONFIG.SYS' statement it follows the
 *          N-Parameter.
 *          ( ..\usbecd.sys /D:10CF:5500:0000 /N:KDEV01 )
+*          'EMUL0' .. 'EMUL3' open an emulated K8055, see
+*          'K8055_SetEmulation()'.
 *
 * \param   'pulFileDesc'
 *          - After 'K8055_Open()' was called successfully,
@@ -269,6 +421,12 @@
 *
 *  0x002  ERROR_POINTER    Indicating parameter problems.
 *
+*  0x080  ERROR_RANGE      Four K8055 are open already.
+*                          The device was closed again.
+*
+*  0x100  ERROR_FROM_CALL  The API-Call 'DosOpen' returned
+*                          with error(s).
+*
 *
 */
 ULONG K8055_Open( CHAR *pcaDeviceName,
@@ -568,6 +726,9 @@ ULONG K8055_DummyFnc1( ULONG *pulDummyParam1 );
 *                            inside 'K8055_ReadAllInputs'
 *                            returned with an internal error.
 *
+*  0x1000 ERROR_BREAKER      Circuit breaker open, see
+*                            'K8055_SetBreaker()'.
+*
 *
 */
 ULONG K8055_ReadAllInputs
@@ -712,6 +873,16 @@ ULONG K8055_CheckDigitalInput
 * DO or DAC1 or DAC2 cannot be passed over to K8055
 * separately. They must be treated as a group of 3 values!
 *
+* 'byaPutData[]' is shared by all boards. DO bits, DAC1 and
+* DAC2 the application did not change since its last call
+* for this K8055 keep the values the library gave them
+* (reflex rules, ramps, scheduled events, ...), so the call
+* does not undo them.
+*
+* A DAC with a slew rate limit (see 'K8055_SetDacSlew()')
+* keeps its value for now, the library ramps it to the new
+* value on its own.
+*
 *
 * \param   'pulFileDesc'
 *          - An application using this function must take in
@@ -728,6 +899,9 @@ ULONG K8055_CheckDigitalInput
 *   0x100  ERROR_FROM_CALL   The API-Call 'DosWrite'
 *                            returned with error(s).
 *
+*   0x1000 ERROR_BREAKER     Circuit breaker open, see
+*                            'K8055_SetBreaker()'.
+*
 *
 */
 ULONG K8055_SetAllOutputs( ULONG *pulFileDesc );
@@ -1107,25 +1281,2432 @@ ULONG K8055_GetInfoByte( BYTE *pbyInfoByte,
                          ULONG *pulByteIndex      );
 // -------------------------------------------------16
 
-//
-// -- Functions that are exported --------------- * -- END ----
 
+//--- K8055_StartAcquisition ----------------------------------
+//                                            Export Index 17
+/**
+* \brief 'K8055_StartAcquisition()' starts a thread inside
+* the library that reads the EP81 report of one K8055 once
+* per period ( see 'board.c' ).
+* Every report is evaluated by the alarm comparators at once
+* ( see 'K8055_SetAlarm()' ). So alarms no longer depend on
+* how often an application calls 'K8055_ReadAllInputs()'.
+*
+* If the Acquisition Thread is already running, only its
+* period is changed.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulPeriodMs'
+*          - Period in milliseconds, 10..60000.
+*          K8055 delivers a new report every 10 ms. With
+*          a period of 10 the thread simply reads one report
+*          after the other.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Period out of 10..60000.
+*
+*   0x100  ERROR_FROM_CALL   The thread could not be started.
+*
+*/
+ULONG K8055_StartAcquisition( ULONG *pulFileDesc,
+                              ULONG *pulPeriodMs  );
+// ---------------------------------------------17
 
 
 
+//--- K8055_StopAcquisition -----------------------------------
+//                                            Export Index 18
+/**
+* \brief 'K8055_StopAcquisition()' stops the Acquisition
+* Thread of one K8055 and waits until it has ended.
+* 'K8055_Close()' does the same implicitly.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x100  ERROR_FROM_CALL   'DosWaitThread' failed.
+*
+*/
+ULONG K8055_StopAcquisition( ULONG *pulFileDesc );
+// ---------------------------------------------18
 
-// -- Functions that are not exported --------- + -- BEGIN ----
-//
-//--- Setup routines, used by K8055_Init ----------------------
-//    - Reading descriptors
-//
-ULONG GetDeviceDescriptor( ULONG ulDevpointer );
-ULONG GetConfigurationDescriptor( ULONG ulDevpointer );
-ULONG GetLanguageDescriptor( ULONG ulDevpointer );
-ULONG Get4thStringDescriptor( ULONG ulDevpointer );
-ULONG GetString2Descriptor( ULONG ulDevpointer );
-ULONG DoUnknown21( ULONG ulDevpointer );
-ULONG DoUnknown30Bytes( ULONG ulDevpointer );
+
+
+//--- K8055_SetAlarm ------------------------------------------
+//                                            Export Index 19
+/**
+* \brief 'K8055_SetAlarm()' configures the comparator that
+* watches one analog input. Comparators are evaluated on
+* every EP81 report, read either by the Acquisition Thread
+* or by 'K8055_ReadAllInputs()' / 'K8055_Read()'.
+*
+*   value >= High  for 'MinDuration' ms  -> ALARM_EV_HIGH_SET
+*   value <  High - Hysteresis  for 'MinDuration' ms
+*                                        -> ALARM_EV_HIGH_CLEAR
+*   value <= Low   for 'MinDuration' ms  -> ALARM_EV_LOW_SET
+*   value >  Low + Hysteresis  for 'MinDuration' ms
+*                                        -> ALARM_EV_LOW_CLEAR
+*
+* Setting a comparator resets its state to ALARM_STATE_NORMAL.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - 1 selects A1, 2 selects A2.
+*
+* \param   'pulHighLimit'
+*          - 0..255, or ALARM_LIMIT_OFF (0xFFFFFFFF).
+*
+* \param   'pulLowLimit'
+*          - 0..255, or ALARM_LIMIT_OFF. Must be below the
+*          high limit if both are used.
+*
+* \param   'pulHysteresis'
+*          - 0..255 counts.
+*
+* \param   'pulMinDurationMs'
+*          - Time a condition must hold before the state
+*          changes. 0 means: on the first report.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       One of the values is out of its
+*                            range.
+*
+*/
+ULONG K8055_SetAlarm( ULONG *pulFileDesc,
+                      ULONG *pulChannel,
+                      ULONG *pulHighLimit,
+                      ULONG *pulLowLimit,
+                      ULONG *pulHysteresis,
+                      ULONG *pulMinDurationMs );
+// ---------------------------------------------19
+
+
+
+//--- K8055_GetAlarmEvent -------------------------------------
+//                                            Export Index 20
+/**
+* \brief 'K8055_GetAlarmEvent()' takes the oldest alarm event
+* of one K8055 out of its queue (32 entries). If the queue is
+* empty, the call waits for the next event up to a timeout.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulTimeoutMs'
+*          - 0 returns at once, 0xFFFFFFFF waits forever.
+*
+* \param   'pulChannel'
+*          - Returns 1 for A1, 2 for A2.
+*
+* \param   'pulEvent'
+*          - Returns ALARM_EV_HIGH_SET, .._HIGH_CLEAR,
+*          .._LOW_SET, .._LOW_CLEAR, ALARM_EV_NONE if the
+*          timeout expired, or ALARM_EV_LOST once after
+*          events were dropped because nobody took them.
+*
+* \param   'pulValue'
+*          - Returns the input value that caused the event.
+*
+* \param   'pulTimeMs'
+*          - Returns the time of the report in milliseconds
+*          (library clock).
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*/
+ULONG K8055_GetAlarmEvent( ULONG *pulFileDesc,
+                           ULONG *pulTimeoutMs,
+                           ULONG *pulChannel,
+                           ULONG *pulEvent,
+                           ULONG *pulValue,
+                           ULONG *pulTimeMs     );
+// ---------------------------------------------20
+
+
+
+//--- K8055_GetAlarmState -------------------------------------
+//                                            Export Index 21
+/**
+* \brief 'K8055_GetAlarmState()' tells the current state of
+* one comparator.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - 1 selects A1, 2 selects A2.
+*
+* \param   'pulState'
+*          - Returns ALARM_STATE_NORMAL (0), ALARM_STATE_HIGH
+*          (1) or ALARM_STATE_LOW (2).
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel is not 1..2.
+*
+*/
+ULONG K8055_GetAlarmState( ULONG *pulFileDesc,
+                           ULONG *pulChannel,
+                           ULONG *pulState    );
+// ---------------------------------------------21
+
+
+//--- K8055_SetReflexRules ------------------------------------
+//                                            Export Index 22
+/**
+* \brief 'K8055_SetReflexRules()' replaces the Reflex Rules of
+* a K8055. The rules are checked right after every EP81
+* report. If a rule fires, the library changes the outputs
+* via EP01 at once, without waiting for the application.
+* Reports are read by the Acquisition Thread (see
+* 'K8055_StartAcquisition()') or by 'K8055_ReadAllInputs()'.
+*
+* All rules are checked in table order. The actions of all
+* rules that fire are combined, a later rule wins. The
+* outputs are written only if they change. A following
+* 'K8055_SetAllOutputs()' keeps them, unless the application
+* changed these outputs itself.
+*
+* The rules can be replaced at any time. The running
+* evaluation is not blocked, the next report uses the new
+* table. The fire counters are reset.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulCount'
+*          - Number of rules 0..REFLEX_RULES_MAX (8).
+*          0 switches all rules off.
+*
+* \param   'paRules'
+*          - Array of '*pulCount' rules, see 'reflex.h' for
+*          the layout and an example. May be NULL if
+*          '*pulCount' is 0.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Too many rules, or a value of a
+*                            rule out of range. The old rules
+*                            stay in use.
+*
+*/
+struct _REFLEXRULE;
+ULONG K8055_SetReflexRules( ULONG *pulFileDesc,
+                            ULONG *pulCount,
+                            struct _REFLEXRULE *paRules );
+// ---------------------------------------------22
+
+
+//--- K8055_GetReflexCount ------------------------------------
+//                                            Export Index 23
+/**
+* \brief 'K8055_GetReflexCount()' tells on how many reports
+* one rule has fired since it was set.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulRule'
+*          - Number of the rule 1..REFLEX_RULES_MAX.
+*
+* \param   'pulFired'
+*          - Returns the counter.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Rule number out of range.
+*
+*/
+ULONG K8055_GetReflexCount( ULONG *pulFileDesc,
+                            ULONG *pulRule,
+                            ULONG *pulFired     );
+// ---------------------------------------------23
+
+
+//--- K8055_StartScan -----------------------------------------
+//                                            Export Index 24
+/**
+* \brief 'K8055_StartScan()' starts a Scan Engine: one thread
+* that runs the fixed scan cycle of a PLC for a set of
+* boards.
+*
+* Every cycle starts on an absolute deadline. The engine
+* reads one EP81 report of every board, calls 'pfnLogic'
+* with the Process Images of all boards (see 'scan.h') and
+* then writes the outputs of every board the logic has
+* changed, one EP01 frame per board.
+*
+* The logic runs in a time critical thread. It must not call
+* 'K8055_StopScan()' or 'K8055_Close()', it returns a value
+* other than 0 instead to stop the engine.
+*
+* A board can belong to one engine only. 'K8055_Close()' of
+* a board stops its engine.
+*
+* \param   'pulFileDescs'
+*          - Array of '*pulBoards' handles returned by
+*          'K8055_Open()'.
+*
+* \param   'pulBoards'
+*          - Number of boards 1..4.
+*
+* \param   'pulCycleMs'
+*          - Scan cycle SCAN_CYCLE_MIN_MS (10) ..
+*          SCAN_CYCLE_MAX_MS (60000) milliseconds.
+*
+* \param   'pfnLogic'
+*          - Logic of the application, called once per cycle.
+*
+* \param   'pvUser'
+*          - Handed over to 'pfnLogic' unchanged.
+*
+* \param   'pulScan'
+*          - Returns the number of the engine 1..4, needed by
+*          'K8055_StopScan()' and 'K8055_GetScanStats()'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or a K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Number of boards or cycle out of
+*                            range, a board belongs to
+*                            another engine already, or all
+*                            engines are in use.
+*
+*   0x100  ERROR_FROM_CALL   Thread could not be started.
+*
+*/
+struct _SCANIMAGE;
+typedef ULONG ( APIENTRY *PFNK8055SCAN )
+                          ( ULONG ulBoards,
+                            struct _SCANIMAGE *paImage,
+                            VOID *pvUser               );
+
+ULONG K8055_StartScan( ULONG *pulFileDescs,
+                       ULONG *pulBoards,
+                       ULONG *pulCycleMs,
+                       PFNK8055SCAN pfnLogic,
+                       VOID *pvUser,
+                       ULONG *pulScan        );
+// ---------------------------------------------24
+
+
+//--- K8055_StopScan ------------------------------------------
+//                                            Export Index 25
+/**
+* \brief 'K8055_StopScan()' stops a Scan Engine, waits for
+* the end of its thread and frees the engine. Needed as well
+* if the logic has stopped the engine itself. If
+* 'K8055_Close()' of one of its boards stops the engine just
+* now, the call waits until the engine is free.
+*
+* \param   'pulScan'
+*          - Number returned by 'K8055_StartScan()'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x080  ERROR_RANGE       No such engine running.
+*
+*   0x100  ERROR_FROM_CALL   'DosWaitThread()' failed.
+*
+*/
+ULONG K8055_StopScan( ULONG *pulScan );
+// ---------------------------------------------25
+
+
+//--- K8055_GetScanStats --------------------------------------
+//                                            Export Index 26
+/**
+* \brief 'K8055_GetScanStats()' tells how well a Scan Engine
+* keeps its cycle.
+*
+* \param   'pulScan'
+*          - Number returned by 'K8055_StartScan()'.
+*
+* \param   'pulCycles'
+*          - Returns the number of cycles run.
+*
+* \param   'pulOverruns'
+*          - Returns the number of cycles that ended after
+*          the start of the next one. Missed cycles are
+*          skipped, not repeated.
+*
+* \param   'pulReadErrors'
+*          - Returns the number of EP81 reads that failed.
+*
+* \param   'pulJitterMaxUs', 'pulJitterAvgUs'
+*          - Return the largest and the mean delay of a cycle
+*          start behind its deadline in microseconds.
+*
+* \param   'pulScanMaxUs'
+*          - Returns the longest cycle (read, logic, write) in
+*          microseconds.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x080  ERROR_RANGE       No such engine running.
+*
+*/
+ULONG K8055_GetScanStats( ULONG *pulScan,
+                          ULONG *pulCycles,
+                          ULONG *pulOverruns,
+                          ULONG *pulReadErrors,
+                          ULONG *pulJitterMaxUs,
+                          ULONG *pulJitterAvgUs,
+                          ULONG *pulScanMaxUs    );
+// ---------------------------------------------26
+
+
+//--- K8055_SetPid --------------------------------------------
+//                                            Export Index 27
+/**
+* \brief 'K8055_SetPid()' sets all parameters of one PID
+* controller at once. Controller 1 reads A1 and drives DAC1,
+* controller 2 reads A2 and drives DAC2.
+*
+* The controllers sample on the EP81 reports, so the
+* Acquisition Thread should run (see
+* 'K8055_StartAcquisition()'). A sample is taken when the
+* sample period has passed. The new parameters are used from
+* the next sample on, never half of them. Retuning a running
+* controller keeps its integral. Switching it on starts from
+* the current DAC value. The statistics are reset.
+*
+* While a controller is on, the application should not
+* write the DAC it drives.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - 1 or 2.
+*
+* \param   'pParam'
+*          - Parameter record, see 'pid.h'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel, period, setpoint or
+*                            output limits out of range,
+*                            or a gain is negative or not
+*                            a finite number.
+*
+*/
+struct _PIDPARAM;
+ULONG K8055_SetPid( ULONG *pulFileDesc,
+                    ULONG *pulChannel,
+                    struct _PIDPARAM *pParam );
+// ---------------------------------------------27
+
+
+//--- K8055_GetPidStats ---------------------------------------
+//                                            Export Index 28
+/**
+* \brief 'K8055_GetPidStats()' tells how well one PID
+* controller works since it was set: samples taken and
+* clamped, last, largest and mean error, last output,
+* longest time between two samples, and the latency from the
+* arrival of a report to the DAC being written.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - 1 or 2.
+*
+* \param   'pStats'
+*          - Receives the statistics record, see 'pid.h'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel is not 1..2.
+*
+*/
+struct _PIDSTATS;
+ULONG K8055_GetPidStats( ULONG *pulFileDesc,
+                         ULONG *pulChannel,
+                         struct _PIDSTATS *pStats );
+// ---------------------------------------------28
+
+
+//--- K8055_SetPwm --------------------------------------------
+//                                            Export Index 29
+/**
+* \brief 'K8055_SetPwm()' runs a software PWM on one digital
+* output, or changes period and duty cycle of a running one.
+*
+* The outputs are switched by the Output Thread of the board
+* in slots of 10 ms. Edges of all outputs in the same slot
+* are written with one EP01 frame, unchanged frames are not
+* written at all. The part of the on time that does not fill
+* a whole slot is carried over to the next period, so the
+* mean duty cycle is exact in steps of 1 %.
+*
+* A new duty cycle of a running output is used from its next
+* period on. A new period restarts the output.
+*
+* Other outputs can still be set by 'K8055_SetAllOutputs()'.
+* A PWM output it changes is set right again within 10 ms.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - Digital output 1..8.
+*
+* \param   'pulPeriodMs'
+*          - Period PWM_PERIOD_MIN_MS (100) ..
+*          PWM_PERIOD_MAX_MS (1000) ms, a multiple of 10 ms.
+*
+* \param   'pulDuty'
+*          - Duty cycle 0..100 %.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel, period or duty cycle
+*                            out of range.
+*
+*   0x100  ERROR_FROM_CALL   Output Thread could not be
+*                            started.
+*
+*/
+ULONG K8055_SetPwm( ULONG *pulFileDesc,
+                    ULONG *pulChannel,
+                    ULONG *pulPeriodMs,
+                    ULONG *pulDuty      );
+// ---------------------------------------------29
+
+
+//--- K8055_StopPwm -------------------------------------------
+//                                            Export Index 30
+/**
+* \brief 'K8055_StopPwm()' ends the PWM on one digital output
+* and switches the output off. Without PWM outputs the
+* Output Thread ends too.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - Digital output 1..8.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel out of range.
+*
+*   0x100  ERROR_FROM_CALL   'DosWrite()' failed.
+*
+*/
+ULONG K8055_StopPwm( ULONG *pulFileDesc,
+                     ULONG *pulChannel   );
+// ---------------------------------------------30
+
+
+//--- K8055_GetOutputStats ------------------------------------
+//                                            Export Index 31
+/**
+* \brief 'K8055_GetOutputStats()' tells how much work the
+* Output Thread of a board has done since 'K8055_Open()'.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulSlots'
+*          - Returns the number of Output Slots (10 ms)
+*          handled.
+*
+* \param   'pulWrites'
+*          - Returns the number of EP01 frames written by the
+*          thread.
+*
+* \param   'pulLateSlots'
+*          - Returns the number of slots skipped, because the
+*          thread was late.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*/
+ULONG K8055_GetOutputStats( ULONG *pulFileDesc,
+                            ULONG *pulSlots,
+                            ULONG *pulWrites,
+                            ULONG *pulLateSlots );
+// ---------------------------------------------31
+
+//--- K8055_SetWave -------------------------------------------
+//                                            Export Index 32
+/**
+* \brief 'K8055_SetWave()' sets up one channel of the DAC
+* waveform generator. Channel 1 drives DAC1, channel 2
+* drives DAC2.
+*
+* The points of one period (256) are computed here, with the
+* output range already applied. The Output Thread puts out
+* one point per slot of 10 ms, picked by a phase accumulator,
+* so any frequency is possible and does not drift. Slots the
+* thread misses are skipped, the wave keeps its phase.
+*
+* A running channel takes the new table at once, without
+* restart. 'K8055_StartWave()' starts the output.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - Generator channel 1..2.
+*
+* \param   'pulShape'
+*          - WAVE_SINE, WAVE_RAMP, WAVE_TRIANGLE or WAVE_USER
+*          (see 'K8055_SetWaveTable()').
+*
+* \param   'pulFreqMilliHz'
+*          - Frequency WAVE_FREQ_MIN_MHZ (0.001 Hz) ..
+*          WAVE_FREQ_MAX_MHZ (50 Hz) in milli Hertz. With
+*          100 points a second, 1 Hz has got 100 points a
+*          period, 10 Hz only 10.
+*
+* \param   'pulLow', 'pulHigh'
+*          - DAC values 0..255 of the lowest and the highest
+*          point. 'pulLow' greater than 'pulHigh' turns the
+*          wave upside down.
+*
+* \param   'pulPhaseDeg'
+*          - Phase offset 0..359 degrees. Two channels
+*          started together keep this offset.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       A parameter out of range.
+*
+*/
+ULONG K8055_SetWave( ULONG *pulFileDesc,
+                     ULONG *pulChannel,
+                     ULONG *pulShape,
+                     ULONG *pulFreqMilliHz,
+                     ULONG *pulLow,
+                     ULONG *pulHigh,
+                     ULONG *pulPhaseDeg     );
+// ---------------------------------------------32
+
+
+//--- K8055_SetWaveTable --------------------------------------
+//                                            Export Index 33
+/**
+* \brief 'K8055_SetWaveTable()' loads the points of the user
+* waveform WAVE_USER of a board. The points are stretched to
+* 256, linear between two points, the last point leads back
+* to the first one.
+*
+* Channels already set up with WAVE_USER keep their table,
+* call 'K8055_SetWave()' again to use the new points.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulPoints'
+*          - Number of points 2..256.
+*
+* \param   'pbyPoints'
+*          - The points, 0 is 'pulLow', 255 is 'pulHigh' of
+*          'K8055_SetWave()'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Number of points out of range.
+*
+*/
+ULONG K8055_SetWaveTable( ULONG *pulFileDesc,
+                          ULONG *pulPoints,
+                          BYTE *pbyPoints    );
+// ---------------------------------------------33
+
+
+//--- K8055_StartWave -----------------------------------------
+//                                            Export Index 34
+/**
+* \brief 'K8055_StartWave()' starts one or both generator
+* channels. Channels started by the same call start in the
+* same Output Slot, so DAC1 and DAC2 stay locked in phase.
+* The statistics of the channels are reset.
+*
+* While a channel runs, 'K8055_SetAllOutputs()' cannot hold
+* its DAC, the value is set right again within 10 ms.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannels'
+*          - WAVE_DAC1, WAVE_DAC2 or both or-ed.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x001  ERROR_INIT        Channel not set up by
+*                            'K8055_SetWave()'.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Unknown channel bits.
+*
+*   0x100  ERROR_FROM_CALL   Output Thread could not be
+*                            started.
+*
+*/
+ULONG K8055_StartWave( ULONG *pulFileDesc,
+                       ULONG *pulChannels  );
+// ---------------------------------------------34
+
+
+//--- K8055_StopWave ------------------------------------------
+//                                            Export Index 35
+/**
+* \brief 'K8055_StopWave()' stops one or both generator
+* channels. The DACs keep their last value.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannels'
+*          - WAVE_DAC1, WAVE_DAC2 or both or-ed.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Unknown channel bits.
+*
+*/
+ULONG K8055_StopWave( ULONG *pulFileDesc,
+                      ULONG *pulChannels  );
+// ---------------------------------------------35
+
+
+//--- K8055_GetWaveStats --------------------------------------
+//                                            Export Index 36
+/**
+* \brief 'K8055_GetWaveStats()' compares the frequency a
+* generator channel has achieved since its start with the
+* requested one. The achieved frequency differs by the
+* rounding of the phase step and by the clock of the Output
+* Thread.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - Generator channel 1..2.
+*
+* \param   'pulRequestedMilliHz'
+*          - Returns the frequency set by 'K8055_SetWave()'
+*          in milli Hertz, 0 if none was set.
+*
+* \param   'pulAchievedMilliHz'
+*          - Returns the frequency put out in milli Hertz,
+*          measured between the first and the last point.
+*          0 before the second point.
+*
+* \param   'pulSamples'
+*          - Returns the number of points put out.
+*
+* \param   'pulMissed'
+*          - Returns the number of points lost, because the
+*          Output Thread was late.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel out of range.
+*
+*/
+ULONG K8055_GetWaveStats( ULONG *pulFileDesc,
+                          ULONG *pulChannel,
+                          ULONG *pulRequestedMilliHz,
+                          ULONG *pulAchievedMilliHz,
+                          ULONG *pulSamples,
+                          ULONG *pulMissed           );
+// ---------------------------------------------36
+
+//--- K8055_SetDacSlew ----------------------------------------
+//                                            Export Index 37
+/**
+* \brief 'K8055_SetDacSlew()' sets the slew rate limit of one
+* DAC.
+*
+* With a limit set, the DAC never moves faster than the given
+* number of counts per second. This holds for the ramps of
+* 'K8055_RampDac()', for 'K8055_SetAllOutputs()' and for
+* every frame the library writes on its own (reflex rules,
+* PID controllers, the waveform generator, transactions,
+* scheduled events, ...): a DAC value that would jump too
+* far is not written at once, the library ramps the DAC to
+* it on the Output Thread. Only 'K8055_Write()' is not
+* limited.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - 1 = DAC1, 2 = DAC2.
+*
+* \param   'pulCountsPerSec'
+*          - 1..RAMP_SLEW_MAX (25500) DAC counts per second,
+*          RAMP_SLEW_OFF (0) removes the limit.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel or limit out of range.
+*
+*/
+ULONG K8055_SetDacSlew( ULONG *pulFileDesc,
+                        ULONG *pulChannel,
+                        ULONG *pulCountsPerSec );
+// ---------------------------------------------37
+
+
+//--- K8055_RampDac -------------------------------------------
+//                                            Export Index 38
+/**
+* \brief 'K8055_RampDac()' ramps one DAC from its current
+* value to a target value. The call returns at once, the
+* steps are written by the Output Thread, one step per slot
+* of 10 ms.
+*
+* A ramp already running goes on from where it is towards
+* the new target. A following 'K8055_SetAllOutputs()' does
+* not undo the ramp, unless the application changed this
+* DAC in the Data Buffer.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - 1 = DAC1, 2 = DAC2.
+*
+* \param   'pulTarget'
+*          - Target value 0..255.
+*
+* \param   'pulTimeMs'
+*          - Time for the ramp 0..RAMP_TIME_MAX_MS (600000)
+*          ms, rounded up to 10 ms. A slew rate limit can make
+*          the ramp slower. 0 goes to the target as fast as
+*          the limit allows.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel, target or time out of
+*                            range.
+*
+*   0x100  ERROR_FROM_CALL   Output Thread could not be
+*                            started.
+*
+*/
+ULONG K8055_RampDac( ULONG *pulFileDesc,
+                     ULONG *pulChannel,
+                     ULONG *pulTarget,
+                     ULONG *pulTimeMs    );
+// ---------------------------------------------38
+
+
+//--- K8055_GetDacRamp ----------------------------------------
+//                                            Export Index 39
+/**
+* \brief 'K8055_GetDacRamp()' tells the value last written to
+* a DAC and the target of its ramp.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulChannel'
+*          - 1 = DAC1, 2 = DAC2.
+*
+* \param   'pulValue'
+*          - Returns the value last written.
+*
+* \param   'pulTarget'
+*          - Returns the target of the running ramp, or the
+*          value last written, if no ramp runs.
+*
+* \param   'pulBusy'
+*          - Returns TRUE while the ramp runs.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Channel out of range.
+*
+*/
+ULONG K8055_GetDacRamp( ULONG *pulFileDesc,
+                        ULONG *pulChannel,
+                        ULONG *pulValue,
+                        ULONG *pulTarget,
+                        ULONG *pulBusy      );
+// ---------------------------------------------39
+
+//--- K8055_DigitalOutSet -------------------------------------
+//                                            Export Index 40
+/**
+* \brief 'K8055_DigitalOutSet()' switches on the digital
+* outputs given by a mask, all other outputs stay as they
+* are.
+*
+* Every board keeps a shadow of its digital outputs. Set,
+* clear and toggle change it without a lock, so threads that
+* own different outputs never wait for each other and no
+* change gets lost. The shadow is written by the caller, or,
+* if another thread is writing just now, by that thread.
+* Changes of several threads can leave the PC in one EP01
+* frame this way.
+*
+* A following 'K8055_SetAllOutputs()' does not undo the
+* change, unless the application changed these bits in the
+* Data Buffer.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulMask'
+*          - Outputs to switch on, O1 = 0x01 .. O8 = 0x80.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Mask greater than 0xFF.
+*
+*   0x100  ERROR_FROM_CALL   'DosWrite()' failed. Only the
+*                            thread that did the write gets
+*                            this error.
+*
+*/
+ULONG K8055_DigitalOutSet( ULONG *pulFileDesc,
+                           ULONG *pulMask      );
+// ---------------------------------------------40
+
+
+//--- K8055_DigitalOutClear -----------------------------------
+//                                            Export Index 41
+/**
+* \brief 'K8055_DigitalOutClear()' switches off the digital
+* outputs given by a mask. See 'K8055_DigitalOutSet()'.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulMask'
+*          - Outputs to switch off, O1 = 0x01 .. O8 = 0x80.
+*
+* \return  - Return Code, see 'K8055_DigitalOutSet()'.
+*
+*/
+ULONG K8055_DigitalOutClear( ULONG *pulFileDesc,
+                             ULONG *pulMask      );
+// ---------------------------------------------41
+
+
+//--- K8055_DigitalOutToggle ----------------------------------
+//                                            Export Index 42
+/**
+* \brief 'K8055_DigitalOutToggle()' inverts the digital
+* outputs given by a mask. See 'K8055_DigitalOutSet()'.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulMask'
+*          - Outputs to invert, O1 = 0x01 .. O8 = 0x80.
+*
+* \return  - Return Code, see 'K8055_DigitalOutSet()'.
+*
+*/
+ULONG K8055_DigitalOutToggle( ULONG *pulFileDesc,
+                              ULONG *pulMask      );
+// ---------------------------------------------42
+
+//--- K8055_TxBegin -------------------------------------------
+//                                            Export Index 43
+/**
+* \brief 'K8055_TxBegin()' starts an output transaction.
+*
+* DO, DAC1 and DAC2 as the K8055 outputs them right now are
+* stored into the record as old values, and the new values
+* are preset with them. The application then changes any of
+* the new values and calls 'K8055_TxCommit()'. Nothing is
+* locked in between.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pTx'
+*          - Record of the transaction (see 'txn.h').
+*          'ulFlags' is not changed.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*/
+struct _OUTPUTTX;
+ULONG K8055_TxBegin( ULONG *pulFileDesc,
+                     struct _OUTPUTTX *pTx );
+// ---------------------------------------------43
+
+
+//--- K8055_TxCommit ------------------------------------------
+//                                            Export Index 44
+/**
+* \brief 'K8055_TxCommit()' writes the new values of an
+* output transaction with one EP01 frame. No other thread
+* of the library can write to the K8055 in between.
+*
+* With 'ulFlags' TXN_MERGE only the DO bits and DACs the
+* transaction changed are written, the others keep what
+* other threads set after 'K8055_TxBegin()'.
+*
+* With 'ulFlags' TXN_COMPARE the commit is a compare and set:
+* if DO, DAC1 or DAC2 changed after 'K8055_TxBegin()', the
+* commit fails with ERROR_CONFLICT, nothing is written. The
+* check costs no USB transfer. Background subsystems that
+* drive outputs (PWM, waveforms, ramps) let such commits
+* fail most of the time.
+*
+* After a commit the record holds the written frame as old
+* and new values, so it can be used for the next transaction
+* at once. A following 'K8055_SetAllOutputs()' does not undo
+* the commit, unless the application changed these outputs
+* in the Data Buffer.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pTx'
+*          - Record of the transaction, filled by
+*          'K8055_TxBegin()'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       A new value greater than 255,
+*                            or unknown flags.
+*
+*   0x100  ERROR_FROM_CALL   'DosWrite()' failed.
+*
+*   0x400  ERROR_CONFLICT    TXN_COMPARE: the outputs
+*                            changed since 'K8055_TxBegin()'.
+*                            Begin again.
+*
+*/
+ULONG K8055_TxCommit( ULONG *pulFileDesc,
+                      struct _OUTPUTTX *pTx );
+// ---------------------------------------------44
+
+//--- K8055_ScheduleOutput ------------------------------------
+//                                            Export Index 45
+/**
+* \brief 'K8055_ScheduleOutput()' schedules a change of the
+* outputs of one board at a future time.
+*
+* The library keeps the events in a timer wheel and carries
+* them out on its own Scheduler Thread, in slots of 10 ms.
+* All events of one board due in the same slot are written
+* with one EP01 frame, events scheduled later win over
+* earlier ones. The thread starts with the first event and
+* ends when no event is pending. A following
+* 'K8055_SetAllOutputs()' keeps the new values, unless the
+* application changed these outputs in its Data Buffer.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulDelayMs'
+*          - Time from now 0..SCHED_DELAY_MAX_MS (2.7 h),
+*          rounded up to the next slot of 10 ms.
+*
+* \param   'pulDoMask', 'pulDoBits'
+*          - Digital outputs to change (O1 = 0x01) and their
+*          new values. A mask of 0 leaves DO alone.
+*
+* \param   'pulDacMask'
+*          - SCHED_DAC1, SCHED_DAC2, both or-ed or 0.
+*
+* \param   'pulDac1', 'pulDac2'
+*          - New DAC values 0..255, used if given in
+*          'pulDacMask'.
+*
+* \param   'pulEventId'
+*          - Returns the id of the event for
+*          'K8055_CancelScheduled()'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x010  ERROR_BUFFER      SCHED_EVENTS_MAX (4096) events
+*                            are pending already.
+*
+*   0x080  ERROR_RANGE       A parameter out of range.
+*
+*   0x100  ERROR_FROM_CALL   Scheduler Thread could not be
+*                            started.
+*
+*/
+ULONG K8055_ScheduleOutput( ULONG *pulFileDesc,
+                            ULONG *pulDelayMs,
+                            ULONG *pulDoMask,
+                            ULONG *pulDoBits,
+                            ULONG *pulDacMask,
+                            ULONG *pulDac1,
+                            ULONG *pulDac2,
+                            ULONG *pulEventId  );
+// ---------------------------------------------45
+
+
+//--- K8055_SchedulePulse -------------------------------------
+//                                            Export Index 46
+/**
+* \brief 'K8055_SchedulePulse()' switches digital outputs on
+* at a future time and off again after a given length, i.e.
+* two events of 'K8055_ScheduleOutput()'.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulDelayMs'
+*          - Time from now to the start of the pulse.
+*
+* \param   'pulLengthMs'
+*          - Length of the pulse, 10 ms at least. Delay and
+*          length together must not exceed
+*          SCHED_DELAY_MAX_MS.
+*
+* \param   'pulDoMask'
+*          - Digital outputs to pulse, O1 = 0x01.
+*
+* \param   'pulOnId', 'pulOffId'
+*          - Return the ids of both events. Cancelling only
+*          the first one leaves the outputs off at the end.
+*
+* \return  - Return Code, see 'K8055_ScheduleOutput()'.
+*
+*/
+ULONG K8055_SchedulePulse( ULONG *pulFileDesc,
+                           ULONG *pulDelayMs,
+                           ULONG *pulLengthMs,
+                           ULONG *pulDoMask,
+                           ULONG *pulOnId,
+                           ULONG *pulOffId     );
+// ---------------------------------------------46
+
+
+//--- K8055_CancelScheduled -----------------------------------
+//                                            Export Index 47
+/**
+* \brief 'K8055_CancelScheduled()' cancels a pending event.
+*
+* \param   'pulFileDesc'
+*          - The K8055 the event was scheduled for.
+*
+* \param   'pulEventId'
+*          - Id returned by 'K8055_ScheduleOutput()' or
+*          'K8055_SchedulePulse()'.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       No such event pending, it may
+*                            have been fired already.
+*
+*/
+ULONG K8055_CancelScheduled( ULONG *pulFileDesc,
+                             ULONG *pulEventId   );
+// ---------------------------------------------47
+
+
+//--- K8055_GetScheduleStats ----------------------------------
+//                                            Export Index 48
+/**
+* \brief 'K8055_GetScheduleStats()' tells how many events
+* are pending and how late the Scheduler Thread fired them,
+* all boards together, since the DLL was loaded.
+*
+* \param   'pulPending'
+*          - Returns the number of events pending.
+*
+* \param   'pulFired'
+*          - Returns the number of events fired.
+*
+* \param   'pulFrames'
+*          - Returns the number of EP01 frames written.
+*
+* \param   'pulLateMaxUs', 'pulLateAvgUs'
+*          - Return the largest and the mean time in us
+*          between the start of the due slot and the moment
+*          an event was fired.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*/
+ULONG K8055_GetScheduleStats( ULONG *pulPending,
+                              ULONG *pulFired,
+                              ULONG *pulFrames,
+                              ULONG *pulLateMaxUs,
+                              ULONG *pulLateAvgUs  );
+// ---------------------------------------------48
+
+//--- K8055_GroupCommit ---------------------------------------
+//                                            Export Index 49
+/**
+* \brief 'K8055_GroupCommit()' writes the outputs of up to
+* K8055_MAX_BOARDS (4) boards at the same moment.
+*
+* Every board gets a Group Worker, a thread that stays until
+* the board is closed. The workers take the transfer locks
+* of their boards first, then a barrier releases all of them
+* at once and the EP01 frames are written side by side
+* instead of one after the other. The frames replace DO and
+* both DACs, like 'K8055_Write()'; the Data Buffer of
+* 'K8055_SetAllOutputs()' is not changed.
+*
+* \param   'pulCount'
+*          - Number of boards 1..K8055_MAX_BOARDS.
+*
+* \param   'pulFileDescs'
+*          - Array of 'pulCount' K8055 opened by
+*          'K8055_Open()', each one once.
+*
+* \param   'pFrames'
+*          - Array of 'pulCount' records (see 'group.h'), the
+*          outputs for the board of the same index.
+*
+* \param   'pulSkewUs'
+*          - Returns the skew of this commit: the time in us
+*          between the first and the last board having its
+*          frame written.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or a K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Count or values out of range,
+*                            or a board given twice.
+*
+*   0x100  ERROR_FROM_CALL   A Group Worker could not be
+*                            started, nothing written. Or a
+*                            write failed, the other boards
+*                            got their frames.
+*
+*/
+struct _GROUPFRAME;
+ULONG K8055_GroupCommit( ULONG *pulCount,
+                         ULONG *pulFileDescs,
+                         struct _GROUPFRAME *pFrames,
+                         ULONG *pulSkewUs           );
+// ---------------------------------------------49
+
+
+//--- K8055_GetGroupStats -------------------------------------
+//                                            Export Index 50
+/**
+* \brief 'K8055_GetGroupStats()' tells the skew of all group
+* commits since the DLL was loaded.
+*
+* \param   'pulCommits'
+*          - Returns the number of group commits.
+*
+* \param   'pulSkewMaxUs', 'pulSkewAvgUs'
+*          - Return the largest and the mean skew in us, see
+*          'K8055_GroupCommit()'.
+*
+* \param   'pulIssueMaxUs'
+*          - Returns the largest time in us between the first
+*          and the last worker starting its write after the
+*          barrier. It tells how much of the skew is thread
+*          dispatch, the rest is the USB stack.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*/
+ULONG K8055_GetGroupStats( ULONG *pulCommits,
+                           ULONG *pulSkewMaxUs,
+                           ULONG *pulSkewAvgUs,
+                           ULONG *pulIssueMaxUs );
+// ---------------------------------------------50
+
+//--- K8055_GroupSample ---------------------------------------
+//                                            Export Index 51
+/**
+* \brief 'K8055_GroupSample()' reads the inputs of up to
+* K8055_MAX_BOARDS (4) boards at the same moment and puts
+* them into one record: up to 20 digital inputs, 8 analog
+* inputs and 8 counters, with one time stamp.
+*
+* The EP81 reads are released by the barrier of the Group
+* Workers, see 'K8055_GroupCommit()'. The record tells for
+* every board how long after the first report its own one
+* came in. Alarms, reflex rules and PID controllers get the
+* reports like those of the Acquisition Thread.
+*
+* \param   'pulCount'
+*          - Number of boards 1..K8055_MAX_BOARDS.
+*
+* \param   'pulFileDescs'
+*          - Array of 'pulCount' K8055 opened by
+*          'K8055_Open()', each one once. The order gives the
+*          place of a board in the record.
+*
+* \param   'pSample'
+*          - Receives the record (see 'group.h').
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or a K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Count out of range, or a board
+*                            given twice.
+*
+*   0x100  ERROR_FROM_CALL   A Group Worker could not be
+*                            started, nothing read.
+*
+*   The error bits of a failed read, see 'aulRcRead' of the
+*   record. The inputs of that board are 0.
+*
+*/
+struct _GROUPSAMPLE;
+ULONG K8055_GroupSample( ULONG *pulCount,
+                         ULONG *pulFileDescs,
+                         struct _GROUPSAMPLE *pSample );
+// ---------------------------------------------51
+
+//--- K8055_SetRecovery ---------------------------------------
+//                                            Export Index 52
+/**
+* \brief 'K8055_SetRecovery()' sets when a K8055 counts as
+* unplugged or reset, and how the library brings it back.
+*
+* Every transfer on EP01 and EP81 counts. After a number of
+* failures in a row (ERROR_FROM_CALL or ERROR_BYTE_NUMBER,
+* not ERROR_TOGGLE_BIT, which is normal with several readers)
+* the board is lost and a Recovery Thread opens and
+* initialises it again in the background, with a
+* pause between two attempts that starts at 100 ms and is
+* doubled up to a maximum. The handle of the application
+* stays valid. When the board is back, the last output frame
+* written to it is written once more, and all threads of the
+* library go on with their transfers.
+*
+* Without this call the board is lost after
+* PLUG_FAILS_DEFAULT (3) failures, the pause is
+* PLUG_BACKOFF_DEFAULT_MS (5000) ms at most.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulFailLimit'
+*          - Failures in a row 1..PLUG_FAILS_MAX (100), 0
+*          switches the recovery off.
+*
+* \param   'pulBackoffMaxMs'
+*          - Longest pause between two attempts,
+*          PLUG_BACKOFF_MIN_MS (100) .. PLUG_BACKOFF_MAX_MS
+*          (60000) ms.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Limit or pause out of range.
+*
+*/
+ULONG K8055_SetRecovery( ULONG *pulFileDesc,
+                         ULONG *pulFailLimit,
+                         ULONG *pulBackoffMaxMs );
+// ---------------------------------------------52
+
+
+//--- K8055_GetPlugStats --------------------------------------
+//                                            Export Index 53
+/**
+* \brief 'K8055_GetPlugStats()' tells whether a K8055 is lost
+* right now and what its outages cost.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulState'
+*          - Returns PLUG_UP (0) or PLUG_LOST (1), the
+*          Recovery Thread is at work.
+*
+* \param   'pulOutages'
+*          - Returns the number of outages recovered.
+*
+* \param   'pulOutageMs'
+*          - Returns the time from the first failed transfer
+*          to the recovery of the last outage in ms. While the
+*          board is lost, the time so far.
+*
+* \param   'pulOutageTotalMs'
+*          - Returns the time of all outages recovered in ms.
+*
+* \param   'pulSamplesLost'
+*          - Returns the number of EP81 reports that failed
+*          during outages, the current one included.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*/
+ULONG K8055_GetPlugStats( ULONG *pulFileDesc,
+                          ULONG *pulState,
+                          ULONG *pulOutages,
+                          ULONG *pulOutageMs,
+                          ULONG *pulOutageTotalMs,
+                          ULONG *pulSamplesLost    );
+// ---------------------------------------------53
+
+//--- K8055_ReadInputsTimed -----------------------------------
+//                                            Export Index 54
+/**
+* \brief 'K8055_ReadInputsTimed()' reads Ix, A1 and A2 like
+* 'K8055_ReadAllInputs()', but returns within a timeout.
+*
+* The timed calls hand their transfer over to the I/O Worker
+* of the board, a thread started with the first timed call,
+* and wait for it up to the timeout. 'DosWrite()' itself
+* cannot be interrupted. If the time is up, the call returns
+* ERROR_DEADLINE and the transfer is given up: its result is
+* thrown away and it counts as failed transfer for the
+* recovery (see 'K8055_SetRecovery()'), which opens the
+* device again and so ends the transfer. Until the hung
+* transfer has returned, all timed calls to the board fail
+* at once with ERROR_DEADLINE.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulTimeoutMs'
+*          - 1..TIMED_TIMEOUT_MAX_MS (60000) ms. Waiting for
+*          the locks of the board counts as well.
+*
+* \param   'pulDigitalInputsIx', 'pulAnalogInputA1',
+*          'pulAnalogInputA2'
+*          - Return the inputs, see 'K8055_ReadAllInputs()'.
+*          Not changed if the call fails.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x020  ERROR_BYTE_NUMBER Not 8 bytes received.
+*
+*   0x040  ERROR_TOGGLE_BIT  No new report.
+*
+*   0x080  ERROR_RANGE       Timeout out of range.
+*
+*   0x100  ERROR_FROM_CALL   'DosWrite()' failed, or the I/O
+*                            Worker could not be started.
+*
+*   0x800  ERROR_DEADLINE    Time was up, the transfer was
+*                            given up.
+*
+*   0x1000 ERROR_BREAKER     Circuit breaker open, see
+*                            'K8055_SetBreaker()'.
+*
+*/
+ULONG K8055_ReadInputsTimed( ULONG *pulFileDesc,
+                             ULONG *pulTimeoutMs,
+                             ULONG *pulDigitalInputsIx,
+                             ULONG *pulAnalogInputA1,
+                             ULONG *pulAnalogInputA2 );
+// ---------------------------------------------54
+
+
+//--- K8055_WriteOutputsTimed ---------------------------------
+//                                            Export Index 55
+/**
+* \brief 'K8055_WriteOutputsTimed()' writes DO and both DACs
+* with one EP01 frame, within a timeout. A following
+* 'K8055_SetAllOutputs()' keeps the values, unless the
+* application changed these outputs in its Data Buffer.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulTimeoutMs'
+*          - 1..TIMED_TIMEOUT_MAX_MS (60000) ms. Waiting for
+*          the locks of the board counts as well.
+*
+* \param   'pulDigitalOut', 'pulDac1', 'pulDac2'
+*          - New outputs, 0..255 each.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Value or timeout out of range.
+*
+*   0x100  ERROR_FROM_CALL   'DosWrite()' failed, or the I/O
+*                            Worker could not be started.
+*
+*   0x800  ERROR_DEADLINE    Time was up. The transfer was
+*                            given up, see
+*                            'K8055_ReadInputsTimed()'.
+*
+*   0x1000 ERROR_BREAKER     Circuit breaker open, see
+*                            'K8055_SetBreaker()'.
+*
+*/
+ULONG K8055_WriteOutputsTimed( ULONG *pulFileDesc,
+                               ULONG *pulTimeoutMs,
+                               ULONG *pulDigitalOut,
+                               ULONG *pulDac1,
+                               ULONG *pulDac2        );
+// ---------------------------------------------55
+
+
+//--- K8055_ExchangeTimed -------------------------------------
+//                                            Export Index 56
+/**
+* \brief 'K8055_ExchangeTimed()' writes the outputs and reads
+* the inputs right after, both within one timeout. One call
+* per cycle of a control loop.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulTimeoutMs'
+*          - 1..TIMED_TIMEOUT_MAX_MS (60000) ms. Waiting for
+*          the locks of the board counts as well.
+*
+* \param   'pulDigitalOut', 'pulDac1', 'pulDac2'
+*          - New outputs, see 'K8055_WriteOutputsTimed()'.
+*
+* \param   'pulDigitalInputsIx', 'pulAnalogInputA1',
+*          'pulAnalogInputA2'
+*          - Return the inputs, see 'K8055_ReadInputsTimed()'.
+*
+* \return  - Return Code, see 'K8055_ReadInputsTimed()'.
+*          If the write fails, nothing is read.
+*
+*/
+ULONG K8055_ExchangeTimed( ULONG *pulFileDesc,
+                           ULONG *pulTimeoutMs,
+                           ULONG *pulDigitalOut,
+                           ULONG *pulDac1,
+                           ULONG *pulDac2,
+                           ULONG *pulDigitalInputsIx,
+                           ULONG *pulAnalogInputA1,
+                           ULONG *pulAnalogInputA2   );
+// ---------------------------------------------56
+
+
+//--- K8055_InitTimed -----------------------------------------
+//                                            Export Index 57
+/**
+* \brief 'K8055_InitTimed()' initialises a K8055 like
+* 'K8055_Init()', within a timeout. The init takes more than
+* one second by itself.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulTimeoutMs'
+*          - 1..TIMED_TIMEOUT_MAX_MS (60000) ms. Waiting for
+*          the locks of the board counts as well.
+*
+* \return  - Return Code, see 'K8055_Init()', and
+*
+*   0x080  ERROR_RANGE       Timeout out of range.
+*
+*   0x800  ERROR_DEADLINE    Time was up. The transfer was
+*                            given up, see
+*                            'K8055_ReadInputsTimed()'.
+*
+*   0x1000 ERROR_BREAKER     Circuit breaker open, see
+*                            'K8055_SetBreaker()'.
+*
+*/
+ULONG K8055_InitTimed( ULONG *pulFileDesc,
+                       ULONG *pulTimeoutMs );
+// ---------------------------------------------57
+
+//--- K8055_SetRetryPolicy ------------------------------------
+//                                            Export Index 58
+/**
+* \brief 'K8055_SetRetryPolicy()' sets how failed EP81 reads
+* of a K8055 are retried inside the library.
+*
+* A failed report is transferred again inside the call.
+* During the pause before a retry the board and the shared
+* buffers are not locked, other threads go on with their
+* transfers. Before the first retry the
+* library pauses 'pulBackoffUs', before every further one
+* twice as long as before. The policy holds for
+* 'K8055_ReadAllInputs()' and for all threads of the library
+* that read reports (acquisition, scan engines, group
+* sampling, timed calls). Without this call a read takes one
+* transfer, as before.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulAttempts'
+*          - Transfers per read 1..RETRY_ATTEMPTS_MAX (8), the
+*          first one included. 1 switches retries off.
+*
+* \param   'pulBackoffUs'
+*          - Pause before the first retry,
+*          0..RETRY_BACKOFF_MAX_US (100000) us. No pause is
+*          longer than the maximum.
+*
+* \param   'pulRetryOn'
+*          - Error bits a retry is made for, any of
+*          ERROR_TOGGLE_BIT, ERROR_BYTE_NUMBER and
+*          ERROR_FROM_CALL. A read failing with another bit
+*          is not retried.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Value out of range.
+*
+*/
+ULONG K8055_SetRetryPolicy( ULONG *pulFileDesc,
+                            ULONG *pulAttempts,
+                            ULONG *pulBackoffUs,
+                            ULONG *pulRetryOn    );
+// ---------------------------------------------58
+
+
+//--- K8055_GetRetryStats -------------------------------------
+//                                            Export Index 59
+/**
+* \brief 'K8055_GetRetryStats()' copies the retry statistics
+* of a K8055: a histogram of the retries per read, the
+* retries per error bit and the longest time a read spent in
+* retries.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pStats'
+*          - Receives the statistics (see 'retry.h').
+*
+* \param   'pulReset'
+*          - Not 0: the statistics start from 0 again.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*/
+struct _RETRYSTATS;
+ULONG K8055_GetRetryStats( ULONG *pulFileDesc,
+                           struct _RETRYSTATS *pStats,
+                           ULONG *pulReset             );
+// ---------------------------------------------59
+
+
+//--- K8055_SetBreaker ----------------------------------------
+//                                            Export Index 60
+/**
+* \brief 'K8055_SetBreaker()' sets the circuit breaker of a
+* K8055. The library keeps the health of every board: error
+* counts per bit, failures and Toggle Bit errors in a row,
+* the error rate of the last HEALTH_WINDOW (64) transfers and
+* the latencies (see 'K8055_GetHealth()').
+*
+* The breaker opens after 'pulTripFails' failed transfers in
+* a row or, once 64 transfers are known, if at least
+* 'pulTripPercent' of them failed. While it is open,
+* 'K8055_ReadAllInputs()', 'K8055_SetAllOutputs()' and the
+* timed calls return ERROR_BREAKER at once. The first call
+* after 'pulCooldownMs' makes one probe read. If it works, the
+* breaker closes and the call goes on, if not, the breaker
+* stays open for another cooldown. Without this call the
+* breaker never opens, as before.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulTripFails'
+*          - Failures in a row, 0..BREAKER_FAILS_MAX (100).
+*          0 switches the breaker off and closes it.
+*
+* \param   'pulTripPercent'
+*          - Error rate in percent, 0..100. 0 does not trip by
+*          rate.
+*
+* \param   'pulCooldownMs'
+*          - BREAKER_COOLDOWN_MIN_MS..BREAKER_COOLDOWN_MAX_MS
+*          (10..600000) ms.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Value out of range.
+*
+*/
+ULONG K8055_SetBreaker( ULONG *pulFileDesc,
+                        ULONG *pulTripFails,
+                        ULONG *pulTripPercent,
+                        ULONG *pulCooldownMs   );
+// ---------------------------------------------60
+
+
+//--- K8055_GetHealth -----------------------------------------
+//                                            Export Index 61
+/**
+* \brief 'K8055_GetHealth()' copies the health of a K8055:
+* the state of the circuit breaker, a score 0..100 (100 minus
+* the recent error rate, 0 while the breaker is not closed),
+* the error counts, the runs of failures and Toggle Bit
+* errors and the 50th, 90th and 99th percentile of the
+* transfer latencies. The percentiles are the upper bounds of
+* power of two buckets.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pHealthStats'
+*          - Receives the health (see 'health.h').
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*/
+struct _HEALTHSTATS;
+ULONG K8055_GetHealth( ULONG *pulFileDesc,
+                       struct _HEALTHSTATS *pHealthStats );
+// ---------------------------------------------61
+
+
+//--- K8055_SetStats ------------------------------------------
+//                                            Export Index 62
+/**
+* \brief 'K8055_SetStats()' switches the call statistics of
+* all boards on or off. While they are on, every call of
+* 'K8055_Open()', 'K8055_Init()' (as a whole and each of its
+* steps), 'K8055_Read()', 'K8055_Write()',
+* 'K8055_ReadAllInputs()' and 'K8055_SetAllOutputs()', and
+* every EP81 read and EP01 write the library makes on its own
+* is counted with its error bits and its latency. While they
+* are off, which is the default, a call costs one test more.
+*
+* \param   'pulEnable'
+*          - 1 on, 0 off.
+*
+* \param   'pulReset'
+*          - Not 0: all statistics start from 0 again.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x080  ERROR_RANGE       Value out of range.
+*
+*/
+ULONG K8055_SetStats( ULONG *pulEnable,
+                      ULONG *pulReset   );
+// ---------------------------------------------62
+
+
+//--- K8055_GetStats ------------------------------------------
+//                                            Export Index 63
+/**
+* \brief 'K8055_GetStats()' copies the statistics of one call
+* of a K8055: number of calls, calls with errors, a count for
+* every error bit, minimum, maximum and average latency, the
+* 50th, 90th and 99th percentile and the latency histogram.
+*
+* The histogram is log-linear: 0..7 us have a bucket of their
+* own, above every power of two is split into four buckets
+* (see 'stats.h'). The percentiles are the upper bounds of
+* their buckets, less than 25 % above the true value.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulCall'
+*          - The call, STAT_OPEN .. STAT_CALLS - 1
+*          (see 'stats.h').
+*
+* \param   'pCallStats'
+*          - Receives the statistics.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or K8055 not opened.
+*
+*   0x080  ERROR_RANGE       Unknown call.
+*
+*/
+struct _CALLSTATS;
+ULONG K8055_GetStats( ULONG *pulFileDesc,
+                      ULONG *pulCall,
+                      struct _CALLSTATS *pCallStats );
+// ---------------------------------------------63
+
+
+//--- K8055_GetTrace ------------------------------------------
+//                                            Export Index 64
+/**
+* \brief 'K8055_GetTrace()' copies entries of the packet
+* trace. The library records every Setup Packet and every
+* Parameter Packet of all boards, with the bytes after the
+* transfer, the return value of 'DosWrite()', the start time
+* and the duration, in a ring of the last TRACE_ENTRIES (256)
+* transfers. The trace is always on, it takes no lock.
+*
+* Every entry has got a sequence number 1, 2, 3 .. An
+* application that follows the trace passes the number
+* returned by the last call. Entries that were overwritten
+* before they were copied are missing, which shows as a gap.
+*
+* \param   'pulFromSeq'
+*          - In: first sequence number wanted, 0 for the
+*          oldest entry in the ring.
+*          Out: sequence number to pass next time.
+*
+* \param   'pEntries'
+*          - Receives the entries (see 'trace.h').
+*
+* \param   'pulCount'
+*          - In: entries 'pEntries' can hold.
+*          Out: entries copied.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*/
+struct _TRACEENTRY;
+ULONG K8055_GetTrace( ULONG *pulFromSeq,
+                      struct _TRACEENTRY *pEntries,
+                      ULONG *pulCount                );
+// ---------------------------------------------64
+
+
+//--- K8055_DumpTrace -----------------------------------------
+//                                            Export Index 65
+/**
+* \brief 'K8055_DumpTrace()' writes all entries of the packet
+* trace to a binary file, the oldest first. The file is
+* decoded offline by 'tools/k8055trc.exe'.
+*
+* \param   'pszFileName'
+*          - Name of the file. An existing file is
+*          overwritten.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x100  ERROR_FROM_CALL   The file could not be written.
+*
+*/
+ULONG K8055_DumpTrace( CHAR *pszFileName );
+// ---------------------------------------------65
+
+
+//--- K8055_SetProbes -----------------------------------------
+//                                            Export Index 66
+/**
+* \brief 'K8055_SetProbes()' hands over a hook that is called
+* at the static probe points of the library, and chooses the
+* probe points (see 'probe.h'):
+*
+*   PROBE_XFER_SUBMIT   A transfer starts.
+*   PROBE_XFER_DONE     A transfer is over.
+*   PROBE_TOGGLE_MISS   An EP81 report without a new Toggle
+*                       Bit.
+*   PROBE_RETRY         A failed EP81 read is retried.
+*   PROBE_INIT_STEP     A step of 'K8055_Init()' starts.
+*   PROBE_INIT_STEP_END A step of 'K8055_Init()' is over.
+*
+* The hook gets the probe number, the handle of the K8055,
+* two values that depend on the probe point, the library
+* clock in microseconds (lower 32 bits) and 'pvUser'. It is
+* called by the thread at the probe point, often with the
+* transfer lock of the board owned, so it must return
+* quickly and must not call the library.
+*
+* The call returns after all running calls of the old hook
+* are over. After a call with NULL the old hook is not
+* called any more.
+*
+* A probe point that is off costs one test. A DLL built with
+* 'K8055_NO_PROBES' defined has got no probe points at all,
+* the call then has no effect.
+*
+* \param   'pfnHook'
+*          - The hook. NULL switches all probe points off.
+*
+* \param   'pvUser'
+*          - Handed over to 'pfnHook' unchanged.
+*
+* \param   'pulMask'
+*          - Bit 1 << PROBE_xxx for every probe point wanted,
+*          PROBE_MASK_ALL (0x3F) for all.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x080  ERROR_RANGE       Unknown probe point in the mask.
+*
+*/
+typedef VOID ( APIENTRY *PFNK8055PROBE )
+                          ( ULONG ulProbe,
+                            ULONG ulHandle,
+                            ULONG ulArg1,
+                            ULONG ulArg2,
+                            ULONG ulTimeUs,
+                            VOID *pvUser    );
+
+ULONG K8055_SetProbes( PFNK8055PROBE pfnHook,
+                       VOID *pvUser,
+                       ULONG *pulMask         );
+// ---------------------------------------------66
+
+
+//--- K8055_StartSpans ----------------------------------------
+//                                            Export Index 67
+/**
+* \brief 'K8055_StartSpans()' starts the span recorder. From
+* now on the library writes a timeline of its work to a file
+* in the trace event format of Chrome ( JSON ), to be opened
+* by 'chrome://tracing' or Perfetto:
+*
+*  - the calls 'K8055_Init()' with each of its steps and
+*    'delay()', 'K8055_Read()', 'K8055_Write()',
+*    'K8055_ReadAllInputs()' and 'K8055_SetAllOutputs()',
+*  - every transfer via EP0, EP01 and EP81,
+*  - the pauses before a retry,
+*  - the ticks of the Scheduler and the logic of the Scan
+*    Engines.
+*
+* Every board is a track of its own ( 'Board slot N' ), the
+* ticks of the Scheduler and the logic of the Scan Engines
+* are on the track 'Library'. A Flush Thread writes the
+* spans every SPAN_FLUSH_MS (100) ms, the memory used is
+* fixed ( SPAN_EVENTS spans, see 'span.h' ). Spans that did
+* not fit are lost and marked in the file.
+*
+* \param   'pszFileName'
+*          - Name of the file. An existing file is
+*          overwritten.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x100  ERROR_FROM_CALL   The file could not be opened or
+*                            the Flush Thread not started.
+*
+*   0x400  ERROR_CONFLICT    The recorder is running already.
+*
+*/
+ULONG K8055_StartSpans( CHAR *pszFileName );
+// ---------------------------------------------67
+
+
+//--- K8055_StopSpans -----------------------------------------
+//                                            Export Index 68
+/**
+* \brief 'K8055_StopSpans()' stops the span recorder, writes
+* the spans left and closes the file.
+*
+* \param   'pulLost'
+*          - Receives the number of spans lost because the
+*          buffer was full.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x100  ERROR_FROM_CALL   The file could not be written.
+*
+*   0x400  ERROR_CONFLICT    The recorder is not running.
+*
+*/
+ULONG K8055_StopSpans( ULONG *pulLost );
+// ---------------------------------------------68
+
+
+//--- K8055_SetEmulation --------------------------------------
+//                                            Export Index 69
+/**
+* \brief 'K8055_SetEmulation()' sets the timing of an
+* emulated K8055. 'K8055_Open()' with the device name
+* 'EMUL0' .. 'EMUL3' opens an emulated K8055 instead of one
+* served by 'usbecd.sys' ( see 'emul.c' ). It answers all
+* transfers like a K8055, for benchmarks and tests without
+* a board. It starts without latency and with one report
+* per 10 ms. Counter 1 counts the reports, also those never
+* read, so a gap in it shows missed reports. The waits block
+* the caller like a real transfer. They end on a timer tick
+* of OS/2, so times below a tick of about 32 ms are
+* stretched to it.
+*
+* \param   'pulFileDesc'
+*          - An emulated K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulLatencyUs'
+*          - Time every transfer takes, 0..EMUL_TIME_MAX_US
+*          (1000000) us.
+*
+* \param   'pulJitterUs'
+*          - Random time on top of 'pulLatencyUs',
+*          0..EMUL_TIME_MAX_US us.
+*
+* \param   'pulReportUs'
+*          - Interval of the reports via EP81,
+*          0..EMUL_TIME_MAX_US us. A read before the next
+*          report is due waits for it. 0 hands out a new
+*          report with every read.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or the K8055 is not emulated.
+*
+*   0x080  ERROR_RANGE       A time is too long.
+*
+*/
+ULONG K8055_SetEmulation( ULONG *pulFileDesc,
+                          ULONG *pulLatencyUs,
+                          ULONG *pulJitterUs,
+                          ULONG *pulReportUs   );
+// ---------------------------------------------69
+
+
+//--- K8055_MeasureLoopback -----------------------------------
+//                                            Export Index 70
+/**
+* \brief 'K8055_MeasureLoopback()' measures the latency from
+* an output to an input wired to it, on a test rig or on an
+* emulated K8055 ( see 'K8055_SetEmulationWiring()' ).
+* The output is changed '*pulRepeats' times via
+* 'byaPutData[]' and 'K8055_SetAllOutputs()', like an
+* application does. After each change reports are read with
+* 'K8055_ReadAllInputs()' until the input shows it. The
+* time from the start of the write to the end of that read
+* is one sample ( see 'loop.c' ).
+*
+* A digital output is toggled. DAC1 is stepped between
+* LOOP_DAC_LOW (0x40) and LOOP_DAC_HIGH (0xC0), A1 has seen
+* the step when it crossed LOOP_DAC_MID (0x80). The other
+* outputs keep their values, the output measured gets its
+* value back at the end.
+*
+* The call takes about two report intervals per change,
+* some 20 s for 1000 changes.
+*
+* \param   'pulFileDesc'
+*          - A K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulOutput'
+*          - 1..8: digital output DO1..DO8,
+*          LOOP_DAC1 (9): DAC1.
+*
+* \param   'pulInput'
+*          - 1..5: digital input I1..I5, for a digital
+*          output. LOOP_A1 (6): A1, for DAC1.
+*
+* \param   'pulRepeats'
+*          - Number of changes, 1 or more.
+*
+* \param   'paulLatencyUs'
+*          - Array of '*pulRepeats' ULONG of the caller,
+*          gets the latency of each change in us. A change
+*          not seen within LOOP_TIMEOUT_US (1 s) gets
+*          LOOP_LOST (0xFFFFFFFF).
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems.
+*
+*   0x080  ERROR_RANGE       Output, input or number of
+*                            changes out of range, or DAC1
+*                            not with A1.
+*
+*   0x100  ERROR_FROM_CALL   A transfer failed.
+*
+*   0x800  ERROR_DEADLINE    A change was lost. If already
+*                            the start level or the first
+*                            change did not show, the
+*                            wiring is missing and the
+*                            measurement ends.
+*
+*/
+ULONG K8055_MeasureLoopback( ULONG *pulFileDesc,
+                             ULONG *pulOutput,
+                             ULONG *pulInput,
+                             ULONG *pulRepeats,
+                             ULONG *paulLatencyUs );
+// ---------------------------------------------70
+
+
+//--- K8055_SetEmulationWiring --------------------------------
+//                                            Export Index 71
+/**
+* \brief 'K8055_SetEmulationWiring()' wires outputs of an
+* emulated K8055 to its inputs, like on a test rig, so
+* 'K8055_MeasureLoopback()' runs without a board. An output
+* shows in the first report made after it was written.
+* Without wiring the inputs stay 0.
+*
+* \param   'pulFileDesc'
+*          - An emulated K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulWiring'
+*          - EMUL_WIRE_NONE (0), or any of
+*          EMUL_WIRE_DO  (0x0001)  DO1..DO5 drive I1..I5,
+*          EMUL_WIRE_DAC (0x0002)  DAC1 drives A1,
+*                                  DAC2 drives A2.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or the K8055 is not emulated.
+*
+*   0x080  ERROR_RANGE       Unknown bits in '*pulWiring'.
+*
+*/
+ULONG K8055_SetEmulationWiring( ULONG *pulFileDesc,
+                                ULONG *pulWiring    );
+// ---------------------------------------------71
+
+
+//--- K8055_SetEmulationFault ---------------------------------
+//                                            Export Index 72
+/**
+* \brief 'K8055_SetEmulationFault()' injects a fault into the
+* transfers of an emulated K8055, to see how the library
+* notices it and recovers. The fault hits a transfer with a
+* probability of '*pulPerMille' per mille, within a window of
+* '*pulLengthMs' starting '*pulStartMs' from now and repeated
+* every '*pulPeriodMs'. Each fault has got a setting of its
+* own, a new call replaces it.
+*
+* A board pulled out by EMUL_FAULT_UNPLUG fails every
+* transfer with ERROR_FROM_CALL until the window ends and
+* the Recovery Thread ( see 'K8055_SetRecovery()' ) has opened
+* it again. It then starts with inputs, outputs and counters
+* at 0, the Recovery Thread writes the last outputs again.
+*
+* \param   'pulFileDesc'
+*          - An emulated K8055 opened by 'K8055_Open()'.
+*
+* \param   'pulFault'
+*          - EMUL_FAULT_TOGGLE (0)  Report without a new
+*                                   Toggle Bit.
+*            EMUL_FAULT_BYTES  (1)  Report with 7 bytes at
+*                                   offset 6 instead of 8.
+*            EMUL_FAULT_XFER   (2)  'DosWrite()' fails.
+*            EMUL_FAULT_DELAY  (3)  Transfer takes 50 ms
+*                                   longer.
+*            EMUL_FAULT_UNPLUG (4)  Board pulled out.
+*
+* \param   'pulPerMille'
+*          - 0..1000, 0 switches the fault off, 1000 hits
+*          every transfer within the window.
+*
+* \param   'pulStartMs'
+*          - Start of the first window in ms from now.
+*
+* \param   'pulLengthMs'
+*          - Length of a window in ms, 0 for no end.
+*
+* \param   'pulPeriodMs'
+*          - The window repeats every '*pulPeriodMs' ms, 0
+*          for once. Not shorter than the window.
+*
+* \return  - Return Code.
+*          Meaning of bits listed below:
+*
+*   0x000  RET_OK            Call returned with no error.
+*
+*   0x002  ERROR_POINTER     Indicating parameter problems,
+*                            or the K8055 is not emulated.
+*
+*   0x080  ERROR_RANGE       Unknown fault, '*pulPerMille'
+*                            above 1000, or a period shorter
+*                            than the window or without one.
+*
+*/
+ULONG K8055_SetEmulationFault( ULONG *pulFileDesc,
+                               ULONG *pulFault,
+                               ULONG *pulPerMille,
+                               ULONG *pulStartMs,
+                               ULONG *pulLengthMs,
+                               ULONG *pulPeriodMs  );
+// ---------------------------------------------72
+
+
+//
+// -- Functions that are exported --------------- * -- END ----
+
+
+
+
+
+// -- Functions that are not exported --------- + -- BEGIN ----
+//
+//--- Setup routines, used by K8055_Init ----------------------
+//    - Reading descriptors
+//
+ULONG GetDeviceDescriptor( ULONG ulDevpointer );
+ULONG GetConfigurationDescriptor( ULONG ulDevpointer );
+ULONG GetLanguageDescriptor( ULONG ulDevpointer );
+ULONG Get4thStringDescriptor( ULONG ulDevpointer );
+ULONG GetString2Descriptor( ULONG ulDevpointer );
+ULONG DoUnknown21( ULONG ulDevpointer );
+ULONG DoUnknown30Bytes( ULONG ulDevpointer );
+
+//--- Init of a lost K8055, used by the Recovery Thread -------
+//    Called with 'BoardLockXfer()' owned
+//
+ULONG InitBoard( ULONG ulDevpointer );
 
 //--- Setup routines, used by K8055_Init ----------------------
 //    - Setting configuration
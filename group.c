@@ -0,0 +1,629 @@
+//======================================= group.c === BEGIN ===
+/**
+ * \file  'group.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Group transfers: several K8055 at the same moment.
+ *
+ * Writing the outputs of four boards one after the other
+ * lets the last board switch up to four USB round trips
+ * after the first one. Reading them one after the other
+ * gives samples up to 40 ms apart.
+ *
+ * Every board taking part in a group transfer gets a Group
+ * Worker, a thread of its own. For a transfer, every worker
+ * gets its job, takes the transfer lock of its board and
+ * reports ready. When all workers are ready, one event
+ * semaphore releases all of them at once ("barrier"), and
+ * the EP01 writes or EP81 reads run side by side. The time
+ * each transfer started and ended is taken, the spread of
+ * these times over the boards is the skew of the group.
+ *
+ * The workers stay until their board is closed.
+ *
+ * \version 1.0.2 -
+ * 2026-10-19 the hold of a Group Worker is released during
+ * the pause of a retry
+ * \version 1.0.1 -
+ * 2026-10-18 group sampling, 'K8055_GroupSample()'
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "group.h"
+
+
+/**
+* \brief Group Worker of one K8055
+*/
+typedef struct _GROUPWORKER
+{
+  volatile BOOL blRun;
+  TID        tid;
+  HEV        hevArm;        // A job is waiting
+  HEV        hevReady;      // Lock taken, waiting for 'hevGo'
+  HEV        hevDone;       // Job done
+
+  // -- Job
+  ULONG      ulAction;      // GROUP_WRITE or GROUP_READ
+  GROUPFRAME Frame;
+  BYTE       byaData[ SIZEBUFFERMAX ];
+  ULONG      ulRcXfer;
+  K8055TIME  tmStart;
+  K8055TIME  tmDone;
+} GROUPWORKER;
+
+/**
+* \brief Data shared by all Group Workers
+*/
+typedef struct _GROUPDATA
+{
+  HMTX       hmtx;          // One group transfer at a time
+  HEV        hevGo;         // The barrier
+
+  // -- Statistics of 'K8055_GroupCommit()'
+  ULONG      ulCommits;
+  K8055TIME  tmSkewLast;
+  K8055TIME  tmSkewMax;
+  K8055TIME  tmSkewSum;
+  K8055TIME  tmIssueMax;
+
+  // -- Sequence number of 'K8055_GroupSample()'
+  ULONG      ulSamples;
+} GROUPDATA;
+
+
+//-----------------------------------------------------------//
+//--- Group data, workers indexed by Board Slot -------------//
+//
+GROUPDATA   Group;
+GROUPWORKER aWorker[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Creates the lock and the barrier, once.
+*/
+static VOID GroupInit( VOID )
+{
+  DosEnterCritSec();
+  if ( Group.hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &Group.hmtx, 0, FALSE );
+    DosCreateEventSem( NULL, &Group.hevGo, 0, FALSE );
+  }
+  DosExitCritSec();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of a Group Worker.
+*
+* \param    'pvSlot'
+*           - Board Slot, passed as a pointer value.
+*/
+static VOID GroupWorker( VOID *pvSlot )
+{
+  ULONG ulSlot;
+  ULONG ulPostCount;
+  GROUPWORKER *pWorker;
+
+  ulSlot = (ULONG)pvSlot;
+  pWorker = &aWorker[ ulSlot ];
+
+  DosSetPriority( PRTYS_THREAD, PRTYC_TIMECRITICAL, 0, 0 );
+
+  while ( TRUE )
+  {
+    DosWaitEventSem( pWorker->hevArm, SEM_INDEFINITE_WAIT );
+    DosResetEventSem( pWorker->hevArm, &ulPostCount );
+    if ( pWorker->blRun == FALSE )
+    {
+      break;
+    }
+
+    // -- Nothing left to wait for after the barrier. The
+    //    transfer takes the lock once more, a retry pause
+    //    releases both holds ( see 'RetryAgain()' ). --
+    BoardLockXfer( ulSlot );
+    DosPostEventSem( pWorker->hevReady );
+    DosWaitEventSem( Group.hevGo, SEM_INDEFINITE_WAIT );
+
+    pWorker->tmStart = TimeNowUs();
+    if ( pWorker->ulAction == GROUP_READ )
+    {
+      pWorker->ulRcXfer = BoardReadReport( ulSlot,
+                                           &pWorker->byaData[0] );
+    }
+    else
+    {
+      pWorker->ulRcXfer =
+          BoardWriteFrame( ulSlot,
+                           pWorker->Frame.ulDigitalOut,
+                           pWorker->Frame.ulDac1,
+                           pWorker->Frame.ulDac2        );
+    }
+    pWorker->tmDone = TimeNowUs();
+    BoardUnlockXfer( ulSlot );
+
+    // -- Alarms, reflex rules and PID controllers see the
+    //    report like one of the Acquisition Thread. Not
+    //    under the transfer lock, see 'BoardReportIn()'. --
+    if ( ( pWorker->ulAction == GROUP_READ ) &&
+         ( pWorker->ulRcXfer == RET_OKAY ) )
+    {
+      BoardReportIn( ulSlot, &pWorker->byaData[0],
+                     pWorker->tmDone );
+    }
+
+    DosPostEventSem( pWorker->hevDone );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Starts the Group Worker of a board, if it does
+*           not run. Called with 'Group.hmtx' owned.
+*
+* \return   RET_OKAY or ERROR_FROM_CALL
+*/
+static ULONG GroupStart( ULONG ulSlot )
+{
+  INT iTid;
+  ULONG ulPostCount;
+  GROUPWORKER *pWorker;
+
+  pWorker = &aWorker[ ulSlot ];
+  if ( pWorker->blRun == TRUE )
+  {
+    return RET_OKAY;
+  }
+
+  if ( pWorker->hevArm == 0 )
+  {
+    DosCreateEventSem( NULL, &pWorker->hevArm, 0, FALSE );
+    DosCreateEventSem( NULL, &pWorker->hevReady, 0, FALSE );
+    DosCreateEventSem( NULL, &pWorker->hevDone, 0, FALSE );
+  }
+  DosResetEventSem( pWorker->hevArm, &ulPostCount );
+
+  pWorker->blRun = TRUE;
+  iTid = _beginthread( GroupWorker, NULL, THREAD_STACK_SIZE,
+                       (VOID *)ulSlot );
+  if ( iTid == -1 )
+  {
+    pWorker->blRun = FALSE;
+    return ERROR_FROM_CALL;
+  }
+  pWorker->tid = (TID)iTid;
+
+  return RET_OKAY;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardDetach()'. The Group Worker of the
+*           board ends.
+*/
+VOID GroupDetach( ULONG ulSlot )
+{
+  TID tidWorker;
+  GROUPWORKER *pWorker;
+
+  if ( Group.hmtx == 0 )
+  {
+    return;
+  }
+  pWorker = &aWorker[ ulSlot ];
+
+  DosRequestMutexSem( Group.hmtx, SEM_INDEFINITE_WAIT );
+  if ( pWorker->blRun == TRUE )
+  {
+    pWorker->blRun = FALSE;
+    DosPostEventSem( pWorker->hevArm );
+    tidWorker = pWorker->tid;
+    DosWaitThread( &tidWorker, DCWW_WAIT );
+    pWorker->tid = 0;
+  }
+  DosReleaseMutexSem( Group.hmtx );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Checks the handles of a group transfer and turns
+*           them into Board Slots.
+*
+* \return   RET_OKAY, ERROR_POINTER or ERROR_RANGE
+*/
+static ULONG GroupSlots( ULONG ulCount,
+                         ULONG *pulFileDescs,
+                         ULONG *pulSlots      )
+{
+  ULONG ulIndex;
+  ULONG ulOther;
+
+  if ( ( ulCount < 1 ) || ( ulCount > K8055_MAX_BOARDS ) )
+  {
+    return ERROR_RANGE;
+  }
+
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pulSlots[ ulIndex ] = BoardSlot( pulFileDescs[ ulIndex ] );
+    if ( pulSlots[ ulIndex ] == BOARD_NONE )
+    {
+      return ERROR_POINTER;
+    }
+    for ( ulOther = 0; ulOther < ulIndex; ulOther++ )
+    {
+      if ( pulSlots[ ulOther ] == pulSlots[ ulIndex ] )
+      {
+        return ERROR_RANGE;
+      }
+    }
+  }
+
+  return RET_OKAY;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Runs one group transfer: arms the workers of all
+*           boards, waits until all hold their transfer lock,
+*           releases them and waits until all are done.
+*           Called with 'Group.hmtx' owned, the jobs of the
+*           workers are set.
+*
+* \return   RET_OKAY or ERROR_FROM_CALL, if a worker could
+*           not be started. Nothing is transferred then.
+*/
+static ULONG GroupRun( ULONG ulCount, ULONG *pulSlots )
+{
+  ULONG ulRc;
+  ULONG ulIndex;
+  ULONG ulPostCount;
+  GROUPWORKER *pWorker;
+
+  ulRc = RET_OKAY;
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    ulRc = ulRc | GroupStart( pulSlots[ ulIndex ] );
+  }
+  if ( ulRc != RET_OKAY )
+  {
+    return ulRc;
+  }
+
+  // -- Arm all workers, wait until all hold their lock --
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pWorker = &aWorker[ pulSlots[ ulIndex ] ];
+    DosResetEventSem( pWorker->hevReady, &ulPostCount );
+    DosResetEventSem( pWorker->hevDone, &ulPostCount );
+    DosPostEventSem( pWorker->hevArm );
+  }
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pWorker = &aWorker[ pulSlots[ ulIndex ] ];
+    DosWaitEventSem( pWorker->hevReady, SEM_INDEFINITE_WAIT );
+  }
+
+  // -- Barrier --
+  DosPostEventSem( Group.hevGo );
+
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pWorker = &aWorker[ pulSlots[ ulIndex ] ];
+    DosWaitEventSem( pWorker->hevDone, SEM_INDEFINITE_WAIT );
+  }
+  DosResetEventSem( Group.hevGo, &ulPostCount );
+
+  return ulRc;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------49-
+//
+// Export Index 49
+/**
+* \brief 'K8055_GroupCommit()' writes the outputs of several
+* boards at the same moment. See 'func.h' for details.
+*/
+ULONG K8055_GroupCommit( ULONG *pulCount,
+                         ULONG *pulFileDescs,
+                         struct _GROUPFRAME *pFrames,
+                         ULONG *pulSkewUs           )
+{
+  ULONG ulRc;
+  ULONG ulIndex;
+  ULONG ulCount;
+  ULONG aulSlot[ K8055_MAX_BOARDS ];
+  K8055TIME tmStartMin;
+  K8055TIME tmStartMax;
+  K8055TIME tmDoneMin;
+  K8055TIME tmDoneMax;
+  GROUPWORKER *pWorker;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulCount ) ||
+       ( NULL == pulFileDescs ) ||
+       ( NULL == pFrames ) ||
+       ( NULL == pulSkewUs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulCount = *pulCount;
+  ulRc = ulRc | GroupSlots( ulCount, pulFileDescs, aulSlot );
+  if ( ulRc != RET_OKAY )
+  {
+    return ulRc;
+  }
+
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    if ( ( pFrames[ ulIndex ].ulDigitalOut > 0xFF ) ||
+         ( pFrames[ ulIndex ].ulDac1 > 0xFF ) ||
+         ( pFrames[ ulIndex ].ulDac2 > 0xFF ) )
+    {
+      ulRc = ulRc | ERROR_RANGE;
+      return ulRc;
+    }
+  }
+
+  GroupInit();
+  DosRequestMutexSem( Group.hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pWorker = &aWorker[ aulSlot[ ulIndex ] ];
+    pWorker->ulAction = GROUP_WRITE;
+    pWorker->Frame = pFrames[ ulIndex ];
+  }
+  ulRc = ulRc | GroupRun( ulCount, aulSlot );
+  if ( ulRc != RET_OKAY )
+  {
+    DosReleaseMutexSem( Group.hmtx );
+    return ulRc;
+  }
+
+  // -- Skew --
+  pWorker = &aWorker[ aulSlot[0] ];
+  tmStartMin = pWorker->tmStart;
+  tmStartMax = pWorker->tmStart;
+  tmDoneMin = pWorker->tmDone;
+  tmDoneMax = pWorker->tmDone;
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pWorker = &aWorker[ aulSlot[ ulIndex ] ];
+    if ( pWorker->ulRcXfer != NO_DOS_ERROR )
+    {
+      ulRc = ulRc | ERROR_FROM_CALL;
+    }
+    if ( pWorker->tmStart < tmStartMin )
+    {
+      tmStartMin = pWorker->tmStart;
+    }
+    if ( pWorker->tmStart > tmStartMax )
+    {
+      tmStartMax = pWorker->tmStart;
+    }
+    if ( pWorker->tmDone < tmDoneMin )
+    {
+      tmDoneMin = pWorker->tmDone;
+    }
+    if ( pWorker->tmDone > tmDoneMax )
+    {
+      tmDoneMax = pWorker->tmDone;
+    }
+  }
+
+  ++Group.ulCommits;
+  Group.tmSkewLast = tmDoneMax - tmDoneMin;
+  Group.tmSkewSum = Group.tmSkewSum + Group.tmSkewLast;
+  if ( Group.tmSkewLast > Group.tmSkewMax )
+  {
+    Group.tmSkewMax = Group.tmSkewLast;
+  }
+  if ( tmStartMax - tmStartMin > Group.tmIssueMax )
+  {
+    Group.tmIssueMax = tmStartMax - tmStartMin;
+  }
+  *pulSkewUs = (ULONG)Group.tmSkewLast;
+
+  DosReleaseMutexSem( Group.hmtx );
+
+  return ulRc;
+}
+//---------49-
+
+
+//----------------------------------------------------------50-
+//
+// Export Index 50
+/**
+* \brief 'K8055_GetGroupStats()' tells the skew of the group
+* commits so far. See 'func.h' for details.
+*/
+ULONG K8055_GetGroupStats( ULONG *pulCommits,
+                           ULONG *pulSkewMaxUs,
+                           ULONG *pulSkewAvgUs,
+                           ULONG *pulIssueMaxUs )
+{
+  ULONG ulRc;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulCommits ) ||
+       ( NULL == pulSkewMaxUs ) ||
+       ( NULL == pulSkewAvgUs ) ||
+       ( NULL == pulIssueMaxUs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  GroupInit();
+  DosRequestMutexSem( Group.hmtx, SEM_INDEFINITE_WAIT );
+  *pulCommits = Group.ulCommits;
+  *pulSkewMaxUs = (ULONG)Group.tmSkewMax;
+  *pulSkewAvgUs = 0;
+  if ( Group.ulCommits != 0 )
+  {
+    *pulSkewAvgUs = (ULONG)( Group.tmSkewSum / Group.ulCommits );
+  }
+  *pulIssueMaxUs = (ULONG)Group.tmIssueMax;
+  DosReleaseMutexSem( Group.hmtx );
+
+  return ulRc;
+}
+//---------50-
+
+
+//----------------------------------------------------------51-
+//
+// Export Index 51
+/**
+* \brief 'K8055_GroupSample()' reads the inputs of several
+* boards at the same moment into one record.
+* See 'func.h' for details.
+*/
+ULONG K8055_GroupSample( ULONG *pulCount,
+                         ULONG *pulFileDescs,
+                         struct _GROUPSAMPLE *pSample )
+{
+  ULONG ulRc;
+  ULONG ulIndex;
+  ULONG ulCount;
+  ULONG aulSlot[ K8055_MAX_BOARDS ];
+  BYTE *pbyData;
+  K8055TIME tmFirst;
+  K8055TIME tmLast;
+  GROUPWORKER *pWorker;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulCount ) ||
+       ( NULL == pulFileDescs ) ||
+       ( NULL == pSample ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulCount = *pulCount;
+  ulRc = ulRc | GroupSlots( ulCount, pulFileDescs, aulSlot );
+  if ( ulRc != RET_OKAY )
+  {
+    return ulRc;
+  }
+
+  GroupInit();
+  DosRequestMutexSem( Group.hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    aWorker[ aulSlot[ ulIndex ] ].ulAction = GROUP_READ;
+  }
+  ulRc = ulRc | GroupRun( ulCount, aulSlot );
+  if ( ulRc != RET_OKAY )
+  {
+    DosReleaseMutexSem( Group.hmtx );
+    return ulRc;
+  }
+
+  // -- Time of the sample: the first report that came in --
+  tmFirst = aWorker[ aulSlot[0] ].tmDone;
+  tmLast = tmFirst;
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pWorker = &aWorker[ aulSlot[ ulIndex ] ];
+    if ( pWorker->tmDone < tmFirst )
+    {
+      tmFirst = pWorker->tmDone;
+    }
+    if ( pWorker->tmDone > tmLast )
+    {
+      tmLast = pWorker->tmDone;
+    }
+  }
+
+  memset( pSample, 0, sizeof( GROUPSAMPLE ) );
+  pSample->ulBoards = ulCount;
+  pSample->ulSequence = ++Group.ulSamples;
+  pSample->ulTimeMs = (ULONG)( tmFirst / 1000 );
+  pSample->ulSkewUs = (ULONG)( tmLast - tmFirst );
+
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pWorker = &aWorker[ aulSlot[ ulIndex ] ];
+    pbyData = &pWorker->byaData[0];
+
+    pSample->aulFileDesc[ ulIndex ] = pulFileDescs[ ulIndex ];
+    pSample->aulRcRead[ ulIndex ] = pWorker->ulRcXfer;
+    pSample->aulOffsetUs[ ulIndex ] =
+      (ULONG)( pWorker->tmDone - tmFirst );
+
+    // -- A board without a valid report keeps zeros --
+    if ( pWorker->ulRcXfer != RET_OKAY )
+    {
+      ulRc = ulRc | pWorker->ulRcXfer;
+      continue;
+    }
+    pSample->ulDigitalIn = pSample->ulDigitalIn |
+      ( BoardDecodeIx( pbyData[0] ) << ( ulIndex * GROUP_INPUTS ) );
+    pSample->aulAnalog[ 2 * ulIndex ] = pbyData[2];
+    pSample->aulAnalog[ 2 * ulIndex + 1 ] = pbyData[3];
+    pSample->aulCounter[ 2 * ulIndex ] =
+      pbyData[4] + ( pbyData[5] << 8 );
+    pSample->aulCounter[ 2 * ulIndex + 1 ] =
+      pbyData[6] + ( pbyData[7] << 8 );
+  }
+
+  DosReleaseMutexSem( Group.hmtx );
+
+  return ulRc;
+}
+//---------51-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== group.c === END ===
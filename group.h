@@ -0,0 +1,74 @@
+/**
+ * \file 'group.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'group.h' is the headerfile belonging to 'group.c'.
+ * It provides the records of the group transfers, which
+ * serve several K8055 at the same moment.
+ *
+ * \version 1.0.1 -
+ * 2026-10-18 'GROUPSAMPLE'
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_GROUP_
+#define __K8055DD_H_GROUP_
+
+
+//-- Values belonging to group transfers -------- BEGIN --!
+//
+/**
+* \brief Job of a Group Worker
+*/
+#define GROUP_WRITE 0
+#define GROUP_READ  1
+
+/**
+* \brief Digital inputs per board in 'GROUPSAMPLE'
+*/
+#define GROUP_INPUTS 5
+//
+//-- Values belonging to group transfers ---------- END --!
+
+
+/**
+* \brief Outputs of one board for 'K8055_GroupCommit()'
+*/
+typedef struct _GROUPFRAME
+{
+  ULONG ulDigitalOut;    // 0..255
+  ULONG ulDac1;          // 0..255
+  ULONG ulDac2;          // 0..255
+} GROUPFRAME;
+
+
+/**
+* \brief Inputs of several boards, read at the same moment
+* by 'K8055_GroupSample()'. Index n of the arrays belongs to
+* the n-th handle given; A1 and A2 of board n are at 2n and
+* 2n+1, the same for the counters.
+*/
+typedef struct _GROUPSAMPLE
+{
+  ULONG ulBoards;        // Number of boards read
+  ULONG ulSequence;      // Counts the samples, from 1
+  ULONG ulTimeMs;        // Library clock, first report
+  ULONG ulSkewUs;        // First to last report
+  ULONG ulDigitalIn;     // I1..I5 of board n: bits 5n..5n+4
+  ULONG aulAnalog[ 2 * K8055_MAX_BOARDS ];   // 0..255
+  ULONG aulCounter[ 2 * K8055_MAX_BOARDS ];  // 0..65535
+  ULONG aulFileDesc[ K8055_MAX_BOARDS ];
+  ULONG aulRcRead[ K8055_MAX_BOARDS ];       // 0 or error bits
+  ULONG aulOffsetUs[ K8055_MAX_BOARDS ];     // After first report
+} GROUPSAMPLE;
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID GroupDetach( ULONG ulSlot );
+
+#endif
+
+
@@ -0,0 +1,495 @@
+//====================================== health.c === BEGIN ===
+/**
+ * \file  'health.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Health of every K8055 and its circuit breaker.
+ *
+ * Every transfer on EP01 and EP81 reports its result and its
+ * latency to 'HealthResult()'. Per board the library counts
+ * the errors by bit, the failures and the Toggle Bit errors
+ * in a row, the error rate over the last HEALTH_WINDOW
+ * transfers and a histogram of the latencies.
+ *
+ * A flaky board slows down the application, because every
+ * call waits for a transfer that fails. With a circuit
+ * breaker set ( 'K8055_SetBreaker()' ), too many failures in
+ * a row or a too high error rate open the breaker: the calls
+ * of the application fail at once with ERROR_BREAKER. After
+ * the cooldown the next call makes one probe transfer with
+ * 'Read_8_Bytes()'. If it works, the breaker closes and the
+ * call goes on, if not, the cooldown starts again.
+ *
+ * 'hmtx' of a board is held for counting only, no other
+ * lock is ever requested while it is owned. So the transfers
+ * may report with their transfer lock owned.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "health.h"
+
+
+/**
+* \brief Health data of one K8055
+*/
+typedef struct _HEALTHBOARD
+{
+  HMTX        hmtx;           // Guards everything below
+
+  // -- Circuit breaker
+  ULONG       ulBreaker;
+  ULONG       ulTripFails;    // 0 = never trips
+  ULONG       ulTripPct;      // 0 = rate not used
+  ULONG       ulCooldownMs;
+  K8055TIME   tmOpenUntil;
+
+  // -- Last HEALTH_WINDOW transfers, 1 = failed
+  BYTE        abyWindow[ HEALTH_WINDOW ];
+  ULONG       ulWindowPos;
+  ULONG       ulWindowCount;
+  ULONG       ulWindowErrors;
+
+  ULONG       aulLatency[ HEALTH_LAT_BUCKETS ];
+
+  // -- Counters, the rest is computed on request
+  HEALTHSTATS Stats;
+} HEALTHBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Health data, indexed by Board Slot --------------------//
+//
+HEALTHBOARD aHealth[ K8055_MAX_BOARDS ];
+
+//-----------------------------------------------------------//
+//--- Data Buffer of 'Read_8_Bytes()', see 'func.c' ---------//
+//
+extern BYTE byaGetData[ SIZEGETBYTES ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. Healthy, breaker off.
+*/
+VOID HealthAttach( ULONG ulSlot )
+{
+  HEALTHBOARD *pHealth;
+
+  pHealth = &aHealth[ ulSlot ];
+
+  if ( pHealth->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pHealth->hmtx, 0, FALSE );
+  }
+  pHealth->ulBreaker = BREAKER_CLOSED;
+  pHealth->ulTripFails = 0;
+  pHealth->ulTripPct = 0;
+  pHealth->ulCooldownMs = 1000;
+  pHealth->tmOpenUntil = 0;
+  memset( &pHealth->abyWindow[0], 0, HEALTH_WINDOW );
+  pHealth->ulWindowPos = 0;
+  pHealth->ulWindowCount = 0;
+  pHealth->ulWindowErrors = 0;
+  memset( &pHealth->aulLatency[0], 0, sizeof( pHealth->aulLatency ) );
+  memset( &pHealth->Stats, 0, sizeof( HEALTHSTATS ) );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Forgets the failures of the past, when the
+*           breaker closes. Called with 'hmtx' owned.
+*/
+static VOID HealthClear( HEALTHBOARD *pHealth )
+{
+  memset( &pHealth->abyWindow[0], 0, HEALTH_WINDOW );
+  pHealth->ulWindowPos = 0;
+  pHealth->ulWindowCount = 0;
+  pHealth->ulWindowErrors = 0;
+  pHealth->Stats.ulFailRun = 0;
+  pHealth->Stats.ulToggleRun = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Result and latency of one transfer.
+*
+* \param    'ulRc'
+*           - Error bits of the transfer. ERROR_FROM_CALL,
+*           ERROR_TOGGLE_BIT, ERROR_BYTE_NUMBER and
+*           ERROR_DEADLINE count as failure.
+*/
+VOID HealthResult( ULONG ulSlot, ULONG ulRc, K8055TIME tmLatency )
+{
+  ULONG ulBucket;
+  BYTE  byFailed;
+  HEALTHBOARD *pHealth;
+  HEALTHSTATS *pStats;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+  pHealth = &aHealth[ ulSlot ];
+  pStats = &pHealth->Stats;
+
+  byFailed = 0;
+  if ( ( ulRc & ( ERROR_FROM_CALL | ERROR_TOGGLE_BIT |
+                  ERROR_BYTE_NUMBER | ERROR_DEADLINE ) ) != 0 )
+  {
+    byFailed = 1;
+  }
+
+  ulBucket = 0;
+  while ( ( ulBucket < HEALTH_LAT_BUCKETS - 1 ) &&
+          ( ( tmLatency >> ( ulBucket + 1 ) ) != 0 ) )
+  {
+    ++ulBucket;
+  }
+
+  DosRequestMutexSem( pHealth->hmtx, SEM_INDEFINITE_WAIT );
+
+  ++pStats->ulTransfers;
+  if ( ( ulRc & ERROR_FROM_CALL ) != 0 )
+  {
+    ++pStats->ulErrFromCall;
+  }
+  if ( ( ulRc & ERROR_TOGGLE_BIT ) != 0 )
+  {
+    ++pStats->ulErrToggle;
+    ++pStats->ulToggleRun;
+    if ( pStats->ulToggleRun > pStats->ulToggleRunMax )
+    {
+      pStats->ulToggleRunMax = pStats->ulToggleRun;
+    }
+  }
+  else
+  {
+    pStats->ulToggleRun = 0;
+  }
+  if ( ( ulRc & ERROR_BYTE_NUMBER ) != 0 )
+  {
+    ++pStats->ulErrBytes;
+  }
+  if ( ( ulRc & ERROR_DEADLINE ) != 0 )
+  {
+    ++pStats->ulErrDeadline;
+  }
+  if ( byFailed == 1 )
+  {
+    ++pStats->ulFailRun;
+  }
+  else
+  {
+    pStats->ulFailRun = 0;
+  }
+
+  // -- Sliding window --
+  if ( pHealth->ulWindowCount == HEALTH_WINDOW )
+  {
+    pHealth->ulWindowErrors = pHealth->ulWindowErrors -
+                              pHealth->abyWindow[ pHealth->ulWindowPos ];
+  }
+  else
+  {
+    ++pHealth->ulWindowCount;
+  }
+  pHealth->abyWindow[ pHealth->ulWindowPos ] = byFailed;
+  pHealth->ulWindowErrors = pHealth->ulWindowErrors + byFailed;
+  pHealth->ulWindowPos = ( pHealth->ulWindowPos + 1 ) % HEALTH_WINDOW;
+
+  ++pHealth->aulLatency[ ulBucket ];
+  if ( tmLatency > pStats->ulLatMaxUs )
+  {
+    pStats->ulLatMaxUs = (ULONG)tmLatency;
+  }
+
+  // -- Trip? --
+  if ( ( pHealth->ulBreaker == BREAKER_CLOSED ) &&
+       ( pHealth->ulTripFails != 0 ) &&
+       ( ( pStats->ulFailRun >= pHealth->ulTripFails ) ||
+         ( ( pHealth->ulTripPct != 0 ) &&
+           ( pHealth->ulWindowCount == HEALTH_WINDOW ) &&
+           ( pHealth->ulWindowErrors * 100 >=
+             pHealth->ulTripPct * HEALTH_WINDOW ) ) ) )
+  {
+    pHealth->ulBreaker = BREAKER_OPEN;
+    pHealth->tmOpenUntil = TimeNowUs() +
+                           (K8055TIME)pHealth->ulCooldownMs * 1000;
+    ++pStats->ulTrips;
+  }
+
+  DosReleaseMutexSem( pHealth->hmtx );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Lets a call of the application through, or not.
+*           After the cooldown of an open breaker the calling
+*           thread makes the probe transfer.
+*
+* \return   RET_OKAY or ERROR_BREAKER
+*/
+ULONG HealthGate( ULONG ulSlot )
+{
+  ULONG ulRcDOScall;
+  BOOL  blProbe;
+  BOOL  blValid;
+  HEALTHBOARD *pHealth;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return RET_OKAY;
+  }
+  pHealth = &aHealth[ ulSlot ];
+
+  DosRequestMutexSem( pHealth->hmtx, SEM_INDEFINITE_WAIT );
+  if ( pHealth->ulBreaker == BREAKER_CLOSED )
+  {
+    DosReleaseMutexSem( pHealth->hmtx );
+    return RET_OKAY;
+  }
+
+  blProbe = FALSE;
+  if ( ( pHealth->ulBreaker == BREAKER_OPEN ) &&
+       ( TimeNowUs() >= pHealth->tmOpenUntil ) )
+  {
+    pHealth->ulBreaker = BREAKER_PROBE;
+    ++pHealth->Stats.ulProbes;
+    blProbe = TRUE;
+  }
+  else
+  {
+    ++pHealth->Stats.ulFastFails;
+  }
+  DosReleaseMutexSem( pHealth->hmtx );
+
+  if ( blProbe == FALSE )
+  {
+    return ERROR_BREAKER;
+  }
+
+  // -- One single transfer, not retried, not counted --
+  SharedLock();
+  BoardLockXfer( ulSlot );
+  ulRcDOScall = Read_8_Bytes( BoardHandle( ulSlot ) );
+  blValid = ( ( ulRcDOScall == NO_DOS_ERROR ) &&
+              ( byaGetData[6] == 0x08 ) );
+  BoardUnlockXfer( ulSlot );
+  SharedUnlock();
+
+  DosRequestMutexSem( pHealth->hmtx, SEM_INDEFINITE_WAIT );
+  if ( pHealth->ulBreaker == BREAKER_PROBE )
+  {
+    if ( blValid == TRUE )
+    {
+      pHealth->ulBreaker = BREAKER_CLOSED;
+      HealthClear( pHealth );
+    }
+    else
+    {
+      pHealth->ulBreaker = BREAKER_OPEN;
+      pHealth->tmOpenUntil = TimeNowUs() +
+                             (K8055TIME)pHealth->ulCooldownMs * 1000;
+    }
+  }
+  DosReleaseMutexSem( pHealth->hmtx );
+
+  if ( blValid == FALSE )
+  {
+    return ERROR_BREAKER;
+  }
+  return RET_OKAY;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Upper bound of the latency bucket the given
+*           percentile falls into. Called with 'hmtx' owned.
+*/
+static ULONG HealthPercentile( HEALTHBOARD *pHealth, ULONG ulPct )
+{
+  ULONG ulBucket;
+  ULONG ulTotal;
+  ULONG ulTarget;
+  ULONG ulSum;
+
+  ulTotal = 0;
+  for ( ulBucket = 0; ulBucket < HEALTH_LAT_BUCKETS; ulBucket++ )
+  {
+    ulTotal = ulTotal + pHealth->aulLatency[ ulBucket ];
+  }
+  if ( ulTotal == 0 )
+  {
+    return 0;
+  }
+
+  ulTarget = ( ulTotal / 100 ) * ulPct +
+             ( ( ulTotal % 100 ) * ulPct + 99 ) / 100;
+  ulSum = 0;
+  for ( ulBucket = 0; ulBucket < HEALTH_LAT_BUCKETS - 1; ulBucket++ )
+  {
+    ulSum = ulSum + pHealth->aulLatency[ ulBucket ];
+    if ( ulSum >= ulTarget )
+    {
+      break;
+    }
+  }
+  return ( 2UL << ulBucket ) - 1;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------60-
+//
+// Export Index 60
+/**
+* \brief 'K8055_SetBreaker()' sets when the circuit breaker
+* of a K8055 opens and how long it stays open.
+* See 'func.h' for details.
+*/
+ULONG K8055_SetBreaker( ULONG *pulFileDesc,
+                        ULONG *pulTripFails,
+                        ULONG *pulTripPercent,
+                        ULONG *pulCooldownMs   )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  HEALTHBOARD *pHealth;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulTripFails ) ||
+       ( NULL == pulTripPercent ) ||
+       ( NULL == pulCooldownMs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulTripFails > BREAKER_FAILS_MAX ) ||
+       ( *pulTripPercent > 100 ) ||
+       ( *pulCooldownMs < BREAKER_COOLDOWN_MIN_MS ) ||
+       ( *pulCooldownMs > BREAKER_COOLDOWN_MAX_MS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pHealth = &aHealth[ ulSlot ];
+  DosRequestMutexSem( pHealth->hmtx, SEM_INDEFINITE_WAIT );
+  pHealth->ulTripFails = *pulTripFails;
+  pHealth->ulTripPct = *pulTripPercent;
+  pHealth->ulCooldownMs = *pulCooldownMs;
+  if ( ( *pulTripFails == 0 ) &&
+       ( pHealth->ulBreaker == BREAKER_OPEN ) )
+  {
+    pHealth->ulBreaker = BREAKER_CLOSED;
+    HealthClear( pHealth );
+  }
+  DosReleaseMutexSem( pHealth->hmtx );
+
+  return ulRc;
+}
+//---------60-
+
+
+//----------------------------------------------------------61-
+//
+// Export Index 61
+/**
+* \brief 'K8055_GetHealth()' copies the health of a K8055.
+* See 'func.h' for details.
+*/
+ULONG K8055_GetHealth( ULONG *pulFileDesc,
+                       struct _HEALTHSTATS *pHealthStats )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  HEALTHBOARD *pHealth;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pHealthStats ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pHealth = &aHealth[ ulSlot ];
+  DosRequestMutexSem( pHealth->hmtx, SEM_INDEFINITE_WAIT );
+
+  memcpy( pHealthStats, &pHealth->Stats, sizeof( HEALTHSTATS ) );
+  pHealthStats->ulBreaker = pHealth->ulBreaker;
+  pHealthStats->ulWindowErrPct = 0;
+  if ( pHealth->ulWindowCount != 0 )
+  {
+    pHealthStats->ulWindowErrPct = pHealth->ulWindowErrors * 100 /
+                                   pHealth->ulWindowCount;
+  }
+  pHealthStats->ulScore = 100 - pHealthStats->ulWindowErrPct;
+  if ( pHealth->ulBreaker != BREAKER_CLOSED )
+  {
+    pHealthStats->ulScore = 0;
+  }
+  pHealthStats->ulLatP50Us = HealthPercentile( pHealth, 50 );
+  pHealthStats->ulLatP90Us = HealthPercentile( pHealth, 90 );
+  pHealthStats->ulLatP99Us = HealthPercentile( pHealth, 99 );
+
+  DosReleaseMutexSem( pHealth->hmtx );
+
+  return ulRc;
+}
+//---------61-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================= health.c === END ===
@@ -0,0 +1,93 @@
+/**
+ * \file 'health.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'health.h' is the headerfile belonging to 'health.c',
+ * the health of every K8055 and its circuit breaker.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_HEALTH_
+#define __K8055DD_H_HEALTH_
+
+
+//-- Values belonging to the circuit breaker ---- BEGIN --!
+//
+/**
+* \brief State of the circuit breaker of a board
+*/
+#define BREAKER_CLOSED 0     // Calls go through
+#define BREAKER_OPEN   1     // Calls fail at once
+#define BREAKER_PROBE  2     // One probe transfer on its way
+
+/**
+* \brief Trip values of 'K8055_SetBreaker()'. A breaker with
+* 0 failures in a row never trips, this is the default.
+*/
+#define BREAKER_FAILS_MAX    100
+#define BREAKER_COOLDOWN_MIN_MS 10
+#define BREAKER_COOLDOWN_MAX_MS 600000
+
+/**
+* \brief Error rates are taken over the last HEALTH_WINDOW
+* transfers.
+*/
+#define HEALTH_WINDOW 64
+
+/**
+* \brief Latency histogram: bucket n holds transfers of
+* 2^n .. 2^(n+1)-1 us, bucket 0 those below 2 us.
+*/
+#define HEALTH_LAT_BUCKETS 24
+//
+//-- Values belonging to the circuit breaker ------ END --!
+
+
+/**
+* \brief Health of one K8055, see 'K8055_GetHealth()'
+*/
+typedef struct _HEALTHSTATS
+{
+  ULONG ulBreaker;         // BREAKER_CLOSED .. BREAKER_PROBE
+  ULONG ulScore;           // 0..100, 0 while open
+  ULONG ulTransfers;
+  ULONG ulErrFromCall;     // Transfers per error bit
+  ULONG ulErrToggle;
+  ULONG ulErrBytes;
+  ULONG ulErrDeadline;
+  ULONG ulWindowErrPct;    // Failed in the last HEALTH_WINDOW
+  ULONG ulFailRun;         // Failures in a row, now
+  ULONG ulToggleRun;       // ERROR_TOGGLE_BIT in a row, now
+  ULONG ulToggleRunMax;
+  ULONG ulLatP50Us;        // Upper bounds of the buckets
+  ULONG ulLatP90Us;
+  ULONG ulLatP99Us;
+  ULONG ulLatMaxUs;
+  ULONG ulTrips;           // Times the breaker opened
+  ULONG ulFastFails;       // Calls refused with ERROR_BREAKER
+  ULONG ulProbes;
+} HEALTHSTATS;
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID  HealthAttach( ULONG ulSlot );
+
+//--- Used by every transfer on EP01 and EP81 -----------------
+//    Takes a lock of its own only, which is never held while
+//    another lock is requested. May be called with any lock
+//    owned.
+//
+VOID  HealthResult( ULONG ulSlot, ULONG ulRc, K8055TIME tmLatency );
+
+//--- Used by the calls an application makes ------------------
+//    Before any lock is taken. RET_OKAY or ERROR_BREAKER.
+//
+ULONG HealthGate( ULONG ulSlot );
+
+#endif
+
+
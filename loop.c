@@ -0,0 +1,262 @@
+//======================================== loop.c === BEGIN ===
+/**
+ * \file  'loop.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Loopback latency: the time from an output to an
+ * input wired to it.
+ *
+ * On a test rig a digital output is wired to a digital
+ * input, or DAC1 to A1. 'K8055_MeasureLoopback()' changes
+ * the output the way an application does, with
+ * 'K8055_Prepair...()' and 'K8055_SetAllOutputs()' via
+ * 'byaPutData[]', and reads reports with
+ * 'K8055_ReadAllInputs()' until the change shows up. The
+ * time from the start of 'K8055_SetAllOutputs()' to the end
+ * of that read is one round trip: EP01 transfer, the K8055,
+ * the report interval of EP81 and the transfer back.
+ *
+ * A digital output is toggled, DAC1 is stepped between
+ * LOOP_DAC_LOW and LOOP_DAC_HIGH. Every change is one
+ * sample. The other outputs keep their values.
+ *
+ * The emulated K8055 has the same wiring, see
+ * 'K8055_SetEmulationWiring()'.
+ *
+ * \version 1.0.0 -
+ * 2026-10-19 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "loop.h"
+
+
+//-----------------------------------------------------------//
+//--- Data Buffer of 'K8055_SetAllOutputs()', see 'func.c' --//
+//
+extern BYTE byaPutData[ SIZEPUTBYTES ];
+
+//-----------------------------------------------------------//
+//--- Raw bits of I1..I5 in a report, see 'func.c' ----------//
+//
+extern BYTE byaDigInput[ 6 ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Sets the output to one of its two levels, via
+*           'byaPutData[]' like an application.
+*
+* \return   Return Code of 'K8055_SetAllOutputs()'
+*/
+static ULONG LoopSet( ULONG *pulFileDesc,
+                      ULONG ulOutput,
+                      BOOL blHigh         )
+{
+  ULONG ulValue;
+  ULONG ulDAC;
+  ULONG ulMask;
+
+  if ( ulOutput == LOOP_DAC1 )
+  {
+    ulValue = ( blHigh == TRUE ) ? LOOP_DAC_HIGH : LOOP_DAC_LOW;
+    ulDAC = 1;
+    K8055_PrepairDACxOut( &ulValue, &ulDAC );
+  }
+  else
+  {
+    ulMask = 1 << ( ulOutput - 1 );
+    ulValue = byaPutData[ 9 ] & ~ulMask;
+    if ( blHigh == TRUE )
+    {
+      ulValue = ulValue | ulMask;
+    }
+    K8055_PrepairDigitalOut( &ulValue );
+  }
+
+  return K8055_SetAllOutputs( pulFileDesc );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Reads reports until the input shows the level,
+*           at most LOOP_TIMEOUT_US after 'tmSent'.
+*
+* \param    'pulLatencyUs'
+*           - Time from 'tmSent' to the end of the read that
+*           showed the level, or LOOP_LOST.
+*
+* \return   RET_OKAY, ERROR_DEADLINE if the level did not
+*           show, ERROR_FROM_CALL etc. of failed reads.
+*/
+static ULONG LoopWait( ULONG *pulFileDesc,
+                       ULONG ulInput,
+                       BOOL blHigh,
+                       K8055TIME tmSent,
+                       ULONG *pulLatencyUs )
+{
+  ULONG ulRc;
+  ULONG ulRcRead;
+  ULONG ulIx;
+  ULONG ulA1;
+  ULONG ulA2;
+  BOOL  blLevel;
+  K8055TIME tmNow;
+
+  ulRc = RET_OKAY;
+  do
+  {
+    ulRcRead = K8055_ReadAllInputs( pulFileDesc, &ulIx, &ulA1, &ulA2 );
+    tmNow = TimeNowUs();
+
+    if ( ulRcRead == RET_OKAY )
+    {
+      if ( ulInput == LOOP_A1 )
+      {
+        blLevel = ( ulA1 >= LOOP_DAC_MID ) ? TRUE : FALSE;
+      }
+      else
+      {
+        blLevel = ( ( ulIx & byaDigInput[ ulInput ] ) != 0 ) ?
+                  TRUE : FALSE;
+      }
+      if ( blLevel == blHigh )
+      {
+        *pulLatencyUs = (ULONG)( tmNow - tmSent );
+        return ulRc;
+      }
+    }
+    else
+    {
+      // -- An old report is no error, just no change yet --
+      ulRc = ulRc | ( ulRcRead & ~ERROR_TOGGLE_BIT );
+    }
+  } while ( tmNow - tmSent < LOOP_TIMEOUT_US );
+
+  *pulLatencyUs = LOOP_LOST;
+  return ulRc | ERROR_DEADLINE;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------70-
+//
+// Export Index 70
+/**
+* \brief 'K8055_MeasureLoopback()' measures the round trip
+* from an output to an input wired to it, '*pulRepeats'
+* times. See 'func.h' for details.
+*/
+ULONG K8055_MeasureLoopback( ULONG *pulFileDesc,
+                             ULONG *pulOutput,
+                             ULONG *pulInput,
+                             ULONG *pulRepeats,
+                             ULONG *paulLatencyUs )
+{
+  ULONG ulRc;
+  ULONG ulOutput;
+  ULONG ulInput;
+  ULONG ulRepeat;
+  ULONG ulStartUs;
+  ULONG ulOldOut;
+  ULONG ulOldDAC1;
+  ULONG ulDAC;
+  BOOL  blHigh;
+  K8055TIME tmSent;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulOutput ) ||
+       ( NULL == pulInput ) ||
+       ( NULL == pulRepeats ) ||
+       ( NULL == paulLatencyUs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( BoardSlot( *pulFileDesc ) == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  // -- DAC1 goes with A1, DO1..DO8 with I1..I5 --
+  ulOutput = *pulOutput;
+  ulInput = *pulInput;
+  if ( ( *pulRepeats == 0 ) ||
+       ( ( ulOutput == LOOP_DAC1 ) != ( ulInput == LOOP_A1 ) ) ||
+       ( ulOutput < 1 ) || ( ulOutput > LOOP_DAC1 ) ||
+       ( ulInput < 1 ) || ( ulInput > LOOP_A1 ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  ulOldOut = byaPutData[ 9 ];
+  ulOldDAC1 = byaPutData[ 10 ];
+
+  // -- Start from the low level. If it does not show, or
+  //    the first change does not, the wiring is missing --
+  tmSent = TimeNowUs();
+  ulRc = ulRc | LoopSet( pulFileDesc, ulOutput, FALSE );
+  ulRc = ulRc | LoopWait( pulFileDesc, ulInput, FALSE, tmSent,
+                          &ulStartUs );
+
+  blHigh = FALSE;
+  for ( ulRepeat = 0;
+        ( ulRepeat < *pulRepeats ) && ( ulStartUs != LOOP_LOST );
+        ulRepeat++ )
+  {
+    blHigh = ( blHigh == TRUE ) ? FALSE : TRUE;
+    tmSent = TimeNowUs();
+    ulRc = ulRc | LoopSet( pulFileDesc, ulOutput, blHigh );
+    ulRc = ulRc | LoopWait( pulFileDesc, ulInput, blHigh, tmSent,
+                            &paulLatencyUs[ ulRepeat ] );
+    if ( ( ulRepeat == 0 ) && ( paulLatencyUs[0] == LOOP_LOST ) )
+    {
+      break;
+    }
+  }
+
+  // -- The outputs as they were --
+  if ( ulOutput == LOOP_DAC1 )
+  {
+    ulDAC = 1;
+    K8055_PrepairDACxOut( &ulOldDAC1, &ulDAC );
+  }
+  else
+  {
+    K8055_PrepairDigitalOut( &ulOldOut );
+  }
+  K8055_SetAllOutputs( pulFileDesc );
+
+  return ulRc;
+}
+//---------70-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= loop.c === END ===
@@ -0,0 +1,45 @@
+/**
+ * \file 'loop.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'loop.h' is the headerfile belonging to 'loop.c',
+ * the measurement of the loopback latency from an output to
+ * an input wired to it.
+ *
+ * \version 1.0.0 -
+ * 2026-10-19 init
+ */
+#ifndef __K8055DD_H_LOOP_
+#define __K8055DD_H_LOOP_
+
+
+//-- Values belonging to the loopback latency --- BEGIN --!
+//
+/**
+* \brief Outputs and inputs of 'K8055_MeasureLoopback()'
+* besides DO1..DO8 and I1..I5: DAC1 is stepped between
+* LOOP_DAC_LOW and LOOP_DAC_HIGH, A1 has seen the step when
+* it crossed LOOP_DAC_MID.
+*/
+#define LOOP_DAC1       9
+#define LOOP_A1         6
+
+#define LOOP_DAC_LOW    0x40
+#define LOOP_DAC_MID    0x80
+#define LOOP_DAC_HIGH   0xC0
+
+/**
+* \brief A change not seen within LOOP_TIMEOUT_US is lost,
+* its latency is LOOP_LOST.
+*/
+#define LOOP_TIMEOUT_US 1000000
+#define LOOP_LOST       0xFFFFFFFF
+//
+//-- Values belonging to the loopback latency ----- END --!
+
+#endif
+
+
+
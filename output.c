@@ -0,0 +1,539 @@
+//====================================== output.c === BEGIN ===
+/**
+ * \file  'output.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief The Output Thread of a K8055.
+ *
+ * K8055 fetches a new EP01 frame every 10 ms at most. The
+ * Output Thread divides the time into Output Slots of that
+ * length. At the start of every slot it asks all clients
+ * (PWM, waveforms, ...) which outputs they want, merges their requests
+ * into the current frame of the board and writes the frame,
+ * if anything changed. Edges of all clients that fall into
+ * the same slot leave the PC in one frame.
+ *
+ * Slots start on absolute deadlines. If the thread falls
+ * behind by a whole slot or more, the missed slots are
+ * skipped and counted, the clients are told the true slot
+ * number, so they do not drift.
+ *
+ * Between two slots the thread waits via 'TimeWaitSlotUs()':
+ * a slot is shorter than a timer tick, so it yields at
+ * regular priority and does not starve the applications.
+ *
+ * The thread runs only while at least one client needs it
+ * (see 'OutputDemand()'). Ramps end by themselves, their
+ * demand is dropped by the thread (see 'OutputRetire()').
+ * A ramp started by the slew rate limit of a frame is
+ * demanded without waiting (see 'OutputKickRamp()'), the
+ * writer may own locks the thread needs.
+ *
+ * \version 1.0.4 -
+ * 2026-10-19 'OutputKickRamp()'
+ * \version 1.0.3 -
+ * 2026-10-19 no yielding at time critical priority between
+ * the slots, 'hevStop' ends the wait
+ * \version 1.0.2 -
+ * 2026-10-18 client: DAC ramps, 'OutputRetire()'
+ * \version 1.0.1 -
+ * 2026-10-18 client: waveform generator
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "output.h"
+#include "pwm.h"
+#include "wave.h"
+#include "ramp.h"
+
+
+/**
+* \brief Output Thread data of one K8055
+*/
+typedef struct _OUTPUTBOARD
+{
+  HMTX          hmtxDemand;  // Guards clients and thread
+  HMTX          hmtxSlot;    // Owned while a slot is handled
+  ULONG         ulClients;   // OUTPUT_CLIENT_... bits
+  volatile BOOL blRun;
+  volatile BOOL blRampKick;  // Ramp not yet demanded
+  BOOL          blDetached;  // No kick starts the thread
+  TID           tid;
+  HEV           hevStop;
+
+  // -- Statistics
+  ULONG         ulSlots;     // Slots handled
+  ULONG         ulWrites;    // EP01 frames written
+  ULONG         ulLate;      // Slots skipped
+} OUTPUTBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Output Thread data, indexed by Board Slot -------------//
+//
+OUTPUTBOARD aOutput[ K8055_MAX_BOARDS ];
+
+
+//--- Prototype of the demand of a kicked ramp -------------
+//
+static VOID OutputPickUp( ULONG ulSlot );
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Handles one slot: asks the clients, merges and
+*           writes.
+*/
+static VOID OutputSlot( ULONG ulSlot, ULONG ulTick )
+{
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  ULONG ulNewOut;
+  ULONG ulNewDAC1;
+  ULONG ulNewDAC2;
+  OUTPUTREQ Req;
+  OUTPUTBOARD *pOutput;
+
+  pOutput = &aOutput[ ulSlot ];
+
+  memset( &Req, 0, sizeof( Req ) );
+  if ( ( pOutput->ulClients & OUTPUT_CLIENT_PWM ) != 0 )
+  {
+    PwmSlot( ulSlot, ulTick, &Req );
+  }
+  if ( ( pOutput->ulClients & OUTPUT_CLIENT_WAVE ) != 0 )
+  {
+    WaveSlot( ulSlot, ulTick, &Req );
+  }
+  if ( ( pOutput->ulClients & OUTPUT_CLIENT_RAMP ) != 0 )
+  {
+    RampSlot( ulSlot, ulTick, &Req );
+  }
+
+  BoardLockXfer( ulSlot );
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+
+  ulNewOut = ( ulDigitalOut & ~Req.ulDoMask ) |
+             ( Req.ulDoBits & Req.ulDoMask );
+  ulNewDAC1 = ( Req.blDac1 == TRUE ) ? Req.ulDac1 : ulDAC1;
+  ulNewDAC2 = ( Req.blDac2 == TRUE ) ? Req.ulDac2 : ulDAC2;
+
+  if ( ( ulNewOut != ulDigitalOut ) ||
+       ( ulNewDAC1 != ulDAC1 ) ||
+       ( ulNewDAC2 != ulDAC2 ) )
+  {
+    BoardWriteFrame( ulSlot, ulNewOut, ulNewDAC1, ulNewDAC2 );
+    ++pOutput->ulWrites;
+  }
+  BoardUnlockXfer( ulSlot );
+
+  ++pOutput->ulSlots;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Drops the demand of clients that have ended by
+*           themselves. 'hmtxDemand' is only tried, so a
+*           thread stopping this one is never waited for.
+*
+* \return   TRUE, if no client is left and the thread must
+*           end.
+*/
+static BOOL OutputRetire( ULONG ulSlot )
+{
+  BOOL blEnd;
+  OUTPUTBOARD *pOutput;
+
+  pOutput = &aOutput[ ulSlot ];
+
+  if ( ( ( pOutput->ulClients & OUTPUT_CLIENT_RAMP ) == 0 ) ||
+       ( RampIdle( ulSlot ) == FALSE ) )
+  {
+    return FALSE;
+  }
+
+  if ( DosRequestMutexSem( pOutput->hmtxDemand,
+                           SEM_IMMEDIATE_RETURN ) != NO_DOS_ERROR )
+  {
+    return FALSE;
+  }
+
+  // -- A new ramp may have been started in between --
+  blEnd = FALSE;
+  if ( RampIdle( ulSlot ) == TRUE )
+  {
+    pOutput->ulClients = pOutput->ulClients & ~OUTPUT_CLIENT_RAMP;
+  }
+  if ( pOutput->ulClients == 0 )
+  {
+    pOutput->blRun = FALSE;
+    pOutput->tid = 0;
+    blEnd = TRUE;
+  }
+
+  DosReleaseMutexSem( pOutput->hmtxDemand );
+  OutputPickUp( ulSlot );
+
+  return blEnd;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of the Output Thread.
+*
+* \param    'pvSlot'
+*           - Board Slot, passed as a pointer value.
+*/
+static VOID OutputThread( VOID *pvSlot )
+{
+  ULONG ulSlot;
+  ULONG ulTick;
+  ULONG ulSkip;
+  K8055TIME tmDeadline;
+  K8055TIME tmNow;
+  OUTPUTBOARD *pOutput;
+
+  ulSlot = (ULONG)pvSlot;
+  pOutput = &aOutput[ ulSlot ];
+
+  DosSetPriority( PRTYS_THREAD, PRTYC_TIMECRITICAL, 0, 0 );
+
+  ulTick = 0;
+  tmDeadline = TimeNowUs();
+  while ( pOutput->blRun == TRUE )
+  {
+    if ( ( TimeWaitSlotUs( tmDeadline, pOutput->hevStop ) == TRUE ) ||
+         ( pOutput->blRun == FALSE ) )
+    {
+      break;
+    }
+
+    DosRequestMutexSem( pOutput->hmtxSlot, SEM_INDEFINITE_WAIT );
+    OutputSlot( ulSlot, ulTick );
+    DosReleaseMutexSem( pOutput->hmtxSlot );
+
+    if ( OutputRetire( ulSlot ) == TRUE )
+    {
+      break;
+    }
+
+    // -- Next slot, skip the ones already missed --
+    tmDeadline = tmDeadline + OUTPUT_SLOT_US;
+    ++ulTick;
+    tmNow = TimeNowUs();
+    if ( tmNow >= tmDeadline + OUTPUT_SLOT_US )
+    {
+      ulSkip = (ULONG)( ( tmNow - tmDeadline ) / OUTPUT_SLOT_US );
+      tmDeadline = tmDeadline + (K8055TIME)ulSkip * OUTPUT_SLOT_US;
+      ulTick = ulTick + ulSkip;
+      pOutput->ulLate = pOutput->ulLate + ulSkip;
+    }
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Stops the Output Thread. Must be called with
+*           'hmtxDemand' owned and 'hmtxSlot' not owned.
+*/
+static VOID OutputStop( OUTPUTBOARD *pOutput )
+{
+  TID tidOutput;
+
+  if ( pOutput->blRun == FALSE )
+  {
+    return;
+  }
+
+  pOutput->blRun = FALSE;
+  DosPostEventSem( pOutput->hevStop );
+
+  tidOutput = pOutput->tid;
+  DosWaitThread( &tidOutput, DCWW_WAIT );
+  pOutput->tid = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'.
+*/
+VOID OutputAttach( ULONG ulSlot )
+{
+  OUTPUTBOARD *pOutput;
+
+  pOutput = &aOutput[ ulSlot ];
+
+  pOutput->ulClients = 0;
+  pOutput->blRun = FALSE;
+  pOutput->blRampKick = FALSE;
+  pOutput->blDetached = FALSE;
+  pOutput->tid = 0;
+  pOutput->ulSlots = 0;
+  pOutput->ulWrites = 0;
+  pOutput->ulLate = 0;
+
+  if ( pOutput->hmtxDemand == 0 )
+  {
+    DosCreateMutexSem( NULL, &pOutput->hmtxDemand, 0, FALSE );
+    DosCreateMutexSem( NULL, &pOutput->hmtxSlot, 0, FALSE );
+    DosCreateEventSem( NULL, &pOutput->hevStop, 0, FALSE );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardDetach()'. The thread is stopped,
+*           all clients are dropped.
+*/
+VOID OutputDetach( ULONG ulSlot )
+{
+  OUTPUTBOARD *pOutput;
+
+  pOutput = &aOutput[ ulSlot ];
+
+  DosRequestMutexSem( pOutput->hmtxDemand, SEM_INDEFINITE_WAIT );
+  OutputStop( pOutput );
+  pOutput->ulClients = 0;
+  pOutput->blRampKick = FALSE;
+  pOutput->blDetached = TRUE;
+  DosReleaseMutexSem( pOutput->hmtxDemand );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of 'OutputDemand()', called with
+*           'hmtxDemand' owned.
+*/
+static ULONG OutputDemandOwned( ULONG ulSlot,
+                                ULONG ulClient,
+                                BOOL blOn       )
+{
+  ULONG ulRc;
+  ULONG ulPostCount;
+  INT   iTid;
+  OUTPUTBOARD *pOutput;
+
+  ulRc = RET_OKAY;
+  pOutput = &aOutput[ ulSlot ];
+
+  if ( blOn == TRUE )
+  {
+    pOutput->ulClients = pOutput->ulClients | ulClient;
+  }
+  else
+  {
+    pOutput->ulClients = pOutput->ulClients & ~ulClient;
+  }
+
+  if ( ( pOutput->ulClients == 0 ) && ( pOutput->blRun == TRUE ) )
+  {
+    OutputStop( pOutput );
+  }
+
+  if ( ( pOutput->ulClients != 0 ) && ( pOutput->blRun == FALSE ) )
+  {
+    DosResetEventSem( pOutput->hevStop, &ulPostCount );
+    pOutput->blRun = TRUE;
+    iTid = _beginthread( OutputThread, NULL, THREAD_STACK_SIZE,
+                         (VOID *)ulSlot );
+    if ( iTid == -1 )
+    {
+      pOutput->blRun = FALSE;
+      pOutput->ulClients = pOutput->ulClients & ~ulClient;
+      ulRc = ulRc | ERROR_FROM_CALL;
+    }
+    else
+    {
+      pOutput->tid = (TID)iTid;
+    }
+  }
+
+  return ulRc;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Demands the thread for a kicked ramp. Called by
+*           every owner of 'hmtxDemand' after releasing it.
+*           'hmtxDemand' is only tried: if someone else owns
+*           it, the kick is picked up by that one.
+*/
+static VOID OutputPickUp( ULONG ulSlot )
+{
+  OUTPUTBOARD *pOutput;
+
+  pOutput = &aOutput[ ulSlot ];
+
+  while ( pOutput->blRampKick == TRUE )
+  {
+    if ( DosRequestMutexSem( pOutput->hmtxDemand,
+                             SEM_IMMEDIATE_RETURN ) != NO_DOS_ERROR )
+    {
+      return;
+    }
+
+    if ( ( pOutput->blRampKick == TRUE ) &&
+         ( pOutput->blDetached == FALSE ) )
+    {
+      OutputDemandOwned( ulSlot, OUTPUT_CLIENT_RAMP, TRUE );
+    }
+    pOutput->blRampKick = FALSE;
+    DosReleaseMutexSem( pOutput->hmtxDemand );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    A client tells whether it needs the Output Thread.
+*           The thread is started with the first client and
+*           stopped with the last one.
+*
+* \param    'ulClient'
+*           - OUTPUT_CLIENT_...
+*
+* \return   RET_OKAY or ERROR_FROM_CALL, if the thread could
+*           not be started.
+*/
+ULONG OutputDemand( ULONG ulSlot, ULONG ulClient, BOOL blOn )
+{
+  ULONG ulRc;
+  OUTPUTBOARD *pOutput;
+
+  pOutput = &aOutput[ ulSlot ];
+
+  DosRequestMutexSem( pOutput->hmtxDemand, SEM_INDEFINITE_WAIT );
+  ulRc = OutputDemandOwned( ulSlot, ulClient, blOn );
+  DosReleaseMutexSem( pOutput->hmtxDemand );
+  OutputPickUp( ulSlot );
+
+  return ulRc;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    See 'output.h'.
+*/
+VOID OutputKickRamp( ULONG ulSlot )
+{
+  aOutput[ ulSlot ].blRampKick = TRUE;
+  OutputPickUp( ulSlot );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    See 'output.h'.
+*/
+VOID OutputLock( ULONG ulSlot )
+{
+  DosRequestMutexSem( aOutput[ ulSlot ].hmtxSlot,
+                      SEM_INDEFINITE_WAIT         );
+}
+// -----
+
+VOID OutputUnlock( ULONG ulSlot )
+{
+  DosReleaseMutexSem( aOutput[ ulSlot ].hmtxSlot );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------31-
+//
+// Export Index 31
+/**
+* \brief 'K8055_GetOutputStats()' tells how much work the
+* Output Thread has done. See 'func.h' for details.
+*/
+ULONG K8055_GetOutputStats( ULONG *pulFileDesc,
+                            ULONG *pulSlots,
+                            ULONG *pulWrites,
+                            ULONG *pulLateSlots )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  OUTPUTBOARD *pOutput;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulSlots ) ||
+       ( NULL == pulWrites ) ||
+       ( NULL == pulLateSlots ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+  pOutput = &aOutput[ ulSlot ];
+
+  OutputLock( ulSlot );
+  *pulSlots = pOutput->ulSlots;
+  *pulWrites = pOutput->ulWrites;
+  *pulLateSlots = pOutput->ulLate;
+  OutputUnlock( ulSlot );
+
+  return ulRc;
+}
+//---------31-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================= output.c === END ===
@@ -0,0 +1,84 @@
+/**
+ * \file 'output.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'output.h' is the headerfile belonging to
+ * 'output.c', the Output Thread of a K8055. Subsystems that
+ * change outputs on their own time base (PWM, waveforms,
+ * ramps, ...) register as clients. The thread asks all clients once
+ * per Output Slot and writes at most one EP01 frame per slot.
+ *
+ * \version 1.0.3 -
+ * 2026-10-19 'OutputKickRamp()'
+ * \version 1.0.2 -
+ * 2026-10-18 client: DAC ramps, may end on its own
+ * \version 1.0.1 -
+ * 2026-10-18 client: waveform generator
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_OUTPUT_
+#define __K8055DD_H_OUTPUT_
+
+
+//-- Values belonging to the output thread ------ BEGIN --!
+//
+/**
+* \brief Length of one Output Slot. K8055 polls EP01 every
+* 10 ms, faster writes would only queue up in usbecd.sys.
+*/
+#define OUTPUT_SLOT_MS 10
+#define OUTPUT_SLOT_US ( OUTPUT_SLOT_MS * 1000 )
+
+/**
+* \brief Clients of the Output Thread, one bit each
+*/
+#define OUTPUT_CLIENT_PWM 0x0001
+#define OUTPUT_CLIENT_WAVE 0x0002
+#define OUTPUT_CLIENT_RAMP 0x0004
+//
+//-- Values belonging to the output thread -------- END --!
+
+
+/**
+* \brief Output values one client asks for in one slot.
+* Only the bits in 'ulDoMask' and the DACs flagged in
+* 'blDac1'/'blDac2' are taken, the rest stays as it is.
+*/
+typedef struct _OUTPUTREQ
+{
+  ULONG ulDoMask;        // DO bits the client drives
+  ULONG ulDoBits;        // Their values
+  BOOL  blDac1;
+  ULONG ulDac1;
+  BOOL  blDac2;
+  ULONG ulDac2;
+} OUTPUTREQ;
+
+
+//--- Used by board.c and the clients ------------------------
+//
+VOID  OutputAttach( ULONG ulSlot );
+VOID  OutputDetach( ULONG ulSlot );
+ULONG OutputDemand( ULONG ulSlot, ULONG ulClient, BOOL blOn );
+
+//    Demands the thread for a ramp without waiting, so it may
+//    be called with any lock owned. If the demand is busy,
+//    its owner demands the ramp when it is done.
+//
+VOID  OutputKickRamp( ULONG ulSlot );
+
+//    The Output Thread owns this lock while it handles a
+//    slot. A client that takes it can change its state and
+//    the outputs without the thread coming in between.
+//    Order: OutputLock() first, BoardLockXfer() second.
+//    Never call 'OutputDemand()' while owning it.
+//
+VOID  OutputLock( ULONG ulSlot );
+VOID  OutputUnlock( ULONG ulSlot );
+
+#endif
+
+
@@ -0,0 +1,503 @@
+//========================================= pid.c === BEGIN ===
+/**
+ * \file  'pid.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief PID controllers: A1 drives DAC1, A2 drives DAC2.
+ *
+ * The controllers are evaluated on the EP81 reports
+ * ('PidEvaluate()' is called by 'BoardReportIn()'). With the
+ * Acquisition Thread running they sample in that time
+ * critical thread, so the sample period does not depend on
+ * the scheduling of the application. The real time between
+ * two samples is used for the integral and the derivative.
+ *
+ * Anti-windup: while the output is clamped, the integral is
+ * only changed in the direction that leads out of the
+ * limit. The integral itself never leaves the output range.
+ *
+ * A new parameter set replaces the old one as a whole
+ * between two samples. When a controller is switched on, it
+ * starts from the current DAC value (bumpless).
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 no sample without time passed since the last
+ * one, gains must be finite and not negative
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "pid.h"
+
+
+/**
+* \brief State of one PID controller
+*/
+typedef struct _PIDCHANNEL
+{
+  PIDPARAM  Param;
+  BOOL      blFirst;          // Next sample is the first
+  double    dIntegral;
+  double    dLastInput;
+  K8055TIME tmLastSample;
+
+  // -- Statistics
+  ULONG     ulSamples;
+  ULONG     ulSaturated;
+  double    dError;
+  double    dErrorAbsMax;
+  double    dErrorAbsSum;
+  ULONG     ulOutput;
+  ULONG     ulIntervalMaxUs;
+  ULONG     ulLatencyMaxUs;
+  K8055TIME tmLatencySumUs;
+} PIDCHANNEL;
+
+/**
+* \brief PID data of one K8055
+*/
+typedef struct _PIDBOARD
+{
+  HMTX       hmtx;            // Guards everything below
+  PIDCHANNEL aChannel[ PID_CHANNELS ];
+} PIDBOARD;
+
+
+//-----------------------------------------------------------//
+//--- PID data, indexed by Board Slot -----------------------//
+//
+PIDBOARD aPid[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Clears the statistics of one controller.
+*/
+static VOID PidStatsReset( PIDCHANNEL *pChannel )
+{
+  pChannel->ulSamples = 0;
+  pChannel->ulSaturated = 0;
+  pChannel->dError = 0.0;
+  pChannel->dErrorAbsMax = 0.0;
+  pChannel->dErrorAbsSum = 0.0;
+  pChannel->ulOutput = 0;
+  pChannel->ulIntervalMaxUs = 0;
+  pChannel->ulLatencyMaxUs = 0;
+  pChannel->tmLatencySumUs = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. Both controllers start
+*           switched off.
+*/
+VOID PidAttach( ULONG ulSlot )
+{
+  ULONG ulIndex;
+  PIDBOARD *pPid;
+
+  pPid = &aPid[ ulSlot ];
+
+  if ( pPid->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pPid->hmtx, 0, FALSE );
+  }
+
+  DosRequestMutexSem( pPid->hmtx, SEM_INDEFINITE_WAIT );
+  for ( ulIndex = 0; ulIndex < PID_CHANNELS; ulIndex++ )
+  {
+    memset( &pPid->aChannel[ ulIndex ].Param, 0,
+            sizeof( PIDPARAM ) );
+    pPid->aChannel[ ulIndex ].blFirst = TRUE;
+    PidStatsReset( &pPid->aChannel[ ulIndex ] );
+  }
+  DosReleaseMutexSem( pPid->hmtx );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    One sample of one controller.
+*
+* \param    'ulCurrent'
+*           - DAC value output right now.
+*
+* \return   New DAC value 0..255
+*/
+static ULONG PidSample( PIDCHANNEL *pChannel,
+                        double dInput,
+                        ULONG ulCurrent,
+                        K8055TIME tmReport )
+{
+  PIDPARAM *pParam;
+  double dDt;
+  double dError;
+  double dDerivative;
+  double dStep;
+  double dOut;
+  double dMin;
+  double dMax;
+  ULONG  ulIntervalUs;
+
+  pParam = &pChannel->Param;
+  dMin = (double)pParam->ulOutMin;
+  dMax = (double)pParam->ulOutMax;
+
+  dError = pParam->dSetpoint - dInput;
+
+  if ( pChannel->blFirst == TRUE )
+  {
+    // -- Bumpless start from the current DAC value --
+    dDt = 0.0;
+    dDerivative = 0.0;
+    pChannel->dIntegral = (double)ulCurrent - pParam->dKp * dError;
+    pChannel->blFirst = FALSE;
+  }
+  else
+  {
+    ulIntervalUs = (ULONG)( tmReport - pChannel->tmLastSample );
+    if ( ulIntervalUs > pChannel->ulIntervalMaxUs )
+    {
+      pChannel->ulIntervalMaxUs = ulIntervalUs;
+    }
+    dDt = (double)ulIntervalUs / 1000000.0;
+    dDerivative = ( dInput - pChannel->dLastInput ) / dDt;
+  }
+
+  if ( pChannel->dIntegral > dMax )
+  {
+    pChannel->dIntegral = dMax;
+  }
+  if ( pChannel->dIntegral < dMin )
+  {
+    pChannel->dIntegral = dMin;
+  }
+
+  dStep = pParam->dKi * dError * dDt;
+  dOut = pParam->dKp * dError + pChannel->dIntegral + dStep -
+         pParam->dKd * dDerivative;
+
+  // -- Clamp, integrate only out of the limit --
+  if ( dOut > dMax )
+  {
+    dOut = dMax;
+    ++pChannel->ulSaturated;
+    if ( dStep < 0.0 )
+    {
+      pChannel->dIntegral = pChannel->dIntegral + dStep;
+    }
+  }
+  else if ( dOut < dMin )
+  {
+    dOut = dMin;
+    ++pChannel->ulSaturated;
+    if ( dStep > 0.0 )
+    {
+      pChannel->dIntegral = pChannel->dIntegral + dStep;
+    }
+  }
+  else
+  {
+    pChannel->dIntegral = pChannel->dIntegral + dStep;
+  }
+
+  pChannel->dLastInput = dInput;
+  pChannel->tmLastSample = tmReport;
+
+  // -- Statistics --
+  ++pChannel->ulSamples;
+  pChannel->dError = dError;
+  if ( dError < 0.0 )
+  {
+    dError = -dError;
+  }
+  if ( dError > pChannel->dErrorAbsMax )
+  {
+    pChannel->dErrorAbsMax = dError;
+  }
+  pChannel->dErrorAbsSum = pChannel->dErrorAbsSum + dError;
+  pChannel->ulOutput = (ULONG)( dOut + 0.5 );
+
+  return pChannel->ulOutput;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardReportIn()' for every report of a
+*           board. Every controller whose period has passed
+*           takes a sample. Both DACs are written with one
+*           EP01 frame, and only if a value changes.
+*
+* \param    'pbyData'
+*           - The 8 data bytes of the report.
+*
+* \param    'tmReport'
+*           - Time the report arrived, the latency is counted
+*           from here.
+*/
+VOID PidEvaluate( ULONG ulSlot,
+                  BYTE *pbyData,
+                  K8055TIME tmReport )
+{
+  ULONG ulIndex;
+  ULONG ulDigitalOut;
+  ULONG aulDAC[ PID_CHANNELS ];
+  ULONG ulNew;
+  ULONG ulLatencyUs;
+  BOOL  blSampled[ PID_CHANNELS ];
+  BOOL  blChanged;
+  PIDBOARD *pPid;
+  PIDCHANNEL *pChannel;
+
+  pPid = &aPid[ ulSlot ];
+
+  // -- Cheap test first, most boards run without PID --
+  if ( ( pPid->aChannel[0].Param.ulEnable == 0 ) &&
+       ( pPid->aChannel[1].Param.ulEnable == 0 ) )
+  {
+    return;
+  }
+
+  DosRequestMutexSem( pPid->hmtx, SEM_INDEFINITE_WAIT );
+  BoardLockXfer( ulSlot );
+
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &aulDAC[0], &aulDAC[1] );
+  blChanged = FALSE;
+
+  for ( ulIndex = 0; ulIndex < PID_CHANNELS; ulIndex++ )
+  {
+    pChannel = &pPid->aChannel[ ulIndex ];
+    blSampled[ ulIndex ] = FALSE;
+
+    if ( pChannel->Param.ulEnable == 0 )
+    {
+      continue;
+    }
+    if ( ( pChannel->blFirst == FALSE ) &&
+         ( tmReport - pChannel->tmLastSample + PID_PERIOD_SLACK_US <
+           (K8055TIME)pChannel->Param.ulPeriodMs * 1000 ) )
+    {
+      continue;
+    }
+
+    // -- No time passed, or a report older than the last
+    //    sample: no derivative, no integral --
+    if ( ( pChannel->blFirst == FALSE ) &&
+         ( tmReport <= pChannel->tmLastSample ) )
+    {
+      continue;
+    }
+
+    ulNew = PidSample( pChannel,
+                       (double)pbyData[ 2 + ulIndex ],  // A1, A2
+                       aulDAC[ ulIndex ],
+                       tmReport                        );
+    blSampled[ ulIndex ] = TRUE;
+    if ( ulNew != aulDAC[ ulIndex ] )
+    {
+      aulDAC[ ulIndex ] = ulNew;
+      blChanged = TRUE;
+    }
+  }
+
+  if ( blChanged == TRUE )
+  {
+    BoardWriteFrame( ulSlot, ulDigitalOut, aulDAC[0], aulDAC[1] );
+  }
+
+  BoardUnlockXfer( ulSlot );
+
+  // -- Latency: report arrived .. DAC written --
+  ulLatencyUs = (ULONG)( TimeNowUs() - tmReport );
+  for ( ulIndex = 0; ulIndex < PID_CHANNELS; ulIndex++ )
+  {
+    if ( blSampled[ ulIndex ] == TRUE )
+    {
+      pChannel = &pPid->aChannel[ ulIndex ];
+      pChannel->tmLatencySumUs = pChannel->tmLatencySumUs +
+                                 ulLatencyUs;
+      if ( ulLatencyUs > pChannel->ulLatencyMaxUs )
+      {
+        pChannel->ulLatencyMaxUs = ulLatencyUs;
+      }
+    }
+  }
+
+  DosReleaseMutexSem( pPid->hmtx );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------27-
+//
+// Export Index 27
+/**
+* \brief 'K8055_SetPid()' sets all parameters of one PID
+* controller at once. See 'func.h' for details.
+*/
+ULONG K8055_SetPid( ULONG *pulFileDesc,
+                    ULONG *pulChannel,
+                    struct _PIDPARAM *pParam )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulChannel;
+  PIDBOARD *pPid;
+  PIDCHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pParam ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulChannel = *pulChannel;
+  if ( ( ulChannel < 1 ) || ( ulChannel > PID_CHANNELS ) ||
+       ( pParam->ulEnable > 1 ) ||
+       ( pParam->ulPeriodMs < PID_PERIOD_MIN_MS ) ||
+       ( pParam->ulPeriodMs > PID_PERIOD_MAX_MS ) ||
+       ( !( pParam->dSetpoint >= 0.0 ) ) ||
+       ( !( pParam->dSetpoint <= 255.0 ) ) ||
+       ( !( pParam->dKp >= 0.0 ) ) ||
+       ( !( pParam->dKp <= DBL_MAX ) ) ||
+       ( !( pParam->dKi >= 0.0 ) ) ||
+       ( !( pParam->dKi <= DBL_MAX ) ) ||
+       ( !( pParam->dKd >= 0.0 ) ) ||
+       ( !( pParam->dKd <= DBL_MAX ) ) ||
+       ( pParam->ulOutMax > 255 ) ||
+       ( pParam->ulOutMin > pParam->ulOutMax ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pPid = &aPid[ ulSlot ];
+  pChannel = &pPid->aChannel[ ulChannel - 1 ];
+
+  DosRequestMutexSem( pPid->hmtx, SEM_INDEFINITE_WAIT );
+
+  // -- Switched on: start bumpless. Retuned: keep the
+  //    integral. --
+  if ( pChannel->Param.ulEnable == 0 )
+  {
+    pChannel->blFirst = TRUE;
+  }
+  memcpy( &pChannel->Param, pParam, sizeof( PIDPARAM ) );
+  PidStatsReset( pChannel );
+
+  DosReleaseMutexSem( pPid->hmtx );
+
+  return ulRc;
+}
+//---------27-
+
+
+//----------------------------------------------------------28-
+//
+// Export Index 28
+/**
+* \brief 'K8055_GetPidStats()' tells how well one PID
+* controller works. See 'func.h' for details.
+*/
+ULONG K8055_GetPidStats( ULONG *pulFileDesc,
+                         ULONG *pulChannel,
+                         struct _PIDSTATS *pStats )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulChannel;
+  PIDBOARD *pPid;
+  PIDCHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pStats ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulChannel = *pulChannel;
+  if ( ( ulChannel < 1 ) || ( ulChannel > PID_CHANNELS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pPid = &aPid[ ulSlot ];
+  pChannel = &pPid->aChannel[ ulChannel - 1 ];
+
+  DosRequestMutexSem( pPid->hmtx, SEM_INDEFINITE_WAIT );
+  pStats->ulSamples = pChannel->ulSamples;
+  pStats->ulSaturated = pChannel->ulSaturated;
+  pStats->dError = pChannel->dError;
+  pStats->dErrorAbsMax = pChannel->dErrorAbsMax;
+  pStats->dErrorAbsAvg = 0.0;
+  pStats->ulLatencyAvgUs = 0;
+  if ( pChannel->ulSamples != 0 )
+  {
+    pStats->dErrorAbsAvg = pChannel->dErrorAbsSum /
+                           pChannel->ulSamples;
+    pStats->ulLatencyAvgUs = (ULONG)( pChannel->tmLatencySumUs /
+                                      pChannel->ulSamples    );
+  }
+  pStats->ulOutput = pChannel->ulOutput;
+  pStats->ulIntervalMaxUs = pChannel->ulIntervalMaxUs;
+  pStats->ulLatencyMaxUs = pChannel->ulLatencyMaxUs;
+  DosReleaseMutexSem( pPid->hmtx );
+
+  return ulRc;
+}
+//---------28-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================== pid.c === END ===
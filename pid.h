@@ -0,0 +1,99 @@
+/**
+ * \file 'pid.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'pid.h' is the headerfile belonging to 'pid.c'.
+ * It provides the parameter and statistics records of the
+ * PID controllers.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 gains finite and not negative
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_PID_
+#define __K8055DD_H_PID_
+
+
+//-- Values belonging to the PID controllers ---- BEGIN --!
+//
+/**
+* \brief Number of PID controllers per K8055.
+* Controller 1 reads A1 and drives DAC1, controller 2 reads
+* A2 and drives DAC2.
+*/
+#define PID_CHANNELS 2
+
+/**
+* \brief Sample period limits in milliseconds. K8055 delivers
+* a new report via EP81 every 10 ms.
+*/
+#define PID_PERIOD_MIN_MS 10
+#define PID_PERIOD_MAX_MS 60000
+
+/**
+* \brief A sample is taken if the period has passed, less
+* this slack. Without it a period of 20 ms would often wait
+* for the third report of 10 ms.
+*/
+#define PID_PERIOD_SLACK_US 5000
+//
+//-- Values belonging to the PID controllers ------ END --!
+
+
+/**
+* \brief Parameters of one PID controller.
+*
+* Setpoint, error and output are given in counts (0..255),
+* the unit of A1/A2 and DAC1/DAC2.
+*
+*   output = Kp * e + Ki * Integral( e dt ) - Kd * d(An)/dt
+*
+* The derivative term acts on the measured value, so a new
+* setpoint does not kick the output. 'dKi' is given per
+* second, 'dKd' in seconds. All gains are finite numbers
+* of 0 or more.
+*/
+typedef struct _PIDPARAM
+{
+  ULONG  ulEnable;       // 0: controller off, DAC unchanged
+  ULONG  ulPeriodMs;     // Sample period
+  double dSetpoint;      // 0..255
+  double dKp;
+  double dKi;            // 1/s
+  double dKd;            // s
+  ULONG  ulOutMin;       // Output clamp, 0..255
+  ULONG  ulOutMax;       // Output clamp, ulOutMin..255
+} PIDPARAM;
+
+
+/**
+* \brief Statistics of one PID controller since it was
+* (re)configured by 'K8055_SetPid()'.
+*/
+typedef struct _PIDSTATS
+{
+  ULONG  ulSamples;       // Samples taken
+  ULONG  ulSaturated;     // Samples with clamped output
+  double dError;          // Error of the last sample
+  double dErrorAbsMax;    // Largest |error|
+  double dErrorAbsAvg;    // Mean |error|
+  ULONG  ulOutput;        // DAC value of the last sample
+  ULONG  ulIntervalMaxUs; // Longest time between samples
+  ULONG  ulLatencyMaxUs;  // Report arrived .. DAC written
+  ULONG  ulLatencyAvgUs;
+} PIDSTATS;
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID PidAttach( ULONG ulSlot );
+VOID PidEvaluate( ULONG ulSlot,
+                  BYTE *pbyData,
+                  K8055TIME tmReport );
+
+#endif
+
+
@@ -0,0 +1,558 @@
+//======================================== plug.c === BEGIN ===
+/**
+ * \file  'plug.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Unplugged and reset K8055: detection and recovery.
+ *
+ * A K8055 pulled out or reset by a glitch leaves a handle
+ * behind that fails every transfer. Up to now the
+ * application had to notice, close, open and init by hand,
+ * and the outputs stayed at zero in the meantime.
+ *
+ * Every transfer on EP01 and EP81 reports its result to
+ * 'PlugResult()'. After PLUG_FAILS_DEFAULT failures in a row
+ * the board counts as lost and a Recovery Thread starts. It
+ * opens the device again, with a growing pause between the
+ * attempts. The new handle is duplicated onto the old one
+ * ( 'DosDupHandle()' ), so the handle the application holds
+ * stays valid. Then the board is initialised like by
+ * 'K8055_Init()' and gets the last output frame written to
+ * it once more. The init ( 'InitBoard()' ) uses buffers of
+ * its own and owns only the transfer lock of the board, the
+ * other boards are not held up by the init pauses. Acquisition, scan engines and all others go
+ * on by themselves, their transfers simply work again.
+ *
+ * The time from the first failed transfer to the recovery
+ * and the reports lost in this time are counted.
+ *
+ * An emulated K8055 keeps its handle, 'EmulReplug()' takes
+ * the place of 'DosOpen()' and 'DosDupHandle()'.
+ *
+ * A transfer hung in the driver keeps the transfer lock of
+ * the board. The Recovery Thread waits for the lock no longer
+ * than PLUG_XFER_WAIT_MS and then replaces the handle anyway,
+ * which closes the old one under the hung transfer. The board
+ * is initialised by the next attempt, once the lock is free.
+ *
+ * \version 1.0.5 -
+ * 2026-10-19 a report without a new Toggle Bit is no failure
+ * \version 1.0.4 -
+ * 2026-10-19 the board is initialised by 'InitBoard()' with
+ * its transfer lock only, other boards go on meanwhile
+ * \version 1.0.3 -
+ * 2026-10-19 a stop request left over from the last board
+ * in the slot is reset
+ * \version 1.0.2 -
+ * 2026-10-19 the handle is replaced without waiting for a
+ * hung transfer, the shared lock is not taken
+ * \version 1.0.1 -
+ * 2026-10-19 emulated K8055 replugged via 'EmulReplug()'
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "atomic.h"
+#include "emul.h"
+#include "plug.h"
+
+
+/**
+* \brief Recovery data of one K8055
+*/
+typedef struct _PLUGBOARD
+{
+  HMTX      hmtx;           // Guards the statistics, the thread
+  CHAR      szName[ CCHMAXPATH ];
+
+  // -- Written lock free by 'PlugResult()'
+  volatile LONG lState;     // PLUG_UP or PLUG_LOST
+  volatile LONG lFails;     // Failed transfers in a row
+  volatile LONG lFailedReads;
+  K8055TIME tmFirstFail;
+
+  // -- Policy
+  ULONG     ulFailLimit;
+  ULONG     ulBackoffMaxMs;
+
+  // -- Recovery Thread
+  TID       tid;
+  HEV       hevStop;
+  volatile BOOL blRun;
+
+  // -- Statistics
+  ULONG     ulOutages;
+  ULONG     ulAttempts;
+  K8055TIME tmOutageLast;
+  K8055TIME tmOutageTotal;
+  ULONG     ulLostLast;
+  ULONG     ulLostTotal;
+} PLUGBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Recovery data, indexed by Board Slot ------------------//
+//
+PLUGBOARD aPlug[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. Board up, default
+*           policy, no statistics.
+*/
+VOID PlugAttach( ULONG ulSlot )
+{
+  ULONG ulPostCount;
+  PLUGBOARD *pPlug;
+
+  pPlug = &aPlug[ ulSlot ];
+
+  if ( pPlug->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pPlug->hmtx, 0, FALSE );
+    DosCreateEventSem( NULL, &pPlug->hevStop, 0, FALSE );
+  }
+
+  // -- 'PlugDetach()' may have posted after the last Recovery
+  //    Thread was past its final reset --
+  DosResetEventSem( pPlug->hevStop, &ulPostCount );
+  pPlug->szName[0] = 0;
+  pPlug->lState = PLUG_UP;
+  pPlug->lFails = 0;
+  pPlug->lFailedReads = 0;
+  pPlug->tmFirstFail = 0;
+  pPlug->ulFailLimit = PLUG_FAILS_DEFAULT;
+  pPlug->ulBackoffMaxMs = PLUG_BACKOFF_DEFAULT_MS;
+  pPlug->tid = 0;
+  pPlug->blRun = FALSE;
+  pPlug->ulOutages = 0;
+  pPlug->ulAttempts = 0;
+  pPlug->tmOutageLast = 0;
+  pPlug->tmOutageTotal = 0;
+  pPlug->ulLostLast = 0;
+  pPlug->ulLostTotal = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'K8055_Open()'. Keeps the device name
+*           for opening the device again.
+*/
+VOID PlugName( ULONG ulSlot, CHAR *pcaDeviceName )
+{
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+  strncpy( aPlug[ ulSlot ].szName, pcaDeviceName, CCHMAXPATH - 1 );
+  aPlug[ ulSlot ].szName[ CCHMAXPATH - 1 ] = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardDetach()'. A running Recovery
+*           Thread is stopped, the board stays as it is.
+*/
+VOID PlugDetach( ULONG ulSlot )
+{
+  TID tidPlug;
+  PLUGBOARD *pPlug;
+
+  pPlug = &aPlug[ ulSlot ];
+  if ( pPlug->hmtx == 0 )
+  {
+    return;
+  }
+
+  DosRequestMutexSem( pPlug->hmtx, SEM_INDEFINITE_WAIT );
+  tidPlug = pPlug->tid;
+  pPlug->blRun = FALSE;
+  pPlug->tid = 0;
+  DosReleaseMutexSem( pPlug->hmtx );
+
+  // -- Not under the lock, the thread takes it to finish --
+  if ( tidPlug != 0 )
+  {
+    DosPostEventSem( pPlug->hevStop );
+    DosWaitThread( &tidPlug, DCWW_WAIT );
+  }
+  pPlug->lState = PLUG_UP;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    One attempt of the Recovery Thread: open, put
+*           the new handle in place of the old one, init and
+*           write the last output frame again.
+*
+* \return   RET_OKAY, ERROR_FROM_CALL or the Return Code of
+*           'InitBoard()'
+*/
+static ULONG PlugReopen( ULONG ulSlot )
+{
+  ULONG ulRc;
+  ULONG ulRcDOScall;
+  ULONG ulAction;
+  ULONG hDev;
+  ULONG hNew;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  BOOL  blLocked;
+  PLUGBOARD *pPlug;
+
+  pPlug = &aPlug[ ulSlot ];
+  hDev = BoardHandle( ulSlot );
+
+  // -- Every transfer owns the transfer lock of its board --
+  blLocked = BoardTryLockXfer( ulSlot, PLUG_XFER_WAIT_MS );
+
+  if ( EmulHandle( hDev ) == TRUE )
+  {
+    // -- An emulated K8055 is back once its fault is over --
+    if ( blLocked == FALSE )
+    {
+      return ERROR_FROM_CALL;
+    }
+    ulRcDOScall = EmulReplug( hDev );
+  }
+  else
+  {
+    ulAction = 0;
+    ulRcDOScall = DosOpen( pPlug->szName,
+                           &hNew,
+                           &ulAction,
+                           0, 0, 1, 18, 0 );
+    if ( ulRcDOScall != NO_DOS_ERROR )
+    {
+      if ( blLocked == TRUE )
+      {
+        BoardUnlockXfer( ulSlot );
+      }
+      return ERROR_FROM_CALL;
+    }
+
+    // -- No transfer may run while the handle is replaced,
+    //    but a hung one only ends by replacing it --
+    ulRcDOScall = DosDupHandle( hNew, &hDev );
+    DosClose( hNew );
+    if ( blLocked == FALSE )
+    {
+      return ERROR_FROM_CALL;
+    }
+  }
+
+  // -- The transfer lock is kept for the init, the shared
+  //    lock is not needed --
+  ulRc = RET_OKAY;
+  if ( ulRcDOScall != NO_DOS_ERROR )
+  {
+    ulRc = ERROR_FROM_CALL;
+  }
+  if ( ulRc == RET_OKAY )
+  {
+    ulRc = InitBoard( hDev );
+  }
+  if ( ulRc == RET_OKAY )
+  {
+    // -- Outputs as they were before the board got lost --
+    BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+    if ( BoardWriteFrame( ulSlot, ulDigitalOut,
+                          ulDAC1, ulDAC2 ) != NO_DOS_ERROR )
+    {
+      ulRc = ERROR_FROM_CALL;
+    }
+  }
+  BoardUnlockXfer( ulSlot );
+
+  return ulRc;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of the Recovery Thread of one K8055. It ends
+*           when the board is back or closed.
+*
+* \param    'pvSlot'
+*           - Board Slot, passed as a pointer value.
+*/
+static VOID PlugThread( VOID *pvSlot )
+{
+  ULONG ulSlot;
+  ULONG ulWaitMs;
+  ULONG ulPostCount;
+  K8055TIME tmOutage;
+  PLUGBOARD *pPlug;
+
+  ulSlot = (ULONG)pvSlot;
+  pPlug = &aPlug[ ulSlot ];
+
+  ulWaitMs = PLUG_BACKOFF_MIN_MS;
+  while ( pPlug->blRun == TRUE )
+  {
+    // -- Posted by 'PlugDetach()' only --
+    if ( DosWaitEventSem( pPlug->hevStop, ulWaitMs ) == NO_DOS_ERROR )
+    {
+      break;
+    }
+
+    ++pPlug->ulAttempts;
+    if ( PlugReopen( ulSlot ) == RET_OKAY )
+    {
+      DosRequestMutexSem( pPlug->hmtx, SEM_INDEFINITE_WAIT );
+      tmOutage = TimeNowUs() - pPlug->tmFirstFail;
+      ++pPlug->ulOutages;
+      pPlug->tmOutageLast = tmOutage;
+      pPlug->tmOutageTotal = pPlug->tmOutageTotal + tmOutage;
+      pPlug->ulLostLast = (ULONG)AtomicExchange( &pPlug->lFailedReads, 0 );
+      pPlug->ulLostTotal = pPlug->ulLostTotal + pPlug->ulLostLast;
+      AtomicExchange( &pPlug->lFails, 0 );
+      AtomicExchange( &pPlug->lState, PLUG_UP );
+      pPlug->blRun = FALSE;
+      pPlug->tid = 0;
+      DosReleaseMutexSem( pPlug->hmtx );
+      break;
+    }
+
+    ulWaitMs = ulWaitMs * 2;
+    if ( ulWaitMs > pPlug->ulBackoffMaxMs )
+    {
+      ulWaitMs = pPlug->ulBackoffMaxMs;
+    }
+  }
+
+  DosResetEventSem( pPlug->hevStop, &ulPostCount );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Result of one transfer. Failures in a row make
+*           the board count as lost and start the Recovery
+*           Thread, a success ends the row.
+*
+* \param    'ulRc'
+*           - Error bits of the transfer. ERROR_FROM_CALL and
+*           ERROR_BYTE_NUMBER count as failure. Not so
+*           ERROR_TOGGLE_BIT: the K8055 has answered, several
+*           readers of one EP81 miss Toggle Bits all the
+*           time.
+*
+* \param    'blRead'
+*           - TRUE for an EP81 report, it counts as lost
+*           sample.
+*/
+VOID PlugResult( ULONG ulSlot, ULONG ulRc, BOOL blRead )
+{
+  INT iTid;
+  LONG lFails;
+  PLUGBOARD *pPlug;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return;
+  }
+  pPlug = &aPlug[ ulSlot ];
+
+  if ( ( ulRc & ( ERROR_FROM_CALL |
+                  ERROR_BYTE_NUMBER ) ) == 0 )
+  {
+    // -- While lost only the Recovery Thread ends the row --
+    if ( ( pPlug->lFails != 0 ) && ( pPlug->lState == PLUG_UP ) )
+    {
+      AtomicExchange( &pPlug->lFails, 0 );
+      AtomicExchange( &pPlug->lFailedReads, 0 );
+    }
+    return;
+  }
+
+  lFails = AtomicExchangeAdd( &pPlug->lFails, 1 ) + 1;
+  if ( lFails == 1 )
+  {
+    pPlug->tmFirstFail = TimeNowUs();
+  }
+  if ( blRead == TRUE )
+  {
+    AtomicExchangeAdd( &pPlug->lFailedReads, 1 );
+  }
+
+  if ( ( pPlug->ulFailLimit == 0 ) ||
+       ( (ULONG)lFails < pPlug->ulFailLimit ) ||
+       ( pPlug->szName[0] == 0 ) )
+  {
+    return;
+  }
+
+  // -- One caller only starts the Recovery Thread --
+  if ( AtomicCompareExchange( &pPlug->lState,
+                              PLUG_LOST, PLUG_UP ) != PLUG_UP )
+  {
+    return;
+  }
+
+  pPlug->blRun = TRUE;
+  iTid = _beginthread( PlugThread, NULL, THREAD_STACK_SIZE,
+                       (VOID *)ulSlot );
+  if ( iTid == -1 )
+  {
+    // -- Next failure tries again --
+    pPlug->blRun = FALSE;
+    AtomicExchange( &pPlug->lState, PLUG_UP );
+    return;
+  }
+  pPlug->tid = (TID)iTid;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------52-
+//
+// Export Index 52
+/**
+* \brief 'K8055_SetRecovery()' sets when a K8055 counts as
+* lost and how long the Recovery Thread waits at most between
+* two attempts. See 'func.h' for details.
+*/
+ULONG K8055_SetRecovery( ULONG *pulFileDesc,
+                         ULONG *pulFailLimit,
+                         ULONG *pulBackoffMaxMs )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  PLUGBOARD *pPlug;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulFailLimit ) ||
+       ( NULL == pulBackoffMaxMs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulFailLimit > PLUG_FAILS_MAX ) ||
+       ( *pulBackoffMaxMs < PLUG_BACKOFF_MIN_MS ) ||
+       ( *pulBackoffMaxMs > PLUG_BACKOFF_MAX_MS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pPlug = &aPlug[ ulSlot ];
+  DosRequestMutexSem( pPlug->hmtx, SEM_INDEFINITE_WAIT );
+  pPlug->ulFailLimit = *pulFailLimit;
+  pPlug->ulBackoffMaxMs = *pulBackoffMaxMs;
+  DosReleaseMutexSem( pPlug->hmtx );
+
+  return ulRc;
+}
+//---------52-
+
+
+//----------------------------------------------------------53-
+//
+// Export Index 53
+/**
+* \brief 'K8055_GetPlugStats()' tells whether a K8055 is lost
+* right now and how long its outages took.
+* See 'func.h' for details.
+*/
+ULONG K8055_GetPlugStats( ULONG *pulFileDesc,
+                          ULONG *pulState,
+                          ULONG *pulOutages,
+                          ULONG *pulOutageMs,
+                          ULONG *pulOutageTotalMs,
+                          ULONG *pulSamplesLost    )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  PLUGBOARD *pPlug;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulState ) ||
+       ( NULL == pulOutages ) ||
+       ( NULL == pulOutageMs ) ||
+       ( NULL == pulOutageTotalMs ) ||
+       ( NULL == pulSamplesLost ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pPlug = &aPlug[ ulSlot ];
+  DosRequestMutexSem( pPlug->hmtx, SEM_INDEFINITE_WAIT );
+  *pulState = (ULONG)pPlug->lState;
+  *pulOutages = pPlug->ulOutages;
+  *pulOutageTotalMs = (ULONG)( pPlug->tmOutageTotal / 1000 );
+  *pulSamplesLost = pPlug->ulLostTotal;
+  if ( pPlug->lState == PLUG_LOST )
+  {
+    // -- The outage going on, so far --
+    *pulOutageMs = (ULONG)( ( TimeNowUs() - pPlug->tmFirstFail ) / 1000 );
+    *pulSamplesLost = *pulSamplesLost + (ULONG)pPlug->lFailedReads;
+  }
+  else
+  {
+    *pulOutageMs = (ULONG)( pPlug->tmOutageLast / 1000 );
+  }
+  DosReleaseMutexSem( pPlug->hmtx );
+
+  return ulRc;
+}
+//---------53-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= plug.c === END ===
@@ -0,0 +1,71 @@
+/**
+ * \file 'plug.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'plug.h' is the headerfile belonging to 'plug.c',
+ * the watch over unplugged or reset K8055 and their
+ * recovery in the background.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 PLUG_XFER_WAIT_MS
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_PLUG_
+#define __K8055DD_H_PLUG_
+
+
+//-- Values belonging to the recovery ----------- BEGIN --!
+//
+/**
+* \brief State of a board, see 'K8055_GetPlugStats()'
+*/
+#define PLUG_UP   0      // Transfers work
+#define PLUG_LOST 1      // Lost, Recovery Thread at work
+
+/**
+* \brief Failed transfers in a row that make a board count as
+* lost. 0 switches the recovery off.
+*/
+#define PLUG_FAILS_DEFAULT 3
+#define PLUG_FAILS_MAX     100
+
+/**
+* \brief Waiting time of the Recovery Thread between two
+* attempts. It starts with the minimum and is doubled after
+* every failed attempt, up to the maximum.
+*/
+#define PLUG_BACKOFF_MIN_MS     100
+#define PLUG_BACKOFF_DEFAULT_MS 5000
+#define PLUG_BACKOFF_MAX_MS     60000
+
+/**
+* \brief Longest wait of the Recovery Thread for the transfer
+* lock. A transfer hung in the driver keeps it, the handle is
+* then replaced without the lock.
+*/
+#define PLUG_XFER_WAIT_MS 100
+//
+//-- Values belonging to the recovery ------------- END --!
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID PlugAttach( ULONG ulSlot );
+VOID PlugDetach( ULONG ulSlot );
+
+//--- Used by func.c ------------------------------------------
+//
+VOID PlugName( ULONG ulSlot, CHAR *pcaDeviceName );
+
+//--- Used by every transfer on EP01 and EP81 -----------------
+//    'ulRc' holds the error bits of the transfer. Lock free,
+//    may be called with any lock owned.
+//
+VOID PlugResult( ULONG ulSlot, ULONG ulRc, BOOL blRead );
+
+#endif
+
+
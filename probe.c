@@ -0,0 +1,178 @@
+//======================================= probe.c === BEGIN ===
+/**
+ * \file  'probe.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Static probe points on the transfer path.
+ *
+ * The library marks the start and the end of every transfer,
+ * every EP81 report without a new Toggle Bit, every retry and
+ * the steps of 'K8055_Init()' with 'PROBE()' ( see
+ * 'probe.h' ). An application or a monitor loaded into it
+ * hands over a hook with 'K8055_SetProbes()' and chooses the
+ * probe points it wants. The hook gets the probe number, the
+ * handle, two values and the library clock, and may build
+ * latency histograms or a log of a running plant, without
+ * another build of the DLL.
+ *
+ * A probe point that is off costs a test of 'ulProbeMask'.
+ * Built with 'K8055_NO_PROBES' defined the probe points are
+ * gone completely.
+ *
+ * The hook is called by the thread at the probe point, often
+ * with the transfer lock of the board owned. It must return
+ * quickly and must not call the library.
+ *
+ * The hook and its user pointer are kept together in one of
+ * two records. A record is never changed while it is
+ * published, the new one is published by an interlocked
+ * exchange of the record index, like the tables of
+ * 'reflex.c'. Running hook calls are counted, and
+ * 'K8055_SetProbes()' returns only after they are over. So
+ * after 'K8055_SetProbes()' with NULL the old hook is never
+ * called again and may be unloaded.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 hook and user pointer published together,
+ * 'K8055_SetProbes()' waits for running hook calls
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "atomic.h"
+#include "probe.h"
+
+
+//-----------------------------------------------------------//
+//--- Probe points switched on, and the hook ----------------//
+//
+volatile ULONG ulProbeMask = 0;
+
+typedef struct _PROBEHOOK
+{
+  PFNK8055PROBE pfnHook;
+  VOID         *pvUser;
+} PROBEHOOK;
+
+PROBEHOOK aProbeHook[ 2 ];
+
+// -- Published record, 0: none, 1 or 2: 'aProbeHook[]' + 1 --
+volatile LONG lProbeHook = 0;
+
+// -- Hook calls running just now --
+volatile LONG lProbeBusy = 0;
+
+// -- 'K8055_SetProbes()' running just now --
+volatile LONG lProbeSetting = 0;
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Calls the hook for a probe point that is on.
+*/
+VOID ProbeFire( ULONG ulProbe, ULONG ulHandle,
+                ULONG ulArg1, ULONG ulArg2 )
+{
+  LONG lHook;
+  PROBEHOOK *pHook;
+
+  AtomicExchangeAdd( &lProbeBusy, 1 );
+  lHook = lProbeHook;
+  if ( lHook != 0 )
+  {
+    pHook = &aProbeHook[ lHook - 1 ];
+    pHook->pfnHook( ulProbe, ulHandle, ulArg1, ulArg2,
+                    (ULONG)TimeNowUs(), pHook->pvUser );
+  }
+  AtomicExchangeAdd( &lProbeBusy, -1 );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------66-
+//
+// Export Index 66
+/**
+* \brief 'K8055_SetProbes()' hands over the hook of the probe
+* points and switches them on or off. See 'func.h' for
+* details.
+*/
+ULONG K8055_SetProbes( PFNK8055PROBE pfnHook,
+                       VOID *pvUser,
+                       ULONG *pulMask         )
+{
+  ULONG ulRc;
+  LONG  lNew;
+  //
+  ulRc = RET_OKAY;
+
+  if ( NULL == pulMask )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulMask & ~PROBE_MASK_ALL ) != 0 )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  // -- One caller at a time --
+  while ( AtomicExchange( &lProbeSetting, 1 ) != 0 )
+  {
+    DosSleep( 1 );
+  }
+
+  // -- All off while the hook changes. The record not
+  //    published is not in use, running hook calls were
+  //    waited for by the call before --
+  AtomicExchange( (volatile LONG *)&ulProbeMask, 0 );
+  lNew = 0;
+  if ( pfnHook != NULL )
+  {
+    lNew = ( lProbeHook == 1 ) ? 2 : 1;
+    aProbeHook[ lNew - 1 ].pfnHook = pfnHook;
+    aProbeHook[ lNew - 1 ].pvUser = pvUser;
+  }
+  AtomicExchange( &lProbeHook, lNew );
+
+  // -- Probe points passed before still call the old hook --
+  while ( lProbeBusy != 0 )
+  {
+    DosSleep( 0 );
+  }
+
+  if ( pfnHook != NULL )
+  {
+    AtomicExchange( (volatile LONG *)&ulProbeMask, (LONG)*pulMask );
+  }
+
+  AtomicExchange( &lProbeSetting, 0 );
+
+  return ulRc;
+}
+//---------66-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== probe.c === END ===
@@ -0,0 +1,86 @@
+/**
+ * \file 'probe.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'probe.h' is the headerfile belonging to 'probe.c',
+ * the static probe points on the transfer path. The modules
+ * mark a probe point with 'PROBE()'.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 'PROBE()' is one statement
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_PROBE_
+#define __K8055DD_H_PROBE_
+
+
+//-- Values belonging to the probe points ------- BEGIN --!
+//
+/**
+* \brief Probe points. The hook of 'K8055_SetProbes()' gets
+* the number, the handle and two values:
+*
+*   PROBE_XFER_SUBMIT   TRACE_SETUP / TRACE_DATA,
+*                       TRACE_OUT / TRACE_IN
+*   PROBE_XFER_DONE     return value of 'DosWrite()',
+*                       duration in us
+*   PROBE_TOGGLE_MISS   attempt 1.., 0
+*   PROBE_RETRY         attempt 1.. that failed, pause in us
+*   PROBE_INIT_STEP     step 1..9, 0
+*   PROBE_INIT_STEP_END step 1..9, return value of the step
+*/
+#define PROBE_XFER_SUBMIT   0
+#define PROBE_XFER_DONE     1
+#define PROBE_TOGGLE_MISS   2
+#define PROBE_RETRY         3
+#define PROBE_INIT_STEP     4
+#define PROBE_INIT_STEP_END 5
+#define PROBE_COUNT         6
+
+#define PROBE_MASK_ALL      0x3F
+//
+//-- Values belonging to the probe points --------- END --!
+
+
+//-----------------------------------------------------------//
+//--- Probe points switched on, bit 'PROBE_xxx' -------------//
+//
+extern volatile ULONG ulProbeMask;
+
+
+//-------------------------------------------------------------
+// A probe point. While it is off, it costs one test of
+// 'ulProbeMask'. Compiled with 'K8055_NO_PROBES' defined,
+// there is no code at all.
+//
+#if defined( K8055_NO_PROBES )
+
+#define PROBE( ulProbe, ulHandle, ulArg1, ulArg2 )             \
+        do { } while ( 0 )
+
+#else
+
+#define PROBE( ulProbe, ulHandle, ulArg1, ulArg2 )             \
+        do                                                     \
+        {                                                      \
+          if ( ( ulProbeMask & ( 1UL << ( ulProbe ) ) ) != 0 ) \
+          {                                                    \
+            ProbeFire( ( ulProbe ), (ULONG)( ulHandle ),       \
+                       ( ulArg1 ), ( ulArg2 ) );               \
+          }                                                    \
+        } while ( 0 )
+
+#endif
+
+
+//--- Used by 'PROBE()' ---------------------------------------
+//
+VOID ProbeFire( ULONG ulProbe, ULONG ulHandle,
+                ULONG ulArg1, ULONG ulArg2 );
+
+#endif
+
+
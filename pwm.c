@@ -0,0 +1,335 @@
+//========================================= pwm.c === BEGIN ===
+/**
+ * \file  'pwm.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Software PWM on the digital outputs O1..O8.
+ *
+ * Every output can run a slow PWM (1..10 Hz) for heaters or
+ * valves. The pattern is computed by the Output Thread (see
+ * 'output.c') once per Output Slot of 10 ms. The edges of
+ * all outputs in one slot are written with one EP01 frame,
+ * and a frame is only written if a bit changes.
+ *
+ * A period of 100 ms has got only 10 slots, but the duty
+ * cycle is given in steps of 1 %. The part of the on time
+ * that does not fill a whole slot is carried over into the
+ * next period. So the mean duty cycle is exact, the single
+ * period is off by less than one slot.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "output.h"
+#include "pwm.h"
+
+
+/**
+* \brief One PWM channel
+*/
+typedef struct _PWMCHANNEL
+{
+  BOOL  blFresh;          // Set, not yet started
+  ULONG ulPeriodSlots;    // Period in Output Slots
+  ULONG ulDuty;           // 0..100 %
+  ULONG ulLastTick;       // Output Slot seen last
+  ULONG ulPhase;          // Slot within the period
+  ULONG ulOnSlots;        // On time of this period
+  ULONG ulCarry;          // Rest of the on time, 1/100 slot
+} PWMCHANNEL;
+
+/**
+* \brief PWM data of one K8055
+*/
+typedef struct _PWMBOARD
+{
+  HMTX       hmtx;        // Guards everything below
+  ULONG      ulMask;      // Outputs running PWM, O1 = 0x01
+  PWMCHANNEL aChannel[ PWM_CHANNELS ];
+} PWMBOARD;
+
+
+//-----------------------------------------------------------//
+//--- PWM data, indexed by Board Slot -----------------------//
+//
+PWMBOARD aPwm[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. All outputs start
+*           without PWM.
+*/
+VOID PwmAttach( ULONG ulSlot )
+{
+  PWMBOARD *pPwm;
+
+  pPwm = &aPwm[ ulSlot ];
+
+  if ( pPwm->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pPwm->hmtx, 0, FALSE );
+  }
+  pPwm->ulMask = 0;
+  memset( &pPwm->aChannel[0], 0, sizeof( pPwm->aChannel ) );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Starts a new period: on time in slots, the rest
+*           is carried over.
+*/
+static VOID PwmNewPeriod( PWMCHANNEL *pChannel )
+{
+  ULONG ulOn;
+
+  // -- On time in 1/100 slot --
+  ulOn = pChannel->ulDuty * pChannel->ulPeriodSlots +
+         pChannel->ulCarry;
+  pChannel->ulOnSlots = ulOn / 100;
+  pChannel->ulCarry = ulOn % 100;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by the Output Thread at the start of every
+*           Output Slot. Adds the PWM outputs to the request.
+*
+* \param    'ulTick'
+*           - Number of the slot. Slots the thread has missed
+*           are not passed, so the number may jump.
+*/
+VOID PwmSlot( ULONG ulSlot, ULONG ulTick, OUTPUTREQ *pReq )
+{
+  ULONG ulIndex;
+  ULONG ulBit;
+  PWMBOARD *pPwm;
+  PWMCHANNEL *pChannel;
+
+  pPwm = &aPwm[ ulSlot ];
+
+  DosRequestMutexSem( pPwm->hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < PWM_CHANNELS; ulIndex++ )
+  {
+    ulBit = 1 << ulIndex;
+    if ( ( pPwm->ulMask & ulBit ) == 0 )
+    {
+      continue;
+    }
+    pChannel = &pPwm->aChannel[ ulIndex ];
+
+    if ( pChannel->blFresh == TRUE )
+    {
+      pChannel->blFresh = FALSE;
+      pChannel->ulPhase = 0;
+      pChannel->ulCarry = 0;
+      PwmNewPeriod( pChannel );
+    }
+    else
+    {
+      pChannel->ulPhase = pChannel->ulPhase +
+                          ( ulTick - pChannel->ulLastTick );
+      while ( pChannel->ulPhase >= pChannel->ulPeriodSlots )
+      {
+        pChannel->ulPhase = pChannel->ulPhase -
+                            pChannel->ulPeriodSlots;
+        PwmNewPeriod( pChannel );
+      }
+    }
+    pChannel->ulLastTick = ulTick;
+
+    pReq->ulDoMask = pReq->ulDoMask | ulBit;
+    if ( pChannel->ulPhase < pChannel->ulOnSlots )
+    {
+      pReq->ulDoBits = pReq->ulDoBits | ulBit;
+    }
+  }
+
+  DosReleaseMutexSem( pPwm->hmtx );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------29-
+//
+// Export Index 29
+/**
+* \brief 'K8055_SetPwm()' starts PWM on one digital output or
+* changes its duty cycle. See 'func.h' for details.
+*/
+ULONG K8055_SetPwm( ULONG *pulFileDesc,
+                    ULONG *pulChannel,
+                    ULONG *pulPeriodMs,
+                    ULONG *pulDuty      )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulBit;
+  PWMBOARD *pPwm;
+  PWMCHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulPeriodMs ) ||
+       ( NULL == pulDuty ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannel < 1 ) || ( *pulChannel > PWM_CHANNELS ) ||
+       ( *pulPeriodMs < PWM_PERIOD_MIN_MS ) ||
+       ( *pulPeriodMs > PWM_PERIOD_MAX_MS ) ||
+       ( ( *pulPeriodMs % OUTPUT_SLOT_MS ) != 0 ) ||
+       ( *pulDuty > PWM_DUTY_MAX ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pPwm = &aPwm[ ulSlot ];
+  pChannel = &pPwm->aChannel[ *pulChannel - 1 ];
+  ulBit = 1 << ( *pulChannel - 1 );
+
+  DosRequestMutexSem( pPwm->hmtx, SEM_INDEFINITE_WAIT );
+
+  // -- A running channel takes the new values with its
+  //    next period --
+  if ( ( ( pPwm->ulMask & ulBit ) == 0 ) ||
+       ( pChannel->ulPeriodSlots != *pulPeriodMs / OUTPUT_SLOT_MS ) )
+  {
+    pChannel->blFresh = TRUE;
+  }
+  pChannel->ulPeriodSlots = *pulPeriodMs / OUTPUT_SLOT_MS;
+  pChannel->ulDuty = *pulDuty;
+  pPwm->ulMask = pPwm->ulMask | ulBit;
+
+  DosReleaseMutexSem( pPwm->hmtx );
+
+  ulRc = ulRc | OutputDemand( ulSlot, OUTPUT_CLIENT_PWM, TRUE );
+
+  return ulRc;
+}
+//---------29-
+
+
+//----------------------------------------------------------30-
+//
+// Export Index 30
+/**
+* \brief 'K8055_StopPwm()' ends PWM on one digital output and
+* switches it off. See 'func.h' for details.
+*/
+ULONG K8055_StopPwm( ULONG *pulFileDesc,
+                     ULONG *pulChannel   )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulBit;
+  ULONG ulMask;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  PWMBOARD *pPwm;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannel < 1 ) || ( *pulChannel > PWM_CHANNELS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pPwm = &aPwm[ ulSlot ];
+  ulBit = 1 << ( *pulChannel - 1 );
+
+  // -- No Output Slot in between: the bit stays off --
+  OutputLock( ulSlot );
+
+  DosRequestMutexSem( pPwm->hmtx, SEM_INDEFINITE_WAIT );
+  pPwm->ulMask = pPwm->ulMask & ~ulBit;
+  ulMask = pPwm->ulMask;
+  DosReleaseMutexSem( pPwm->hmtx );
+
+  BoardLockXfer( ulSlot );
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+  if ( ( ulDigitalOut & ulBit ) != 0 )
+  {
+    if ( BoardWriteFrame( ulSlot, ulDigitalOut & ~ulBit,
+                          ulDAC1, ulDAC2 ) != NO_DOS_ERROR )
+    {
+      ulRc = ulRc | ERROR_FROM_CALL;
+    }
+  }
+  BoardUnlockXfer( ulSlot );
+
+  OutputUnlock( ulSlot );
+
+  if ( ulMask == 0 )
+  {
+    ulRc = ulRc | OutputDemand( ulSlot, OUTPUT_CLIENT_PWM, FALSE );
+
+    // -- 'K8055_SetPwm()' from another thread in between --
+    if ( pPwm->ulMask != 0 )
+    {
+      ulRc = ulRc | OutputDemand( ulSlot, OUTPUT_CLIENT_PWM, TRUE );
+    }
+  }
+
+  return ulRc;
+}
+//---------30-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================== pwm.c === END ===
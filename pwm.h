@@ -0,0 +1,48 @@
+/**
+ * \file 'pwm.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'pwm.h' is the headerfile belonging to 'pwm.c'.
+ * It provides the constants of the software PWM on the
+ * digital outputs. Include 'output.h' first.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_PWM_
+#define __K8055DD_H_PWM_
+
+
+//-- Values belonging to the PWM ---------------- BEGIN --!
+//
+/**
+* \brief Number of PWM channels, one per digital output
+* O1..O8.
+*/
+#define PWM_CHANNELS 8
+
+/**
+* \brief Period limits in milliseconds (10 Hz .. 1 Hz). The
+* period must be a multiple of OUTPUT_SLOT_MS.
+*/
+#define PWM_PERIOD_MIN_MS 100
+#define PWM_PERIOD_MAX_MS 1000
+
+/**
+* \brief Duty cycle is given in percent.
+*/
+#define PWM_DUTY_MAX 100
+//
+//-- Values belonging to the PWM ------------------ END --!
+
+
+//--- Used by board.c and output.c ----------------------------
+//
+VOID PwmAttach( ULONG ulSlot );
+VOID PwmSlot( ULONG ulSlot, ULONG ulTick, OUTPUTREQ *pReq );
+
+#endif
+
+
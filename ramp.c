@@ -0,0 +1,615 @@
+//======================================== ramp.c === BEGIN ===
+/**
+ * \file  'ramp.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Ramps and slew rate limits on DAC1 and DAC2.
+ *
+ * A ramp moves a DAC from its current value to a target in
+ * equal steps, one step per Output Slot of 10 ms (see
+ * 'output.c'). The position is kept in 1/1000 DAC counts,
+ * so slow ramps do not lose steps to rounding.
+ *
+ * A slew rate limit caps the step of every ramp. It also
+ * catches 'K8055_SetAllOutputs()' and every frame written by
+ * 'BoardWriteFrame()': a DAC value that would jump further
+ * than the limit allows is not written, the DAC is ramped to
+ * it instead. A ramp running without a limit is cancelled by
+ * 'K8055_SetAllOutputs()' with a value other than its
+ * target.
+ *
+ * The Output Thread is demanded while a ramp runs. When all
+ * ramps of a board have reached their target, the thread
+ * drops the demand by itself (see 'RampIdle()').
+ *
+ * \version 1.0.2 -
+ * 2026-10-19 'RampLimitFrame()': the slew rate limit holds
+ * for all frames of 'BoardWriteFrame()'
+ * \version 1.0.1 -
+ * 2026-10-19 no store into 'byaPutData[]', a DAC value
+ * equal to the one sent keeps a running ramp
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "output.h"
+#include "ramp.h"
+
+
+/**
+* \brief Ramp of one DAC. Positions and steps are given in
+* 1/1000 DAC counts.
+*/
+typedef struct _RAMPCHANNEL
+{
+  BOOL  blRun;
+  ULONG ulSlew;           // Counts per second, 0 = no limit
+  ULONG ulPos;
+  ULONG ulTarget;
+  ULONG ulStep;           // Per Output Slot
+} RAMPCHANNEL;
+
+/**
+* \brief Ramp data of one K8055
+*/
+typedef struct _RAMPBOARD
+{
+  HMTX        hmtx;       // Guards everything below
+  RAMPCHANNEL aChannel[ RAMP_CHANNELS ];
+} RAMPBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Ramp data, indexed by Board Slot ----------------------//
+//
+RAMPBOARD aRamp[ K8055_MAX_BOARDS ];
+
+//-----------------------------------------------------------//
+//--- One DAC count in ramp units ---------------------------//
+//
+#define RAMP_UNIT 1000
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. No ramps, no limits.
+*/
+VOID RampAttach( ULONG ulSlot )
+{
+  RAMPBOARD *pRamp;
+
+  pRamp = &aRamp[ ulSlot ];
+
+  if ( pRamp->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pRamp->hmtx, 0, FALSE );
+  }
+  memset( &pRamp->aChannel[0], 0, sizeof( pRamp->aChannel ) );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Largest step per Output Slot the slew rate limit
+*           of a channel allows.
+*/
+static ULONG RampSlewStep( RAMPCHANNEL *pChannel )
+{
+  if ( pChannel->ulSlew == RAMP_SLEW_OFF )
+  {
+    return 255 * RAMP_UNIT;
+  }
+  return pChannel->ulSlew * RAMP_UNIT / ( 1000 / OUTPUT_SLOT_MS );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by the Output Thread at the start of every
+*           Output Slot. Moves the running ramps one step on
+*           and adds their DAC values to the request.
+*/
+VOID RampSlot( ULONG ulSlot, ULONG ulTick, OUTPUTREQ *pReq )
+{
+  ULONG ulIndex;
+  ULONG ulValue;
+  RAMPBOARD *pRamp;
+  RAMPCHANNEL *pChannel;
+
+  pRamp = &aRamp[ ulSlot ];
+
+  DosRequestMutexSem( pRamp->hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < RAMP_CHANNELS; ulIndex++ )
+  {
+    pChannel = &pRamp->aChannel[ ulIndex ];
+    if ( pChannel->blRun == FALSE )
+    {
+      continue;
+    }
+
+    if ( pChannel->ulPos < pChannel->ulTarget )
+    {
+      pChannel->ulPos = pChannel->ulPos + pChannel->ulStep;
+      if ( pChannel->ulPos > pChannel->ulTarget )
+      {
+        pChannel->ulPos = pChannel->ulTarget;
+      }
+    }
+    else
+    {
+      if ( pChannel->ulPos - pChannel->ulTarget > pChannel->ulStep )
+      {
+        pChannel->ulPos = pChannel->ulPos - pChannel->ulStep;
+      }
+      else
+      {
+        pChannel->ulPos = pChannel->ulTarget;
+      }
+    }
+
+    if ( pChannel->ulPos == pChannel->ulTarget )
+    {
+      pChannel->blRun = FALSE;
+    }
+
+    ulValue = ( pChannel->ulPos + RAMP_UNIT / 2 ) / RAMP_UNIT;
+    if ( ulIndex == 0 )
+    {
+      pReq->blDac1 = TRUE;
+      pReq->ulDac1 = ulValue;
+    }
+    else
+    {
+      pReq->blDac2 = TRUE;
+      pReq->ulDac2 = ulValue;
+    }
+  }
+
+  DosReleaseMutexSem( pRamp->hmtx );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Asked by the Output Thread after a slot.
+*
+* \return   TRUE, if no ramp of the board runs any more.
+*/
+BOOL RampIdle( ULONG ulSlot )
+{
+  ULONG ulIndex;
+  BOOL  blIdle;
+  RAMPBOARD *pRamp;
+
+  pRamp = &aRamp[ ulSlot ];
+  blIdle = TRUE;
+
+  DosRequestMutexSem( pRamp->hmtx, SEM_INDEFINITE_WAIT );
+  for ( ulIndex = 0; ulIndex < RAMP_CHANNELS; ulIndex++ )
+  {
+    if ( pRamp->aChannel[ ulIndex ].blRun == TRUE )
+    {
+      blIdle = FALSE;
+    }
+  }
+  DosReleaseMutexSem( pRamp->hmtx );
+
+  return blIdle;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    See 'ramp.h'.
+*
+* \param    'pbyData'
+*           - The 8 data bytes of the EP01 frame, DAC1 and
+*           DAC2 at [2] and [3].
+*/
+BOOL RampFilterFrame( ULONG ulSlot, BYTE *pbyData )
+{
+  ULONG ulIndex;
+  ULONG ulSent[ RAMP_CHANNELS ];
+  ULONG ulWanted;
+  ULONG ulDigitalOut;
+  BOOL  blStart;
+  RAMPBOARD *pRamp;
+  RAMPCHANNEL *pChannel;
+
+  pRamp = &aRamp[ ulSlot ];
+  blStart = FALSE;
+
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &ulSent[0], &ulSent[1] );
+
+  DosRequestMutexSem( pRamp->hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < RAMP_CHANNELS; ulIndex++ )
+  {
+    pChannel = &pRamp->aChannel[ ulIndex ];
+    ulWanted = pbyData[ 2 + ulIndex ];
+
+    if ( pChannel->blRun == TRUE )
+    {
+      if ( ( ulWanted * RAMP_UNIT == pChannel->ulTarget ) ||
+           ( ulWanted == ulSent[ ulIndex ] ) )
+      {
+        // -- Unchanged target or the value sent last, as
+        //    merged by 'BoardLegacyMerge()', the ramp
+        //    goes on --
+      }
+      else if ( pChannel->ulSlew != RAMP_SLEW_OFF )
+      {
+        pChannel->ulTarget = ulWanted * RAMP_UNIT;
+        pChannel->ulStep = RampSlewStep( pChannel );
+      }
+      else
+      {
+        pChannel->blRun = FALSE;
+        continue;
+      }
+      pbyData[ 2 + ulIndex ] =
+          (BYTE)( ( pChannel->ulPos + RAMP_UNIT / 2 ) / RAMP_UNIT );
+    }
+    else if ( ( pChannel->ulSlew != RAMP_SLEW_OFF ) &&
+              ( ulWanted != ulSent[ ulIndex ] ) )
+    {
+      pChannel->ulPos = ulSent[ ulIndex ] * RAMP_UNIT;
+      pChannel->ulTarget = ulWanted * RAMP_UNIT;
+      pChannel->ulStep = RampSlewStep( pChannel );
+      pChannel->blRun = TRUE;
+      pbyData[ 2 + ulIndex ] = (BYTE)ulSent[ ulIndex ];
+      blStart = TRUE;
+    }
+  }
+
+  DosReleaseMutexSem( pRamp->hmtx );
+
+  return blStart;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    See 'ramp.h'. A step the limit allows within one
+*           Output Slot is written as it is. The values of
+*           a running ramp are its own, or are the value
+*           sent last.
+*
+* \param    'paulSent'
+*           - DAC1 and DAC2 sent last.
+*
+* \param    'paulDac'
+*           - DAC1 and DAC2 to be written, replaced by the
+*           value the limit allows.
+*/
+BOOL RampLimitFrame( ULONG ulSlot, ULONG *paulSent, ULONG *paulDac )
+{
+  ULONG ulIndex;
+  ULONG ulWanted;
+  ULONG ulRunning;
+  ULONG ulMaxJump;
+  BOOL  blStart;
+  RAMPBOARD *pRamp;
+  RAMPCHANNEL *pChannel;
+
+  pRamp = &aRamp[ ulSlot ];
+  blStart = FALSE;
+
+  DosRequestMutexSem( pRamp->hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < RAMP_CHANNELS; ulIndex++ )
+  {
+    pChannel = &pRamp->aChannel[ ulIndex ];
+    if ( pChannel->ulSlew == RAMP_SLEW_OFF )
+    {
+      continue;
+    }
+    ulWanted = paulDac[ ulIndex ];
+
+    if ( pChannel->blRun == TRUE )
+    {
+      ulRunning = ( pChannel->ulPos + RAMP_UNIT / 2 ) / RAMP_UNIT;
+      if ( ( ulWanted != ulRunning ) &&
+           ( ulWanted != paulSent[ ulIndex ] ) )
+      {
+        // -- Someone else wants a new value, the ramp
+        //    takes it as its target --
+        pChannel->ulTarget = ulWanted * RAMP_UNIT;
+        pChannel->ulStep = RampSlewStep( pChannel );
+        paulDac[ ulIndex ] = ulRunning;
+      }
+      continue;
+    }
+
+    // -- A rounded ramp step may be one count longer --
+    ulMaxJump = ( RampSlewStep( pChannel ) + RAMP_UNIT - 1 ) /
+                RAMP_UNIT;
+    if ( ( ulWanted > paulSent[ ulIndex ] + ulMaxJump ) ||
+         ( ulWanted + ulMaxJump < paulSent[ ulIndex ] ) )
+    {
+      pChannel->ulPos = paulSent[ ulIndex ] * RAMP_UNIT;
+      pChannel->ulTarget = ulWanted * RAMP_UNIT;
+      pChannel->ulStep = RampSlewStep( pChannel );
+      pChannel->blRun = TRUE;
+      paulDac[ ulIndex ] = paulSent[ ulIndex ];
+      blStart = TRUE;
+    }
+  }
+
+  DosReleaseMutexSem( pRamp->hmtx );
+
+  return blStart;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Demands the Output Thread for the ramps.
+*
+* \return   RET_OKAY or ERROR_FROM_CALL
+*/
+ULONG RampDemand( ULONG ulSlot )
+{
+  return OutputDemand( ulSlot, OUTPUT_CLIENT_RAMP, TRUE );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------37-
+//
+// Export Index 37
+/**
+* \brief 'K8055_SetDacSlew()' sets the slew rate limit of
+* one DAC. See 'func.h' for details.
+*/
+ULONG K8055_SetDacSlew( ULONG *pulFileDesc,
+                        ULONG *pulChannel,
+                        ULONG *pulCountsPerSec )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  RAMPBOARD *pRamp;
+  RAMPCHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulCountsPerSec ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannel < 1 ) || ( *pulChannel > RAMP_CHANNELS ) ||
+       ( *pulCountsPerSec > RAMP_SLEW_MAX ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pRamp = &aRamp[ ulSlot ];
+  pChannel = &pRamp->aChannel[ *pulChannel - 1 ];
+
+  DosRequestMutexSem( pRamp->hmtx, SEM_INDEFINITE_WAIT );
+  pChannel->ulSlew = *pulCountsPerSec;
+
+  // -- A running ramp obeys the new limit at once --
+  if ( ( pChannel->blRun == TRUE ) &&
+       ( pChannel->ulStep > RampSlewStep( pChannel ) ) )
+  {
+    pChannel->ulStep = RampSlewStep( pChannel );
+  }
+  DosReleaseMutexSem( pRamp->hmtx );
+
+  return ulRc;
+}
+//---------37-
+
+
+//----------------------------------------------------------38-
+//
+// Export Index 38
+/**
+* \brief 'K8055_RampDac()' ramps one DAC to a target value.
+* See 'func.h' for details.
+*/
+ULONG K8055_RampDac( ULONG *pulFileDesc,
+                     ULONG *pulChannel,
+                     ULONG *pulTarget,
+                     ULONG *pulTimeMs    )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulSlots;
+  ULONG ulDistance;
+  ULONG ulSent[ RAMP_CHANNELS ];
+  ULONG ulDigitalOut;
+  RAMPBOARD *pRamp;
+  RAMPCHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulTarget ) ||
+       ( NULL == pulTimeMs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannel < 1 ) || ( *pulChannel > RAMP_CHANNELS ) ||
+       ( *pulTarget > 255 ) ||
+       ( *pulTimeMs > RAMP_TIME_MAX_MS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pRamp = &aRamp[ ulSlot ];
+  pChannel = &pRamp->aChannel[ *pulChannel - 1 ];
+
+  BoardLockXfer( ulSlot );
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &ulSent[0], &ulSent[1] );
+  BoardUnlockXfer( ulSlot );
+
+  DosRequestMutexSem( pRamp->hmtx, SEM_INDEFINITE_WAIT );
+
+  // -- A running ramp goes on from where it is --
+  if ( pChannel->blRun == FALSE )
+  {
+    pChannel->ulPos = ulSent[ *pulChannel - 1 ] * RAMP_UNIT;
+  }
+  pChannel->ulTarget = *pulTarget * RAMP_UNIT;
+
+  if ( pChannel->ulPos > pChannel->ulTarget )
+  {
+    ulDistance = pChannel->ulPos - pChannel->ulTarget;
+  }
+  else
+  {
+    ulDistance = pChannel->ulTarget - pChannel->ulPos;
+  }
+
+  ulSlots = ( *pulTimeMs + OUTPUT_SLOT_MS - 1 ) / OUTPUT_SLOT_MS;
+  if ( ulSlots == 0 )
+  {
+    ulSlots = 1;
+  }
+  pChannel->ulStep = ( ulDistance + ulSlots - 1 ) / ulSlots;
+  if ( pChannel->ulStep > RampSlewStep( pChannel ) )
+  {
+    pChannel->ulStep = RampSlewStep( pChannel );
+  }
+  if ( pChannel->ulStep == 0 )
+  {
+    pChannel->ulStep = 1;
+  }
+  pChannel->blRun = TRUE;
+
+  DosReleaseMutexSem( pRamp->hmtx );
+
+  ulRc = ulRc | OutputDemand( ulSlot, OUTPUT_CLIENT_RAMP, TRUE );
+
+  return ulRc;
+}
+//---------38-
+
+
+//----------------------------------------------------------39-
+//
+// Export Index 39
+/**
+* \brief 'K8055_GetDacRamp()' tells where the ramp of one
+* DAC is. See 'func.h' for details.
+*/
+ULONG K8055_GetDacRamp( ULONG *pulFileDesc,
+                        ULONG *pulChannel,
+                        ULONG *pulValue,
+                        ULONG *pulTarget,
+                        ULONG *pulBusy      )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulSent[ RAMP_CHANNELS ];
+  ULONG ulDigitalOut;
+  RAMPBOARD *pRamp;
+  RAMPCHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulValue ) ||
+       ( NULL == pulTarget ) ||
+       ( NULL == pulBusy ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannel < 1 ) || ( *pulChannel > RAMP_CHANNELS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pRamp = &aRamp[ ulSlot ];
+  pChannel = &pRamp->aChannel[ *pulChannel - 1 ];
+
+  BoardLockXfer( ulSlot );
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &ulSent[0], &ulSent[1] );
+  BoardUnlockXfer( ulSlot );
+
+  DosRequestMutexSem( pRamp->hmtx, SEM_INDEFINITE_WAIT );
+  *pulValue = ulSent[ *pulChannel - 1 ];
+  *pulTarget = ulSent[ *pulChannel - 1 ];
+  *pulBusy = FALSE;
+  if ( pChannel->blRun == TRUE )
+  {
+    *pulTarget = pChannel->ulTarget / RAMP_UNIT;
+    *pulBusy = TRUE;
+  }
+  DosReleaseMutexSem( pRamp->hmtx );
+
+  return ulRc;
+}
+//---------39-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= ramp.c === END ===
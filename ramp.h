@@ -0,0 +1,72 @@
+/**
+ * \file 'ramp.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'ramp.h' is the headerfile belonging to 'ramp.c'.
+ * It provides the constants of the DAC ramps and slew rate
+ * limits. Include 'output.h' first.
+ *
+ * \version 1.0.2 -
+ * 2026-10-19 'RampLimitFrame()'
+ * \version 1.0.1 -
+ * 2026-10-19 the value sent last keeps a running ramp
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_RAMP_
+#define __K8055DD_H_RAMP_
+
+
+//-- Values belonging to the DAC ramps ---------- BEGIN --!
+//
+/**
+* \brief Number of DACs, 1 = DAC1, 2 = DAC2
+*/
+#define RAMP_CHANNELS 2
+
+/**
+* \brief Slew rate limit in DAC counts per second. 0 means
+* no limit. 25500 is a full jump in one Output Slot of 10 ms.
+*/
+#define RAMP_SLEW_OFF 0
+#define RAMP_SLEW_MAX 25500
+
+/**
+* \brief Longest ramp time of 'K8055_RampDac()', 10 min
+*/
+#define RAMP_TIME_MAX_MS 600000
+//
+//-- Values belonging to the DAC ramps ------------ END --!
+
+
+//--- Used by board.c, func.c and output.c -------------------
+//
+VOID  RampAttach( ULONG ulSlot );
+VOID  RampSlot( ULONG ulSlot, ULONG ulTick, OUTPUTREQ *pReq );
+BOOL  RampIdle( ULONG ulSlot );
+
+//    Called by 'K8055_SetAllOutputs()' with 'BoardLockXfer()'
+//    owned, before the frame is written. DAC values that
+//    would break a slew rate limit are replaced by the
+//    current value and reached by a ramp instead. The
+//    value sent last does not stop a running ramp.
+//    Returns TRUE, if a ramp was started. The caller must
+//    then call 'RampDemand()' after releasing its locks.
+//
+BOOL  RampFilterFrame( ULONG ulSlot, BYTE *pbyData );
+ULONG RampDemand( ULONG ulSlot );
+
+//    Called by 'BoardWriteFrame()' with 'BoardLockXfer()'
+//    owned. Same limit for the frames of the subsystems,
+//    but without a limit a ramp is left alone. Returns
+//    TRUE, if a ramp was started. 'BoardWriteFrame()' then
+//    calls 'OutputKickRamp()' after releasing its lock.
+//
+BOOL  RampLimitFrame( ULONG ulSlot, ULONG *paulSent,
+                      ULONG *paulDac );
+
+#endif
+
+
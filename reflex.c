@@ -0,0 +1,439 @@
+//====================================== reflex.c === BEGIN ===
+/**
+ * \file  'reflex.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Reflex Rules: "if I1 goes high or A2 > 200 then
+ * clear O4 and set DAC1 = 0".
+ *
+ * The rules of a K8055 are evaluated right after every EP81
+ * report ('ReflexEvaluate()' is called by 'BoardReportIn()'
+ * before any other subsystem). If a rule fires, the new
+ * output frame is written via EP01 at once. There is no
+ * round trip through the application, so with the
+ * Acquisition Thread running the reaction time is one
+ * report period (10 ms).
+ *
+ * The rule table can be replaced while the rules are being
+ * evaluated. Every board has got two tables. The new rules
+ * are copied into the one not in use and then published by
+ * an interlocked exchange of the table index (see
+ * 'atomic.h'). Replacing the rules never blocks the thread
+ * that evaluates them.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 no stores into 'byaPutData[]'
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "atomic.h"
+#include "reflex.h"
+
+
+/**
+* \brief One set of rules
+*/
+typedef struct _REFLEXTABLE
+{
+  ULONG      ulCount;
+  REFLEXRULE aRule[ REFLEX_RULES_MAX ];
+} REFLEXTABLE;
+
+/**
+* \brief Reflex data of one K8055
+*/
+typedef struct _REFLEXBOARD
+{
+  HMTX          hmtx;     // Serialises 'K8055_SetReflexRules()'
+  REFLEXTABLE   aTable[ 2 ];
+  volatile LONG lActive;  // Table used by 'ReflexEvaluate()'
+  volatile LONG lInUse;   // Table being read + 1, 0 if none
+  volatile LONG alFired[ REFLEX_RULES_MAX ];
+  ULONG         ulLastIx; // Decoded inputs of last report
+  BOOL          blFirst;  // No report seen yet
+} REFLEXBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Reflex data, indexed by Board Slot --------------------//
+//
+REFLEXBOARD aReflex[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. The board starts
+*           without rules.
+*/
+VOID ReflexAttach( ULONG ulSlot )
+{
+  ULONG ulIndex;
+  REFLEXBOARD *pReflex;
+
+  pReflex = &aReflex[ ulSlot ];
+
+  pReflex->aTable[ 0 ].ulCount = 0;
+  pReflex->aTable[ 1 ].ulCount = 0;
+  pReflex->lActive = 0;
+  pReflex->lInUse = 0;
+  for ( ulIndex = 0; ulIndex < REFLEX_RULES_MAX; ulIndex++ )
+  {
+    pReflex->alFired[ ulIndex ] = 0;
+  }
+  pReflex->ulLastIx = 0;
+  pReflex->blFirst = TRUE;
+
+  if ( pReflex->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pReflex->hmtx, 0, FALSE );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Checks one condition against a report.
+*
+* \param    'ulInputs', 'ulLastInputs'
+*           - Decoded digital inputs of this and of the
+*           previous report.
+*/
+static BOOL ReflexCondition( ULONG ulCondition,
+                             ULONG ulParam,
+                             ULONG ulInputs,
+                             ULONG ulLastInputs,
+                             BYTE *pbyData       )
+{
+  switch ( ulCondition )
+  {
+    case REFLEX_COND_INPUT_HIGH:
+      return ( ( ulInputs & ulParam ) != 0 );
+
+    case REFLEX_COND_INPUT_LOW:
+      return ( ( ~ulInputs & ulParam ) != 0 );
+
+    case REFLEX_COND_INPUT_RISE:
+      return ( ( ulInputs & ~ulLastInputs & ulParam ) != 0 );
+
+    case REFLEX_COND_INPUT_FALL:
+      return ( ( ~ulInputs & ulLastInputs & ulParam ) != 0 );
+
+    case REFLEX_COND_A1_ABOVE:
+      return ( pbyData[2] > ulParam );
+
+    case REFLEX_COND_A1_BELOW:
+      return ( pbyData[2] < ulParam );
+
+    case REFLEX_COND_A2_ABOVE:
+      return ( pbyData[3] > ulParam );
+
+    case REFLEX_COND_A2_BELOW:
+      return ( pbyData[3] < ulParam );
+
+    default:
+      return FALSE;
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardReportIn()' for every report of a
+*           board, one report at a time. All rules are checked
+*           in table order, the actions of all rules that
+*           fire are applied one after the other. EP01 is
+*           only written if the outputs really change.
+*
+*           A following 'K8055_SetAllOutputs()' of the
+*           application does not undo the reaction, see
+*           'BoardLegacyMerge()'.
+*
+* \param    'pbyData'
+*           - The 8 data bytes of the report.
+*/
+VOID ReflexEvaluate( ULONG ulSlot,
+                     BYTE *pbyData,
+                     K8055TIME tmReport )
+{
+  LONG  lTable;
+  ULONG ulIndex;
+  ULONG ulInputs;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  ULONG ulNewOut;
+  ULONG ulNewDAC1;
+  ULONG ulNewDAC2;
+  BOOL  blCond1;
+  BOOL  blCond2;
+  BOOL  blFire;
+  REFLEXBOARD *pReflex;
+  REFLEXTABLE *pTable;
+  REFLEXRULE *pRule;
+
+  pReflex = &aReflex[ ulSlot ];
+
+  ulInputs = BoardDecodeIx( pbyData[0] );
+  if ( pReflex->blFirst == TRUE )
+  {
+    pReflex->ulLastIx = ulInputs;
+    pReflex->blFirst = FALSE;
+  }
+
+  // -- Announce the table to be read, then make sure it
+  //    was not replaced in the meantime --
+  do
+  {
+    lTable = pReflex->lActive;
+    AtomicExchange( &pReflex->lInUse, lTable + 1 );
+  } while ( pReflex->lActive != lTable );
+
+  pTable = &pReflex->aTable[ lTable ];
+  if ( pTable->ulCount == 0 )
+  {
+    AtomicExchange( &pReflex->lInUse, 0 );
+    pReflex->ulLastIx = ulInputs;
+    return;
+  }
+
+  BoardLockXfer( ulSlot );
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+  ulNewOut = ulDigitalOut;
+  ulNewDAC1 = ulDAC1;
+  ulNewDAC2 = ulDAC2;
+
+  for ( ulIndex = 0; ulIndex < pTable->ulCount; ulIndex++ )
+  {
+    pRule = &pTable->aRule[ ulIndex ];
+
+    blCond1 = ReflexCondition( pRule->ulCondition1,
+                               pRule->ulParam1,
+                               ulInputs,
+                               pReflex->ulLastIx,
+                               pbyData            );
+    blCond2 = ReflexCondition( pRule->ulCondition2,
+                               pRule->ulParam2,
+                               ulInputs,
+                               pReflex->ulLastIx,
+                               pbyData            );
+    if ( pRule->ulCombine == REFLEX_ALL )
+    {
+      blFire = blCond1 && blCond2;
+    }
+    else
+    {
+      blFire = blCond1 || blCond2;
+    }
+    if ( blFire == FALSE )
+    {
+      continue;
+    }
+
+    AtomicExchangeAdd( &pReflex->alFired[ ulIndex ], 1 );
+    ulNewOut = ( ulNewOut & ~pRule->ulDoClear ) | pRule->ulDoSet;
+    if ( pRule->ulDac1 != REFLEX_DAC_KEEP )
+    {
+      ulNewDAC1 = pRule->ulDac1;
+    }
+    if ( pRule->ulDac2 != REFLEX_DAC_KEEP )
+    {
+      ulNewDAC2 = pRule->ulDac2;
+    }
+  }
+
+  AtomicExchange( &pReflex->lInUse, 0 );
+  pReflex->ulLastIx = ulInputs;
+
+  if ( ( ulNewOut != ulDigitalOut ) ||
+       ( ulNewDAC1 != ulDAC1 ) ||
+       ( ulNewDAC2 != ulDAC2 ) )
+  {
+    BoardWriteFrame( ulSlot, ulNewOut, ulNewDAC1, ulNewDAC2 );
+  }
+  BoardUnlockXfer( ulSlot );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Checks the values of one rule.
+*/
+static BOOL ReflexRuleValid( REFLEXRULE *pRule )
+{
+  if ( ( pRule->ulCombine > REFLEX_ALL ) ||
+       ( pRule->ulCondition1 > REFLEX_COND_LAST ) ||
+       ( pRule->ulCondition2 > REFLEX_COND_LAST ) ||
+       ( pRule->ulParam1 > 255 ) ||
+       ( pRule->ulParam2 > 255 ) ||
+       ( pRule->ulDoClear > 255 ) ||
+       ( pRule->ulDoSet > 255 ) ||
+       ( ( pRule->ulDac1 > 255 ) &&
+         ( pRule->ulDac1 != REFLEX_DAC_KEEP ) ) ||
+       ( ( pRule->ulDac2 > 255 ) &&
+         ( pRule->ulDac2 != REFLEX_DAC_KEEP ) ) )
+  {
+    return FALSE;
+  }
+  return TRUE;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------22-
+//
+// Export Index 22
+/**
+* \brief 'K8055_SetReflexRules()' replaces all rules of a
+* K8055 at once. See 'func.h' for details.
+*/
+ULONG K8055_SetReflexRules( ULONG *pulFileDesc,
+                            ULONG *pulCount,
+                            struct _REFLEXRULE *paRules )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulIndex;
+  LONG  lOld;
+  LONG  lNew;
+  REFLEXBOARD *pReflex;
+  REFLEXTABLE *pTable;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulCount ) ||
+       ( ( NULL == paRules ) && ( *pulCount != 0 ) ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( *pulCount > REFLEX_RULES_MAX )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+  for ( ulIndex = 0; ulIndex < *pulCount; ulIndex++ )
+  {
+    if ( ReflexRuleValid( &paRules[ ulIndex ] ) == FALSE )
+    {
+      ulRc = ulRc | ERROR_RANGE;
+      return ulRc;
+    }
+  }
+
+  pReflex = &aReflex[ ulSlot ];
+
+  DosRequestMutexSem( pReflex->hmtx, SEM_INDEFINITE_WAIT );
+
+  lOld = pReflex->lActive;
+  lNew = 1 - lOld;
+
+  // -- A report thread that saw 'lNew' before the last
+  //    switch is leaving it right now --
+  while ( pReflex->lInUse == lNew + 1 )
+  {
+    DosSleep( 0 );
+  }
+
+  pTable = &pReflex->aTable[ lNew ];
+  pTable->ulCount = *pulCount;
+  if ( *pulCount != 0 )
+  {
+    memcpy( &pTable->aRule[0], paRules,
+            *pulCount * sizeof( REFLEXRULE ) );
+  }
+  for ( ulIndex = 0; ulIndex < REFLEX_RULES_MAX; ulIndex++ )
+  {
+    AtomicExchange( &pReflex->alFired[ ulIndex ], 0 );
+  }
+
+  // -- Publish, the next report uses the new rules --
+  AtomicExchange( &pReflex->lActive, lNew );
+
+  DosReleaseMutexSem( pReflex->hmtx );
+
+  return ulRc;
+}
+//---------22-
+
+
+//----------------------------------------------------------23-
+//
+// Export Index 23
+/**
+* \brief 'K8055_GetReflexCount()' tells how often one rule
+* has fired. See 'func.h' for details.
+*/
+ULONG K8055_GetReflexCount( ULONG *pulFileDesc,
+                            ULONG *pulRule,
+                            ULONG *pulFired     )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulRule ) ||
+       ( NULL == pulFired ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulRule < 1 ) || ( *pulRule > REFLEX_RULES_MAX ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  *pulFired = (ULONG)aReflex[ ulSlot ].alFired[ *pulRule - 1 ];
+
+  return ulRc;
+}
+//---------23-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================= reflex.c === END ===
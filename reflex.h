@@ -0,0 +1,94 @@
+/**
+ * \file 'reflex.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'reflex.h' is the headerfile belonging to
+ * 'reflex.c'. It provides the layout of a Reflex Rule and
+ * its constants.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_REFLEX_
+#define __K8055DD_H_REFLEX_
+
+
+//-- Values belonging to the reflex rules ------- BEGIN --!
+//
+/**
+* \brief Maximum number of rules per K8055
+*/
+#define REFLEX_RULES_MAX 8
+
+/**
+* \brief Conditions. The meaning of 'ulParam' is given
+* in brackets. Digital inputs are given as decoded mask
+* (I1: 0x01, I2: 0x02, I3: 0x04, I4: 0x08, I5: 0x10),
+* see 'K8055_DecodeDigitalInputs()'.
+*/
+#define REFLEX_COND_NONE        0   // Never true
+#define REFLEX_COND_INPUT_HIGH  1   // Any masked input set
+#define REFLEX_COND_INPUT_LOW   2   // Any masked input clear
+#define REFLEX_COND_INPUT_RISE  3   // Any masked input was set
+                                    // since the last report
+#define REFLEX_COND_INPUT_FALL  4   // .. was cleared
+#define REFLEX_COND_A1_ABOVE    5   // A1 >  ulParam (0..255)
+#define REFLEX_COND_A1_BELOW    6   // A1 <  ulParam
+#define REFLEX_COND_A2_ABOVE    7   // A2 >  ulParam
+#define REFLEX_COND_A2_BELOW    8   // A2 <  ulParam
+#define REFLEX_COND_LAST        8
+
+/**
+* \brief How the two conditions of a rule are combined
+*/
+#define REFLEX_ANY  0               // Condition 1 OR  2
+#define REFLEX_ALL  1               // Condition 1 AND 2
+
+/**
+* \brief DAC value of an action that leaves a DAC untouched
+*/
+#define REFLEX_DAC_KEEP 0xFFFFFFFF
+//
+//-- Values belonging to the reflex rules --------- END --!
+
+
+/**
+* \brief One Reflex Rule. If the conditions are met, the
+* digital outputs are changed to ( DO & ~ulDoClear ) |
+* ulDoSet and the DACs are set, unless REFLEX_DAC_KEEP.
+*
+* Example: "if I1 goes high or A2 > 200 then clear O4 and
+* set DAC1 = 0"
+*
+*   { REFLEX_ANY,
+*     REFLEX_COND_INPUT_RISE, 0x01,
+*     REFLEX_COND_A2_ABOVE,   200,
+*     0x08, 0x00,
+*     0, REFLEX_DAC_KEEP }
+*/
+typedef struct _REFLEXRULE
+{
+  ULONG ulCombine;       // REFLEX_ANY or REFLEX_ALL
+  ULONG ulCondition1;    // REFLEX_COND_...
+  ULONG ulParam1;
+  ULONG ulCondition2;    // REFLEX_COND_NONE if unused
+  ULONG ulParam2;
+  ULONG ulDoClear;       // DO bits to clear (0..255)
+  ULONG ulDoSet;         // DO bits to set   (0..255)
+  ULONG ulDac1;          // 0..255 or REFLEX_DAC_KEEP
+  ULONG ulDac2;          // 0..255 or REFLEX_DAC_KEEP
+} REFLEXRULE;
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID ReflexAttach( ULONG ulSlot );
+VOID ReflexEvaluate( ULONG ulSlot,
+                     BYTE *pbyData,
+                     K8055TIME tmReport );
+
+#endif
+
+
@@ -0,0 +1,308 @@
+//======================================= retry.c === BEGIN ===
+/**
+ * \file  'retry.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Retries of failed EP81 reads.
+ *
+ * A report without a new Toggle Bit or with a short byte
+ * count is mostly a hiccup of the USB stack, the next
+ * transfer works. Up to now every application repeated
+ * 'K8055_ReadAllInputs()' with a sleep of its own, at least
+ * one timer tick of 32 ms later.
+ *
+ * With a retry policy the library transfers again after a
+ * pause of some microseconds. During the pause the transfer
+ * lock of the board and the shared lock are released, also
+ * if the caller holds them more than once, so other threads
+ * and boards are not held up by a retry. The policy tells
+ * how many transfers a read may take, how long the first
+ * pause is and which error bits are worth a retry. It is
+ * used by 'K8055_ReadAllInputs()' and by every thread of the
+ * library that reads reports ( 'BoardReadReport()' ). A
+ * histogram per board counts how many retries the reads
+ * took.
+ *
+ * All data of a board is guarded by its transfer lock.
+ *
+ * \version 1.0.4 -
+ * 2026-10-19 every hold of the locks is released during the
+ * pause
+ * \version 1.0.3 -
+ * 2026-10-19 the locks of the caller are released during
+ * the pause
+ * \version 1.0.2 -
+ * 2026-10-18 the pause before a retry is a span of the span
+ * recorder
+ * \version 1.0.1 -
+ * 2026-10-18 probe point for every retry
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "retry.h"
+#include "probe.h"
+#include "span.h"
+
+
+/**
+* \brief Retry policy and statistics of one K8055
+*/
+typedef struct _RETRYBOARD
+{
+  // -- Policy
+  ULONG      ulAttempts;
+  ULONG      ulBackoffUs;
+  ULONG      ulRetryOn;
+
+  // -- Read in progress
+  K8055TIME  tmFirst;
+
+  RETRYSTATS Stats;
+} RETRYBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Retry data, indexed by Board Slot ---------------------//
+//
+RETRYBOARD aRetry[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. No retries, no
+*           statistics.
+*/
+VOID RetryAttach( ULONG ulSlot )
+{
+  RETRYBOARD *pRetry;
+
+  pRetry = &aRetry[ ulSlot ];
+
+  pRetry->ulAttempts = 1;
+  pRetry->ulBackoffUs = 0;
+  pRetry->ulRetryOn = ERROR_TOGGLE_BIT | ERROR_BYTE_NUMBER;
+  pRetry->tmFirst = 0;
+  memset( &pRetry->Stats, 0, sizeof( RETRYSTATS ) );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Decides after every EP81 transfer whether to
+*           transfer again, see 'retry.h'.
+*/
+BOOL RetryAgain( ULONG ulSlot, ULONG ulAttempts, ULONG ulRc,
+                 BOOL blShared )
+{
+  ULONG ulShift;
+  ULONG ulPauseUs;
+  ULONG ulHoldsXfer;
+  ULONG ulHoldsShared;
+  K8055TIME tmWait;
+  K8055TIME tmSpan;
+  RETRYBOARD *pRetry;
+
+  if ( ulSlot >= K8055_MAX_BOARDS )
+  {
+    return FALSE;
+  }
+  pRetry = &aRetry[ ulSlot ];
+
+  if ( ( ulAttempts == 1 ) && ( ulRc != RET_OKAY ) )
+  {
+    pRetry->tmFirst = TimeNowUs();
+  }
+
+  // -- Another transfer? --
+  if ( ( ulRc != RET_OKAY ) &&
+       ( ( ulRc & ~pRetry->ulRetryOn ) == 0 ) &&
+       ( ulAttempts < pRetry->ulAttempts ) )
+  {
+    if ( ( ulRc & ERROR_TOGGLE_BIT ) != 0 )
+    {
+      ++pRetry->Stats.ulRetriesToggle;
+    }
+    if ( ( ulRc & ERROR_BYTE_NUMBER ) != 0 )
+    {
+      ++pRetry->Stats.ulRetriesBytes;
+    }
+    if ( ( ulRc & ERROR_FROM_CALL ) != 0 )
+    {
+      ++pRetry->Stats.ulRetriesCall;
+    }
+
+    ulShift = ulAttempts - 1;
+    ulPauseUs = pRetry->ulBackoffUs << ulShift;
+    if ( ulPauseUs > RETRY_BACKOFF_MAX_US )
+    {
+      ulPauseUs = RETRY_BACKOFF_MAX_US;
+    }
+    PROBE( PROBE_RETRY, BoardHandle( ulSlot ), ulAttempts, ulPauseUs );
+    if ( ulPauseUs != 0 )
+    {
+      // -- Nobody waits for the locks during the pause, they
+      //    are taken again in the order of 'board.h', as often
+      //    as the caller held them --
+      ulHoldsShared = 0;
+      ulHoldsXfer = BoardUnlockXferAll( ulSlot );
+      if ( blShared == TRUE )
+      {
+        ulHoldsShared = SharedUnlockAll();
+      }
+      tmSpan = SpanStart();
+      TimeWaitUntilUs( TimeNowUs() + ulPauseUs );
+      SpanEnd( ulSlot, SPAN_RETRY_WAIT, ulAttempts, tmSpan );
+      SharedRelock( ulHoldsShared );
+      BoardRelockXfer( ulSlot, ulHoldsXfer );
+    }
+    return TRUE;
+  }
+
+  // -- The read is over --
+  if ( ulRc == RET_OKAY )
+  {
+    ++pRetry->Stats.aulHistogram[ ulAttempts - 1 ];
+  }
+  else
+  {
+    ++pRetry->Stats.aulHistogram[ RETRY_ATTEMPTS_MAX ];
+  }
+  if ( ulAttempts > 1 )
+  {
+    tmWait = TimeNowUs() - pRetry->tmFirst;
+    if ( tmWait > pRetry->Stats.ulWaitMaxUs )
+    {
+      pRetry->Stats.ulWaitMaxUs = (ULONG)tmWait;
+    }
+  }
+
+  return FALSE;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------58-
+//
+// Export Index 58
+/**
+* \brief 'K8055_SetRetryPolicy()' sets how failed EP81 reads
+* of a K8055 are retried. See 'func.h' for details.
+*/
+ULONG K8055_SetRetryPolicy( ULONG *pulFileDesc,
+                            ULONG *pulAttempts,
+                            ULONG *pulBackoffUs,
+                            ULONG *pulRetryOn    )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  RETRYBOARD *pRetry;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulAttempts ) ||
+       ( NULL == pulBackoffUs ) ||
+       ( NULL == pulRetryOn ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulAttempts < 1 ) ||
+       ( *pulAttempts > RETRY_ATTEMPTS_MAX ) ||
+       ( *pulBackoffUs > RETRY_BACKOFF_MAX_US ) ||
+       ( ( *pulRetryOn & ~RETRY_ON_ALLOWED ) != 0 ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pRetry = &aRetry[ ulSlot ];
+  BoardLockXfer( ulSlot );
+  pRetry->ulAttempts = *pulAttempts;
+  pRetry->ulBackoffUs = *pulBackoffUs;
+  pRetry->ulRetryOn = *pulRetryOn;
+  BoardUnlockXfer( ulSlot );
+
+  return ulRc;
+}
+//---------58-
+
+
+//----------------------------------------------------------59-
+//
+// Export Index 59
+/**
+* \brief 'K8055_GetRetryStats()' copies the retry statistics
+* of a K8055. See 'func.h' for details.
+*/
+ULONG K8055_GetRetryStats( ULONG *pulFileDesc,
+                           struct _RETRYSTATS *pStats,
+                           ULONG *pulReset             )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  RETRYBOARD *pRetry;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pStats ) ||
+       ( NULL == pulReset ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pRetry = &aRetry[ ulSlot ];
+  BoardLockXfer( ulSlot );
+  memcpy( pStats, &pRetry->Stats, sizeof( RETRYSTATS ) );
+  if ( *pulReset != 0 )
+  {
+    memset( &pRetry->Stats, 0, sizeof( RETRYSTATS ) );
+  }
+  BoardUnlockXfer( ulSlot );
+
+  return ulRc;
+}
+//---------59-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== retry.c === END ===
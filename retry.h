@@ -0,0 +1,86 @@
+/**
+ * \file 'retry.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'retry.h' is the headerfile belonging to 'retry.c',
+ * the retries of failed EP81 reads inside the library.
+ *
+ * \version 1.0.2 -
+ * 2026-10-19 'RetryAgain()' releases every hold of the locks
+ * \version 1.0.1 -
+ * 2026-10-19 'RetryAgain()' releases the locks of the caller
+ * during the pause
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_RETRY_
+#define __K8055DD_H_RETRY_
+
+
+//-- Values belonging to the retry policy ------- BEGIN --!
+//
+/**
+* \brief Most transfers per read a policy may allow, the first
+* one included. The policy of 'RetryAttach()' allows 1, that
+* is no retry.
+*/
+#define RETRY_ATTEMPTS_MAX 8
+
+/**
+* \brief Pause before the first retry, doubled for every
+* further one, never longer than the maximum.
+*/
+#define RETRY_BACKOFF_MAX_US 100000
+
+/**
+* \brief Error bits a policy may make a retry for. The
+* policy of 'RetryAttach()' retries ERROR_TOGGLE_BIT and
+* ERROR_BYTE_NUMBER.
+*/
+#define RETRY_ON_ALLOWED ( ERROR_TOGGLE_BIT | \
+                           ERROR_BYTE_NUMBER | \
+                           ERROR_FROM_CALL )
+//
+//-- Values belonging to the retry policy --------- END --!
+
+
+/**
+* \brief Retry statistics of one K8055, see
+* 'K8055_GetRetryStats()'
+*/
+typedef struct _RETRYSTATS
+{
+  // -- [n]: reads valid after n retries. [RETRY_ATTEMPTS_MAX]:
+  //    reads that failed after all attempts.
+  ULONG aulHistogram[ RETRY_ATTEMPTS_MAX + 1 ];
+  ULONG ulRetriesToggle;   // Retries for ERROR_TOGGLE_BIT
+  ULONG ulRetriesBytes;    // Retries for ERROR_BYTE_NUMBER
+  ULONG ulRetriesCall;     // Retries for ERROR_FROM_CALL
+  ULONG ulWaitMaxUs;       // Longest time spent in retries
+} RETRYSTATS;
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID RetryAttach( ULONG ulSlot );
+
+//--- Used by every EP81 read ---------------------------------
+//    Called with 'BoardLockXfer()' owned, after every
+//    transfer. 'ulAttempts' transfers are done, the last one
+//    returned 'ulRc'. TRUE: the pause is over, the caller
+//    transfers again. FALSE: the read is over, the statistics
+//    are updated.
+//    'blShared' TRUE: the caller owns 'SharedLock()' too.
+//    Both locks are released during the pause, every hold
+//    of them, and owned again as often when the call
+//    returns. A caller must not rely on holding them across
+//    a read.
+//
+BOOL  RetryAgain( ULONG ulSlot, ULONG ulAttempts, ULONG ulRc,
+                  BOOL blShared );
+
+#endif
+
+
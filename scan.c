@@ -0,0 +1,606 @@
+//======================================== scan.c === BEGIN ===
+/**
+ * \file  'scan.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Scan Engines: the fixed scan cycle of a PLC.
+ *
+ * A Scan Engine owns one thread and a set of up to four
+ * K8055. Every cycle it
+ *  - reads one EP81 report of every board of the set,
+ *  - calls the logic of the application with the Process
+ *    Images of all boards,
+ *  - writes the outputs of every board via EP01, if the
+ *    logic changed them.
+ * All reads are done at the start of the cycle, all writes
+ * at the end, so the logic works on one consistent image.
+ *
+ * Cycles start on absolute deadlines (start time + n times
+ * the cycle time), so errors do not add up. A cycle that
+ * ends after the start of the next one is counted as
+ * overrun, the missed cycles are skipped. The lateness of
+ * every cycle start is recorded as jitter.
+ *
+ * Reports read by the engine are handed over to
+ * 'BoardReportIn()', so alarms and reflex rules keep
+ * working.
+ *
+ * \version 1.0.3 -
+ * 2026-10-19 waits for the cycle with 'TimeWaitSlotUs()'
+ * \version 1.0.2 -
+ * 2026-10-19 only one caller stops an engine, others wait
+ * for the end of its thread
+ * \version 1.0.1 -
+ * 2026-10-18 the logic is a span of the span recorder
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "scan.h"
+#include "span.h"
+
+
+/**
+* \brief One Scan Engine
+*/
+typedef struct _SCANENGINE
+{
+  volatile BOOL blInUse;
+  BOOL          blStopping;      // 'ScanStop()' is running
+  volatile BOOL blRun;
+  TID           tid;
+  HEV           hevStop;
+  HMTX          hmtxStats;       // Guards the statistics
+  ULONG         ulBoards;
+  ULONG         aulSlot[ K8055_MAX_BOARDS ];
+  SCANIMAGE     aImage[ K8055_MAX_BOARDS ];
+  ULONG         ulCycleUs;
+  PFNK8055SCAN  pfnLogic;
+  VOID         *pvUser;
+
+  // -- Statistics
+  ULONG         ulCycles;
+  ULONG         ulOverruns;
+  ULONG         ulReadErrors;
+  ULONG         ulJitterMaxUs;
+  K8055TIME     tmJitterSumUs;
+  ULONG         ulScanMaxUs;
+} SCANENGINE;
+
+
+//-----------------------------------------------------------//
+//--- Scan Engines, 'K8055_StartScan()' returns index + 1 ---//
+//
+SCANENGINE aScan[ SCAN_ENGINES_MAX ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Reads the inputs of all boards of an engine and
+*           fills in their Process Images.
+*/
+static VOID ScanInputs( SCANENGINE *pScan )
+{
+  ULONG ulIndex;
+  ULONG ulSlot;
+  BYTE  byaData[ SIZEBUFFERMAX ];
+  K8055TIME tmReport;
+  SCANIMAGE *pImage;
+
+  for ( ulIndex = 0; ulIndex < pScan->ulBoards; ulIndex++ )
+  {
+    ulSlot = pScan->aulSlot[ ulIndex ];
+    pImage = &pScan->aImage[ ulIndex ];
+
+    pImage->ulRcRead = BoardReadReport( ulSlot, &byaData[0] );
+    tmReport = TimeNowUs();
+    if ( pImage->ulRcRead == RET_OKAY )
+    {
+      pImage->ulDigitalIn = BoardDecodeIx( byaData[0] );
+      pImage->ulA1 = byaData[2];
+      pImage->ulA2 = byaData[3];
+      pImage->ulCounter1 = byaData[4] + ( byaData[5] << 8 );
+      pImage->ulCounter2 = byaData[6] + ( byaData[7] << 8 );
+      BoardReportIn( ulSlot, &byaData[0], tmReport );
+    }
+    else
+    {
+      ++pScan->ulReadErrors;
+    }
+
+    // -- Reflex rules may have changed the outputs --
+    BoardGetOutputs( ulSlot,
+                     &pImage->ulDigitalOut,
+                     &pImage->ulDAC1,
+                     &pImage->ulDAC2        );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Writes the outputs of all boards of an engine,
+*           one EP01 frame per board that has changed.
+*/
+static VOID ScanOutputs( SCANENGINE *pScan )
+{
+  ULONG ulIndex;
+  ULONG ulSlot;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  SCANIMAGE *pImage;
+
+  for ( ulIndex = 0; ulIndex < pScan->ulBoards; ulIndex++ )
+  {
+    ulSlot = pScan->aulSlot[ ulIndex ];
+    pImage = &pScan->aImage[ ulIndex ];
+
+    BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+    if ( ( ( pImage->ulDigitalOut & 0xFF ) != ulDigitalOut ) ||
+         ( ( pImage->ulDAC1 & 0xFF ) != ulDAC1 ) ||
+         ( ( pImage->ulDAC2 & 0xFF ) != ulDAC2 ) )
+    {
+      BoardWriteFrame( ulSlot,
+                       pImage->ulDigitalOut & 0xFF,
+                       pImage->ulDAC1 & 0xFF,
+                       pImage->ulDAC2 & 0xFF        );
+    }
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of a Scan Engine thread.
+*
+* \param    'pvScan'
+*           - Index into 'aScan[]', passed as a pointer value.
+*/
+static VOID ScanThread( VOID *pvScan )
+{
+  ULONG ulRcLogic;
+  ULONG ulJitterUs;
+  ULONG ulScanUs;
+  K8055TIME tmDeadline;
+  K8055TIME tmStart;
+  K8055TIME tmEnd;
+  K8055TIME tmSpan;
+  SCANENGINE *pScan;
+
+  pScan = &aScan[ (ULONG)pvScan ];
+
+  DosSetPriority( PRTYS_THREAD, PRTYC_TIMECRITICAL, 0, 0 );
+
+  tmDeadline = TimeNowUs();
+  while ( pScan->blRun == TRUE )
+  {
+    // -- Wait for the start of the cycle --
+    if ( TimeWaitSlotUs( tmDeadline, pScan->hevStop ) == TRUE )
+    {
+      break;
+    }
+
+    tmStart = TimeNowUs();
+    ScanInputs( pScan );
+    tmSpan = SpanStart();
+    ulRcLogic = pScan->pfnLogic( pScan->ulBoards,
+                                 &pScan->aImage[0],
+                                 pScan->pvUser      );
+    SpanEnd( BOARD_NONE, SPAN_SCAN_LOGIC, ulRcLogic, tmSpan );
+    ScanOutputs( pScan );
+    tmEnd = TimeNowUs();
+
+    // -- Statistics --
+    ulJitterUs = (ULONG)( tmStart - tmDeadline );
+    ulScanUs = (ULONG)( tmEnd - tmStart );
+
+    DosRequestMutexSem( pScan->hmtxStats, SEM_INDEFINITE_WAIT );
+    ++pScan->ulCycles;
+    pScan->tmJitterSumUs = pScan->tmJitterSumUs + ulJitterUs;
+    if ( ulJitterUs > pScan->ulJitterMaxUs )
+    {
+      pScan->ulJitterMaxUs = ulJitterUs;
+    }
+    if ( ulScanUs > pScan->ulScanMaxUs )
+    {
+      pScan->ulScanMaxUs = ulScanUs;
+    }
+
+    // -- Next deadline, skip the cycles already missed --
+    tmDeadline = tmDeadline + pScan->ulCycleUs;
+    if ( tmEnd > tmDeadline )
+    {
+      ++pScan->ulOverruns;
+      while ( tmDeadline < tmEnd )
+      {
+        tmDeadline = tmDeadline + pScan->ulCycleUs;
+      }
+    }
+    DosReleaseMutexSem( pScan->hmtxStats );
+
+    if ( ulRcLogic != 0 )
+    {
+      pScan->blRun = FALSE;
+    }
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Stops the thread of an engine and frees it.
+*           Must not be called by the thread itself.
+*           'K8055_StopScan()' and 'K8055_Close()' may stop
+*           the same engine at the same time, only the first
+*           one stops it, the other one waits until it is
+*           free.
+*/
+static ULONG ScanStop( SCANENGINE *pScan )
+{
+  ULONG ulRc;
+  ULONG ulRcDOScall;
+  BOOL  blStopper;
+  TID   tidScan;
+
+  ulRc = RET_OKAY;
+
+  DosEnterCritSec();
+  blStopper = FALSE;
+  if ( ( pScan->blInUse == TRUE ) && ( pScan->blStopping == FALSE ) )
+  {
+    pScan->blStopping = TRUE;
+    blStopper = TRUE;
+  }
+  DosExitCritSec();
+
+  if ( blStopper == FALSE )
+  {
+    while ( ( pScan->blInUse == TRUE ) &&
+            ( pScan->blStopping == TRUE ) )
+    {
+      DosSleep( 1 );
+    }
+    return ulRc;
+  }
+
+  pScan->blRun = FALSE;
+  DosPostEventSem( pScan->hevStop );
+
+  // -- The thread may have ended already, if the logic
+  //    asked for it --
+  tidScan = pScan->tid;
+  ulRcDOScall = DosWaitThread( &tidScan, DCWW_WAIT );
+  if ( ( ulRcDOScall != NO_DOS_ERROR ) &&
+       ( ulRcDOScall != ERROR_INVALID_THREADID ) )
+  {
+    ulRc = ulRc | ERROR_FROM_CALL;
+  }
+
+  DosCloseEventSem( pScan->hevStop );
+  DosCloseMutexSem( pScan->hmtxStats );
+  pScan->hevStop = 0;
+  pScan->hmtxStats = 0;
+  pScan->tid = 0;
+  pScan->ulBoards = 0;
+
+  DosEnterCritSec();
+  pScan->blStopping = FALSE;
+  pScan->blInUse = FALSE;
+  DosExitCritSec();
+
+  return ulRc;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardDetach()'. An engine using the
+*           board is stopped, the other boards of its set
+*           stop with it.
+*/
+VOID ScanDetach( ULONG ulSlot )
+{
+  ULONG ulScan;
+  ULONG ulIndex;
+
+  for ( ulScan = 0; ulScan < SCAN_ENGINES_MAX; ulScan++ )
+  {
+    if ( aScan[ ulScan ].blInUse == FALSE )
+    {
+      continue;
+    }
+    for ( ulIndex = 0; ulIndex < aScan[ ulScan ].ulBoards;
+          ulIndex++ )
+    {
+      if ( aScan[ ulScan ].aulSlot[ ulIndex ] == ulSlot )
+      {
+        ScanStop( &aScan[ ulScan ] );
+        break;
+      }
+    }
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Tells whether a board belongs to a Scan Engine
+*           already. Called inside 'DosEnterCritSec()'.
+*/
+static BOOL ScanSlotBusy( ULONG ulSlot )
+{
+  ULONG ulScan;
+  ULONG ulIndex;
+
+  for ( ulScan = 0; ulScan < SCAN_ENGINES_MAX; ulScan++ )
+  {
+    if ( aScan[ ulScan ].blInUse == FALSE )
+    {
+      continue;
+    }
+    for ( ulIndex = 0; ulIndex < aScan[ ulScan ].ulBoards;
+          ulIndex++ )
+    {
+      if ( aScan[ ulScan ].aulSlot[ ulIndex ] == ulSlot )
+      {
+        return TRUE;
+      }
+    }
+  }
+  return FALSE;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------24-
+//
+// Export Index 24
+/**
+* \brief 'K8055_StartScan()' starts a Scan Engine for a set
+* of boards. See 'func.h' for details.
+*/
+ULONG K8055_StartScan( ULONG *pulFileDescs,
+                       ULONG *pulBoards,
+                       ULONG *pulCycleMs,
+                       PFNK8055SCAN pfnLogic,
+                       VOID *pvUser,
+                       ULONG *pulScan        )
+{
+  ULONG ulRc;
+  ULONG ulScan;
+  ULONG ulIndex;
+  ULONG ulBoards;
+  ULONG ulSlot;
+  ULONG aulSlot[ K8055_MAX_BOARDS ];
+  INT   iTid;
+  SCANENGINE *pScan;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDescs ) ||
+       ( NULL == pulBoards ) ||
+       ( NULL == pulCycleMs ) ||
+       ( NULL == pfnLogic ) ||
+       ( NULL == pulScan ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+  *pulScan = 0;
+
+  ulBoards = *pulBoards;
+  if ( ( ulBoards < 1 ) || ( ulBoards > K8055_MAX_BOARDS ) ||
+       ( *pulCycleMs < SCAN_CYCLE_MIN_MS ) ||
+       ( *pulCycleMs > SCAN_CYCLE_MAX_MS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  for ( ulIndex = 0; ulIndex < ulBoards; ulIndex++ )
+  {
+    aulSlot[ ulIndex ] = BoardSlot( pulFileDescs[ ulIndex ] );
+    if ( aulSlot[ ulIndex ] == BOARD_NONE )
+    {
+      ulRc = ulRc | ERROR_POINTER;
+      return ulRc;
+    }
+  }
+
+  // -- Take a free engine, no board may be used twice --
+  pScan = NULL;
+  DosEnterCritSec();
+  for ( ulIndex = 0; ulIndex < ulBoards; ulIndex++ )
+  {
+    ulSlot = aulSlot[ ulIndex ];
+    if ( ScanSlotBusy( ulSlot ) == TRUE )
+    {
+      ulRc = ulRc | ERROR_RANGE;
+    }
+  }
+  for ( ulScan = 0; ( ulScan < SCAN_ENGINES_MAX ) &&
+                    ( ulRc == RET_OKAY ); ulScan++ )
+  {
+    if ( aScan[ ulScan ].blInUse == FALSE )
+    {
+      pScan = &aScan[ ulScan ];
+      pScan->blInUse = TRUE;
+      pScan->blStopping = FALSE;
+      pScan->ulBoards = ulBoards;
+      memcpy( &pScan->aulSlot[0], &aulSlot[0],
+              ulBoards * sizeof( ULONG ) );
+      break;
+    }
+  }
+  DosExitCritSec();
+
+  if ( pScan == NULL )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  memset( &pScan->aImage[0], 0, sizeof( pScan->aImage ) );
+  for ( ulIndex = 0; ulIndex < ulBoards; ulIndex++ )
+  {
+    pScan->aImage[ ulIndex ].ulFileDesc = pulFileDescs[ ulIndex ];
+  }
+  pScan->ulCycleUs = *pulCycleMs * 1000;
+  pScan->pfnLogic = pfnLogic;
+  pScan->pvUser = pvUser;
+  pScan->ulCycles = 0;
+  pScan->ulOverruns = 0;
+  pScan->ulReadErrors = 0;
+  pScan->ulJitterMaxUs = 0;
+  pScan->tmJitterSumUs = 0;
+  pScan->ulScanMaxUs = 0;
+
+  DosCreateEventSem( NULL, &pScan->hevStop, 0, FALSE );
+  DosCreateMutexSem( NULL, &pScan->hmtxStats, 0, FALSE );
+  pScan->blRun = TRUE;
+
+  iTid = _beginthread( ScanThread, NULL, THREAD_STACK_SIZE,
+                       (VOID *)ulScan );
+  if ( iTid == -1 )
+  {
+    DosCloseEventSem( pScan->hevStop );
+    DosCloseMutexSem( pScan->hmtxStats );
+    pScan->blRun = FALSE;
+    pScan->blInUse = FALSE;
+    ulRc = ulRc | ERROR_FROM_CALL;
+    return ulRc;
+  }
+  pScan->tid = (TID)iTid;
+
+  *pulScan = ulScan + 1;
+
+  return ulRc;
+}
+//---------24-
+
+
+//----------------------------------------------------------25-
+//
+// Export Index 25
+/**
+* \brief 'K8055_StopScan()' stops a Scan Engine and waits for
+* the end of its thread. See 'func.h' for details.
+*/
+ULONG K8055_StopScan( ULONG *pulScan )
+{
+  ULONG ulRc;
+  //
+  ulRc = RET_OKAY;
+
+  if ( NULL == pulScan )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulScan < 1 ) || ( *pulScan > SCAN_ENGINES_MAX ) ||
+       ( aScan[ *pulScan - 1 ].blInUse == FALSE ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  ulRc = ulRc | ScanStop( &aScan[ *pulScan - 1 ] );
+
+  return ulRc;
+}
+//---------25-
+
+
+//----------------------------------------------------------26-
+//
+// Export Index 26
+/**
+* \brief 'K8055_GetScanStats()' tells how well a Scan Engine
+* keeps its cycle. See 'func.h' for details.
+*/
+ULONG K8055_GetScanStats( ULONG *pulScan,
+                          ULONG *pulCycles,
+                          ULONG *pulOverruns,
+                          ULONG *pulReadErrors,
+                          ULONG *pulJitterMaxUs,
+                          ULONG *pulJitterAvgUs,
+                          ULONG *pulScanMaxUs    )
+{
+  ULONG ulRc;
+  SCANENGINE *pScan;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulScan ) ||
+       ( NULL == pulCycles ) ||
+       ( NULL == pulOverruns ) ||
+       ( NULL == pulReadErrors ) ||
+       ( NULL == pulJitterMaxUs ) ||
+       ( NULL == pulJitterAvgUs ) ||
+       ( NULL == pulScanMaxUs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulScan < 1 ) || ( *pulScan > SCAN_ENGINES_MAX ) ||
+       ( aScan[ *pulScan - 1 ].blInUse == FALSE ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+  pScan = &aScan[ *pulScan - 1 ];
+
+  DosRequestMutexSem( pScan->hmtxStats, SEM_INDEFINITE_WAIT );
+  *pulCycles = pScan->ulCycles;
+  *pulOverruns = pScan->ulOverruns;
+  *pulReadErrors = pScan->ulReadErrors;
+  *pulJitterMaxUs = pScan->ulJitterMaxUs;
+  *pulJitterAvgUs = 0;
+  if ( pScan->ulCycles != 0 )
+  {
+    *pulJitterAvgUs = (ULONG)( pScan->tmJitterSumUs /
+                               pScan->ulCycles      );
+  }
+  *pulScanMaxUs = pScan->ulScanMaxUs;
+  DosReleaseMutexSem( pScan->hmtxStats );
+
+  return ulRc;
+}
+//---------26-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= scan.c === END ===
@@ -0,0 +1,66 @@
+/**
+ * \file 'scan.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'scan.h' is the headerfile belonging to 'scan.c'.
+ * It provides the Process Image handed over to the logic
+ * of a Scan Engine and its constants.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_SCAN_
+#define __K8055DD_H_SCAN_
+
+
+//-- Values belonging to the scan engine -------- BEGIN --!
+//
+/**
+* \brief Number of Scan Engines that can run at the same
+* time. Every engine owns one thread and one set of boards.
+*/
+#define SCAN_ENGINES_MAX  4
+
+/**
+* \brief Scan cycle limits in milliseconds. K8055 delivers a
+* new report via EP81 every 10 ms.
+*/
+#define SCAN_CYCLE_MIN_MS 10
+#define SCAN_CYCLE_MAX_MS 60000
+//
+//-- Values belonging to the scan engine ---------- END --!
+
+
+/**
+* \brief Process Image of one K8055. The engine fills in the
+* inputs and the current outputs at the start of a cycle.
+* The logic changes the outputs, the engine writes them at
+* the end of the cycle.
+*/
+typedef struct _SCANIMAGE
+{
+  ULONG ulFileDesc;      // As given to 'K8055_StartScan()'
+  ULONG ulRcRead;        // 0 or error bits of the EP81 read
+  ULONG ulDigitalIn;     // I1: 0x01 .. I5: 0x10
+  ULONG ulA1;            // 0..255
+  ULONG ulA2;            // 0..255
+  ULONG ulCounter1;      // 0..65535
+  ULONG ulCounter2;      // 0..65535
+  ULONG ulDigitalOut;    // 0..255, written by the logic
+  ULONG ulDAC1;          // 0..255, written by the logic
+  ULONG ulDAC2;          // 0..255, written by the logic
+} SCANIMAGE;
+
+// -- The type of the logic, 'PFNK8055SCAN', is given in
+//    'func.h' next to 'K8055_StartScan()'.
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID ScanDetach( ULONG ulSlot );
+
+#endif
+
+
@@ -0,0 +1,892 @@
+//======================================= sched.c === BEGIN ===
+/**
+ * \file  'sched.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Timer wheel for output changes at future times.
+ *
+ * An application schedules output changes ("O3 on in
+ * 250 ms, off 1.2 s later") and the library carries them
+ * out on its own Scheduler Thread, for all boards.
+ *
+ * Time is divided into slots of 10 ms, the rate at which a
+ * K8055 takes new EP01 frames. All events of one board that
+ * are due in the same slot are merged and written with one
+ * frame, in the order they were scheduled.
+ *
+ * The events are kept in a hierarchical timer wheel of
+ * three levels. Level 0 holds one bucket per slot for the
+ * next 256 slots. Level 1 and 2 hold events further away in
+ * coarser buckets. They are moved one level down when their
+ * bucket comes up ("cascade"). Scheduling, cancelling and
+ * firing an event take constant time, no matter how many
+ * events are pending.
+ *
+ * The thread is started with the first event and ends when
+ * no event is left. It sleeps until the next slot with an
+ * event or a cascade, a new event wakes it. It never skips
+ * such a slot: when it was late, it catches up and the
+ * lateness is measured per event.
+ *
+ * \version 1.0.3 -
+ * 2026-10-19 no store into 'byaPutData[]'
+ * \version 1.0.2 -
+ * 2026-10-19 the thread sleeps until the next slot with work
+ * instead of yielding through every slot at time critical
+ * priority
+ * \version 1.0.1 -
+ * 2026-10-18 every tick is a span of the span recorder
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "sched.h"
+#include "span.h"
+
+
+/**
+* \brief One scheduled output change
+*/
+typedef struct _SCHEDEVENT
+{
+  LONG  lNext;          // Next event in the bucket, -1: none
+  ULONG ulId;           // 0: free
+  BOOL  blCancel;
+  ULONG ulSlot;         // Board Slot
+  ULONG ulDue;          // Slot number of the wheel
+  ULONG ulDoMask;
+  ULONG ulDoBits;
+  ULONG ulDacMask;      // SCHED_DAC1, SCHED_DAC2
+  ULONG ulDac1;
+  ULONG ulDac2;
+} SCHEDEVENT;
+
+/**
+* \brief Bucket of the wheel, events in scheduling order
+*/
+typedef struct _SCHEDBUCKET
+{
+  LONG lHead;
+  LONG lTail;
+} SCHEDBUCKET;
+
+/**
+* \brief Changes of one board within one slot
+*/
+typedef struct _SCHEDMERGE
+{
+  BOOL  blAny;
+  ULONG ulDoMask;
+  ULONG ulDoBits;
+  ULONG ulDacMask;
+  ULONG ulDac1;
+  ULONG ulDac2;
+} SCHEDMERGE;
+
+/**
+* \brief The timer wheel
+*/
+typedef struct _SCHEDWHEEL
+{
+  HMTX        hmtx;          // Guards everything below
+  BOOL        blRun;
+  TID         tid;
+  HEV         hevWake;       // Posted for a new event
+  K8055TIME   tmBase;        // Start of slot 0
+  ULONG       ulTick;        // Next slot to handle
+
+  SCHEDBUCKET aL0[ SCHED_L0_SIZE ];
+  SCHEDBUCKET aL1[ SCHED_LN_SIZE ];
+  SCHEDBUCKET aL2[ SCHED_LN_SIZE ];
+
+  LONG        lFree;         // List of free events
+  ULONG       ulFree;
+  ULONG       ulPending;     // Not fired, not cancelled
+  ULONG       ulSequence;    // Upper part of the next id
+
+  // -- Statistics
+  ULONG       ulFired;
+  ULONG       ulFrames;
+  K8055TIME   tmLateMax;
+  K8055TIME   tmLateSum;
+} SCHEDWHEEL;
+
+
+//-----------------------------------------------------------//
+//--- The wheel and its events, shared by all boards --------//
+//
+SCHEDWHEEL Wheel;
+SCHEDEVENT aSchedEvent[ SCHED_EVENTS_MAX ];
+
+//-----------------------------------------------------------//
+//--- Event ids: sequence number above the event index ------//
+//
+#define SCHED_INDEX_BITS 12
+#define SCHED_INDEX_MASK ( ( 1 << SCHED_INDEX_BITS ) - 1 )
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Empties the wheel, all events become free. Called
+*           with 'hmtx' owned.
+*/
+static VOID SchedReset( VOID )
+{
+  LONG lIndex;
+
+  memset( &Wheel.aL0[0], 0xFF, sizeof( Wheel.aL0 ) );
+  memset( &Wheel.aL1[0], 0xFF, sizeof( Wheel.aL1 ) );
+  memset( &Wheel.aL2[0], 0xFF, sizeof( Wheel.aL2 ) );
+
+  for ( lIndex = 0; lIndex < SCHED_EVENTS_MAX; lIndex++ )
+  {
+    aSchedEvent[ lIndex ].ulId = 0;
+    aSchedEvent[ lIndex ].lNext = lIndex + 1;
+  }
+  aSchedEvent[ SCHED_EVENTS_MAX - 1 ].lNext = -1;
+  Wheel.lFree = 0;
+  Wheel.ulFree = SCHED_EVENTS_MAX;
+  Wheel.ulPending = 0;
+  Wheel.ulTick = 0;
+  Wheel.tmBase = TimeNowUs();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Creates the lock and empties the wheel, once.
+*/
+static VOID SchedInit( VOID )
+{
+  DosEnterCritSec();
+  if ( Wheel.hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &Wheel.hmtx, 0, FALSE );
+    DosCreateEventSem( NULL, &Wheel.hevWake, 0, FALSE );
+    SchedReset();
+  }
+  DosExitCritSec();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Appends an event to a bucket.
+*/
+static VOID SchedAppend( SCHEDBUCKET *pBucket, LONG lIndex )
+{
+  aSchedEvent[ lIndex ].lNext = -1;
+  if ( pBucket->lHead == -1 )
+  {
+    pBucket->lHead = lIndex;
+  }
+  else
+  {
+    aSchedEvent[ pBucket->lTail ].lNext = lIndex;
+  }
+  pBucket->lTail = lIndex;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Puts an event into the bucket its due slot
+*           belongs to, seen from the next slot to handle.
+*/
+static VOID SchedInsert( LONG lIndex )
+{
+  ULONG ulDue;
+  ULONG ulTick;
+
+  ulDue = aSchedEvent[ lIndex ].ulDue;
+  ulTick = Wheel.ulTick;
+
+  if ( ulDue - ulTick < SCHED_L0_SIZE )
+  {
+    SchedAppend( &Wheel.aL0[ ulDue & ( SCHED_L0_SIZE - 1 ) ],
+                 lIndex );
+  }
+  else if ( ( ulDue >> SCHED_L0_BITS ) - ( ulTick >> SCHED_L0_BITS )
+            < SCHED_LN_SIZE )
+  {
+    SchedAppend( &Wheel.aL1[ ( ulDue >> SCHED_L0_BITS ) &
+                             ( SCHED_LN_SIZE - 1 )        ],
+                 lIndex );
+  }
+  else
+  {
+    SchedAppend( &Wheel.aL2[ ( ulDue >> ( SCHED_L0_BITS +
+                                          SCHED_LN_BITS ) ) &
+                             ( SCHED_LN_SIZE - 1 )            ],
+                 lIndex );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Moves all events of a bucket one level down.
+*/
+static VOID SchedCascade( SCHEDBUCKET *pBucket )
+{
+  LONG lIndex;
+  LONG lNext;
+
+  lIndex = pBucket->lHead;
+  pBucket->lHead = -1;
+  pBucket->lTail = -1;
+
+  while ( lIndex != -1 )
+  {
+    lNext = aSchedEvent[ lIndex ].lNext;
+    SchedInsert( lIndex );
+    lIndex = lNext;
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Returns an event to the free list.
+*/
+static VOID SchedFree( LONG lIndex )
+{
+  aSchedEvent[ lIndex ].ulId = 0;
+  aSchedEvent[ lIndex ].lNext = Wheel.lFree;
+  Wheel.lFree = lIndex;
+  ++Wheel.ulFree;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    The next slot with work: the first bucket of
+*           level 0 holding events, or the next cascade if it
+*           comes first. The slots in between are empty.
+*           Called with 'hmtx' owned.
+*/
+static ULONG SchedNext( VOID )
+{
+  ULONG ulTick;
+  ULONG ulCascade;
+
+  ulTick = Wheel.ulTick;
+  ulCascade = ( ulTick + SCHED_L0_SIZE - 1 ) & ~( SCHED_L0_SIZE - 1 );
+  while ( ( ulTick != ulCascade ) &&
+          ( Wheel.aL0[ ulTick & ( SCHED_L0_SIZE - 1 ) ].lHead == -1 ) )
+  {
+    ++ulTick;
+  }
+  return ulTick;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Handles the next slot: cascades, merges the due
+*           events per board and writes one frame per board.
+*           Called with 'hmtx' owned.
+*/
+static VOID SchedTick( VOID )
+{
+  ULONG ulTick;
+  ULONG ulSlot;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  ULONG ulNewOut;
+  ULONG ulNewDAC1;
+  ULONG ulNewDAC2;
+  LONG  lIndex;
+  LONG  lNext;
+  K8055TIME tmLate;
+  K8055TIME tmNow;
+  SCHEDBUCKET *pBucket;
+  SCHEDEVENT *pEvent;
+  SCHEDMERGE *pMerge;
+  SCHEDMERGE aMerge[ K8055_MAX_BOARDS ];
+
+  ulTick = Wheel.ulTick;
+
+  // -- Coarse buckets coming up, upper level first --
+  if ( ( ulTick & ( SCHED_L0_SIZE - 1 ) ) == 0 )
+  {
+    if ( ( ulTick & ( ( 1 << ( SCHED_L0_BITS +
+                               SCHED_LN_BITS ) ) - 1 ) ) == 0 )
+    {
+      SchedCascade( &Wheel.aL2[ ( ulTick >> ( SCHED_L0_BITS +
+                                              SCHED_LN_BITS ) ) &
+                                ( SCHED_LN_SIZE - 1 )            ] );
+    }
+    SchedCascade( &Wheel.aL1[ ( ulTick >> SCHED_L0_BITS ) &
+                              ( SCHED_LN_SIZE - 1 )        ] );
+  }
+
+  pBucket = &Wheel.aL0[ ulTick & ( SCHED_L0_SIZE - 1 ) ];
+  lIndex = pBucket->lHead;
+  pBucket->lHead = -1;
+  pBucket->lTail = -1;
+  ++Wheel.ulTick;
+
+  if ( lIndex == -1 )
+  {
+    return;
+  }
+
+  tmNow = TimeNowUs();
+  tmLate = 0;
+  if ( tmNow > Wheel.tmBase + (K8055TIME)ulTick * SCHED_SLOT_US )
+  {
+    tmLate = tmNow - ( Wheel.tmBase +
+                       (K8055TIME)ulTick * SCHED_SLOT_US );
+  }
+
+  // -- Merge in scheduling order --
+  memset( &aMerge[0], 0, sizeof( aMerge ) );
+  while ( lIndex != -1 )
+  {
+    pEvent = &aSchedEvent[ lIndex ];
+    lNext = pEvent->lNext;
+
+    if ( pEvent->blCancel == FALSE )
+    {
+      pMerge = &aMerge[ pEvent->ulSlot ];
+      pMerge->blAny = TRUE;
+      pMerge->ulDoBits = ( pMerge->ulDoBits & ~pEvent->ulDoMask ) |
+                         ( pEvent->ulDoBits & pEvent->ulDoMask );
+      pMerge->ulDoMask = pMerge->ulDoMask | pEvent->ulDoMask;
+      if ( ( pEvent->ulDacMask & SCHED_DAC1 ) != 0 )
+      {
+        pMerge->ulDac1 = pEvent->ulDac1;
+      }
+      if ( ( pEvent->ulDacMask & SCHED_DAC2 ) != 0 )
+      {
+        pMerge->ulDac2 = pEvent->ulDac2;
+      }
+      pMerge->ulDacMask = pMerge->ulDacMask | pEvent->ulDacMask;
+
+      --Wheel.ulPending;
+      ++Wheel.ulFired;
+      Wheel.tmLateSum = Wheel.tmLateSum + tmLate;
+      if ( tmLate > Wheel.tmLateMax )
+      {
+        Wheel.tmLateMax = tmLate;
+      }
+    }
+    SchedFree( lIndex );
+    lIndex = lNext;
+  }
+
+  // -- One frame per board --
+  for ( ulSlot = 0; ulSlot < K8055_MAX_BOARDS; ulSlot++ )
+  {
+    pMerge = &aMerge[ ulSlot ];
+    if ( pMerge->blAny == FALSE )
+    {
+      continue;
+    }
+
+    BoardLockXfer( ulSlot );
+    BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+    ulNewOut = ( ulDigitalOut & ~pMerge->ulDoMask ) |
+               pMerge->ulDoBits;
+    ulNewDAC1 = ( ( pMerge->ulDacMask & SCHED_DAC1 ) != 0 ) ?
+                pMerge->ulDac1 : ulDAC1;
+    ulNewDAC2 = ( ( pMerge->ulDacMask & SCHED_DAC2 ) != 0 ) ?
+                pMerge->ulDac2 : ulDAC2;
+    if ( ( ulNewOut != ulDigitalOut ) ||
+         ( ulNewDAC1 != ulDAC1 ) ||
+         ( ulNewDAC2 != ulDAC2 ) )
+    {
+      BoardWriteFrame( ulSlot, ulNewOut, ulNewDAC1, ulNewDAC2 );
+      ++Wheel.ulFrames;
+    }
+    BoardUnlockXfer( ulSlot );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of the Scheduler Thread. Handles the slots
+*           with work on absolute deadlines, ends when no
+*           event is pending.
+*/
+static VOID SchedThread( VOID *pvDummy )
+{
+  ULONG ulTick;
+  ULONG ulPostCount;
+  K8055TIME tmDeadline;
+  K8055TIME tmSpan;
+
+  DosSetPriority( PRTYS_THREAD, PRTYC_TIMECRITICAL, 0, 0 );
+
+  while ( TRUE )
+  {
+    DosRequestMutexSem( Wheel.hmtx, SEM_INDEFINITE_WAIT );
+    if ( Wheel.ulPending == 0 )
+    {
+      // -- Cancelled events may still sit in the buckets --
+      SchedReset();
+      Wheel.blRun = FALSE;
+      Wheel.tid = 0;
+      DosReleaseMutexSem( Wheel.hmtx );
+      break;
+    }
+    DosResetEventSem( Wheel.hevWake, &ulPostCount );
+    tmDeadline = Wheel.tmBase +
+                 (K8055TIME)SchedNext() * SCHED_SLOT_US;
+    DosReleaseMutexSem( Wheel.hmtx );
+
+    // -- A new event may be due earlier, look again --
+    if ( TimeWaitSlotUs( tmDeadline, Wheel.hevWake ) == TRUE )
+    {
+      continue;
+    }
+
+    DosRequestMutexSem( Wheel.hmtx, SEM_INDEFINITE_WAIT );
+    ulTick = SchedNext();
+    if ( Wheel.tmBase + (K8055TIME)ulTick * SCHED_SLOT_US <=
+         TimeNowUs() )
+    {
+      // -- Empty slots are passed over --
+      tmSpan = SpanStart();
+      Wheel.ulTick = ulTick;
+      SchedTick();
+      SpanEnd( BOARD_NONE, SPAN_SCHED_TICK, ulTick, tmSpan );
+    }
+    DosReleaseMutexSem( Wheel.hmtx );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Takes a free event and fills in its due slot.
+*           Called with 'hmtx' owned.
+*
+* \return   Index of the event
+*/
+static LONG SchedNew( ULONG ulSlot, ULONG ulDelayMs )
+{
+  LONG  lIndex;
+  ULONG ulDue;
+  K8055TIME tmDue;
+  SCHEDEVENT *pEvent;
+
+  lIndex = Wheel.lFree;
+  Wheel.lFree = aSchedEvent[ lIndex ].lNext;
+  --Wheel.ulFree;
+
+  ++Wheel.ulSequence;
+  if ( ( Wheel.ulSequence << SCHED_INDEX_BITS ) == 0 )
+  {
+    Wheel.ulSequence = 1;
+  }
+
+  // -- First slot that starts at or after the due time --
+  tmDue = TimeNowUs() + (K8055TIME)ulDelayMs * 1000;
+  ulDue = Wheel.ulTick;
+  if ( tmDue > Wheel.tmBase )
+  {
+    ulDue = (ULONG)( ( tmDue - Wheel.tmBase + SCHED_SLOT_US - 1 ) /
+                     SCHED_SLOT_US );
+  }
+  if ( (LONG)( ulDue - Wheel.ulTick ) < 0 )
+  {
+    ulDue = Wheel.ulTick;
+  }
+
+  pEvent = &aSchedEvent[ lIndex ];
+  memset( pEvent, 0, sizeof( SCHEDEVENT ) );
+  pEvent->ulId = ( Wheel.ulSequence << SCHED_INDEX_BITS ) |
+                 (ULONG)lIndex;
+  pEvent->ulSlot = ulSlot;
+  pEvent->ulDue = ulDue;
+
+  return lIndex;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Starts the Scheduler Thread, if it does not run.
+*           Called with 'hmtx' owned.
+*
+* \return   RET_OKAY or ERROR_FROM_CALL
+*/
+static ULONG SchedStart( VOID )
+{
+  INT iTid;
+
+  if ( Wheel.blRun == TRUE )
+  {
+    // -- The event may be due before the slot waited for --
+    DosPostEventSem( Wheel.hevWake );
+    return RET_OKAY;
+  }
+
+  // -- The wheel is empty, slot 0 starts now --
+  Wheel.ulTick = 0;
+  Wheel.tmBase = TimeNowUs();
+
+  iTid = _beginthread( SchedThread, NULL, THREAD_STACK_SIZE, NULL );
+  if ( iTid == -1 )
+  {
+    return ERROR_FROM_CALL;
+  }
+  Wheel.tid = (TID)iTid;
+  Wheel.blRun = TRUE;
+
+  return RET_OKAY;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardDetach()'. All pending events of
+*           the board are cancelled.
+*/
+VOID SchedDetach( ULONG ulSlot )
+{
+  LONG lIndex;
+
+  if ( Wheel.hmtx == 0 )
+  {
+    return;
+  }
+
+  DosRequestMutexSem( Wheel.hmtx, SEM_INDEFINITE_WAIT );
+  for ( lIndex = 0; lIndex < SCHED_EVENTS_MAX; lIndex++ )
+  {
+    if ( ( aSchedEvent[ lIndex ].ulId != 0 ) &&
+         ( aSchedEvent[ lIndex ].ulSlot == ulSlot ) &&
+         ( aSchedEvent[ lIndex ].blCancel == FALSE ) )
+    {
+      aSchedEvent[ lIndex ].blCancel = TRUE;
+      --Wheel.ulPending;
+    }
+  }
+  DosReleaseMutexSem( Wheel.hmtx );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------45-
+//
+// Export Index 45
+/**
+* \brief 'K8055_ScheduleOutput()' schedules an output change
+* at a future time. See 'func.h' for details.
+*/
+ULONG K8055_ScheduleOutput( ULONG *pulFileDesc,
+                            ULONG *pulDelayMs,
+                            ULONG *pulDoMask,
+                            ULONG *pulDoBits,
+                            ULONG *pulDacMask,
+                            ULONG *pulDac1,
+                            ULONG *pulDac2,
+                            ULONG *pulEventId  )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  LONG  lIndex;
+  SCHEDEVENT *pEvent;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulDelayMs ) ||
+       ( NULL == pulDoMask ) ||
+       ( NULL == pulDoBits ) ||
+       ( NULL == pulDacMask ) ||
+       ( NULL == pulDac1 ) ||
+       ( NULL == pulDac2 ) ||
+       ( NULL == pulEventId ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulDelayMs > SCHED_DELAY_MAX_MS ) ||
+       ( *pulDoMask > 0xFF ) || ( *pulDoBits > 0xFF ) ||
+       ( ( *pulDacMask & ~( SCHED_DAC1 | SCHED_DAC2 ) ) != 0 ) ||
+       ( *pulDac1 > 0xFF ) || ( *pulDac2 > 0xFF ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  SchedInit();
+  DosRequestMutexSem( Wheel.hmtx, SEM_INDEFINITE_WAIT );
+
+  if ( Wheel.ulFree == 0 )
+  {
+    DosReleaseMutexSem( Wheel.hmtx );
+    ulRc = ulRc | ERROR_BUFFER;
+    return ulRc;
+  }
+
+  ulRc = ulRc | SchedStart();
+  if ( ulRc != RET_OKAY )
+  {
+    DosReleaseMutexSem( Wheel.hmtx );
+    return ulRc;
+  }
+
+  lIndex = SchedNew( ulSlot, *pulDelayMs );
+  pEvent = &aSchedEvent[ lIndex ];
+  pEvent->ulDoMask = *pulDoMask;
+  pEvent->ulDoBits = *pulDoBits & *pulDoMask;
+  pEvent->ulDacMask = *pulDacMask;
+  pEvent->ulDac1 = *pulDac1;
+  pEvent->ulDac2 = *pulDac2;
+  SchedInsert( lIndex );
+  ++Wheel.ulPending;
+  *pulEventId = pEvent->ulId;
+
+  DosReleaseMutexSem( Wheel.hmtx );
+
+  return ulRc;
+}
+//---------45-
+
+
+//----------------------------------------------------------46-
+//
+// Export Index 46
+/**
+* \brief 'K8055_SchedulePulse()' switches digital outputs on
+* at a future time and off again after a given length.
+* See 'func.h' for details.
+*/
+ULONG K8055_SchedulePulse( ULONG *pulFileDesc,
+                           ULONG *pulDelayMs,
+                           ULONG *pulLengthMs,
+                           ULONG *pulDoMask,
+                           ULONG *pulOnId,
+                           ULONG *pulOffId     )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  LONG  lIndex;
+  SCHEDEVENT *pEvent;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulDelayMs ) ||
+       ( NULL == pulLengthMs ) ||
+       ( NULL == pulDoMask ) ||
+       ( NULL == pulOnId ) ||
+       ( NULL == pulOffId ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulLengthMs < SCHED_SLOT_MS ) ||
+       ( *pulDelayMs > SCHED_DELAY_MAX_MS ) ||
+       ( *pulLengthMs > SCHED_DELAY_MAX_MS - *pulDelayMs ) ||
+       ( *pulDoMask == 0 ) || ( *pulDoMask > 0xFF ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  SchedInit();
+  DosRequestMutexSem( Wheel.hmtx, SEM_INDEFINITE_WAIT );
+
+  if ( Wheel.ulFree < 2 )
+  {
+    DosReleaseMutexSem( Wheel.hmtx );
+    ulRc = ulRc | ERROR_BUFFER;
+    return ulRc;
+  }
+
+  ulRc = ulRc | SchedStart();
+  if ( ulRc != RET_OKAY )
+  {
+    DosReleaseMutexSem( Wheel.hmtx );
+    return ulRc;
+  }
+
+  lIndex = SchedNew( ulSlot, *pulDelayMs );
+  pEvent = &aSchedEvent[ lIndex ];
+  pEvent->ulDoMask = *pulDoMask;
+  pEvent->ulDoBits = *pulDoMask;
+  SchedInsert( lIndex );
+  *pulOnId = pEvent->ulId;
+
+  lIndex = SchedNew( ulSlot, *pulDelayMs + *pulLengthMs );
+  pEvent = &aSchedEvent[ lIndex ];
+  pEvent->ulDoMask = *pulDoMask;
+  pEvent->ulDoBits = 0;
+  SchedInsert( lIndex );
+  *pulOffId = pEvent->ulId;
+
+  Wheel.ulPending = Wheel.ulPending + 2;
+
+  DosReleaseMutexSem( Wheel.hmtx );
+
+  return ulRc;
+}
+//---------46-
+
+
+//----------------------------------------------------------47-
+//
+// Export Index 47
+/**
+* \brief 'K8055_CancelScheduled()' cancels a pending event.
+* See 'func.h' for details.
+*/
+ULONG K8055_CancelScheduled( ULONG *pulFileDesc,
+                             ULONG *pulEventId   )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  SCHEDEVENT *pEvent;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulEventId ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ( ulSlot == BOARD_NONE ) || ( Wheel.hmtx == 0 ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pEvent = &aSchedEvent[ *pulEventId & SCHED_INDEX_MASK ];
+
+  DosRequestMutexSem( Wheel.hmtx, SEM_INDEFINITE_WAIT );
+  if ( ( *pulEventId == 0 ) ||
+       ( pEvent->ulId != *pulEventId ) ||
+       ( pEvent->ulSlot != ulSlot ) ||
+       ( pEvent->blCancel == TRUE ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+  }
+  else
+  {
+    pEvent->blCancel = TRUE;
+    --Wheel.ulPending;
+  }
+  DosReleaseMutexSem( Wheel.hmtx );
+
+  return ulRc;
+}
+//---------47-
+
+
+//----------------------------------------------------------48-
+//
+// Export Index 48
+/**
+* \brief 'K8055_GetScheduleStats()' tells how many events
+* are pending and how late they were fired. See 'func.h'
+* for details.
+*/
+ULONG K8055_GetScheduleStats( ULONG *pulPending,
+                              ULONG *pulFired,
+                              ULONG *pulFrames,
+                              ULONG *pulLateMaxUs,
+                              ULONG *pulLateAvgUs  )
+{
+  ULONG ulRc;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulPending ) ||
+       ( NULL == pulFired ) ||
+       ( NULL == pulFrames ) ||
+       ( NULL == pulLateMaxUs ) ||
+       ( NULL == pulLateAvgUs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  SchedInit();
+  DosRequestMutexSem( Wheel.hmtx, SEM_INDEFINITE_WAIT );
+  *pulPending = Wheel.ulPending;
+  *pulFired = Wheel.ulFired;
+  *pulFrames = Wheel.ulFrames;
+  *pulLateMaxUs = (ULONG)Wheel.tmLateMax;
+  *pulLateAvgUs = 0;
+  if ( Wheel.ulFired != 0 )
+  {
+    *pulLateAvgUs = (ULONG)( Wheel.tmLateSum / Wheel.ulFired );
+  }
+  DosReleaseMutexSem( Wheel.hmtx );
+
+  return ulRc;
+}
+//---------48-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== sched.c === END ===
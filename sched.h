@@ -0,0 +1,62 @@
+/**
+ * \file 'sched.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'sched.h' is the headerfile belonging to 'sched.c',
+ * the timer wheel for output changes at future times.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_SCHED_
+#define __K8055DD_H_SCHED_
+
+
+//-- Values belonging to the timer wheel -------- BEGIN --!
+//
+/**
+* \brief Length of one slot of the wheel. Events due in the
+* same slot are written to a board with one EP01 frame.
+*/
+#define SCHED_SLOT_MS 10
+#define SCHED_SLOT_US ( SCHED_SLOT_MS * 1000 )
+
+/**
+* \brief Events that can be pending at the same time, all
+* boards together.
+*/
+#define SCHED_EVENTS_MAX 4096
+
+/**
+* \brief Levels of the wheel. Level 0 has got one bucket per
+* slot (2.56 s), level 1 one per 256 slots (163.84 s),
+* level 2 one per 16384 slots (2.9 h).
+*/
+#define SCHED_L0_BITS 8
+#define SCHED_LN_BITS 6
+#define SCHED_L0_SIZE ( 1 << SCHED_L0_BITS )
+#define SCHED_LN_SIZE ( 1 << SCHED_LN_BITS )
+
+/**
+* \brief Longest delay, stays within level 2
+*/
+#define SCHED_DELAY_MAX_MS 10000000
+
+/**
+* \brief Which DACs an event sets, see 'K8055_ScheduleOutput()'
+*/
+#define SCHED_DAC1 0x01
+#define SCHED_DAC2 0x02
+//
+//-- Values belonging to the timer wheel ---------- END --!
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID SchedDetach( ULONG ulSlot );
+
+#endif
+
+
@@ -0,0 +1,498 @@
+//======================================== span.c === BEGIN ===
+/**
+ * \file  'span.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Span recorder, a timeline of the library.
+ *
+ * Timing problems with several boards are hard to see in
+ * counters. The span recorder marks the start and the
+ * duration of the calls reading and writing the boards, of
+ * 'K8055_Init()' and of each of its steps with the 'delay()'
+ * that belongs to it, of every transfer, of the pauses before
+ * a retry, of the ticks of the Scheduler and of the logic
+ * callbacks of the Scan Engines.
+ *
+ * 'K8055_StartSpans()' opens a file and starts the Flush
+ * Thread, 'K8055_StopSpans()' ends both. The file is written
+ * in the trace event format of Chrome ( JSON array format )
+ * and may be opened by 'chrome://tracing' or by Perfetto.
+ * Every board gets a track of its own, spans without a board
+ * go to the track of the library.
+ *
+ * The memory is bounded: 'SpanEnd()' puts a span into a
+ * buffer of SPAN_EVENTS entries. The Flush Thread takes the
+ * buffer every SPAN_FLUSH_MS, or as soon as it is half
+ * filled, and writes it to the file. If the buffer is full
+ * nevertheless, a span is lost and counted, the file shows
+ * the lost spans as an instant event. A file that was not
+ * closed by 'K8055_StopSpans()' lacks the closing ']' only,
+ * which the viewers accept.
+ *
+ * While the recorder is off, a span costs one test of
+ * 'lSpansOn'.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "span.h"
+
+
+/**
+* \brief One span waiting for the Flush Thread
+*/
+typedef struct _SPANEVENT
+{
+  ULONG     ulSlot;              // Board Slot or BOARD_NONE
+  ULONG     ulSpan;              // SPAN_xxx
+  ULONG     ulArg;
+  ULONG     ulDurUs;
+  K8055TIME tmStart;
+} SPANEVENT;
+
+/**
+* \brief Name, category and name of the argument of a span
+*/
+typedef struct _SPANKIND
+{
+  CHAR *pszName;
+  CHAR *pszCat;
+  CHAR *pszArg;
+} SPANKIND;
+
+/**
+* \brief The recorder
+*/
+typedef struct _SPANRECORDER
+{
+  HMTX          hmtxCtl;         // Start and stop
+  HMTX          hmtx;            // Guards the buffer, a leaf
+  HEV           hevFlush;
+  volatile BOOL blRun;
+  TID           tid;
+  FILE         *pFile;
+  BOOL          blFirst;         // No ',' before the event
+  K8055TIME     tmBase;          // 'ts' 0 in the file
+  ULONG         ulCount;         // Spans in the buffer
+  ULONG         ulLost;
+  ULONG         ulLostWritten;
+  BOOL          ablNamed[ K8055_MAX_BOARDS + 1 ];
+} SPANRECORDER;
+
+
+static const SPANKIND aSpanKind[ SPAN_COUNT ] =
+{
+  { "K8055_Init",          "call",     "rc"      },
+  { "Init step",           "init",     "step"    },
+  { "Init wait",           "wait",     "ms"      },
+  { "K8055_Read",          "call",     "rc"      },
+  { "K8055_Write",         "call",     "rc"      },
+  { "K8055_ReadAllInputs", "call",     "rc"      },
+  { "K8055_SetAllOutputs", "call",     "rc"      },
+  { "EP0 setup",           "xfer",     "rc"      },
+  { "EP01 out",            "xfer",     "rc"      },
+  { "EP81 in",             "xfer",     "rc"      },
+  { "Retry pause",         "wait",     "attempt" },
+  { "Scheduler tick",      "sched",    "tick"    },
+  { "Scan logic",          "callback", "rc"      }
+};
+
+
+//-----------------------------------------------------------//
+//--- The recorder, the buffer and the copy being written ---//
+//
+SPANRECORDER Span;
+
+SPANEVENT aSpan[ SPAN_EVENTS ];
+SPANEVENT aSpanOut[ SPAN_EVENTS ];
+
+volatile LONG lSpansOn = 0;
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Creates the locks and the event, once.
+*/
+static VOID SpanInit( VOID )
+{
+  DosEnterCritSec();
+  if ( Span.hmtxCtl == 0 )
+  {
+    DosCreateMutexSem( NULL, &Span.hmtxCtl, 0, FALSE );
+    DosCreateMutexSem( NULL, &Span.hmtx, 0, FALSE );
+    DosCreateEventSem( NULL, &Span.hevFlush, 0, FALSE );
+  }
+  DosExitCritSec();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Start of a span.
+*
+* \return   Library clock, 0 while the recorder is off
+*/
+K8055TIME SpanStart( VOID )
+{
+  if ( lSpansOn == 0 )
+  {
+    return 0;
+  }
+  return TimeNowUs();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    End of a span, puts it into the buffer.
+*
+* \param    'tmStart'
+*           - Returned by 'SpanStart()'. With 0 the span is
+*           not recorded.
+*/
+VOID SpanEnd( ULONG ulSlot, ULONG ulSpan, ULONG ulArg,
+              K8055TIME tmStart )
+{
+  K8055TIME tmDuration;
+  SPANEVENT *pEvent;
+
+  if ( ( tmStart == 0 ) || ( ulSpan >= SPAN_COUNT ) )
+  {
+    return;
+  }
+  tmDuration = TimeNowUs() - tmStart;
+  if ( tmDuration > 0xFFFFFFFF )
+  {
+    tmDuration = 0xFFFFFFFF;
+  }
+
+  DosRequestMutexSem( Span.hmtx, SEM_INDEFINITE_WAIT );
+  if ( lSpansOn == 0 )
+  {
+    // -- Stopped meanwhile --
+  }
+  else if ( Span.ulCount >= SPAN_EVENTS )
+  {
+    ++Span.ulLost;
+  }
+  else
+  {
+    pEvent = &aSpan[ Span.ulCount ];
+    pEvent->ulSlot = ulSlot;
+    pEvent->ulSpan = ulSpan;
+    pEvent->ulArg = ulArg;
+    pEvent->ulDurUs = (ULONG)tmDuration;
+    pEvent->tmStart = tmStart;
+    ++Span.ulCount;
+    if ( Span.ulCount == SPAN_EVENTS / 2 )
+    {
+      DosPostEventSem( Span.hevFlush );
+    }
+  }
+  DosReleaseMutexSem( Span.hmtx );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Writes one event, a ',' before all but the first
+*           one.
+*/
+static VOID SpanWriteEvent( CHAR *pszEvent )
+{
+  fprintf( Span.pFile, "%s%s", ( Span.blFirst == TRUE ) ? ""
+                                                        : ",\n",
+           pszEvent );
+  Span.blFirst = FALSE;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Names a track when it gets its first span. Track
+*           0 is the library, track 'ulSlot' + 1 a board.
+*/
+static VOID SpanNameTrack( ULONG ulTrack )
+{
+  CHAR achEvent[ 160 ];
+
+  if ( Span.ablNamed[ ulTrack ] == TRUE )
+  {
+    return;
+  }
+  Span.ablNamed[ ulTrack ] = TRUE;
+
+  if ( ulTrack == 0 )
+  {
+    sprintf( &achEvent[0],
+             "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+             "\"tid\":0,\"args\":{\"name\":\"Library\"}}" );
+  }
+  else
+  {
+    sprintf( &achEvent[0],
+             "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+             "\"tid\":%lu,\"args\":{\"name\":\"Board slot %lu\"}}",
+             ulTrack, ulTrack - 1 );
+  }
+  SpanWriteEvent( &achEvent[0] );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Takes the buffer and writes it to the file.
+*           Called by the Flush Thread, and by
+*           'K8055_StopSpans()' after its end.
+*/
+static VOID SpanFlush( VOID )
+{
+  ULONG ulCount;
+  ULONG ulLost;
+  ULONG ulIndex;
+  ULONG ulTrack;
+  K8055TIME tmTs;
+  SPANEVENT *pEvent;
+  const SPANKIND *pKind;
+  CHAR achEvent[ 200 ];
+
+  DosRequestMutexSem( Span.hmtx, SEM_INDEFINITE_WAIT );
+  ulCount = Span.ulCount;
+  memcpy( &aSpanOut[0], &aSpan[0], ulCount * sizeof( SPANEVENT ) );
+  Span.ulCount = 0;
+  ulLost = Span.ulLost;
+  DosReleaseMutexSem( Span.hmtx );
+
+  for ( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+  {
+    pEvent = &aSpanOut[ ulIndex ];
+    pKind = &aSpanKind[ pEvent->ulSpan ];
+
+    ulTrack = 0;
+    if ( pEvent->ulSlot < K8055_MAX_BOARDS )
+    {
+      ulTrack = pEvent->ulSlot + 1;
+    }
+    SpanNameTrack( ulTrack );
+
+    tmTs = 0;
+    if ( pEvent->tmStart > Span.tmBase )
+    {
+      tmTs = pEvent->tmStart - Span.tmBase;
+    }
+
+    sprintf( &achEvent[0],
+             "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+             "\"ts\":%llu,\"dur\":%lu,\"pid\":1,\"tid\":%lu,"
+             "\"args\":{\"%s\":%lu}}",
+             pKind->pszName, pKind->pszCat, tmTs, pEvent->ulDurUs,
+             ulTrack, pKind->pszArg, pEvent->ulArg );
+    SpanWriteEvent( &achEvent[0] );
+  }
+
+  // -- Lost spans show as an instant event of the library --
+  if ( ulLost != Span.ulLostWritten )
+  {
+    SpanNameTrack( 0 );
+    sprintf( &achEvent[0],
+             "{\"name\":\"Spans lost\",\"cat\":\"span\",\"ph\":\"i\","
+             "\"s\":\"g\",\"ts\":%llu,\"pid\":1,\"tid\":0,"
+             "\"args\":{\"lost\":%lu}}",
+             TimeNowUs() - Span.tmBase, ulLost - Span.ulLostWritten );
+    SpanWriteEvent( &achEvent[0] );
+    Span.ulLostWritten = ulLost;
+  }
+
+  fflush( Span.pFile );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of the Flush Thread.
+*/
+static VOID SpanThread( VOID *pvDummy )
+{
+  ULONG ulPostCount;
+
+  while ( Span.blRun == TRUE )
+  {
+    DosWaitEventSem( Span.hevFlush, SPAN_FLUSH_MS );
+    DosResetEventSem( Span.hevFlush, &ulPostCount );
+    if ( Span.blRun == FALSE )
+    {
+      break;
+    }
+    SpanFlush();
+  }
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------67-
+//
+// Export Index 67
+/**
+* \brief 'K8055_StartSpans()' starts the span recorder,
+* writing to a file. See 'func.h' for details.
+*/
+ULONG K8055_StartSpans( CHAR *pszFileName )
+{
+  ULONG ulRc;
+  ULONG ulPostCount;
+  INT   iTid;
+  //
+  ulRc = RET_OKAY;
+
+  if ( NULL == pszFileName )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  SpanInit();
+  DosRequestMutexSem( Span.hmtxCtl, SEM_INDEFINITE_WAIT );
+
+  if ( Span.blRun == TRUE )
+  {
+    DosReleaseMutexSem( Span.hmtxCtl );
+    ulRc = ulRc | ERROR_CONFLICT;
+    return ulRc;
+  }
+
+  Span.pFile = fopen( pszFileName, "w" );
+  if ( Span.pFile == NULL )
+  {
+    DosReleaseMutexSem( Span.hmtxCtl );
+    ulRc = ulRc | ERROR_FROM_CALL;
+    return ulRc;
+  }
+  fprintf( Span.pFile, "[\n" );
+
+  Span.blFirst = TRUE;
+  Span.ulCount = 0;
+  Span.ulLost = 0;
+  Span.ulLostWritten = 0;
+  memset( &Span.ablNamed[0], 0, sizeof( Span.ablNamed ) );
+  Span.tmBase = TimeNowUs();
+
+  DosResetEventSem( Span.hevFlush, &ulPostCount );
+  Span.blRun = TRUE;
+
+  iTid = _beginthread( SpanThread, NULL, THREAD_STACK_SIZE, NULL );
+  if ( iTid == -1 )
+  {
+    Span.blRun = FALSE;
+    fclose( Span.pFile );
+    Span.pFile = NULL;
+    DosReleaseMutexSem( Span.hmtxCtl );
+    ulRc = ulRc | ERROR_FROM_CALL;
+    return ulRc;
+  }
+  Span.tid = (TID)iTid;
+
+  lSpansOn = 1;
+
+  DosReleaseMutexSem( Span.hmtxCtl );
+  return ulRc;
+}
+//---------67-
+
+
+//----------------------------------------------------------68-
+//
+// Export Index 68
+/**
+* \brief 'K8055_StopSpans()' stops the span recorder and
+* closes its file. See 'func.h' for details.
+*/
+ULONG K8055_StopSpans( ULONG *pulLost )
+{
+  ULONG ulRc;
+  TID   tidFlush;
+  //
+  ulRc = RET_OKAY;
+
+  if ( NULL == pulLost )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  SpanInit();
+  DosRequestMutexSem( Span.hmtxCtl, SEM_INDEFINITE_WAIT );
+
+  if ( Span.blRun == FALSE )
+  {
+    DosReleaseMutexSem( Span.hmtxCtl );
+    ulRc = ulRc | ERROR_CONFLICT;
+    return ulRc;
+  }
+
+  // -- A span ending from now on is dropped --
+  DosRequestMutexSem( Span.hmtx, SEM_INDEFINITE_WAIT );
+  lSpansOn = 0;
+  DosReleaseMutexSem( Span.hmtx );
+
+  Span.blRun = FALSE;
+  DosPostEventSem( Span.hevFlush );
+
+  tidFlush = Span.tid;
+  if ( DosWaitThread( &tidFlush, DCWW_WAIT ) != NO_DOS_ERROR )
+  {
+    ulRc = ulRc | ERROR_FROM_CALL;
+  }
+  Span.tid = 0;
+
+  // -- What is left, then the end of the array --
+  SpanFlush();
+  fprintf( Span.pFile, "\n]\n" );
+  if ( fclose( Span.pFile ) != 0 )
+  {
+    ulRc = ulRc | ERROR_FROM_CALL;
+  }
+  Span.pFile = NULL;
+
+  *pulLost = Span.ulLost;
+
+  DosReleaseMutexSem( Span.hmtxCtl );
+  return ulRc;
+}
+//---------68-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= span.c === END ===
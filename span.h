@@ -0,0 +1,83 @@
+/**
+ * \file 'span.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'span.h' is the headerfile belonging to 'span.c',
+ * the span recorder writing a timeline of the library in the
+ * Chrome trace event format.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_SPAN_
+#define __K8055DD_H_SPAN_
+
+
+//-- Values belonging to the span recorder ------ BEGIN --!
+//
+/**
+* \brief Spans kept until the Flush Thread writes them. If
+* the buffer is full, a span is lost and counted.
+*/
+#define SPAN_EVENTS 1024
+
+/**
+* \brief The Flush Thread writes every SPAN_FLUSH_MS or as
+* soon as half of the buffer is filled.
+*/
+#define SPAN_FLUSH_MS 100
+
+/**
+* \brief Spans, and the value each one shows as argument:
+*
+*   SPAN_INIT        'K8055_Init()', return value
+*   SPAN_INIT_STEP   step of 'K8055_Init()' with its
+*                    'delay()', step 1..9
+*   SPAN_INIT_WAIT   'delay(80)' before step 9, ms
+*   SPAN_READ        'K8055_Read()', return value
+*   SPAN_WRITE       'K8055_Write()', return value
+*   SPAN_READ_ALL    'K8055_ReadAllInputs()', return value
+*   SPAN_SET_ALL     'K8055_SetAllOutputs()', return value
+*   SPAN_XFER_SETUP  Setup Packet via EP0, 'DosWrite()'
+*   SPAN_XFER_OUT    Parameter Packet via EP01, 'DosWrite()'
+*   SPAN_XFER_IN     Parameter Packet via EP81, 'DosWrite()'
+*   SPAN_RETRY_WAIT  Pause before a retry, attempt 1..
+*   SPAN_SCHED_TICK  Tick of the Scheduler, tick number
+*   SPAN_SCAN_LOGIC  Logic of a Scan Engine, return value
+*/
+#define SPAN_INIT        0
+#define SPAN_INIT_STEP   1
+#define SPAN_INIT_WAIT   2
+#define SPAN_READ        3
+#define SPAN_WRITE       4
+#define SPAN_READ_ALL    5
+#define SPAN_SET_ALL     6
+#define SPAN_XFER_SETUP  7
+#define SPAN_XFER_OUT    8
+#define SPAN_XFER_IN     9
+#define SPAN_RETRY_WAIT  10
+#define SPAN_SCHED_TICK  11
+#define SPAN_SCAN_LOGIC  12
+#define SPAN_COUNT       13
+//
+//-- Values belonging to the span recorder -------- END --!
+
+
+//--- Used by the modules marking a span ----------------------
+//    'SpanStart()' returns 0 while the recorder is off, and
+//    'SpanEnd()' does nothing with 0. 'ulSlot' BOARD_NONE
+//    puts the span on the track of the library.
+//    The lock of 'SpanEnd()' is a leaf, it may be called with
+//    any lock owned.
+//
+K8055TIME SpanStart( VOID );
+
+VOID SpanEnd( ULONG ulSlot, ULONG ulSpan, ULONG ulArg,
+              K8055TIME tmStart );
+
+#endif
+
+
+
@@ -0,0 +1,408 @@
+//======================================= stats.c === BEGIN ===
+/**
+ * \file  'stats.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Call statistics and latency histograms per board.
+ *
+ * The exports that transfer data ( 'K8055_Open()',
+ * 'K8055_Init()' and each of its steps, 'K8055_Read()',
+ * 'K8055_Write()', 'K8055_ReadAllInputs()',
+ * 'K8055_SetAllOutputs()' ) and the transfers the library
+ * makes on its own count their calls, the error bits they
+ * returned and their latencies. A slowly degrading USB
+ * connection shows up in the histograms long before a cycle
+ * of the application is missed.
+ *
+ * The statistics are off by default and switched on by
+ * 'K8055_SetStats()'. While they are off, a counted call
+ * costs one test of 'lStatsOn'. While they are on, the
+ * counters are updated with interlocked operations
+ * ( see 'atomic.h' ), no lock is taken. A copy made while
+ * calls are counted may mix two calls, which does not
+ * matter for statistics.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "atomic.h"
+#include "stats.h"
+
+
+/**
+* \brief Counters of one call of one K8055
+*/
+typedef struct _STATSCALL
+{
+  volatile LONG lCalls;
+  volatile LONG lErrors;
+  volatile LONG alErrBit[ STATS_ERROR_BITS ];
+  volatile LONG lLatMin;
+  volatile LONG lLatMax;
+  volatile LONG lLatSumLo;        // Sum of the latencies,
+  volatile LONG lLatSumHi;        // carry in 'lLatSumHi'
+  volatile LONG alBucket[ STATS_LAT_BUCKETS ];
+} STATSCALL;
+
+
+//-----------------------------------------------------------//
+//--- Statistics, indexed by Board Slot and call ------------//
+//
+STATSCALL aStats[ K8055_MAX_BOARDS ][ STAT_CALLS ];
+
+volatile LONG lStatsOn = 0;
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    All counters of a board start from 0.
+*/
+static VOID StatsClear( ULONG ulSlot )
+{
+  ULONG ulCall;
+
+  memset( &aStats[ ulSlot ][ 0 ], 0, sizeof( aStats[ 0 ] ) );
+  for ( ulCall = 0; ulCall < STAT_CALLS; ulCall++ )
+  {
+    aStats[ ulSlot ][ ulCall ].lLatMin = 0x7FFFFFFF;
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'.
+*/
+VOID StatsAttach( ULONG ulSlot )
+{
+  StatsClear( ulSlot );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Start of a counted call.
+*
+* \return   Library clock, 0 while the statistics are off
+*/
+K8055TIME StatsStart( VOID )
+{
+  if ( lStatsOn == 0 )
+  {
+    return 0;
+  }
+  return TimeNowUs();
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    End of a counted call.
+*
+* \param    'tmStart'
+*           - Returned by 'StatsStart()'. With 0 the call is
+*           not counted.
+*/
+VOID StatsEnd( ULONG ulSlot, ULONG ulCall, ULONG ulRc,
+               K8055TIME tmStart )
+{
+  if ( tmStart == 0 )
+  {
+    return;
+  }
+  StatsAdd( ulSlot, ulCall, ulRc, TimeNowUs() - tmStart );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Counts a call whose latency is known already.
+*/
+VOID StatsAdd( ULONG ulSlot, ULONG ulCall, ULONG ulRc,
+               K8055TIME tmLatency )
+{
+  ULONG ulBit;
+  ULONG ulUs;
+  ULONG ulExp;
+  ULONG ulBucket;
+  LONG  lOld;
+  STATSCALL *pCall;
+
+  if ( ( lStatsOn == 0 ) ||
+       ( ulSlot >= K8055_MAX_BOARDS ) ||
+       ( ulCall >= STAT_CALLS ) )
+  {
+    return;
+  }
+  pCall = &aStats[ ulSlot ][ ulCall ];
+
+  ulUs = 0x7FFFFFFF;
+  if ( tmLatency < 0x7FFFFFFF )
+  {
+    ulUs = (ULONG)tmLatency;
+  }
+
+  AtomicExchangeAdd( &pCall->lCalls, 1 );
+  if ( ulRc != RET_OKAY )
+  {
+    AtomicExchangeAdd( &pCall->lErrors, 1 );
+    for ( ulBit = 0; ulBit < STATS_ERROR_BITS; ulBit++ )
+    {
+      if ( ( ulRc & ( 1UL << ulBit ) ) != 0 )
+      {
+        AtomicExchangeAdd( &pCall->alErrBit[ ulBit ], 1 );
+      }
+    }
+  }
+
+  // -- Bucket: linear below 8 us, then 4 per power of 2 --
+  if ( ulUs < STATS_LAT_LINEAR )
+  {
+    ulBucket = ulUs;
+  }
+  else
+  {
+    ulExp = 3;
+    while ( ( ulUs >> ( ulExp + 1 ) ) != 0 )
+    {
+      ++ulExp;
+    }
+    ulBucket = STATS_LAT_LINEAR + 4 * ( ulExp - 3 ) +
+               ( ( ulUs >> ( ulExp - 2 ) ) & 3 );
+    if ( ulBucket >= STATS_LAT_BUCKETS )
+    {
+      ulBucket = STATS_LAT_BUCKETS - 1;
+    }
+  }
+  AtomicExchangeAdd( &pCall->alBucket[ ulBucket ], 1 );
+
+  lOld = AtomicExchangeAdd( &pCall->lLatSumLo, (LONG)ulUs );
+  if ( (ULONG)lOld + ulUs < (ULONG)lOld )
+  {
+    AtomicExchangeAdd( &pCall->lLatSumHi, 1 );
+  }
+
+  do
+  {
+    lOld = pCall->lLatMin;
+  } while ( ( (LONG)ulUs < lOld ) &&
+            ( AtomicCompareExchange( &pCall->lLatMin,
+                                     (LONG)ulUs, lOld ) != lOld ) );
+  do
+  {
+    lOld = pCall->lLatMax;
+  } while ( ( (LONG)ulUs > lOld ) &&
+            ( AtomicCompareExchange( &pCall->lLatMax,
+                                     (LONG)ulUs, lOld ) != lOld ) );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Largest latency a bucket holds.
+*/
+static ULONG StatsBucketTop( ULONG ulBucket )
+{
+  ULONG ulExp;
+  ULONG ulSub;
+
+  if ( ulBucket < STATS_LAT_LINEAR )
+  {
+    return ulBucket;
+  }
+  ulExp = ( ulBucket - STATS_LAT_LINEAR ) / 4 + 3;
+  ulSub = ( ulBucket - STATS_LAT_LINEAR ) % 4;
+  return ( ( 5 + ulSub ) << ( ulExp - 2 ) ) - 1;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Upper bound of the bucket the given percentile
+*           falls into.
+*/
+static ULONG StatsPercentile( CALLSTATS *pStats, ULONG ulPct )
+{
+  ULONG ulBucket;
+  ULONG ulTotal;
+  ULONG ulTarget;
+  ULONG ulSum;
+
+  ulTotal = 0;
+  for ( ulBucket = 0; ulBucket < STATS_LAT_BUCKETS; ulBucket++ )
+  {
+    ulTotal = ulTotal + pStats->aulHistogram[ ulBucket ];
+  }
+  if ( ulTotal == 0 )
+  {
+    return 0;
+  }
+
+  ulTarget = ( ulTotal / 100 ) * ulPct +
+             ( ( ulTotal % 100 ) * ulPct + 99 ) / 100;
+  ulSum = 0;
+  for ( ulBucket = 0; ulBucket < STATS_LAT_BUCKETS - 1; ulBucket++ )
+  {
+    ulSum = ulSum + pStats->aulHistogram[ ulBucket ];
+    if ( ulSum >= ulTarget )
+    {
+      break;
+    }
+  }
+  return StatsBucketTop( ulBucket );
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------62-
+//
+// Export Index 62
+/**
+* \brief 'K8055_SetStats()' switches the call statistics of
+* all boards on or off. See 'func.h' for details.
+*/
+ULONG K8055_SetStats( ULONG *pulEnable,
+                      ULONG *pulReset   )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulEnable ) ||
+       ( NULL == pulReset ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( *pulEnable > 1 )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  if ( *pulReset != 0 )
+  {
+    for ( ulSlot = 0; ulSlot < K8055_MAX_BOARDS; ulSlot++ )
+    {
+      StatsClear( ulSlot );
+    }
+  }
+  AtomicExchange( &lStatsOn, (LONG)*pulEnable );
+
+  return ulRc;
+}
+//---------62-
+
+
+//----------------------------------------------------------63-
+//
+// Export Index 63
+/**
+* \brief 'K8055_GetStats()' copies the statistics of one call
+* of a K8055. See 'func.h' for details.
+*/
+ULONG K8055_GetStats( ULONG *pulFileDesc,
+                      ULONG *pulCall,
+                      struct _CALLSTATS *pCallStats )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulIndex;
+  ULONG ulSumLo;
+  ULONG ulSumHi;
+  STATSCALL *pCall;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulCall ) ||
+       ( NULL == pCallStats ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( *pulCall >= STAT_CALLS )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+  pCall = &aStats[ ulSlot ][ *pulCall ];
+
+  pCallStats->ulCalls = (ULONG)pCall->lCalls;
+  pCallStats->ulErrors = (ULONG)pCall->lErrors;
+  for ( ulIndex = 0; ulIndex < STATS_ERROR_BITS; ulIndex++ )
+  {
+    pCallStats->aulErrBit[ ulIndex ] = (ULONG)pCall->alErrBit[ ulIndex ];
+  }
+  for ( ulIndex = 0; ulIndex < STATS_LAT_BUCKETS; ulIndex++ )
+  {
+    pCallStats->aulHistogram[ ulIndex ] =
+                                (ULONG)pCall->alBucket[ ulIndex ];
+  }
+
+  pCallStats->ulLatMinUs = 0;
+  pCallStats->ulLatMaxUs = 0;
+  pCallStats->ulLatAvgUs = 0;
+  if ( pCallStats->ulCalls != 0 )
+  {
+    pCallStats->ulLatMinUs = (ULONG)pCall->lLatMin;
+    pCallStats->ulLatMaxUs = (ULONG)pCall->lLatMax;
+    ulSumLo = (ULONG)pCall->lLatSumLo;
+    ulSumHi = (ULONG)pCall->lLatSumHi;
+    pCallStats->ulLatAvgUs = (ULONG)
+       ( ( ( (K8055TIME)ulSumHi << 32 ) + ulSumLo ) /
+         pCallStats->ulCalls );
+  }
+  pCallStats->ulLatP50Us = StatsPercentile( pCallStats, 50 );
+  pCallStats->ulLatP90Us = StatsPercentile( pCallStats, 90 );
+  pCallStats->ulLatP99Us = StatsPercentile( pCallStats, 99 );
+
+  return ulRc;
+}
+//---------63-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== stats.c === END ===
@@ -0,0 +1,87 @@
+/**
+ * \file 'stats.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'stats.h' is the headerfile belonging to 'stats.c',
+ * the call statistics and latency histograms per board.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_STATS_
+#define __K8055DD_H_STATS_
+
+
+//-- Values belonging to the call statistics ---- BEGIN --!
+//
+/**
+* \brief Calls counted, 'pulCall' of 'K8055_GetStats()'
+*/
+#define STAT_OPEN       0     // 'K8055_Open()'
+#define STAT_INIT       1     // 'K8055_Init()', all steps
+#define STAT_READ       2     // 'K8055_Read()'
+#define STAT_WRITE      3     // 'K8055_Write()'
+#define STAT_READ_ALL   4     // 'K8055_ReadAllInputs()'
+#define STAT_SET_ALL    5     // 'K8055_SetAllOutputs()'
+#define STAT_XFER_READ  6     // EP81 reads of the library
+#define STAT_XFER_WRITE 7     // EP01 writes of the library
+#define STAT_INIT_STEP  8     // 1st step of 'K8055_Init()',
+                              // 9th step is STAT_INIT_STEP + 8
+#define STAT_CALLS      17
+
+/**
+* \brief Error bits counted one by one, 0x001 .. 0x1000
+*/
+#define STATS_ERROR_BITS 13
+
+/**
+* \brief Log-linear latency histogram. Bucket 0..7 hold
+* 0..7 us. Above, every power of two is split into four
+* buckets of the same width: bucket 8 + 4 * ( e - 3 ) + s
+* holds ( 4 + s ) * 2^( e - 2 ) .. ( 5 + s ) * 2^( e - 2 ) - 1
+* us. The last bucket holds all from 14.7 s on.
+*/
+#define STATS_LAT_LINEAR  8
+#define STATS_LAT_BUCKETS 92
+//
+//-- Values belonging to the call statistics ------ END --!
+
+
+/**
+* \brief Statistics of one call of one K8055,
+* see 'K8055_GetStats()'
+*/
+typedef struct _CALLSTATS
+{
+  ULONG ulCalls;
+  ULONG ulErrors;                        // Calls with rc != 0
+  ULONG aulErrBit[ STATS_ERROR_BITS ];   // [n]: bit 1 << n
+  ULONG ulLatMinUs;
+  ULONG ulLatMaxUs;
+  ULONG ulLatAvgUs;
+  ULONG ulLatP50Us;                      // Upper bounds of
+  ULONG ulLatP90Us;                      // the buckets
+  ULONG ulLatP99Us;
+  ULONG aulHistogram[ STATS_LAT_BUCKETS ];
+} CALLSTATS;
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID      StatsAttach( ULONG ulSlot );
+
+//--- Used by the calls counted -------------------------------
+//    Lock free. While the statistics are off, 'StatsStart()'
+//    returns 0 and nothing else is done.
+//
+K8055TIME StatsStart( VOID );
+VOID      StatsEnd( ULONG ulSlot, ULONG ulCall, ULONG ulRc,
+                    K8055TIME tmStart );
+VOID      StatsAdd( ULONG ulSlot, ULONG ulCall, ULONG ulRc,
+                    K8055TIME tmLatency );
+
+#endif
+
+
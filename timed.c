@@ -0,0 +1,599 @@
+//======================================= timed.c === BEGIN ===
+/**
+ * \file  'timed.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Transfers that return within a timeout.
+ *
+ * 'DosWrite()' to 'usbecd.sys' has got no timeout. A hung
+ * K8055 blocks 'K8055_ReadAllInputs()' or
+ * 'K8055_SetAllOutputs()' and the control loop of the
+ * application with it.
+ *
+ * The timed calls hand their transfer over to the I/O Worker
+ * of the board, a thread of its own, and wait for it no
+ * longer than the timeout. Waiting for the locks of the board
+ * counts as well. If the time is up, the call returns
+ * ERROR_DEADLINE and the transfer is given up: its result
+ * is thrown away, the failure is passed to the recovery
+ * (see 'plug.c'), and further timed calls fail at once with
+ * ERROR_DEADLINE until the hung transfer has returned. The
+ * recovery replaces the handle without waiting for the
+ * transfer lock the hung transfer holds. Whether the driver
+ * then ends the transfer is up to 'usbecd.sys'.
+ * 'K8055_Close()' waits for the I/O Worker no longer than
+ * TIMED_DETACH_WAIT_MS, a worker still hung is left behind
+ * and ends when its transfer returns.
+ *
+ * \version 1.0.4 -
+ * 2026-10-19 calls refused because of a hung transfer are
+ * passed to the recovery and the health tracking
+ * \version 1.0.3 -
+ * 2026-10-19 'K8055_Close()' does not hang on a hung
+ * transfer
+ * \version 1.0.2 -
+ * 2026-10-19 no stores into 'byaPutData[]'
+ * \version 1.0.1 -
+ * 2026-10-18 expired transfers counted by the health
+ * tracking, calls refused by an open circuit breaker
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <process.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "plug.h"
+#include "health.h"
+#include "timed.h"
+
+
+/**
+* \brief I/O Worker of one K8055
+*/
+typedef struct _TIMEDBOARD
+{
+  HMTX      hmtx;           // One timed call at a time
+  TID       tid;
+  HEV       hevArm;         // A job is waiting
+  HEV       hevDone;        // Job done
+  volatile BOOL blRun;
+  volatile BOOL blBusy;     // Job running, maybe given up
+
+  // -- Job
+  ULONG     ulAction;       // TIMED_READ .. TIMED_INIT
+  ULONG     ulDigitalOut;
+  ULONG     ulDAC1;
+  ULONG     ulDAC2;
+  BYTE      byaData[ SIZEBUFFERMAX ];
+  ULONG     ulRcJob;
+
+  // -- Statistics
+  ULONG     ulExpired;
+} TIMEDBOARD;
+
+
+//-----------------------------------------------------------//
+//--- I/O Workers, indexed by Board Slot --------------------//
+//
+TIMEDBOARD aTimed[ K8055_MAX_BOARDS ];
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Carries out one job of the I/O Worker.
+*
+* \return   Error bits of the job
+*/
+static ULONG TimedJob( ULONG ulSlot, TIMEDBOARD *pTimed )
+{
+  ULONG ulRc;
+  ULONG hDev;
+
+  ulRc = RET_OKAY;
+
+  if ( pTimed->ulAction == TIMED_INIT )
+  {
+    hDev = BoardHandle( ulSlot );
+    ulRc = K8055_Init( &hDev );
+    return ulRc;
+  }
+
+  if ( ( pTimed->ulAction == TIMED_WRITE ) ||
+       ( pTimed->ulAction == TIMED_EXCHANGE ) )
+  {
+    if ( BoardWriteFrame( ulSlot,
+                          pTimed->ulDigitalOut,
+                          pTimed->ulDAC1,
+                          pTimed->ulDAC2 ) != NO_DOS_ERROR )
+    {
+      ulRc = ulRc | ERROR_FROM_CALL;
+      return ulRc;
+    }
+  }
+
+  if ( ( pTimed->ulAction == TIMED_READ ) ||
+       ( pTimed->ulAction == TIMED_EXCHANGE ) )
+  {
+    ulRc = ulRc | BoardReadReport( ulSlot, &pTimed->byaData[0] );
+    if ( ulRc == RET_OKAY )
+    {
+      BoardReportIn( ulSlot, &pTimed->byaData[0], TimeNowUs() );
+    }
+  }
+
+  return ulRc;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Body of the I/O Worker of one K8055.
+*
+* \param    'pvSlot'
+*           - Board Slot, passed as a pointer value.
+*/
+static VOID TimedWorker( VOID *pvSlot )
+{
+  ULONG ulSlot;
+  ULONG ulPostCount;
+  TIMEDBOARD *pTimed;
+
+  ulSlot = (ULONG)pvSlot;
+  pTimed = &aTimed[ ulSlot ];
+
+  while ( TRUE )
+  {
+    DosWaitEventSem( pTimed->hevArm, SEM_INDEFINITE_WAIT );
+    DosResetEventSem( pTimed->hevArm, &ulPostCount );
+    if ( pTimed->blRun == FALSE )
+    {
+      break;
+    }
+
+    pTimed->ulRcJob = TimedJob( ulSlot, pTimed );
+    pTimed->blBusy = FALSE;
+    DosPostEventSem( pTimed->hevDone );
+  }
+
+  // -- A worker left behind by 'TimedDetach()' ends here --
+  pTimed->tid = 0;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardDetach()'. The I/O Worker of the
+*           board ends. A worker still in a hung transfer
+*           after TIMED_DETACH_WAIT_MS is left behind, it ends
+*           when the transfer returns.
+*/
+VOID TimedDetach( ULONG ulSlot )
+{
+  ULONG ulRcDOScall;
+  K8055TIME tmEnd;
+  TID tidWorker;
+  TIMEDBOARD *pTimed;
+
+  pTimed = &aTimed[ ulSlot ];
+  if ( pTimed->hmtx == 0 )
+  {
+    return;
+  }
+
+  DosRequestMutexSem( pTimed->hmtx, SEM_INDEFINITE_WAIT );
+  if ( pTimed->blRun == TRUE )
+  {
+    pTimed->blRun = FALSE;
+    DosPostEventSem( pTimed->hevArm );
+    tmEnd = TimeNowUs() + (K8055TIME)TIMED_DETACH_WAIT_MS * 1000;
+    do
+    {
+      tidWorker = pTimed->tid;
+      ulRcDOScall = ERROR_INVALID_THREADID;
+      if ( tidWorker != 0 )
+      {
+        ulRcDOScall = DosWaitThread( &tidWorker, DCWW_NOWAIT );
+      }
+      if ( ulRcDOScall != ERROR_THREAD_NOT_TERMINATED )
+      {
+        // -- Ended, 'blBusy' and 'tid' stay with a worker
+        //    left behind --
+        pTimed->tid = 0;
+        pTimed->blBusy = FALSE;
+        break;
+      }
+      DosSleep( 1 );
+    } while ( TimeNowUs() < tmEnd );
+  }
+  DosReleaseMutexSem( pTimed->hmtx );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Runs one job on the I/O Worker of a board and
+*           waits for it up to the timeout. The job is set in
+*           'aTimed[]' by the caller, who owns 'hmtx'.
+*
+* \param    'tmDeadline'
+*           - Library clock the job has to be done by.
+*
+* \return   Error bits of the job, ERROR_DEADLINE or
+*           ERROR_FROM_CALL if the worker could not be
+*           started
+*/
+static ULONG TimedRun( ULONG ulSlot, K8055TIME tmDeadline )
+{
+  INT iTid;
+  ULONG ulPostCount;
+  ULONG ulWaitMs;
+  K8055TIME tmNow;
+  TIMEDBOARD *pTimed;
+
+  pTimed = &aTimed[ ulSlot ];
+
+  // -- A transfer given up before has not returned yet, or
+  //    a worker left behind by 'TimedDetach()' --
+  //    Every refused call counts like an expired one, so the
+  //    recovery and the circuit breaker see a hung board --
+  if ( ( pTimed->blBusy == TRUE ) ||
+       ( ( pTimed->blRun == FALSE ) && ( pTimed->tid != 0 ) ) )
+  {
+    PlugResult( ulSlot, ERROR_FROM_CALL,
+                ( pTimed->ulAction != TIMED_WRITE ) );
+    HealthResult( ulSlot, ERROR_DEADLINE, 0 );
+    return ERROR_DEADLINE;
+  }
+
+  if ( pTimed->blRun == FALSE )
+  {
+    DosResetEventSem( pTimed->hevArm, &ulPostCount );
+    pTimed->blRun = TRUE;
+    iTid = _beginthread( TimedWorker, NULL, THREAD_STACK_SIZE,
+                         (VOID *)ulSlot );
+    if ( iTid == -1 )
+    {
+      pTimed->blRun = FALSE;
+      return ERROR_FROM_CALL;
+    }
+    pTimed->tid = (TID)iTid;
+  }
+
+  pTimed->blBusy = TRUE;
+  DosResetEventSem( pTimed->hevDone, &ulPostCount );
+  DosPostEventSem( pTimed->hevArm );
+
+  tmNow = TimeNowUs();
+  ulWaitMs = 0;
+  if ( tmDeadline > tmNow )
+  {
+    ulWaitMs = (ULONG)( ( tmDeadline - tmNow + 999 ) / 1000 );
+  }
+  if ( DosWaitEventSem( pTimed->hevDone, ulWaitMs ) != NO_DOS_ERROR )
+  {
+    // -- Given up. 'blBusy' stays until the worker is back --
+    ++pTimed->ulExpired;
+    PlugResult( ulSlot, ERROR_FROM_CALL,
+                ( pTimed->ulAction != TIMED_WRITE ) );
+    HealthResult( ulSlot, ERROR_DEADLINE, TimeNowUs() - tmNow );
+    return ERROR_DEADLINE;
+  }
+
+  return pTimed->ulRcJob;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Common start of the timed calls: checks the
+*           handle and the timeout, takes the lock of the
+*           I/O Worker within the timeout.
+*
+* \param    'pulSlot', 'ptmDeadline'
+*           - Return the Board Slot and the deadline.
+*
+* \return   RET_OKAY, ERROR_POINTER, ERROR_RANGE,
+*           ERROR_BREAKER or ERROR_DEADLINE. With RET_OKAY
+*           the caller owns the lock.
+*/
+static ULONG TimedEnter( ULONG *pulFileDesc,
+                         ULONG *pulTimeoutMs,
+                         ULONG *pulSlot,
+                         K8055TIME *ptmDeadline )
+{
+  ULONG ulSlot;
+  TIMEDBOARD *pTimed;
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    return ERROR_POINTER;
+  }
+  if ( ( *pulTimeoutMs == 0 ) ||
+       ( *pulTimeoutMs > TIMED_TIMEOUT_MAX_MS ) )
+  {
+    return ERROR_RANGE;
+  }
+  if ( HealthGate( ulSlot ) != RET_OKAY )
+  {
+    return ERROR_BREAKER;
+  }
+  *ptmDeadline = TimeNowUs() + (K8055TIME)*pulTimeoutMs * 1000;
+  *pulSlot = ulSlot;
+
+  pTimed = &aTimed[ ulSlot ];
+  DosEnterCritSec();
+  if ( pTimed->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pTimed->hmtx, 0, FALSE );
+    DosCreateEventSem( NULL, &pTimed->hevArm, 0, FALSE );
+    DosCreateEventSem( NULL, &pTimed->hevDone, 0, FALSE );
+  }
+  DosExitCritSec();
+
+  if ( DosRequestMutexSem( pTimed->hmtx, *pulTimeoutMs ) != NO_DOS_ERROR )
+  {
+    return ERROR_DEADLINE;
+  }
+
+  return RET_OKAY;
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------54-
+//
+// Export Index 54
+/**
+* \brief 'K8055_ReadInputsTimed()' reads the inputs like
+* 'K8055_ReadAllInputs()', within a timeout.
+* See 'func.h' for details.
+*/
+ULONG K8055_ReadInputsTimed( ULONG *pulFileDesc,
+                             ULONG *pulTimeoutMs,
+                             ULONG *pulDigitalInputsIx,
+                             ULONG *pulAnalogInputA1,
+                             ULONG *pulAnalogInputA2 )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  K8055TIME tmDeadline;
+  TIMEDBOARD *pTimed;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulTimeoutMs ) ||
+       ( NULL == pulDigitalInputsIx ) ||
+       ( NULL == pulAnalogInputA1 ) ||
+       ( NULL == pulAnalogInputA2 ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulRc = ulRc | TimedEnter( pulFileDesc, pulTimeoutMs,
+                            &ulSlot, &tmDeadline );
+  if ( ulRc != RET_OKAY )
+  {
+    return ulRc;
+  }
+  pTimed = &aTimed[ ulSlot ];
+
+  pTimed->ulAction = TIMED_READ;
+  ulRc = ulRc | TimedRun( ulSlot, tmDeadline );
+  if ( ulRc == RET_OKAY )
+  {
+    *pulDigitalInputsIx = pTimed->byaData[0];
+    *pulAnalogInputA1 = pTimed->byaData[2];
+    *pulAnalogInputA2 = pTimed->byaData[3];
+  }
+
+  DosReleaseMutexSem( pTimed->hmtx );
+
+  return ulRc;
+}
+//---------54-
+
+
+//----------------------------------------------------------55-
+//
+// Export Index 55
+/**
+* \brief 'K8055_WriteOutputsTimed()' writes DO and both DACs
+* within a timeout. See 'func.h' for details.
+*/
+ULONG K8055_WriteOutputsTimed( ULONG *pulFileDesc,
+                               ULONG *pulTimeoutMs,
+                               ULONG *pulDigitalOut,
+                               ULONG *pulDac1,
+                               ULONG *pulDac2        )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  K8055TIME tmDeadline;
+  TIMEDBOARD *pTimed;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulTimeoutMs ) ||
+       ( NULL == pulDigitalOut ) ||
+       ( NULL == pulDac1 ) ||
+       ( NULL == pulDac2 ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulDigitalOut > 0xFF ) ||
+       ( *pulDac1 > 0xFF ) ||
+       ( *pulDac2 > 0xFF ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  ulRc = ulRc | TimedEnter( pulFileDesc, pulTimeoutMs,
+                            &ulSlot, &tmDeadline );
+  if ( ulRc != RET_OKAY )
+  {
+    return ulRc;
+  }
+  pTimed = &aTimed[ ulSlot ];
+
+  pTimed->ulAction = TIMED_WRITE;
+  pTimed->ulDigitalOut = *pulDigitalOut;
+  pTimed->ulDAC1 = *pulDac1;
+  pTimed->ulDAC2 = *pulDac2;
+  ulRc = ulRc | TimedRun( ulSlot, tmDeadline );
+
+  DosReleaseMutexSem( pTimed->hmtx );
+
+  return ulRc;
+}
+//---------55-
+
+
+//----------------------------------------------------------56-
+//
+// Export Index 56
+/**
+* \brief 'K8055_ExchangeTimed()' writes the outputs and reads
+* the inputs right after, both within one timeout.
+* See 'func.h' for details.
+*/
+ULONG K8055_ExchangeTimed( ULONG *pulFileDesc,
+                           ULONG *pulTimeoutMs,
+                           ULONG *pulDigitalOut,
+                           ULONG *pulDac1,
+                           ULONG *pulDac2,
+                           ULONG *pulDigitalInputsIx,
+                           ULONG *pulAnalogInputA1,
+                           ULONG *pulAnalogInputA2   )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  K8055TIME tmDeadline;
+  TIMEDBOARD *pTimed;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulTimeoutMs ) ||
+       ( NULL == pulDigitalOut ) ||
+       ( NULL == pulDac1 ) ||
+       ( NULL == pulDac2 ) ||
+       ( NULL == pulDigitalInputsIx ) ||
+       ( NULL == pulAnalogInputA1 ) ||
+       ( NULL == pulAnalogInputA2 ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulDigitalOut > 0xFF ) ||
+       ( *pulDac1 > 0xFF ) ||
+       ( *pulDac2 > 0xFF ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  ulRc = ulRc | TimedEnter( pulFileDesc, pulTimeoutMs,
+                            &ulSlot, &tmDeadline );
+  if ( ulRc != RET_OKAY )
+  {
+    return ulRc;
+  }
+  pTimed = &aTimed[ ulSlot ];
+
+  pTimed->ulAction = TIMED_EXCHANGE;
+  pTimed->ulDigitalOut = *pulDigitalOut;
+  pTimed->ulDAC1 = *pulDac1;
+  pTimed->ulDAC2 = *pulDac2;
+  ulRc = ulRc | TimedRun( ulSlot, tmDeadline );
+  if ( ulRc == RET_OKAY )
+  {
+    *pulDigitalInputsIx = pTimed->byaData[0];
+    *pulAnalogInputA1 = pTimed->byaData[2];
+    *pulAnalogInputA2 = pTimed->byaData[3];
+  }
+
+  DosReleaseMutexSem( pTimed->hmtx );
+
+  return ulRc;
+}
+//---------56-
+
+
+//----------------------------------------------------------57-
+//
+// Export Index 57
+/**
+* \brief 'K8055_InitTimed()' initialises a K8055 like
+* 'K8055_Init()', within a timeout. See 'func.h' for details.
+*/
+ULONG K8055_InitTimed( ULONG *pulFileDesc,
+                       ULONG *pulTimeoutMs )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  K8055TIME tmDeadline;
+  TIMEDBOARD *pTimed;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulTimeoutMs ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulRc = ulRc | TimedEnter( pulFileDesc, pulTimeoutMs,
+                            &ulSlot, &tmDeadline );
+  if ( ulRc != RET_OKAY )
+  {
+    return ulRc;
+  }
+  pTimed = &aTimed[ ulSlot ];
+
+  pTimed->ulAction = TIMED_INIT;
+  ulRc = ulRc | TimedRun( ulSlot, tmDeadline );
+
+  DosReleaseMutexSem( pTimed->hmtx );
+
+  return ulRc;
+}
+//---------57-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== timed.c === END ===
@@ -0,0 +1,49 @@
+/**
+ * \file 'timed.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'timed.h' is the headerfile belonging to 'timed.c',
+ * the transfers that return within a timeout.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 TIMED_DETACH_WAIT_MS
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_TIMED_
+#define __K8055DD_H_TIMED_
+
+
+//-- Values belonging to timed transfers -------- BEGIN --!
+//
+/**
+* \brief Longest timeout of a timed call
+*/
+#define TIMED_TIMEOUT_MAX_MS 60000
+
+/**
+* \brief Longest wait of 'K8055_Close()' for the I/O Worker.
+* A worker stuck in a hung transfer is left behind.
+*/
+#define TIMED_DETACH_WAIT_MS 1000
+
+/**
+* \brief Job of the I/O Worker
+*/
+#define TIMED_READ     1
+#define TIMED_WRITE    2
+#define TIMED_EXCHANGE 3
+#define TIMED_INIT     4
+//
+//-- Values belonging to timed transfers ---------- END --!
+
+
+//--- Used by board.c -----------------------------------------
+//
+VOID TimedDetach( ULONG ulSlot );
+
+#endif
+
+
@@ -0,0 +1,287 @@
+//-------------------------------------------------------------
+//  Offline decoder 'k8055trc.exe' for the packet trace of
+//
+//  ' USB-Interface Board VELLEMAN K8055 '  aka  'VM110'
+//
+//  It reads a file written by 'K8055_DumpTrace()' of
+//  'K8055DD.dll' and prints every transfer: sequence number,
+//  start time relative to the first transfer, duration,
+//  handle, kind, direction and return value of 'DosWrite()',
+//  what the packet means, and its bytes in hex.
+//
+//  Usage:
+//    k8055trc <dumpfile> [-x]
+//
+//    -x ........ No hex dump, one line per transfer.
+//
+//  Preconditions:
+//  - C Compiler:
+//    'OpenWatcom C 1.6' or higher
+//
+//  - Headerfile 'trace.h' of 'K8055DD.dll' ( '..' )
+//
+//  How to compile and link: see 'Makefile.wmk'.
+//
+//-------------------------------------------------------------
+
+
+
+#include <stdio.h>
+#include <string.h>
+
+#define INCL_DOS
+#include <os2.h>
+
+#include "trace.h"     // Layout of the dump file
+
+
+// -- Function Prototypes ------------------------ BEGIN -----!
+
+VOID PrintingSetup( TRACEENTRY *pEntry );
+
+VOID PrintingData( TRACEENTRY *pEntry );
+
+VOID PrintingHex( TRACEENTRY *pEntry );
+
+// -- Function Prototypes ------------------------ END -------!
+
+
+// == Main ============================== BEGIN ===============
+
+int main( INT argc, CHAR* *argv )
+{
+  FILE          *pFile;
+  TRACEFILEHEAD Head;
+  TRACEENTRY    Entry;
+  ULONG         ulIndex;
+  ULONG         ulLastSeq;
+  ULONG         ulLost;
+  BOOL          blHex;
+  unsigned long long tmFirst;
+  unsigned long long tmStart;
+
+  if ( argc < 2 )
+  {
+    printf( "Usage: k8055trc <dumpfile> [-x]\n" );
+    return 1;
+  }
+  blHex = TRUE;
+  if ( ( argc > 2 ) && ( strcmp( argv[2], "-x" ) == 0 ) )
+  {
+    blHex = FALSE;
+  }
+
+  pFile = fopen( argv[1], "rb" );
+  if ( pFile == NULL )
+  {
+    printf( "Cannot open '%s'\n", argv[1] );
+    return 1;
+  }
+
+  if ( ( fread( &Head, sizeof( TRACEFILEHEAD ), 1, pFile ) != 1 ) ||
+       ( memcmp( &Head.achMagic[0], TRACE_FILE_MAGIC, 8 ) != 0 ) )
+  {
+    printf( "'%s' is no packet trace\n", argv[1] );
+    fclose( pFile );
+    return 1;
+  }
+  if ( ( Head.ulVersion != TRACE_FILE_VERSION ) ||
+       ( Head.ulEntrySize != sizeof( TRACEENTRY ) ) )
+  {
+    printf( "Trace version %lu, entry size %lu not known\n",
+            Head.ulVersion, Head.ulEntrySize );
+    fclose( pFile );
+    return 1;
+  }
+
+  printf( "%lu transfers\n\n", Head.ulCount );
+  printf( "     Seq    Start us     Dur us  Handle Kind  Dir   Rc\n" );
+
+  tmFirst = 0;
+  ulLastSeq = 0;
+  ulLost = 0;
+  for ( ulIndex = 0; ulIndex < Head.ulCount; ulIndex++ )
+  {
+    if ( fread( &Entry, sizeof( TRACEENTRY ), 1, pFile ) != 1 )
+    {
+      printf( "File ends after %lu transfers\n", ulIndex );
+      break;
+    }
+
+    tmStart = ( (unsigned long long)Entry.ulStartUsHi << 32 ) +
+              Entry.ulStartUsLo;
+    if ( ulIndex == 0 )
+    {
+      tmFirst = tmStart;
+    }
+    else if ( Entry.ulSeq != ulLastSeq + 1 )
+    {
+      printf( "   --- %lu transfers lost ---\n",
+              Entry.ulSeq - ulLastSeq - 1 );
+      ulLost = ulLost + Entry.ulSeq - ulLastSeq - 1;
+    }
+    ulLastSeq = Entry.ulSeq;
+
+    printf( "%8lu %11lu %10lu  %6lu %-5s %-3s %4lu  ",
+            Entry.ulSeq,
+            (ULONG)( tmStart - tmFirst ),
+            Entry.ulDurationUs,
+            Entry.ulHandle,
+            ( Entry.ulKind == TRACE_SETUP ) ? "SETUP" : "DATA",
+            ( Entry.ulDir == TRACE_IN ) ? "IN" : "OUT",
+            Entry.ulRcDos );
+
+    if ( Entry.ulKind == TRACE_SETUP )
+    {
+      PrintingSetup( &Entry );
+    }
+    else
+    {
+      PrintingData( &Entry );
+    }
+    if ( blHex == TRUE )
+    {
+      PrintingHex( &Entry );
+    }
+  }
+
+  if ( ulLost != 0 )
+  {
+    printf( "\n%lu transfers lost in all\n", ulLost );
+  }
+
+  fclose( pFile );
+  return 0;
+}
+
+// == Main ============================== END =================
+
+
+//-------------------------------------------------------------
+//
+// Meaning of a Setup Packet via EP0. Bytes 6 and 7 hold the
+// number of bytes transferred after the call.
+//
+VOID PrintingSetup( TRACEENTRY *pEntry )
+{
+  BYTE *pby;
+  ULONG ulDone;
+
+  pby = &pEntry->byaPacket[0];
+  ulDone = pby[6] + ( pby[7] << 8 );
+
+  if ( pby[1] == 0x06 )
+  {
+    switch ( pby[3] )
+    {
+      case 0x01:
+        printf( "GET_DESCRIPTOR Device" );
+        break;
+      case 0x02:
+        printf( "GET_DESCRIPTOR Configuration" );
+        break;
+      case 0x03:
+        printf( "GET_DESCRIPTOR String %u", pby[2] );
+        break;
+      case 0x22:
+        printf( "GET_DESCRIPTOR HID Report" );
+        break;
+      default:
+        printf( "GET_DESCRIPTOR type 0x%02X", pby[3] );
+        break;
+    }
+  }
+  else if ( pby[1] == 0x09 )
+  {
+    printf( "SET_CONFIGURATION %u", pby[2] );
+  }
+  else if ( ( pby[0] == 0x21 ) && ( pby[1] == 0x0A ) )
+  {
+    printf( "SET_IDLE" );
+  }
+  else
+  {
+    printf( "Request 0x%02X 0x%02X", pby[0], pby[1] );
+  }
+  printf( ", %lu bytes\n", ulDone );
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Meaning of a Parameter Packet via EP81 ( report of the
+// inputs ) or EP01 ( command to the outputs ).
+//
+VOID PrintingData( TRACEENTRY *pEntry )
+{
+  BYTE *pby;
+  BYTE *pbyData;
+  ULONG ulIx;
+
+  pby = &pEntry->byaPacket[0];
+  pbyData = &pEntry->byaPacket[8];
+
+  if ( pEntry->ulDir == TRACE_IN )
+  {
+    // -- Raw Ix: I1 0x10, I2 0x20, I3 0x01, I4 0x40, I5 0x80 --
+    ulIx = ( ( pbyData[0] & 0x10 ) ? 0x01 : 0 ) |
+           ( ( pbyData[0] & 0x20 ) ? 0x02 : 0 ) |
+           ( ( pbyData[0] & 0x01 ) ? 0x04 : 0 ) |
+           ( ( pbyData[0] & 0x40 ) ? 0x08 : 0 ) |
+           ( ( pbyData[0] & 0x80 ) ? 0x10 : 0 );
+    printf( "EP81 T%u %u bytes  I %02lX  A1 %3u  A2 %3u  "
+            "C1 %5u  C2 %5u\n",
+            ( pby[1] & 0x08 ) ? 1 : 0,
+            pby[6],
+            ulIx,
+            pbyData[2],
+            pbyData[3],
+            pbyData[4] + ( pbyData[5] << 8 ),
+            pbyData[6] + ( pbyData[7] << 8 ) );
+  }
+  else if ( pbyData[0] == 0x05 )
+  {
+    printf( "EP01 DO %02X  DAC1 %3u  DAC2 %3u\n",
+            pbyData[1], pbyData[2], pbyData[3] );
+  }
+  else
+  {
+    printf( "EP01 command 0x%02X\n", pbyData[0] );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+// Bytes of the packet, the Setup or Parameter Packet first,
+// then the data.
+//
+VOID PrintingHex( TRACEENTRY *pEntry )
+{
+  ULONG ulIndex;
+  ULONG ulLength;
+
+  ulLength = pEntry->ulLength;
+  if ( ulLength > TRACE_PACKET_MAX )
+  {
+    ulLength = TRACE_PACKET_MAX;
+  }
+
+  printf( "          " );
+  for ( ulIndex = 0; ulIndex < ulLength; ulIndex++ )
+  {
+    if ( ulIndex == 8 )
+    {
+      printf( " |" );
+    }
+    else if ( ( ulIndex > 8 ) && ( ( ulIndex - 8 ) % 16 == 0 ) )
+    {
+      printf( "\n           " );
+    }
+    printf( " %02X", pEntry->byaPacket[ ulIndex ] );
+  }
+  printf( "\n" );
+}
+// -----
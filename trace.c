@@ -0,0 +1,346 @@
+//======================================= trace.c === BEGIN ===
+/**
+ * \file  'trace.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Packet trace of all transfers.
+ *
+ * Up to now the packets of 'K8055_Init()' could only be seen
+ * by switching on the 'PrintArray56Byte()' test aids and
+ * compiling again, and the hex dumps on stdout changed the
+ * timing they were meant to show.
+ *
+ * Every Setup Packet and every Parameter Packet now goes
+ * through 'TraceDosWrite()' instead of 'DosWrite()'. It keeps
+ * the packet as it is after the transfer, the return value,
+ * the start time and the duration in a ring of TRACE_ENTRIES
+ * entries. The ring is always on and takes no lock:
+ *
+ *  - A writer takes the next sequence number with an
+ *    interlocked add, clears 'ulSeq' of its entry, fills the
+ *    entry and then stores 'ulSeq'.
+ *  - A reader copies an entry and takes it only if 'ulSeq'
+ *    holds the number it expects before and after the copy.
+ *    An entry overwritten meanwhile is lost, which shows as a
+ *    gap in the sequence numbers.
+ *
+ * 'K8055_GetTrace()' copies the ring to the application,
+ * 'K8055_DumpTrace()' writes it to a file, which is decoded
+ * offline by 'tools/k8055trc.exe'.
+ *
+ * \version 1.0.3 -
+ * 2026-10-18 transfers to an emulated K8055 go to
+ * 'EmulDosWrite()'
+ * \version 1.0.2 -
+ * 2026-10-18 every transfer is a span of the span recorder
+ * \version 1.0.1 -
+ * 2026-10-18 probe points at the start and the end of
+ * every transfer
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "atomic.h"
+#include "trace.h"
+#include "probe.h"
+#include "span.h"
+#include "emul.h"
+
+
+//-----------------------------------------------------------//
+//--- The ring, and the number the next entry gets ----------//
+//
+TRACEENTRY aTrace[ TRACE_ENTRIES ];
+
+volatile LONG lTraceNext = 1;
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    'DosWrite()' to 'usbecd.sys', recorded in the
+*           ring.
+*
+* \return   Return value of 'DosWrite()'
+*/
+ULONG TraceDosWrite( HFILE hDev,
+                     PVOID pvPacket,
+                     ULONG cbPacket,
+                     PULONG pcbDone   )
+{
+  ULONG ulRcDOScall;
+  ULONG ulSeq;
+  ULONG ulKind;
+  ULONG ulDir;
+  ULONG ulSpan;
+  BYTE *pbyPacket;
+  K8055TIME tmSpan;
+  K8055TIME tmStart;
+  K8055TIME tmDuration;
+  TRACEENTRY *pEntry;
+
+  // -- 0xEC is the signature of a Parameter Packet, the
+  //    direction is its endpoint. A Setup Packet has got the
+  //    direction in bit 7 of 'bmRequestType' --
+  pbyPacket = (BYTE *)pvPacket;
+  if ( pbyPacket[0] == 0xEC )
+  {
+    ulKind = TRACE_DATA;
+    ulDir = ( ( pbyPacket[4] & 0x80 ) != 0 ) ? TRACE_IN : TRACE_OUT;
+    ulSpan = ( ulDir == TRACE_IN ) ? SPAN_XFER_IN : SPAN_XFER_OUT;
+  }
+  else
+  {
+    ulKind = TRACE_SETUP;
+    ulDir = ( ( pbyPacket[0] & 0x80 ) != 0 ) ? TRACE_IN : TRACE_OUT;
+    ulSpan = SPAN_XFER_SETUP;
+  }
+
+  PROBE( PROBE_XFER_SUBMIT, hDev, ulKind, ulDir );
+
+  tmSpan = SpanStart();
+  tmStart = TimeNowUs();
+  if ( EmulHandle( (ULONG)hDev ) == TRUE )
+  {
+    ulRcDOScall = EmulDosWrite( (ULONG)hDev, pvPacket, cbPacket,
+                                pcbDone );
+  }
+  else
+  {
+    ulRcDOScall = DosWrite( hDev, pvPacket, cbPacket, pcbDone );
+  }
+  tmDuration = TimeNowUs() - tmStart;
+
+  // -- The slot is looked up only while spans are recorded --
+  if ( tmSpan != 0 )
+  {
+    SpanEnd( BoardSlot( (ULONG)hDev ), ulSpan, ulRcDOScall, tmSpan );
+  }
+
+  PROBE( PROBE_XFER_DONE, hDev, ulRcDOScall, (ULONG)tmDuration );
+
+  ulSeq = (ULONG)AtomicExchangeAdd( &lTraceNext, 1 );
+  pEntry = &aTrace[ ulSeq & ( TRACE_ENTRIES - 1 ) ];
+  AtomicExchange( (volatile LONG *)&pEntry->ulSeq, 0 );
+
+  pEntry->ulKind = ulKind;
+  pEntry->ulDir = ulDir;
+  pEntry->ulHandle = (ULONG)hDev;
+  pEntry->ulRcDos = ulRcDOScall;
+  pEntry->ulLength = cbPacket;
+  pEntry->ulStartUsHi = (ULONG)( tmStart >> 32 );
+  pEntry->ulStartUsLo = (ULONG)tmStart;
+  pEntry->ulDurationUs = (ULONG)tmDuration;
+  if ( tmDuration > 0xFFFFFFFF )
+  {
+    pEntry->ulDurationUs = 0xFFFFFFFF;
+  }
+
+  if ( cbPacket > TRACE_PACKET_MAX )
+  {
+    cbPacket = TRACE_PACKET_MAX;
+  }
+  memset( &pEntry->byaPacket[0], 0, TRACE_PACKET_MAX );
+  memcpy( &pEntry->byaPacket[0], pbyPacket, cbPacket );
+
+  AtomicExchange( (volatile LONG *)&pEntry->ulSeq, (LONG)ulSeq );
+
+  return ulRcDOScall;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Copies the entry with the given sequence number.
+*
+* \return   'ulSeq' if copied. Otherwise the number found in
+*           the entry: 0 or an older one while the entry is
+*           being written, a newer one if it was overwritten.
+*/
+static ULONG TraceCopy( ULONG ulSeq, TRACEENTRY *pCopy )
+{
+  ULONG ulFound;
+  TRACEENTRY *pEntry;
+
+  pEntry = &aTrace[ ulSeq & ( TRACE_ENTRIES - 1 ) ];
+  ulFound = (ULONG)AtomicCompareExchange(
+                          (volatile LONG *)&pEntry->ulSeq, 0, 0 );
+  if ( ulFound != ulSeq )
+  {
+    return ulFound;
+  }
+  memcpy( pCopy, pEntry, sizeof( TRACEENTRY ) );
+  ulFound = (ULONG)AtomicCompareExchange(
+                          (volatile LONG *)&pEntry->ulSeq, 0, 0 );
+  if ( ulFound != ulSeq )
+  {
+    return ulFound;
+  }
+  pCopy->ulSeq = ulSeq;
+  return ulSeq;
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Oldest sequence number that may still be in the
+*           ring, and the next one to come.
+*/
+static VOID TraceRange( ULONG *pulOldest, ULONG *pulNext )
+{
+  *pulNext = (ULONG)lTraceNext;
+  *pulOldest = 1;
+  if ( *pulNext > TRACE_ENTRIES + 1 )
+  {
+    *pulOldest = *pulNext - TRACE_ENTRIES;
+  }
+}
+// -----
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------64-
+//
+// Export Index 64
+/**
+* \brief 'K8055_GetTrace()' copies entries of the packet
+* trace, the oldest first. See 'func.h' for details.
+*/
+ULONG K8055_GetTrace( ULONG *pulFromSeq,
+                      struct _TRACEENTRY *pEntries,
+                      ULONG *pulCount                )
+{
+  ULONG ulRc;
+  ULONG ulSeq;
+  ULONG ulOldest;
+  ULONG ulNext;
+  ULONG ulFound;
+  ULONG ulCopied;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFromSeq ) ||
+       ( NULL == pEntries ) ||
+       ( NULL == pulCount ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  TraceRange( &ulOldest, &ulNext );
+  ulSeq = *pulFromSeq;
+  if ( ulSeq < ulOldest )
+  {
+    ulSeq = ulOldest;
+  }
+
+  // -- An entry still being written ends the copy, the
+  //    next call starts with it --
+  ulCopied = 0;
+  while ( ( ulSeq < ulNext ) && ( ulCopied < *pulCount ) )
+  {
+    ulFound = TraceCopy( ulSeq, &pEntries[ ulCopied ] );
+    if ( ulFound == ulSeq )
+    {
+      ++ulCopied;
+    }
+    else if ( ulFound < ulSeq )
+    {
+      break;
+    }
+    ++ulSeq;
+  }
+
+  *pulCount = ulCopied;
+  *pulFromSeq = ulSeq;
+
+  return ulRc;
+}
+//---------64-
+
+
+//----------------------------------------------------------65-
+//
+// Export Index 65
+/**
+* \brief 'K8055_DumpTrace()' writes the packet trace to a
+* file. See 'func.h' for details.
+*/
+ULONG K8055_DumpTrace( CHAR *pszFileName )
+{
+  ULONG ulRc;
+  ULONG ulSeq;
+  ULONG ulOldest;
+  ULONG ulNext;
+  FILE *pFile;
+  TRACEFILEHEAD Head;
+  TRACEENTRY Entry;
+  //
+  ulRc = RET_OKAY;
+
+  if ( NULL == pszFileName )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  pFile = fopen( pszFileName, "wb" );
+  if ( pFile == NULL )
+  {
+    ulRc = ulRc | ERROR_FROM_CALL;
+    return ulRc;
+  }
+
+  memset( &Head, 0, sizeof( TRACEFILEHEAD ) );
+  memcpy( &Head.achMagic[0], TRACE_FILE_MAGIC, 8 );
+  Head.ulVersion = TRACE_FILE_VERSION;
+  Head.ulEntrySize = sizeof( TRACEENTRY );
+  Head.ulCount = 0;
+  fwrite( &Head, sizeof( TRACEFILEHEAD ), 1, pFile );
+
+  TraceRange( &ulOldest, &ulNext );
+  for ( ulSeq = ulOldest; ulSeq < ulNext; ulSeq++ )
+  {
+    if ( TraceCopy( ulSeq, &Entry ) == ulSeq )
+    {
+      fwrite( &Entry, sizeof( TRACEENTRY ), 1, pFile );
+      ++Head.ulCount;
+    }
+  }
+
+  // -- The number of entries is known at the end only --
+  fseek( pFile, 0, SEEK_SET );
+  fwrite( &Head, sizeof( TRACEFILEHEAD ), 1, pFile );
+  if ( fclose( pFile ) != 0 )
+  {
+    ulRc = ulRc | ERROR_FROM_CALL;
+  }
+
+  return ulRc;
+}
+//---------65-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//======================================== trace.c === END ===
@@ -0,0 +1,94 @@
+/**
+ * \file 'trace.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'trace.h' is the headerfile belonging to 'trace.c',
+ * the packet trace of all transfers to and from 'usbecd.sys'.
+ * The layout of 'TRACEENTRY' and of the dump file is read by
+ * the offline decoder 'tools/k8055trc.c' as well.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_TRACE_
+#define __K8055DD_H_TRACE_
+
+
+//-- Values belonging to the packet trace ------- BEGIN --!
+//
+/**
+* \brief Entries in the ring, a power of 2. The oldest entry
+* is overwritten by the newest one.
+*/
+#define TRACE_ENTRIES 256
+
+/**
+* \brief Bytes kept of a packet. The largest packet is the
+* Configuration Descriptor request, 8 + 48 bytes.
+*/
+#define TRACE_PACKET_MAX 56
+
+/**
+* \brief 'ulKind' of an entry
+*/
+#define TRACE_SETUP 0        // Setup Packet via EP0
+#define TRACE_DATA  1        // Parameter Packet via EP01 / EP81
+
+/**
+* \brief 'ulDir' of an entry
+*/
+#define TRACE_OUT 0          // PC to K8055
+#define TRACE_IN  1          // K8055 to PC
+
+/**
+* \brief Dump file of 'K8055_DumpTrace()': a TRACEFILEHEAD,
+* then 'ulCount' TRACEENTRY, the oldest one first.
+*/
+#define TRACE_FILE_MAGIC   "K8055TRC"
+#define TRACE_FILE_VERSION 1
+//
+//-- Values belonging to the packet trace --------- END --!
+
+
+/**
+* \brief One transfer, see 'K8055_GetTrace()'
+*/
+typedef struct _TRACEENTRY
+{
+  ULONG ulSeq;               // 1, 2, 3 .. a gap means lost
+  ULONG ulHandle;            // Device handle of the K8055
+  ULONG ulRcDos;             // Return value of 'DosWrite()'
+  ULONG ulKind;              // TRACE_SETUP or TRACE_DATA
+  ULONG ulDir;               // TRACE_OUT or TRACE_IN
+  ULONG ulLength;            // Bytes of the packet
+  ULONG ulStartUsHi;         // Library clock at the start
+  ULONG ulStartUsLo;
+  ULONG ulDurationUs;
+  BYTE  byaPacket[ TRACE_PACKET_MAX ];   // After the transfer
+} TRACEENTRY;
+
+/**
+* \brief Head of the dump file
+*/
+typedef struct _TRACEFILEHEAD
+{
+  CHAR  achMagic[ 8 ];       // TRACE_FILE_MAGIC, no '\0'
+  ULONG ulVersion;           // TRACE_FILE_VERSION
+  ULONG ulEntrySize;         // sizeof( TRACEENTRY )
+  ULONG ulCount;
+} TRACEFILEHEAD;
+
+
+//--- Used instead of 'DosWrite()' for every transfer ---------
+//    Lock free, may be called with any lock owned.
+//
+ULONG TraceDosWrite( HFILE hDev,
+                     PVOID pvPacket,
+                     ULONG cbPacket,
+                     PULONG pcbDone   );
+
+#endif
+
+
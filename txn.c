@@ -0,0 +1,187 @@
+//========================================= txn.c === BEGIN ===
+/**
+ * \file  'txn.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Output transactions.
+ *
+ * Changing DO and both DACs took three 'K8055_Prepair...()'
+ * calls and 'K8055_SetAllOutputs()'. Another thread could
+ * come in between and send a half prepared frame.
+ *
+ * A transaction collects all changes in a record of the
+ * application and commits them with one EP01 frame, under
+ * the transfer lock of the board. Without a precondition
+ * only the outputs the transaction changed are written, the
+ * others keep what other threads set in the meantime. With
+ * TXN_COMPARE the commit is a compare and set on the whole
+ * frame: if it changed since 'K8055_TxBegin()', the commit
+ * fails before anything is written.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 no store into 'byaPutData[]', 'K8055_TxBegin()'
+ * reads the outputs with the transfer lock owned
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "txn.h"
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------43-
+//
+// Export Index 43
+/**
+* \brief 'K8055_TxBegin()' starts an output transaction.
+* See 'func.h' for details.
+*/
+ULONG K8055_TxBegin( ULONG *pulFileDesc,
+                     struct _OUTPUTTX *pTx )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pTx ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  BoardLockXfer( ulSlot );
+  BoardGetOutputs( ulSlot,
+                   &pTx->ulOldOut,
+                   &pTx->ulOldDac1,
+                   &pTx->ulOldDac2 );
+  BoardUnlockXfer( ulSlot );
+  pTx->ulDigitalOut = pTx->ulOldOut;
+  pTx->ulDac1 = pTx->ulOldDac1;
+  pTx->ulDac2 = pTx->ulOldDac2;
+
+  return ulRc;
+}
+//---------43-
+
+
+//----------------------------------------------------------44-
+//
+// Export Index 44
+/**
+* \brief 'K8055_TxCommit()' writes an output transaction
+* with one EP01 frame. See 'func.h' for details.
+*/
+ULONG K8055_TxCommit( ULONG *pulFileDesc,
+                      struct _OUTPUTTX *pTx )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulDigitalOut;
+  ULONG ulDAC1;
+  ULONG ulDAC2;
+  ULONG ulChanged;
+  ULONG ulNewOut;
+  ULONG ulNewDAC1;
+  ULONG ulNewDAC2;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pTx ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( pTx->ulDigitalOut > 0xFF ) ||
+       ( pTx->ulDac1 > 0xFF ) ||
+       ( pTx->ulDac2 > 0xFF ) ||
+       ( ( pTx->ulFlags & ~TXN_COMPARE ) != 0 ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  BoardLockXfer( ulSlot );
+  BoardGetOutputs( ulSlot, &ulDigitalOut, &ulDAC1, &ulDAC2 );
+
+  // -- Compare and set: any change in between fails --
+  if ( ( ( pTx->ulFlags & TXN_COMPARE ) != 0 ) &&
+       ( ( ulDigitalOut != pTx->ulOldOut ) ||
+         ( ulDAC1 != pTx->ulOldDac1 ) ||
+         ( ulDAC2 != pTx->ulOldDac2 ) ) )
+  {
+    BoardUnlockXfer( ulSlot );
+    ulRc = ulRc | ERROR_CONFLICT;
+    return ulRc;
+  }
+
+  // -- Merge: only what the transaction changed --
+  ulChanged = pTx->ulDigitalOut ^ pTx->ulOldOut;
+  ulNewOut = ( ulDigitalOut & ~ulChanged ) |
+             ( pTx->ulDigitalOut & ulChanged );
+  ulNewDAC1 = ( pTx->ulDac1 != pTx->ulOldDac1 ) ?
+              pTx->ulDac1 : ulDAC1;
+  ulNewDAC2 = ( pTx->ulDac2 != pTx->ulOldDac2 ) ?
+              pTx->ulDac2 : ulDAC2;
+
+  if ( ( ulNewOut != ulDigitalOut ) ||
+       ( ulNewDAC1 != ulDAC1 ) ||
+       ( ulNewDAC2 != ulDAC2 ) )
+  {
+    if ( BoardWriteFrame( ulSlot, ulNewOut,
+                          ulNewDAC1, ulNewDAC2 ) != NO_DOS_ERROR )
+    {
+      ulRc = ulRc | ERROR_FROM_CALL;
+    }
+  }
+  BoardUnlockXfer( ulSlot );
+
+  // -- Ready for the next transaction on top of this one --
+  pTx->ulOldOut = ulNewOut;
+  pTx->ulOldDac1 = ulNewDAC1;
+  pTx->ulOldDac2 = ulNewDAC2;
+  pTx->ulDigitalOut = ulNewOut;
+  pTx->ulDac1 = ulNewDAC1;
+  pTx->ulDac2 = ulNewDAC2;
+
+  return ulRc;
+}
+//---------44-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================== txn.c === END ===
@@ -0,0 +1,58 @@
+/**
+ * \file 'txn.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'txn.h' is the headerfile belonging to 'txn.c'.
+ * It provides the record of an output transaction.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_TXN_
+#define __K8055DD_H_TXN_
+
+
+//-- Values belonging to output transactions ---- BEGIN --!
+//
+/**
+* \brief Flags of 'ulFlags'
+*
+* TXN_COMPARE: commit only if DO, DAC1 and DAC2 still hold
+* the values seen by 'K8055_TxBegin()'. Otherwise the
+* transaction fails with ERROR_CONFLICT and nothing is
+* written.
+*/
+#define TXN_MERGE   0x0000
+#define TXN_COMPARE 0x0001
+//
+//-- Values belonging to output transactions ------ END --!
+
+
+/**
+* \brief One output transaction, owned by the application.
+*
+* 'K8055_TxBegin()' fills in the outputs as they are and
+* presets the new values with them. The application changes
+* the new values, then 'K8055_TxCommit()' writes them with
+* one EP01 frame.
+*/
+typedef struct _OUTPUTTX
+{
+  ULONG ulFlags;         // TXN_...
+
+  // -- Outputs seen by 'K8055_TxBegin()'
+  ULONG ulOldOut;
+  ULONG ulOldDac1;
+  ULONG ulOldDac2;
+
+  // -- New outputs
+  ULONG ulDigitalOut;    // 0..255
+  ULONG ulDac1;          // 0..255
+  ULONG ulDac2;          // 0..255
+} OUTPUTTX;
+
+#endif
+
+
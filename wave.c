@@ -0,0 +1,625 @@
+//======================================== wave.c === BEGIN ===
+/**
+ * \file  'wave.c'
+ *
+ * \author U. Hinz   , ed.enilno-t@blerdhu
+ * \author B. Hennig , ed.gmx@ginneh.b
+ *
+ * \brief Waveform generator on DAC1 and DAC2.
+ *
+ * Every channel owns a table of one period (256 points).
+ * It is computed once by 'K8055_SetWave()', with the output
+ * range already applied, so the Output Thread only has to
+ * look up one byte per Output Slot (see 'output.c').
+ *
+ * The point is selected by a 32 bit phase accumulator. The
+ * phase is computed from the number of the slot since the
+ * start, not summed up, so the frequency does not drift and
+ * slots the thread has missed do not shift the wave.
+ * Channels started together start in the same slot, so
+ * DAC1 and DAC2 stay locked in phase.
+ *
+ * One point is output per slot, 100 points a second at
+ * most. The generator counts the points it has really put
+ * out and the time they took, so the frequency achieved can
+ * be compared with the one requested by 'K8055_SetWave()'.
+ *
+ * \version 1.0.1 -
+ * 2026-10-19 'K8055_GetWaveStats()' tells the requested and
+ * the achieved frequency of the channel
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+
+#define INCL_DOS
+
+#include <os2.h>
+
+#include "func.h"
+#include "board.h"
+#include "output.h"
+#include "wave.h"
+
+
+/**
+* \brief One generator channel
+*/
+typedef struct _WAVECHANNEL
+{
+  BOOL      blRun;
+  BOOL      blStart;          // Starts with the next slot
+  BYTE      byaTable[ WAVE_TABLE_SIZE ];
+  ULONG     ulFreqMilliHz;    // Requested by 'K8055_SetWave()'
+  ULONG     ulStep;           // Phase step per slot
+  ULONG     ulPhase0;         // Phase offset
+  ULONG     ulStartTick;
+  ULONG     ulLastTick;
+
+  // -- Statistics since start
+  ULONG     ulSamples;        // Points put out
+  ULONG     ulMissed;         // Slots skipped by the thread
+  K8055TIME tmFirst;
+  K8055TIME tmLast;
+} WAVECHANNEL;
+
+/**
+* \brief Generator data of one K8055
+*/
+typedef struct _WAVEBOARD
+{
+  HMTX        hmtx;           // Guards everything below
+  BYTE        byaUser[ WAVE_TABLE_SIZE ];
+  WAVECHANNEL aChannel[ WAVE_CHANNELS ];
+} WAVEBOARD;
+
+
+//-----------------------------------------------------------//
+//--- Generator data, indexed by Board Slot -----------------//
+//
+WAVEBOARD aWave[ K8055_MAX_BOARDS ];
+
+//-----------------------------------------------------------//
+//--- Rotation by one point of the sine table, 2 pi / 256 ---//
+//    Saves the math library.
+//
+#define WAVE_COS_STEP 0.99969881869620425
+#define WAVE_SIN_STEP 0.02454122852291229
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by 'BoardAttach()'. Both channels are
+*           stopped, the user table is a rising ramp.
+*/
+VOID WaveAttach( ULONG ulSlot )
+{
+  ULONG ulIndex;
+  WAVEBOARD *pWave;
+
+  pWave = &aWave[ ulSlot ];
+
+  if ( pWave->hmtx == 0 )
+  {
+    DosCreateMutexSem( NULL, &pWave->hmtx, 0, FALSE );
+  }
+  memset( &pWave->aChannel[0], 0, sizeof( pWave->aChannel ) );
+  for ( ulIndex = 0; ulIndex < WAVE_TABLE_SIZE; ulIndex++ )
+  {
+    pWave->byaUser[ ulIndex ] = (BYTE)ulIndex;
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Computes the table of one channel.
+*
+* \param    'ulLow', 'ulHigh'
+*           - Output range 0..255. A waveform value of 0
+*           gives 'ulLow', a value of 1 gives 'ulHigh'.
+*/
+static VOID WaveTable( WAVEBOARD *pWave,
+                       WAVECHANNEL *pChannel,
+                       ULONG ulShape,
+                       ULONG ulLow,
+                       ULONG ulHigh )
+{
+  ULONG  ulIndex;
+  double dValue;
+  double dSin;
+  double dCos;
+  double dTemp;
+  double dSpan;
+
+  dSpan = (double)ulHigh - (double)ulLow;
+  dSin = 0.0;
+  dCos = 1.0;
+
+  for ( ulIndex = 0; ulIndex < WAVE_TABLE_SIZE; ulIndex++ )
+  {
+    switch ( ulShape )
+    {
+      case WAVE_SINE:
+        dValue = 0.5 + 0.5 * dSin;
+        dTemp = dSin * WAVE_COS_STEP + dCos * WAVE_SIN_STEP;
+        dCos = dCos * WAVE_COS_STEP - dSin * WAVE_SIN_STEP;
+        dSin = dTemp;
+        break;
+
+      case WAVE_RAMP:
+        dValue = (double)ulIndex / ( WAVE_TABLE_SIZE - 1 );
+        break;
+
+      case WAVE_TRIANGLE:
+        if ( ulIndex < WAVE_TABLE_SIZE / 2 )
+        {
+          dValue = (double)ulIndex / ( WAVE_TABLE_SIZE / 2 );
+        }
+        else
+        {
+          dValue = (double)( WAVE_TABLE_SIZE - ulIndex ) /
+                   ( WAVE_TABLE_SIZE / 2 );
+        }
+        break;
+
+      default:
+        dValue = (double)pWave->byaUser[ ulIndex ] / 255.0;
+        break;
+    }
+
+    if ( dValue < 0.0 )
+    {
+      dValue = 0.0;
+    }
+    if ( dValue > 1.0 )
+    {
+      dValue = 1.0;
+    }
+    pChannel->byaTable[ ulIndex ] =
+                     (BYTE)( ulLow + dValue * dSpan + 0.5 );
+  }
+}
+// -----
+
+
+//-------------------------------------------------------------
+//
+/**
+* \brief    Called by the Output Thread at the start of every
+*           Output Slot. Adds the DAC values of the running
+*           channels to the request.
+*/
+VOID WaveSlot( ULONG ulSlot, ULONG ulTick, OUTPUTREQ *pReq )
+{
+  ULONG ulIndex;
+  ULONG ulPhase;
+  BYTE  byValue;
+  K8055TIME tmNow;
+  WAVEBOARD *pWave;
+  WAVECHANNEL *pChannel;
+
+  pWave = &aWave[ ulSlot ];
+  tmNow = TimeNowUs();
+
+  DosRequestMutexSem( pWave->hmtx, SEM_INDEFINITE_WAIT );
+
+  for ( ulIndex = 0; ulIndex < WAVE_CHANNELS; ulIndex++ )
+  {
+    pChannel = &pWave->aChannel[ ulIndex ];
+    if ( pChannel->blRun == FALSE )
+    {
+      continue;
+    }
+
+    if ( pChannel->blStart == TRUE )
+    {
+      pChannel->blStart = FALSE;
+      pChannel->ulStartTick = ulTick;
+      pChannel->tmFirst = tmNow;
+    }
+    else
+    {
+      pChannel->ulMissed = pChannel->ulMissed +
+                           ( ulTick - pChannel->ulLastTick - 1 );
+    }
+    pChannel->ulLastTick = ulTick;
+
+    ulPhase = pChannel->ulPhase0 +
+              pChannel->ulStep * ( ulTick - pChannel->ulStartTick );
+    byValue = pChannel->byaTable[ ( ulPhase >> 24 ) &
+                                  ( WAVE_TABLE_SIZE - 1 ) ];
+
+    if ( ulIndex == 0 )
+    {
+      pReq->blDac1 = TRUE;
+      pReq->ulDac1 = byValue;
+    }
+    else
+    {
+      pReq->blDac2 = TRUE;
+      pReq->ulDac2 = byValue;
+    }
+
+    ++pChannel->ulSamples;
+    pChannel->tmLast = tmNow;
+  }
+
+  DosReleaseMutexSem( pWave->hmtx );
+}
+// -----
+
+
+
+
+
+//-- ef ------------------------------------------- Begin ---//
+//   - Functions to be exported -                            //
+
+//----------------------------------------------------------32-
+//
+// Export Index 32
+/**
+* \brief 'K8055_SetWave()' computes the table of one
+* generator channel. See 'func.h' for details.
+*/
+ULONG K8055_SetWave( ULONG *pulFileDesc,
+                     ULONG *pulChannel,
+                     ULONG *pulShape,
+                     ULONG *pulFreqMilliHz,
+                     ULONG *pulLow,
+                     ULONG *pulHigh,
+                     ULONG *pulPhaseDeg     )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  WAVEBOARD *pWave;
+  WAVECHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulShape ) ||
+       ( NULL == pulFreqMilliHz ) ||
+       ( NULL == pulLow ) ||
+       ( NULL == pulHigh ) ||
+       ( NULL == pulPhaseDeg ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannel < 1 ) || ( *pulChannel > WAVE_CHANNELS ) ||
+       ( *pulShape < WAVE_SINE ) || ( *pulShape > WAVE_USER ) ||
+       ( *pulFreqMilliHz < WAVE_FREQ_MIN_MHZ ) ||
+       ( *pulFreqMilliHz > WAVE_FREQ_MAX_MHZ ) ||
+       ( *pulLow > 255 ) || ( *pulHigh > 255 ) ||
+       ( *pulPhaseDeg > 359 ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pWave = &aWave[ ulSlot ];
+  pChannel = &pWave->aChannel[ *pulChannel - 1 ];
+
+  DosRequestMutexSem( pWave->hmtx, SEM_INDEFINITE_WAIT );
+
+  WaveTable( pWave, pChannel, *pulShape, *pulLow, *pulHigh );
+
+  // -- 2^32 is one period, one step per slot of 10 ms --
+  pChannel->ulFreqMilliHz = *pulFreqMilliHz;
+  pChannel->ulStep = (ULONG)( ( (K8055TIME)*pulFreqMilliHz << 32 ) /
+                              ( 1000 * 1000 / OUTPUT_SLOT_MS ) );
+  pChannel->ulPhase0 = (ULONG)( ( (K8055TIME)*pulPhaseDeg << 32 ) /
+                                360 );
+
+  DosReleaseMutexSem( pWave->hmtx );
+
+  return ulRc;
+}
+//---------32-
+
+
+//----------------------------------------------------------33-
+//
+// Export Index 33
+/**
+* \brief 'K8055_SetWaveTable()' uploads the points of the
+* user waveform. See 'func.h' for details.
+*/
+ULONG K8055_SetWaveTable( ULONG *pulFileDesc,
+                          ULONG *pulPoints,
+                          BYTE *pbyPoints    )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulIndex;
+  ULONG ulPoints;
+  ULONG ulLeft;
+  ULONG ulPos;
+  WAVEBOARD *pWave;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulPoints ) ||
+       ( NULL == pbyPoints ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulPoints = *pulPoints;
+  if ( ( ulPoints < 2 ) || ( ulPoints > WAVE_TABLE_SIZE ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pWave = &aWave[ ulSlot ];
+
+  DosRequestMutexSem( pWave->hmtx, SEM_INDEFINITE_WAIT );
+
+  // -- Stretch to one table, linear between the points.
+  //    The last point leads back to the first one. --
+  for ( ulIndex = 0; ulIndex < WAVE_TABLE_SIZE; ulIndex++ )
+  {
+    ulPos = ulIndex * ulPoints;                   // 1/256 point
+    ulLeft = ulPos / WAVE_TABLE_SIZE;
+    ulPos = ulPos % WAVE_TABLE_SIZE;
+    pWave->byaUser[ ulIndex ] =
+       (BYTE)( ( pbyPoints[ ulLeft ] * ( WAVE_TABLE_SIZE - ulPos ) +
+                 pbyPoints[ ( ulLeft + 1 ) % ulPoints ] * ulPos +
+                 WAVE_TABLE_SIZE / 2 ) / WAVE_TABLE_SIZE );
+  }
+
+  DosReleaseMutexSem( pWave->hmtx );
+
+  return ulRc;
+}
+//---------33-
+
+
+//----------------------------------------------------------34-
+//
+// Export Index 34
+/**
+* \brief 'K8055_StartWave()' starts one or both channels in
+* the same Output Slot. See 'func.h' for details.
+*/
+ULONG K8055_StartWave( ULONG *pulFileDesc,
+                       ULONG *pulChannels  )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulIndex;
+  WAVEBOARD *pWave;
+  WAVECHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannels ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannels == 0 ) ||
+       ( ( *pulChannels & ~( WAVE_DAC1 | WAVE_DAC2 ) ) != 0 ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pWave = &aWave[ ulSlot ];
+
+  // -- Not set up yet --
+  for ( ulIndex = 0; ulIndex < WAVE_CHANNELS; ulIndex++ )
+  {
+    if ( ( ( *pulChannels & ( 1 << ulIndex ) ) != 0 ) &&
+         ( pWave->aChannel[ ulIndex ].ulStep == 0 ) )
+    {
+      ulRc = ulRc | ERROR_INIT;
+      return ulRc;
+    }
+  }
+
+  // -- All channels must see the same first slot --
+  OutputLock( ulSlot );
+  DosRequestMutexSem( pWave->hmtx, SEM_INDEFINITE_WAIT );
+  for ( ulIndex = 0; ulIndex < WAVE_CHANNELS; ulIndex++ )
+  {
+    if ( ( *pulChannels & ( 1 << ulIndex ) ) != 0 )
+    {
+      pChannel = &pWave->aChannel[ ulIndex ];
+      pChannel->blRun = TRUE;
+      pChannel->blStart = TRUE;
+      pChannel->ulSamples = 0;
+      pChannel->ulMissed = 0;
+      pChannel->tmFirst = 0;
+      pChannel->tmLast = 0;
+    }
+  }
+  DosReleaseMutexSem( pWave->hmtx );
+  OutputUnlock( ulSlot );
+
+  ulRc = ulRc | OutputDemand( ulSlot, OUTPUT_CLIENT_WAVE, TRUE );
+
+  return ulRc;
+}
+//---------34-
+
+
+//----------------------------------------------------------35-
+//
+// Export Index 35
+/**
+* \brief 'K8055_StopWave()' stops one or both channels, the
+* DACs keep their last value. See 'func.h' for details.
+*/
+ULONG K8055_StopWave( ULONG *pulFileDesc,
+                      ULONG *pulChannels  )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  ULONG ulIndex;
+  BOOL  blAny;
+  WAVEBOARD *pWave;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannels ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannels & ~( WAVE_DAC1 | WAVE_DAC2 ) ) != 0 )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pWave = &aWave[ ulSlot ];
+
+  OutputLock( ulSlot );
+  DosRequestMutexSem( pWave->hmtx, SEM_INDEFINITE_WAIT );
+  blAny = FALSE;
+  for ( ulIndex = 0; ulIndex < WAVE_CHANNELS; ulIndex++ )
+  {
+    if ( ( *pulChannels & ( 1 << ulIndex ) ) != 0 )
+    {
+      pWave->aChannel[ ulIndex ].blRun = FALSE;
+    }
+    if ( pWave->aChannel[ ulIndex ].blRun == TRUE )
+    {
+      blAny = TRUE;
+    }
+  }
+  DosReleaseMutexSem( pWave->hmtx );
+  OutputUnlock( ulSlot );
+
+  if ( blAny == FALSE )
+  {
+    ulRc = ulRc | OutputDemand( ulSlot, OUTPUT_CLIENT_WAVE, FALSE );
+  }
+
+  return ulRc;
+}
+//---------35-
+
+
+//----------------------------------------------------------36-
+//
+// Export Index 36
+/**
+* \brief 'K8055_GetWaveStats()' compares the achieved with
+* the requested frequency. See 'func.h' for details.
+*/
+ULONG K8055_GetWaveStats( ULONG *pulFileDesc,
+                          ULONG *pulChannel,
+                          ULONG *pulRequestedMilliHz,
+                          ULONG *pulAchievedMilliHz,
+                          ULONG *pulSamples,
+                          ULONG *pulMissed           )
+{
+  ULONG ulRc;
+  ULONG ulSlot;
+  double dPeriods;
+  WAVECHANNEL *pChannel;
+  //
+  ulRc = RET_OKAY;
+
+  if ( ( NULL == pulFileDesc ) ||
+       ( NULL == pulChannel ) ||
+       ( NULL == pulRequestedMilliHz ) ||
+       ( NULL == pulAchievedMilliHz ) ||
+       ( NULL == pulSamples ) ||
+       ( NULL == pulMissed ) )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  ulSlot = BoardSlot( *pulFileDesc );
+  if ( ulSlot == BOARD_NONE )
+  {
+    ulRc = ulRc | ERROR_POINTER;
+    return ulRc;
+  }
+
+  if ( ( *pulChannel < 1 ) || ( *pulChannel > WAVE_CHANNELS ) )
+  {
+    ulRc = ulRc | ERROR_RANGE;
+    return ulRc;
+  }
+
+  pChannel = &aWave[ ulSlot ].aChannel[ *pulChannel - 1 ];
+
+  DosRequestMutexSem( aWave[ ulSlot ].hmtx, SEM_INDEFINITE_WAIT );
+  *pulRequestedMilliHz = pChannel->ulFreqMilliHz;
+  *pulAchievedMilliHz = 0;
+  if ( ( pChannel->ulSamples > 1 ) &&
+       ( pChannel->tmLast > pChannel->tmFirst ) )
+  {
+    // -- Periods between the first and the last point,
+    //    2^32 phase is one period --
+    dPeriods = (double)( pChannel->ulLastTick -
+                         pChannel->ulStartTick ) *
+               (double)pChannel->ulStep / 4294967296.0;
+    *pulAchievedMilliHz =
+        (ULONG)( dPeriods * 1000.0 * 1000000.0 /
+                 (double)( pChannel->tmLast - pChannel->tmFirst ) +
+                 0.5 );
+  }
+  *pulSamples = pChannel->ulSamples;
+  *pulMissed = pChannel->ulMissed;
+  DosReleaseMutexSem( aWave[ ulSlot ].hmtx );
+
+  return ulRc;
+}
+//---------36-
+
+//-- ef --------------------------------------------- End ---//
+//        - Functions to be exported -                       //
+//-- ef --------------------------------------------- End ---//
+
+//========================================= wave.c === END ===
@@ -0,0 +1,65 @@
+/**
+ * \file 'wave.h'
+ *
+ * \author U. Hinz
+ * \author B. Hennig
+ *
+ * \brief 'wave.h' is the headerfile belonging to 'wave.c'.
+ * It provides the constants of the DAC waveform generator.
+ * Include 'output.h' first.
+ *
+ * \version 1.0.0 -
+ * 2026-10-18 init
+ */
+#ifndef __K8055DD_H_WAVE_
+#define __K8055DD_H_WAVE_
+
+
+//-- Values belonging to the waveform generator - BEGIN --!
+//
+/**
+* \brief Number of generator channels. Channel 1 drives DAC1,
+* channel 2 drives DAC2.
+*/
+#define WAVE_CHANNELS 2
+
+/**
+* \brief Channel masks for 'K8055_StartWave()' and
+* 'K8055_StopWave()'
+*/
+#define WAVE_DAC1 0x01
+#define WAVE_DAC2 0x02
+
+/**
+* \brief Points of one period. The upper 8 bits of the
+* 32 bit phase accumulator select the point.
+*/
+#define WAVE_TABLE_SIZE 256
+
+/**
+* \brief Waveforms
+*/
+#define WAVE_SINE     1
+#define WAVE_RAMP     2             // Sawtooth, rising
+#define WAVE_TRIANGLE 3
+#define WAVE_USER     4             // See 'K8055_SetWaveTable()'
+
+/**
+* \brief Frequency limits in milli Hertz. One point is output
+* per Output Slot (10 ms), so 50 Hz would be two points a
+* period.
+*/
+#define WAVE_FREQ_MIN_MHZ 1
+#define WAVE_FREQ_MAX_MHZ 50000
+//
+//-- Values belonging to the waveform generator --- END --!
+
+
+//--- Used by board.c and output.c ----------------------------
+//
+VOID WaveAttach( ULONG ulSlot );
+VOID WaveSlot( ULONG ulSlot, ULONG ulTick, OUTPUTREQ *pReq );
+
+#endif
+
+